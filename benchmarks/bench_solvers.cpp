@@ -0,0 +1,364 @@
+/*
+ * Throughput of the solvers and the structured-grid stencil over grids from
+ * the size that fits in L1 cache to the size that is bound by DRAM bandwidth.
+ *
+ * Each benchmark marches one time step per iteration and reports:
+ *
+ * - cells: grid points (spacetime solution elements or Euler1DCore
+ *   coordinates) advanced per second.
+ * - bytes_per_second: the minimal memory traffic of a step per second.  The
+ *   traffic counts the solution arrays read and written once, and the other
+ *   per-point arrays (CFL, coordinates, grid metrics, heat capacity ratio)
+ *   touched once.
+ *   It is a lower bound of what the hardware moves, so it is comparable
+ *   between runs but not to the peak bandwidth.
+ * - footprint: bytes of the arrays, to tell which level of the memory
+ *   hierarchy holds the working set.
+ *
+ * Use --benchmark_out=<file> --benchmark_out_format=json to record the result
+ * for regression tracking.
+ */
+
+#include <modmesh/onedim/onedim.hpp>
+#include <modmesh/spacetime/spacetime.hpp>
+#include <modmesh/multidim/multidim.hpp>
+#include <modmesh/grid.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#ifdef Py_PYTHON_H
+#error "Python.h should not be included."
+#endif
+
+namespace
+{
+
+// 2^8 to 2^22 points: from a few tens of KB to hundreds of MB of arrays.
+constexpr int64_t GRID_MIN = int64_t(1) << 8;
+constexpr int64_t GRID_MAX = int64_t(1) << 22;
+
+void set_counters(benchmark::State & state, size_t npoint, size_t nbyte_step, size_t footprint)
+{
+    auto const nstep = static_cast<double>(state.iterations());
+    state.counters["cells"] = benchmark::Counter(
+        static_cast<double>(npoint) * nstep,
+        benchmark::Counter::kIsRate);
+    state.counters["footprint"] = benchmark::Counter(
+        static_cast<double>(footprint),
+        benchmark::Counter::kDefaults,
+        benchmark::Counter::kIs1024);
+    state.SetBytesProcessed(static_cast<int64_t>(nbyte_step) * state.iterations());
+}
+
+template <typename S, size_t ALPHA>
+void spacetime_march(benchmark::State & state, double velocity, double amplitude)
+{
+    using namespace modmesh::spacetime; // NOLINT(google-build-using-namespace)
+
+    size_t const ncelm = static_cast<size_t>(state.range(0));
+    double const dx = 2 * M_PI / static_cast<double>(ncelm);
+    auto grid = Grid::construct(0.0, 2 * M_PI, ncelm);
+    // Keep the CFL number at 0.5 for both the linear and Burgers' equations.
+    auto svr = S::construct(grid, 0.5 * dx / (velocity + amplitude));
+    modmesh::SimpleArray<double> so0(ncelm + 1);
+    modmesh::SimpleArray<double> so1(ncelm + 1);
+    for (size_t it = 0; it < so0.size(); ++it)
+    {
+        double const x = dx * static_cast<double>(it);
+        so0[it] = velocity + amplitude * std::sin(x);
+        so1[it] = amplitude * std::cos(x);
+    }
+    svr->set_so0(0, so0, false);
+    svr->set_so1(0, so1, false);
+    svr->setup_march();
+
+    for (auto _ : state)
+    {
+        svr->template march_alpha<ALPHA>(1);
+    }
+    benchmark::DoNotOptimize(svr->so0().data());
+
+    size_t const nbyte_soln = svr->so0().nbytes() + svr->so1().nbytes();
+    size_t const nbyte_other = svr->cfl().nbytes() + grid->xcoord().nbytes() + grid->selm_metric().nbytes();
+    set_counters(state, ncelm, 2 * nbyte_soln + nbyte_other, nbyte_soln + nbyte_other);
+}
+
+/// Sod's shock tube on [-1, 1]; the time increment keeps the CFL number of
+/// the initial condition below 0.5.
+template <typename T>
+std::shared_ptr<modmesh::onedim::BasicEuler1DCore<T>> make_shock_tube(size_t ncoord)
+{
+    using namespace modmesh::onedim; // NOLINT(google-build-using-namespace)
+
+    double const dx = 2.0 / static_cast<double>(ncoord - 1);
+    auto svr = BasicEuler1DCore<T>::construct(ncoord, 0.2 * dx);
+    double const gamma = 1.4;
+    for (size_t it = 0; it < ncoord; ++it)
+    {
+        bool const left = it < ncoord / 2;
+        double const density = left ? 1.0 : 0.125;
+        double const pressure = left ? 1.0 : 0.1;
+        svr->coord()[it] = -1.0 + dx * static_cast<double>(it);
+        svr->cfl()[it] = 0.0;
+        svr->gamma()[it] = static_cast<T>(gamma);
+        svr->so0()(it, 0) = static_cast<T>(density);
+        svr->so0()(it, 1) = 0.0;
+        svr->so0()(it, 2) = static_cast<T>(pressure / (gamma - 1));
+        for (size_t iv = 0; iv < 3; ++iv)
+        {
+            svr->so1()(it, iv) = 0.0;
+        }
+    }
+    svr->setup_march();
+    return svr;
+}
+
+template <typename T, size_t ALPHA>
+void euler1d_march(benchmark::State & state)
+{
+    size_t const ncoord = static_cast<size_t>(state.range(0)) + 1;
+    auto svr = make_shock_tube<T>(ncoord);
+
+    for (auto _ : state)
+    {
+        svr->template march_alpha<ALPHA>(1);
+    }
+    benchmark::DoNotOptimize(svr->so0().data());
+
+    size_t const nbyte_soln = svr->so0().nbytes() + svr->so1().nbytes();
+    size_t const nbyte_other = svr->cfl().nbytes() + svr->metric().nbytes() + svr->gamma().nbytes();
+    set_counters(state, ncoord, 2 * nbyte_soln + nbyte_other, nbyte_soln + nbyte_other);
+}
+
+template <size_t ALPHA>
+void Euler1DCore_march_alpha(benchmark::State & state)
+{
+    euler1d_march<double, ALPHA>(state);
+}
+
+/// The solution stored in float32 halves the solution traffic.
+template <size_t ALPHA>
+void Euler1DCoreFp32_march_alpha(benchmark::State & state)
+{
+    euler1d_march<float, ALPHA>(state);
+}
+
+/**
+ * Fork a solver from a warmed-up one and march the fork one step, as a
+ * parameter study does.  The fork copies the solution and the CFL number
+ * when it marches, and shares the coordinates, the heat capacity ratio, and
+ * the grid metric with the origin.
+ */
+void Euler1DCore_clone_march(benchmark::State & state)
+{
+    size_t const ncoord = static_cast<size_t>(state.range(0)) + 1;
+    auto svr = make_shock_tube<double>(ncoord);
+    svr->march_alpha<2>(1);
+
+    for (auto _ : state)
+    {
+        auto fork = svr->clone();
+        fork->march_alpha<2>(1);
+        benchmark::DoNotOptimize(fork->so0().data());
+    }
+
+    auto const & csvr = *svr;
+    size_t const nbyte_soln = csvr.so0().nbytes() + csvr.so1().nbytes();
+    size_t const nbyte_other = csvr.cfl().nbytes() + csvr.metric().nbytes() + csvr.gamma().nbytes();
+    set_counters(state, ncoord, 3 * nbyte_soln + nbyte_other, nbyte_soln + nbyte_other);
+}
+
+/// The generic conservation-law core with the Euler flux, to compare against
+/// the hand-written Euler1DCore.
+template <size_t ALPHA>
+void GenericEuler1DCore_march_alpha(benchmark::State & state)
+{
+    using namespace modmesh::onedim; // NOLINT(google-build-using-namespace)
+
+    size_t const ncoord = static_cast<size_t>(state.range(0)) + 1;
+    double const dx = 2.0 / static_cast<double>(ncoord - 1);
+    auto svr = GenericEuler1DCore::construct(ncoord, 0.2 * dx);
+    double const gamma = svr->policy().gamma;
+    for (size_t it = 0; it < ncoord; ++it)
+    {
+        bool const left = it < ncoord / 2;
+        double const density = left ? 1.0 : 0.125;
+        double const pressure = left ? 1.0 : 0.1;
+        svr->coord()[it] = -1.0 + dx * static_cast<double>(it);
+        svr->cfl()[it] = 0.0;
+        svr->so0()(it, 0) = density;
+        svr->so0()(it, 1) = 0.0;
+        svr->so0()(it, 2) = pressure / (gamma - 1);
+        for (size_t iv = 0; iv < 3; ++iv)
+        {
+            svr->so1()(it, iv) = 0.0;
+        }
+    }
+    svr->setup_march();
+
+    for (auto _ : state)
+    {
+        svr->template march_alpha<ALPHA>(1);
+    }
+    benchmark::DoNotOptimize(svr->so0().data());
+
+    size_t const nbyte_soln = svr->so0().nbytes() + svr->so1().nbytes();
+    size_t const nbyte_other = svr->cfl().nbytes() + svr->metric().nbytes();
+    set_counters(state, ncoord, 2 * nbyte_soln + nbyte_other, nbyte_soln + nbyte_other);
+}
+
+/// Square [0, 1]^2 meshed by nside x nside quadrilaterals or twice as many triangles.
+std::shared_ptr<modmesh::StaticMesh> make_square_mesh(size_t nside, bool triangle)
+{
+    using modmesh::StaticMesh;
+
+    size_t const nrow = nside + 1;
+    auto mh = StaticMesh::construct(
+        /* ndim */ 2,
+        /* nnode */ static_cast<uint32_t>(nrow * nrow),
+        /* nface */ 0,
+        /* ncell */ static_cast<uint32_t>(nside * nside * (triangle ? 2 : 1)));
+    for (size_t ind = 0; ind < nrow * nrow; ++ind)
+    {
+        mh->ndcrd(ind, 0) = static_cast<double>(ind % nrow) / static_cast<double>(nside);
+        mh->ndcrd(ind, 1) = static_cast<double>(ind / nrow) / static_cast<double>(nside);
+    }
+    size_t icl = 0;
+    for (size_t iy = 0; iy < nside; ++iy)
+    {
+        for (size_t ix = 0; ix < nside; ++ix)
+        {
+            int32_t const nd0 = static_cast<int32_t>(iy * nrow + ix);
+            int32_t const nds[4] = {nd0, nd0 + 1, nd0 + 1 + static_cast<int32_t>(nrow), nd0 + static_cast<int32_t>(nrow)};
+            if (triangle)
+            {
+                for (size_t itr = 0; itr < 2; ++itr)
+                {
+                    mh->cltpn(icl) = modmesh::CellType::TRIANGLE;
+                    mh->clnds(icl, 0) = 3;
+                    mh->clnds(icl, 1) = nds[0];
+                    mh->clnds(icl, 2) = nds[1 + itr];
+                    mh->clnds(icl, 3) = nds[2 + itr];
+                    ++icl;
+                }
+            }
+            else
+            {
+                mh->cltpn(icl) = modmesh::CellType::QUADRILATERAL;
+                mh->clnds(icl, 0) = 4;
+                for (size_t inl = 0; inl < 4; ++inl)
+                {
+                    mh->clnds(icl, inl + 1) = nds[inl];
+                }
+                ++icl;
+            }
+        }
+    }
+    mh->build_interior(true);
+    mh->build_boundary();
+    mh->build_ghost();
+    return mh;
+}
+
+/// The unstructured-mesh CESE solver marching a 2D Riemann problem.
+template <bool TRIANGLE, size_t ALPHA>
+void EulerCore_march_alpha(benchmark::State & state)
+{
+    using modmesh::EulerCore;
+    using modmesh::SimpleArray;
+    using modmesh::small_vector;
+
+    size_t const nside = static_cast<size_t>(state.range(0));
+    auto mh = make_square_mesh(nside, TRIANGLE);
+    auto svr = EulerCore::construct(mh, 0.0);
+    svr->set_bc(0, EulerCore::SLIPWALL);
+    svr->set_time_increment(0.2 / static_cast<double>(nside));
+
+    size_t const ncell = svr->ncell();
+    SimpleArray<double> density(small_vector<size_t>{ncell});
+    SimpleArray<double> velocity(small_vector<size_t>{ncell, 2}, 0.0);
+    SimpleArray<double> pressure(small_vector<size_t>{ncell});
+    for (size_t icl = 0; icl < ncell; ++icl)
+    {
+        bool const inner = mh->clcnd(icl, 0) < 0.5 && mh->clcnd(icl, 1) < 0.5;
+        density(icl) = inner ? 1.0 : 0.125;
+        pressure(icl) = inner ? 1.0 : 0.1;
+    }
+    svr->set_primitive(density, velocity, pressure);
+    svr->setup_march();
+
+    for (auto _ : state)
+    {
+        svr->template march_alpha<ALPHA>(1);
+    }
+    benchmark::DoNotOptimize(svr->soln().data());
+
+    size_t const nbyte_soln = svr->soln().nbytes() + svr->dsoln().nbytes() + svr->solt().nbytes();
+    size_t const nbyte_geom = svr->cecnd().nbytes() + svr->cevol().nbytes() + svr->sfmrc().nbytes();
+    set_counters(state, ncell, 2 * (2 * nbyte_soln + nbyte_geom), 2 * nbyte_soln + nbyte_geom);
+}
+
+/// The 5-point Laplacian on a structured grid.
+void StaticGrid2d_apply_stencil(benchmark::State & state)
+{
+    using modmesh::StaticGrid2d;
+
+    size_t const nside = static_cast<size_t>(state.range(0));
+    StaticGrid2d const grid(nside, nside, 1);
+    StaticGrid2d::array_type src = grid.make_field(1.0);
+    StaticGrid2d::array_type dst = grid.make_field();
+    std::vector<StaticGrid2d::index_type> const offsets{{0, 0}, {1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    std::vector<double> const weights{-4.0, 1.0, 1.0, 1.0, 1.0};
+
+    for (auto _ : state)
+    {
+        grid.apply_stencil(src, dst, offsets, weights);
+    }
+    benchmark::DoNotOptimize(dst.data());
+
+    size_t const nbyte = grid.size() * 2 * sizeof(double);
+    set_counters(state, grid.size(), nbyte, src.nbytes() + dst.nbytes());
+}
+
+void mesh_sizes(benchmark::internal::Benchmark * bench)
+{
+    bench->ArgName("nside")->RangeMultiplier(4)->Range(16, 1024);
+}
+
+void grid_sizes(benchmark::internal::Benchmark * bench)
+{
+    bench->ArgName("ncelm")->RangeMultiplier(8)->Range(GRID_MIN, GRID_MAX);
+}
+
+void LinearScalarSolver_march_alpha2(benchmark::State & state)
+{
+    spacetime_march<modmesh::spacetime::LinearScalarSolver, 2>(state, 1.0, 0.0);
+}
+
+void InviscidBurgersSolver_march_alpha2(benchmark::State & state)
+{
+    spacetime_march<modmesh::spacetime::InviscidBurgersSolver, 2>(state, 1.0, 0.5);
+}
+
+} /* end namespace */
+
+BENCHMARK(LinearScalarSolver_march_alpha2)->Apply(grid_sizes);
+BENCHMARK(InviscidBurgersSolver_march_alpha2)->Apply(grid_sizes);
+BENCHMARK_TEMPLATE(Euler1DCore_march_alpha, 0)->Apply(grid_sizes);
+BENCHMARK_TEMPLATE(Euler1DCore_march_alpha, 1)->Apply(grid_sizes);
+BENCHMARK_TEMPLATE(Euler1DCore_march_alpha, 2)->Apply(grid_sizes);
+BENCHMARK_TEMPLATE(Euler1DCoreFp32_march_alpha, 2)->Apply(grid_sizes);
+BENCHMARK_TEMPLATE(GenericEuler1DCore_march_alpha, 2)->Apply(grid_sizes);
+BENCHMARK(Euler1DCore_clone_march)->Apply(grid_sizes);
+BENCHMARK_TEMPLATE(EulerCore_march_alpha, false, 1)->Apply(mesh_sizes);
+BENCHMARK_TEMPLATE(EulerCore_march_alpha, true, 1)->Apply(mesh_sizes);
+BENCHMARK(StaticGrid2d_apply_stencil)->ArgName("nside")->RangeMultiplier(4)->Range(64, 4096);
+
+BENCHMARK_MAIN();
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <new>
 #include <sstream>
 #include <stdexcept>
 
@@ -78,6 +79,27 @@ struct ConcreteBufferNoRemove : public ConcreteBufferRemover
 
 }; /* end struct ConcreteBufferNoRemove */
 
+/**
+ * Release the memory allocated by the aligned operator new[].
+ */
+struct ConcreteBufferAlignedRemover : public ConcreteBufferRemover
+{
+
+    explicit ConcreteBufferAlignedRemover(size_t alignment_in)
+        : alignment(alignment_in)
+    {
+    }
+
+    // NOLINTNEXTLINE(modernize-avoid-c-arrays,cppcoreguidelines-avoid-c-arrays,readability-non-const-parameter)
+    void operator()(int8_t * p) const override
+    {
+        ::operator delete[](p, std::align_val_t(alignment));
+    }
+
+    size_t alignment = 0;
+
+}; /* end struct ConcreteBufferAlignedRemover */
+
 struct ConcreteBufferDataDeleter
 {
 
@@ -158,6 +180,26 @@ public:
 
     static std::shared_ptr<ConcreteBuffer> construct() { return construct(0); }
 
+    /**
+     * Allocate a buffer whose address is a multiple of alignment, which must
+     * be a power of two.  clone() and copy construction do not keep the
+     * alignment.
+     */
+    static std::shared_ptr<ConcreteBuffer> construct_aligned(size_t nbytes, size_t alignment)
+    {
+        auto remover = std::make_unique<detail::ConcreteBufferAlignedRemover>(alignment);
+        auto * data = static_cast<int8_t *>(::operator new[](nbytes, std::align_val_t(alignment)));
+        try
+        {
+            return construct(nbytes, data, std::move(remover));
+        }
+        catch (...)
+        {
+            ::operator delete[](data, std::align_val_t(alignment));
+            throw;
+        }
+    }
+
     std::shared_ptr<ConcreteBuffer> clone() const
     {
         std::shared_ptr<ConcreteBuffer> ret = construct(nbytes());
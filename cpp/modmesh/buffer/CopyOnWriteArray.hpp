@@ -0,0 +1,155 @@
+#pragma once
+
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <modmesh/buffer/SimpleArray.hpp>
+
+#include <memory>
+
+namespace modmesh
+{
+
+/**
+ * SimpleArray whose buffer is shared by copies until one of them is written.
+ *
+ * Copying a CopyOnWriteArray shares the buffer instead of cloning it, unless
+ * anything other than the copy-on-write arrays (e.g., an ndarray or a
+ * reshaped array) holds the buffer.  The element accessors do not check the
+ * sharing, so the owner must call detach() before writing.  detach() clones
+ * the buffer only when another copy-on-write array still shares it.
+ *
+ * A reference to the base SimpleArray, or a view of its buffer, that is taken
+ * before the copy sees the writes to either array until detach() is called.
+ */
+template <typename T>
+class CopyOnWriteArray
+    : public SimpleArray<T>
+{
+
+public:
+
+    using array_type = SimpleArray<T>;
+
+    CopyOnWriteArray() = default;
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    CopyOnWriteArray(array_type const & other)
+        : array_type(other)
+    {
+    }
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    CopyOnWriteArray(array_type && other) noexcept
+        : array_type(std::move(other))
+    {
+    }
+
+    CopyOnWriteArray(CopyOnWriteArray const & other)
+        : CopyOnWriteArray(other, other.shareable())
+    {
+    }
+
+    CopyOnWriteArray(CopyOnWriteArray &&) noexcept = default;
+
+    CopyOnWriteArray & operator=(CopyOnWriteArray const & other)
+    {
+        if (this != &other)
+        {
+            CopyOnWriteArray(other).swap(*this);
+        }
+        return *this;
+    }
+
+    CopyOnWriteArray & operator=(CopyOnWriteArray &&) noexcept = default;
+
+    /// Take the array; unlike SimpleArray, do not copy into the old buffer.
+    CopyOnWriteArray & operator=(array_type const & other)
+    {
+        return *this = array_type(other);
+    }
+
+    CopyOnWriteArray & operator=(array_type && other) noexcept
+    {
+        array_type::operator=(std::move(other));
+        m_token = std::make_shared<token_type>();
+        return *this;
+    }
+
+    ~CopyOnWriteArray() = default;
+
+    void swap(CopyOnWriteArray & other) noexcept
+    {
+        array_type::swap(other);
+        m_token.swap(other.m_token);
+    }
+
+    /// True if another copy-on-write array shares the buffer.
+    bool is_shared() const noexcept { return m_token.use_count() > 1; }
+
+    /// Clone the buffer if it is shared, so that writing it is private.
+    void detach()
+    {
+        if (is_shared())
+        {
+            array_type::operator=(array_type(static_cast<array_type const &>(*this)));
+            m_token = std::make_shared<token_type>();
+        }
+    }
+
+private:
+
+    CopyOnWriteArray(CopyOnWriteArray const & other, bool shared)
+        : array_type(shared ? other.share() : array_type(other))
+        , m_token(shared ? other.m_token : std::make_shared<token_type>())
+    {
+    }
+
+    /// Only the use count matters: it is the number of arrays sharing the buffer.
+    struct token_type
+    {
+    };
+
+    bool shareable() const
+    {
+        if (!*this)
+        {
+            return false;
+        }
+        // shared_from_this() adds one owner of its own.
+        long const nowner = this->buffer().shared_from_this().use_count() - 1;
+        return nowner == m_token.use_count();
+    }
+
+    std::shared_ptr<token_type> m_token = std::make_shared<token_type>();
+
+}; /* end class CopyOnWriteArray */
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -1163,6 +1163,15 @@ public:
         return SimpleArray(m_shape, m_buffer);
     }
 
+    /// Make an array sharing the buffer, shape, stride, and ghost count.
+    SimpleArray share() const
+    {
+        SimpleArray ret(m_shape, m_stride, m_buffer);
+        ret.m_nghost = m_nghost;
+        ret.m_body = m_body;
+        return ret;
+    }
+
     void swap(SimpleArray & other) noexcept
     {
         if (this != &other)
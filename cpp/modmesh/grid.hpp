@@ -35,6 +35,10 @@
 #include <modmesh/base.hpp>
 #include <modmesh/toggle/toggle.hpp>
 #include <modmesh/buffer/buffer.hpp>
+#include <modmesh/parallel.hpp>
+
+#include <array>
+#include <vector>
 
 namespace modmesh
 {
@@ -174,12 +178,490 @@ private:
 
 }; /* end class StaticGrid1d */
 
-class StaticGrid2d : public StaticGridBase<2>
+namespace detail
+{
+
+/// Maximal number of stencil points accumulated in one sweep of a segment.
+constexpr size_t STENCIL_CHUNK = 8;
+
+/**
+ * Set (or add to, if accumulate is true) dst[ip] the weighted sum of the N
+ * stencil points src[ip + shifts[k]] for ip in [ibegin, iend).  N is a
+ * compile-time constant so that the sum is unrolled and the loop over ip
+ * vectorizes.
+ */
+template <size_t N, typename T>
+void stencil_sweep(T * dst, T const * src, ssize_t const * shifts, T const * weights, size_t ibegin, size_t iend, bool accumulate)
+{
+    std::array<T const *, N> sptr;
+    std::array<T, N> wgt;
+    for (size_t it = 0; it < N; ++it)
+    {
+        sptr[it] = src + shifts[it];
+        wgt[it] = weights[it];
+    }
+    if (accumulate)
+    {
+        for (size_t ip = ibegin; ip < iend; ++ip)
+        {
+            T sum = dst[ip];
+            for (size_t it = 0; it < N; ++it)
+            {
+                sum += wgt[it] * sptr[it][ip];
+            }
+            dst[ip] = sum;
+        }
+    }
+    else
+    {
+        for (size_t ip = ibegin; ip < iend; ++ip)
+        {
+            T sum = wgt[0] * sptr[0][ip];
+            for (size_t it = 1; it < N; ++it)
+            {
+                sum += wgt[it] * sptr[it][ip];
+            }
+            dst[ip] = sum;
+        }
+    }
+}
+
+/// Dispatch stencil_sweep() for the run-time number of points n <= N.
+template <size_t N, typename T>
+void stencil_sweep_n(size_t n, T * dst, T const * src, ssize_t const * shifts, T const * weights, size_t ibegin, size_t iend, bool accumulate)
+{
+    if constexpr (N > 1)
+    {
+        if (n < N)
+        {
+            stencil_sweep_n<N - 1>(n, dst, src, shifts, weights, ibegin, iend, accumulate);
+            return;
+        }
+    }
+    stencil_sweep<N>(dst, src, shifts, weights, ibegin, iend, accumulate);
+}
+
+} /* end namespace detail */
+
+/**
+ * Structured grid of ND dimensions with nghost ghost layers on both sides of
+ * every axis.
+ *
+ * A field on the grid is a SimpleArray of the padded shape
+ * (N_0, ..., N_{ND-2}, P), where N_d = n_d + 2 * nghost counts the points
+ * along axis d, and the pitch P rounds N_{ND-1} up to a multiple of
+ * ALIGNMENT bytes.  The field buffer is allocated at an ALIGNMENT-byte
+ * boundary, so that every row along the last axis starts at a cache line.
+ * The padding does not belong to the grid and the stencil operations never
+ * read it.
+ *
+ * Point (i_0, ..., i_{ND-1}), where -nghost <= i_d < n_d + nghost, is at the
+ * flat index offset(i) of a field.  Neighbours are at constant flat
+ * distances, so that a stencil needs no connectivity table.
+ */
+template <uint8_t ND>
+class StaticGridMd : public StaticGridBase<ND>
+{
+
+public:
+
+    using base_type = StaticGridBase<ND>;
+    using serial_type = typename base_type::serial_type;
+    using real_type = typename base_type::real_type;
+    using value_type = real_type;
+    using array_type = SimpleArray<value_type>;
+    using shape_type = std::array<size_t, ND>;
+    using index_type = std::array<ssize_t, ND>;
+
+    static_assert(ND >= 2, "StaticGridMd is for two or more dimensions");
+
+    enum GhostType : uint8_t
+    {
+        EDGE = 0, ///< Copy the nearest interior point (zero gradient).
+        PERIODIC = 1 ///< Copy from the opposite side of the interior.
+    };
+
+    /// Byte alignment of the field rows; a cache line.
+    static constexpr size_t ALIGNMENT = 64;
+    /// Number of points along the last axis in a tile.
+    static constexpr size_t TILE_WIDTH = 512;
+    /// Number of rows in a tile.
+    static constexpr size_t TILE_NROW = 8;
+
+    size_t nghost() const { return m_nghost; }
+    /// Number of interior points along the axis.
+    size_t shape(size_t axis) const { return m_shape.at(axis); }
+    /// Number of interior points.
+    size_t size() const
+    {
+        size_t ret = 1;
+        for (size_t const n : m_shape)
+        {
+            ret *= n;
+        }
+        return ret;
+    }
+
+    /// Number of values between two rows of a field, padding included.
+    size_t pitch() const { return m_stride[ND - 2]; }
+    /// Flat distance between neighbouring points along the axis.
+    size_t stride(size_t axis) const { return m_stride.at(axis); }
+    /// Number of values in a field, padding included.
+    size_t field_size() const { return (m_shape[0] + 2 * m_nghost) * m_stride[0]; }
+
+    size_t offset(index_type const & idx) const
+    {
+        size_t ret = 0;
+        for (size_t it = 0; it < ND; ++it)
+        {
+            ret += static_cast<size_t>(idx[it] + static_cast<ssize_t>(m_nghost)) * m_stride[it];
+        }
+        return ret;
+    }
+
+    /**
+     * Coordinate of the points along the axis.  The array has nghost ghost
+     * elements and defaults to the point index.
+     */
+    array_type const & coord(size_t axis) const { return m_coord.at(axis); }
+    array_type & coord(size_t axis) { return m_coord.at(axis); }
+
+    /// Allocate an aligned field with every value (padding included) set.
+    array_type make_field(value_type value = 0) const
+    {
+        small_vector<size_t> shape(ND);
+        for (size_t it = 0; it < ND - 1; ++it)
+        {
+            shape[it] = m_shape[it] + 2 * m_nghost;
+        }
+        shape[ND - 1] = m_stride[ND - 2];
+        std::shared_ptr<ConcreteBuffer> const buffer =
+            ConcreteBuffer::construct_aligned(field_size() * sizeof(value_type), ALIGNMENT);
+        array_type ret(shape, buffer);
+        ret.fill(value);
+        return ret;
+    }
+
+    void check_field(array_type const & field, char const * name) const
+    {
+        bool match = field.ndim() == ND && field.size() == field_size();
+        for (size_t it = 0; match && it < ND - 1; ++it)
+        {
+            match = field.shape(it) == m_shape[it] + 2 * m_nghost;
+        }
+        if (!match)
+        {
+            throw std::invalid_argument(
+                Formatter() << "StaticGrid" << int(ND) << "d: " << name
+                            << " is not a field of the grid; create it with make_field()");
+        }
+    }
+
+    /**
+     * Set the ghost layers of the field from its interior points.  The axes
+     * are processed in order over the full extent of the other axes, so that
+     * the edge and corner ghost points are set as well.
+     */
+    void fill_ghost(array_type & field, GhostType type) const;
+
+    /**
+     * Call kernel(ibegin, iend) for every contiguous segment [ibegin, iend)
+     * of interior flat indices along the last axis.  The segments are grouped
+     * into tiles of TILE_NROW rows by TILE_WIDTH points, which fit in the L1
+     * cache, and the tiles are distributed over the threads.  The kernel may
+     * read any point within nghost of its segment and must write only to its
+     * segment.  The inner loop over a segment has unit stride, so that the
+     * compiler vectorizes it.
+     */
+    template <typename F>
+    void for_each_tile(F && kernel) const;
+
+    /**
+     * Set dst[p] = sum_k weights[k] * src[p + offsets[k]] for every interior
+     * point p.  The offsets must be within nghost along every axis, and src
+     * and dst must not share the buffer.
+     */
+    void apply_stencil(
+        array_type const & src,
+        array_type & dst,
+        std::vector<index_type> const & offsets,
+        std::vector<value_type> const & weights) const;
+
+protected:
+
+    StaticGridMd(shape_type const & shape, size_t nghost)
+        : m_shape(shape)
+        , m_nghost(nghost)
+    {
+        size_t constexpr nalign = ALIGNMENT / sizeof(value_type);
+        m_stride[ND - 1] = 1;
+        m_stride[ND - 2] = (m_shape[ND - 1] + 2 * m_nghost + nalign - 1) / nalign * nalign;
+        for (size_t it = ND - 2; it > 0; --it)
+        {
+            m_stride[it - 1] = m_stride[it] * (m_shape[it] + 2 * m_nghost);
+        }
+        for (size_t it = 0; it < ND; ++it)
+        {
+            array_type & crd = m_coord[it];
+            crd = array_type(m_shape[it] + 2 * m_nghost);
+            for (size_t ic = 0; ic < crd.size(); ++ic)
+            {
+                crd.data()[ic] = static_cast<value_type>(ic) - static_cast<value_type>(m_nghost);
+            }
+            crd.set_nghost(m_nghost);
+        }
+    }
+
+    StaticGridMd(StaticGridMd const &) = default;
+    StaticGridMd(StaticGridMd &&) noexcept = default;
+    StaticGridMd & operator=(StaticGridMd const & other)
+    {
+        if (this != &other)
+        {
+            m_shape = other.m_shape;
+            m_nghost = other.m_nghost;
+            m_stride = other.m_stride;
+            for (size_t it = 0; it < ND; ++it)
+            {
+                // Copy-assignment of SimpleArray requires the same size.
+                m_coord[it] = array_type(other.m_coord[it]);
+            }
+        }
+        return *this;
+    }
+    StaticGridMd & operator=(StaticGridMd &&) noexcept = default;
+    ~StaticGridMd() = default;
+
+private:
+
+    shape_type m_shape{};
+    size_t m_nghost = 0;
+    shape_type m_stride{};
+    std::array<array_type, ND> m_coord;
+
+}; /* end class StaticGridMd */
+
+template <uint8_t ND>
+void StaticGridMd<ND>::fill_ghost(array_type & field, GhostType type) const
+{
+    MODMESH_TIME("StaticGridMd::fill_ghost");
+    check_field(field, "field");
+    if (EDGE != type && PERIODIC != type)
+    {
+        throw std::invalid_argument(Formatter() << "StaticGrid" << int(ND) << "d::fill_ghost: invalid type "
+                                                << int(type));
+    }
+    if (0 == m_nghost || 0 == size())
+    {
+        return;
+    }
+    value_type * const data = field.data();
+    size_t nouter = 1;
+    for (size_t axis = 0; axis < ND; ++axis)
+    {
+        size_t const nint = m_shape[axis];
+        if (PERIODIC == type && m_nghost > nint)
+        {
+            throw std::invalid_argument(Formatter() << "StaticGrid" << int(ND) << "d::fill_ghost: nghost "
+                                                    << m_nghost << " > " << nint << " points along axis "
+                                                    << axis << " for periodic ghost");
+        }
+        // A layer of the axis is nouter blocks of stride values.
+        size_t const block = m_stride[axis];
+        size_t const outer = 0 == axis ? field_size() : m_stride[axis - 1];
+        for (size_t io = 0; io < nouter; ++io)
+        {
+            value_type * const base = data + io * outer;
+            for (size_t ig = 1; ig <= m_nghost; ++ig)
+            {
+                // Layer positions counted from the first ghost layer.
+                size_t const lower = m_nghost - ig;
+                size_t const upper = m_nghost + nint - 1 + ig;
+                size_t const lower_src = PERIODIC == type ? m_nghost + nint - ig : m_nghost;
+                size_t const upper_src = PERIODIC == type ? m_nghost + ig - 1 : m_nghost + nint - 1;
+                std::copy_n(base + lower_src * block, block, base + lower * block);
+                std::copy_n(base + upper_src * block, block, base + upper * block);
+            }
+        }
+        nouter *= m_shape[axis] + 2 * m_nghost;
+    }
+}
+
+template <uint8_t ND>
+template <typename F>
+void StaticGridMd<ND>::for_each_tile(F && kernel) const
+{
+    size_t const nwidth = m_shape[ND - 1];
+    size_t nrow = 1;
+    for (size_t it = 0; it < ND - 1; ++it)
+    {
+        nrow *= m_shape[it];
+    }
+    if (0 == nwidth || 0 == nrow)
+    {
+        return;
+    }
+    size_t const nxtile = (nwidth + TILE_WIDTH - 1) / TILE_WIDTH;
+    size_t const nytile = (nrow + TILE_NROW - 1) / TILE_NROW;
+    // Give a thread at least a few tiles to amortize the dispatch.
+    size_t constexpr grain = 4;
+    parallel_for(
+        0,
+        nxtile * nytile,
+        [&](size_t ibegin, size_t iend)
+        {
+            for (size_t itile = ibegin; itile < iend; ++itile)
+            {
+                size_t const ix0 = (itile % nxtile) * TILE_WIDTH;
+                size_t const ix1 = std::min(ix0 + TILE_WIDTH, nwidth);
+                size_t const irow0 = (itile / nxtile) * TILE_NROW;
+                size_t const irow1 = std::min(irow0 + TILE_NROW, nrow);
+                for (size_t irow = irow0; irow < irow1; ++irow)
+                {
+                    // Unravel the row index over the interior of the leading axes.
+                    size_t rest = irow;
+                    size_t start = m_nghost + ix0;
+                    for (size_t it = ND - 1; it > 0; --it)
+                    {
+                        start += (rest % m_shape[it - 1] + m_nghost) * m_stride[it - 1];
+                        rest /= m_shape[it - 1];
+                    }
+                    kernel(start, start + (ix1 - ix0));
+                }
+            }
+        },
+        grain);
+}
+
+template <uint8_t ND>
+void StaticGridMd<ND>::apply_stencil(
+    array_type const & src,
+    array_type & dst,
+    std::vector<index_type> const & offsets,
+    std::vector<value_type> const & weights) const
+{
+    MODMESH_TIME("StaticGridMd::apply_stencil");
+    check_field(src, "src");
+    check_field(dst, "dst");
+    if (&src.buffer() == &dst.buffer())
+    {
+        throw std::invalid_argument(Formatter() << "StaticGrid" << int(ND)
+                                                << "d::apply_stencil: src and dst share the buffer");
+    }
+    if (offsets.size() != weights.size())
+    {
+        throw std::invalid_argument(Formatter() << "StaticGrid" << int(ND) << "d::apply_stencil: "
+                                                << offsets.size() << " offsets differ from "
+                                                << weights.size() << " weights");
+    }
+    std::vector<ssize_t> shifts(offsets.size());
+    for (size_t is = 0; is < offsets.size(); ++is)
+    {
+        ssize_t shift = 0;
+        for (size_t it = 0; it < ND; ++it)
+        {
+            ssize_t const off = offsets[is][it];
+            if (off > static_cast<ssize_t>(m_nghost) || -off > static_cast<ssize_t>(m_nghost))
+            {
+                throw std::invalid_argument(Formatter() << "StaticGrid" << int(ND) << "d::apply_stencil: offset "
+                                                        << off << " along axis " << it << " exceeds nghost "
+                                                        << m_nghost);
+            }
+            shift += off * static_cast<ssize_t>(m_stride[it]);
+        }
+        shifts[is] = shift;
+    }
+
+    value_type const * const sdata = src.data();
+    value_type * const ddata = dst.data();
+    size_t const nstencil = shifts.size();
+    for_each_tile(
+        [&](size_t ibegin, size_t iend)
+        {
+            if (0 == nstencil)
+            {
+                std::fill(ddata + ibegin, ddata + iend, value_type(0));
+                return;
+            }
+            // Sweep the segment once per STENCIL_CHUNK stencil points.  A
+            // tile stays in the L1 cache between the sweeps.
+            for (size_t is = 0; is < nstencil; is += detail::STENCIL_CHUNK)
+            {
+                size_t const nchunk = std::min(detail::STENCIL_CHUNK, nstencil - is);
+                detail::stencil_sweep_n<detail::STENCIL_CHUNK>(
+                    nchunk, ddata, sdata, &shifts[is], &weights[is], ibegin, iend, is > 0);
+            }
+        });
+}
+
+/**
+ * 2D structured grid.  Axis 0 is x and axis 1 (contiguous in a field) is y.
+ */
+class StaticGrid2d : public StaticGridMd<2>
 {
+
+public:
+
+    using base_type = StaticGridMd<2>;
+
+    StaticGrid2d()
+        : StaticGrid2d(0, 0)
+    {
+    }
+
+    StaticGrid2d(serial_type nx, serial_type ny, serial_type nghost = 1)
+        : base_type(shape_type{nx, ny}, nghost)
+    {
+    }
+
+    StaticGrid2d(StaticGrid2d const &) = default;
+    StaticGrid2d(StaticGrid2d &&) noexcept = default;
+    StaticGrid2d & operator=(StaticGrid2d const &) = default;
+    StaticGrid2d & operator=(StaticGrid2d &&) noexcept = default;
+    ~StaticGrid2d() = default;
+
+    size_t nx() const { return shape(0); }
+    size_t ny() const { return shape(1); }
+
+    using base_type::offset;
+    size_t offset(ssize_t ix, ssize_t iy) const { return base_type::offset(index_type{ix, iy}); }
+
 }; /* end class StaticGrid2d */
 
-class StaticGrid3d : public StaticGridBase<3>
+/**
+ * 3D structured grid.  Axes 0, 1, 2 are x, y, z, and z is contiguous in a
+ * field.
+ */
+class StaticGrid3d : public StaticGridMd<3>
 {
+
+public:
+
+    using base_type = StaticGridMd<3>;
+
+    StaticGrid3d()
+        : StaticGrid3d(0, 0, 0)
+    {
+    }
+
+    StaticGrid3d(serial_type nx, serial_type ny, serial_type nz, serial_type nghost = 1)
+        : base_type(shape_type{nx, ny, nz}, nghost)
+    {
+    }
+
+    StaticGrid3d(StaticGrid3d const &) = default;
+    StaticGrid3d(StaticGrid3d &&) noexcept = default;
+    StaticGrid3d & operator=(StaticGrid3d const &) = default;
+    StaticGrid3d & operator=(StaticGrid3d &&) noexcept = default;
+    ~StaticGrid3d() = default;
+
+    size_t nx() const { return shape(0); }
+    size_t ny() const { return shape(1); }
+    size_t nz() const { return shape(2); }
+
+    using base_type::offset;
+    size_t offset(ssize_t ix, ssize_t iy, ssize_t iz) const { return base_type::offset(index_type{ix, iy, iz}); }
+
 }; /* end class StaticGrid3d */
 
 } /* end namespace modmesh */
@@ -1,5 +1,6 @@
 #pragma once
 #include <modmesh/inout/gmsh.hpp>
 #include <modmesh/inout/plot3d.hpp>
+#include <modmesh/inout/snapshot.hpp>
 
 // vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -21,6 +21,7 @@ void initialize_inout(pybind11::module & mod)
     {
         wrap_Gmsh(mod);
         wrap_Plot3d(mod);
+        wrap_snapshot(mod);
     };
 
     OneTimeInitializer<inout_pymod_tag>::me()(mod, initialize_impl);
@@ -0,0 +1,112 @@
+#include <modmesh/inout/pymod/inout_pymod.hpp>
+#include <modmesh/modmesh.hpp>
+
+namespace modmesh
+{
+
+namespace python
+{
+
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapSnapshotWriter
+    : public WrapBase<WrapSnapshotWriter, inout::SnapshotWriter, std::shared_ptr<inout::SnapshotWriter>>
+{
+public:
+
+    using base_type = WrapBase<WrapSnapshotWriter, inout::SnapshotWriter, std::shared_ptr<inout::SnapshotWriter>>;
+    using wrapped_type = typename base_type::wrapped_type;
+
+    friend root_base_type;
+
+protected:
+
+    WrapSnapshotWriter(pybind11::module & mod, char const * pyname, char const * pydoc)
+        : base_type(mod, pyname, pydoc)
+    {
+        namespace py = pybind11; // NOLINT(misc-unused-alias-decls)
+
+        (*this)
+            .def(
+                py::init(
+                    [](std::string const & path, size_t capacity)
+                    { return std::make_shared<inout::SnapshotWriter>(path, capacity); }),
+                py::arg("path"),
+                py::arg("capacity") = 2)
+            .def_property_readonly("path", &wrapped_type::path)
+            .def_property_readonly("capacity", &wrapped_type::capacity)
+            .def_property_readonly("npushed", &wrapped_type::npushed)
+            .def_property_readonly("nwritten", &wrapped_type::nwritten)
+            .def_property_readonly("is_open", &wrapped_type::is_open)
+            .def("flush", &wrapped_type::flush, py::call_guard<py::gil_scoped_release>())
+            .def("close", &wrapped_type::close, py::call_guard<py::gil_scoped_release>());
+    }
+
+}; /* end class WrapSnapshotWriter */
+
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapSnapshotReader
+    : public WrapBase<WrapSnapshotReader, inout::SnapshotReader, std::shared_ptr<inout::SnapshotReader>>
+{
+public:
+
+    using base_type = WrapBase<WrapSnapshotReader, inout::SnapshotReader, std::shared_ptr<inout::SnapshotReader>>;
+    using wrapped_type = typename base_type::wrapped_type;
+
+    friend root_base_type;
+
+protected:
+
+    WrapSnapshotReader(pybind11::module & mod, char const * pyname, char const * pydoc)
+        : base_type(mod, pyname, pydoc)
+    {
+        namespace py = pybind11; // NOLINT(misc-unused-alias-decls)
+
+        (*this)
+            .def(
+                py::init(
+                    [](std::string const & path)
+                    { return std::make_shared<inout::SnapshotReader>(path); }),
+                py::arg("path"))
+            .def_property_readonly("nframe", &wrapped_type::nframe)
+            .def(
+                "kind",
+                [](wrapped_type const & self, size_t iframe)
+                { return self.frame(iframe).kind(); },
+                py::arg("iframe"))
+            .def(
+                "has",
+                [](wrapped_type const & self, size_t iframe, std::string const & name)
+                { return self.frame(iframe).has(name); },
+                py::arg("iframe"),
+                py::arg("name"))
+            .def(
+                "array",
+                [](wrapped_type const & self, size_t iframe, std::string const & name)
+                { return to_ndarray(self.frame(iframe).array(name)); },
+                py::arg("iframe"),
+                py::arg("name"))
+            .def(
+                "real",
+                [](wrapped_type const & self, size_t iframe, std::string const & name)
+                { return self.frame(iframe).real(name); },
+                py::arg("iframe"),
+                py::arg("name"))
+            .def(
+                "integer",
+                [](wrapped_type const & self, size_t iframe, std::string const & name)
+                { return self.frame(iframe).integer(name); },
+                py::arg("iframe"),
+                py::arg("name"));
+    }
+
+}; /* end class WrapSnapshotReader */
+
+void wrap_snapshot(pybind11::module & mod)
+{
+    WrapSnapshotWriter::commit(mod, "SnapshotWriter", "Write solution snapshots in a background thread");
+    WrapSnapshotReader::commit(mod, "SnapshotReader", "Read the solution snapshots in a file");
+}
+
+} /* end namespace python */
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
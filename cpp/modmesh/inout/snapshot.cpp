@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <modmesh/inout/snapshot.hpp>
+
+#include <cstring>
+
+namespace modmesh
+{
+
+namespace inout
+{
+
+namespace detail
+{
+
+constexpr char snapshot_magic[8] = {'M', 'M', 'S', 'N', 'A', 'P', '\0', '\n'};
+constexpr uint32_t snapshot_version = 1;
+
+} /* end namespace detail */
+
+SnapshotWriter::SnapshotWriter(std::string const & path, size_t capacity)
+    : m_path(path)
+    , m_capacity(capacity)
+{
+    if (0 == capacity)
+    {
+        throw std::invalid_argument("SnapshotWriter: capacity cannot be zero");
+    }
+    m_stream.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_stream)
+    {
+        throw std::runtime_error(Formatter() << "SnapshotWriter: cannot open " << path << " for writing");
+    }
+    m_stream.write(detail::snapshot_magic, sizeof(detail::snapshot_magic));
+    m_stream.write(reinterpret_cast<char const *>(&detail::snapshot_version), sizeof(detail::snapshot_version)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    m_thread = std::thread([this]()
+                           { run(); });
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+    try
+    {
+        close();
+    }
+    catch (...) // NOLINT(bugprone-empty-catch)
+    {
+        // A destructor may not throw.  Call close() to see the error.
+    }
+}
+
+size_t SnapshotWriter::npushed() const
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    return m_npushed;
+}
+
+size_t SnapshotWriter::nwritten() const
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    return m_nwritten;
+}
+
+bool SnapshotWriter::is_open() const
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    return !m_closing;
+}
+
+void SnapshotWriter::rethrow()
+{
+    if (m_error)
+    {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void SnapshotWriter::push(CheckpointWriter && snapshot)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_closing)
+    {
+        throw std::runtime_error(Formatter() << "SnapshotWriter: " << m_path << " is closed");
+    }
+    m_cv_pop.wait(lock, [this]()
+                  { return m_queue.size() < m_capacity || m_error; });
+    rethrow();
+    m_queue.push_back(std::move(snapshot));
+    ++m_npushed;
+    m_cv_push.notify_one();
+}
+
+void SnapshotWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv_pop.wait(lock, [this]()
+                  { return m_nwritten == m_npushed || m_error; });
+    rethrow();
+}
+
+void SnapshotWriter::close()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_closing)
+        {
+            return;
+        }
+        m_closing = true;
+    }
+    m_cv_push.notify_one();
+    m_thread.join();
+    m_stream.close();
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    if (!m_error && !m_stream)
+    {
+        m_error = std::make_exception_ptr(std::runtime_error(Formatter() << "SnapshotWriter: failed to close " << m_path));
+    }
+    rethrow();
+}
+
+void SnapshotWriter::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_cv_push.wait(lock, [this]()
+                       { return !m_queue.empty() || m_closing; });
+        if (m_queue.empty())
+        {
+            // Closing and all the snapshots are written.
+            break;
+        }
+        // Write without the lock for push() to fill the other buffer.
+        CheckpointWriter & snapshot = m_queue.front();
+        lock.unlock();
+        auto const nbyte = static_cast<uint64_t>(snapshot.nbyte());
+        m_stream.write(reinterpret_cast<char const *>(&nbyte), sizeof(nbyte)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        snapshot.write(m_stream);
+        m_stream.flush();
+        bool const failed = !m_stream;
+        lock.lock();
+        m_queue.pop_front();
+        ++m_nwritten;
+        if (failed && !m_error)
+        {
+            m_error = std::make_exception_ptr(std::runtime_error(Formatter() << "SnapshotWriter: failed to write " << m_path));
+        }
+        m_cv_pop.notify_all();
+    }
+}
+
+SnapshotReader::SnapshotReader(std::string const & path)
+    : m_path(path)
+{
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs)
+    {
+        throw std::runtime_error(Formatter() << "SnapshotReader: cannot open " << path);
+    }
+    char magic[sizeof(detail::snapshot_magic)] = {};
+    uint32_t version = 0;
+    ifs.read(magic, sizeof(magic));
+    ifs.read(reinterpret_cast<char *>(&version), sizeof(version)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (!ifs || 0 != std::memcmp(magic, detail::snapshot_magic, sizeof(magic)))
+    {
+        throw std::runtime_error(Formatter() << "SnapshotReader: " << path << " is not a snapshot file");
+    }
+    if (version != detail::snapshot_version)
+    {
+        throw std::runtime_error(Formatter() << "SnapshotReader: unsupported version " << version << " of " << path);
+    }
+    while (true)
+    {
+        uint64_t nbyte = 0;
+        ifs.read(reinterpret_cast<char *>(&nbyte), sizeof(nbyte)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        if (ifs.gcount() == 0 && ifs.eof())
+        {
+            break;
+        }
+        std::vector<char> buffer;
+        if (ifs.gcount() == sizeof(nbyte))
+        {
+            buffer.resize(static_cast<size_t>(nbyte));
+            ifs.read(buffer.data(), static_cast<std::streamsize>(nbyte));
+        }
+        if (!ifs)
+        {
+            throw std::runtime_error(Formatter() << "SnapshotReader: frame " << m_frames.size() << " of " << path
+                                                 << " is truncated");
+        }
+        m_frames.emplace_back(std::move(buffer), Formatter() << "frame " << m_frames.size() << " of " << path);
+    }
+}
+
+CheckpointReader const & SnapshotReader::frame(size_t it) const
+{
+    if (it >= m_frames.size())
+    {
+        throw std::out_of_range(Formatter() << "SnapshotReader: frame " << it << " >= nframe " << m_frames.size());
+    }
+    return m_frames[it];
+}
+
+} /* end namespace inout */
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -0,0 +1,147 @@
+#pragma once
+
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Streaming output of solution snapshots in a background thread.
+ */
+
+#include <modmesh/serialization/Checkpoint.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace modmesh
+{
+
+namespace inout
+{
+
+/**
+ * Append snapshots to a streaming file in a background thread.
+ *
+ * A snapshot is a CheckpointWriter, which has copied the arrays when they are
+ * added, so that the solver may march on as soon as push() returns.  At most
+ * capacity snapshots wait in the queue, and push() blocks when the queue is
+ * full.  With the default capacity of 2, the solver fills one buffer while
+ * the thread writes the other one.
+ *
+ * The file starts with the magic bytes and the format version, followed by
+ * the frames.  A frame is the number of bytes and the content of a
+ * checkpoint.  An error in the thread is rethrown by the next push(),
+ * flush(), or close().
+ */
+class SnapshotWriter
+{
+
+public:
+
+    explicit SnapshotWriter(std::string const & path, size_t capacity = 2);
+
+    SnapshotWriter() = delete;
+    SnapshotWriter(SnapshotWriter const &) = delete;
+    SnapshotWriter(SnapshotWriter &&) = delete;
+    SnapshotWriter & operator=(SnapshotWriter const &) = delete;
+    SnapshotWriter & operator=(SnapshotWriter &&) = delete;
+    ~SnapshotWriter();
+
+    std::string const & path() const { return m_path; }
+    size_t capacity() const { return m_capacity; }
+    /// Number of snapshots pushed.
+    size_t npushed() const;
+    /// Number of snapshots written to the file.
+    size_t nwritten() const;
+    bool is_open() const;
+
+    void push(CheckpointWriter && snapshot);
+    /// Wait for all the pushed snapshots to be written.
+    void flush();
+    /// Flush, stop the thread, and close the file.
+    void close();
+
+private:
+
+    void run();
+    void rethrow();
+
+    std::string m_path;
+    size_t m_capacity;
+    std::ofstream m_stream;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv_push;
+    std::condition_variable m_cv_pop;
+    std::deque<CheckpointWriter> m_queue;
+    size_t m_npushed = 0;
+    size_t m_nwritten = 0;
+    bool m_closing = false;
+    std::exception_ptr m_error;
+    std::thread m_thread;
+
+}; /* end class SnapshotWriter */
+
+/**
+ * Read all the snapshots in a file written by SnapshotWriter.  The checksum
+ * of every snapshot is verified in the constructor.
+ */
+class SnapshotReader
+{
+
+public:
+
+    explicit SnapshotReader(std::string const & path);
+
+    SnapshotReader() = delete;
+    SnapshotReader(SnapshotReader const &) = delete;
+    SnapshotReader(SnapshotReader &&) = default;
+    SnapshotReader & operator=(SnapshotReader const &) = delete;
+    SnapshotReader & operator=(SnapshotReader &&) = default;
+    ~SnapshotReader() = default;
+
+    size_t nframe() const { return m_frames.size(); }
+    CheckpointReader const & frame(size_t it) const;
+
+private:
+
+    std::string m_path;
+    std::vector<CheckpointReader> m_frames;
+
+}; /* end class SnapshotReader */
+
+} /* end namespace inout */
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
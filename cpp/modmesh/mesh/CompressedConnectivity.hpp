@@ -0,0 +1,267 @@
+#pragma once
+
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Compressed sparse-row (CSR) connectivity.
+ */
+
+#include <modmesh/base.hpp>
+#include <modmesh/buffer/buffer.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace modmesh
+{
+
+/**
+ * Connectivity table stored in the compressed sparse-row format.  The entries
+ * of row irow are indices()[offsets(irow):offsets(irow+1)].
+ *
+ * The padded tables in StaticMesh (fcnds, clnds, clfcs) store the count of
+ * entries in the first column and pad every row to the maximum width.  This
+ * class stores only the valid entries.  Ghost rows are kept by setting nghost
+ * of the offsets array, so that a row is addressed by the same (possibly
+ * negative) index as in the padded table.
+ */
+template <typename I>
+class CompressedConnectivity
+{
+
+public:
+
+    using index_type = I;
+    using array_type = SimpleArray<I>;
+
+    /**
+     * Read-only view to the entries of a row.  Supports range-based for.
+     */
+    class Row
+    {
+    public:
+        Row(index_type const * begin, index_type const * end)
+            : m_begin(begin)
+            , m_end(end)
+        {
+        }
+        index_type const * begin() const { return m_begin; }
+        index_type const * end() const { return m_end; }
+        size_t size() const { return static_cast<size_t>(m_end - m_begin); }
+        bool empty() const { return m_begin == m_end; }
+        index_type const & operator[](size_t it) const { return m_begin[it]; }
+
+    private:
+        index_type const * m_begin;
+        index_type const * m_end;
+    }; /* end class Row */
+
+    CompressedConnectivity()
+        : m_offsets(std::vector<size_t>{1}, 0)
+        , m_indices(std::vector<size_t>{0})
+    {
+    }
+
+    /**
+     * @param[in] offsets 1D array of (nrow+1) monotonically non-decreasing
+     *                    offsets starting from 0.  The nghost of it becomes
+     *                    the number of ghost rows.
+     * @param[in] indices 1D array of the entries of all rows.
+     */
+    CompressedConnectivity(array_type offsets, array_type indices)
+        : m_offsets(std::move(offsets))
+        , m_indices(std::move(indices))
+    {
+        validate();
+    }
+
+    CompressedConnectivity(CompressedConnectivity const &) = default;
+    CompressedConnectivity(CompressedConnectivity &&) noexcept = default;
+    CompressedConnectivity & operator=(CompressedConnectivity const &) = default;
+    CompressedConnectivity & operator=(CompressedConnectivity &&) noexcept = default;
+    ~CompressedConnectivity() = default;
+
+    void swap(CompressedConnectivity & other) noexcept
+    {
+        m_offsets.swap(other.m_offsets);
+        m_indices.swap(other.m_indices);
+    }
+
+    /**
+     * Compress a padded table whose first column is the number of valid
+     * entries in the row.  Ghost rows of the padded table are preserved.
+     */
+    static CompressedConnectivity from_padded(array_type const & padded);
+
+    /**
+     * Expand to a padded table of ncolumn columns (including the leading
+     * count column).  Unused slots are filled with -1.
+     */
+    array_type to_padded(size_t ncolumn) const;
+
+    size_t nghost() const { return m_offsets.nghost(); }
+    size_t nbody() const { return m_offsets.nbody() - 1; }
+    size_t nrow() const { return m_offsets.shape(0) - 1; }
+    size_t nnz() const { return m_indices.size(); }
+    size_t nbytes() const { return m_offsets.nbytes() + m_indices.nbytes(); }
+
+    /// Maximum number of entries in a row.
+    size_t max_size() const
+    {
+        size_t ret = 0;
+        index_type const * ptr = m_offsets.data();
+        for (size_t it = 0; it < nrow(); ++it)
+        {
+            ret = std::max(ret, static_cast<size_t>(ptr[it + 1] - ptr[it]));
+        }
+        return ret;
+    }
+
+    size_t size(ssize_t irow) const { return static_cast<size_t>(m_offsets(irow + 1) - m_offsets(irow)); }
+    index_type const * begin(ssize_t irow) const { return m_indices.data() + m_offsets(irow); }
+    index_type const * end(ssize_t irow) const { return m_indices.data() + m_offsets(irow + 1); }
+    index_type * begin(ssize_t irow) { return m_indices.data() + m_offsets(irow); }
+    index_type * end(ssize_t irow) { return m_indices.data() + m_offsets(irow + 1); }
+    Row row(ssize_t irow) const { return Row(begin(irow), end(irow)); }
+
+    index_type const & operator()(ssize_t irow, size_t it) const { return begin(irow)[it]; }
+    index_type & operator()(ssize_t irow, size_t it) { return begin(irow)[it]; }
+
+    array_type const & offsets() const { return m_offsets; }
+    array_type const & indices() const { return m_indices; }
+    array_type & indices() { return m_indices; }
+
+private:
+
+    void validate() const;
+
+    array_type m_offsets;
+    array_type m_indices;
+
+}; /* end class CompressedConnectivity */
+
+template <typename I>
+CompressedConnectivity<I> CompressedConnectivity<I>::from_padded(array_type const & padded)
+{
+    if (padded.ndim() != 2 || padded.shape(1) < 1)
+    {
+        throw std::invalid_argument(
+            Formatter() << "CompressedConnectivity: padded table must be 2D with at least 1 column, but got "
+                        << padded.ndim() << "D");
+    }
+    size_t const nrow = padded.shape(0);
+    size_t const ncolumn = padded.shape(1);
+    index_type const * src = padded.data();
+
+    // First pass: count entries of each row.
+    array_type offsets(std::vector<size_t>{nrow + 1});
+    index_type * optr = offsets.data();
+    optr[0] = 0;
+    for (size_t it = 0; it < nrow; ++it)
+    {
+        index_type const cnt = src[it * ncolumn];
+        if (cnt < 0 || static_cast<size_t>(cnt) >= ncolumn)
+        {
+            throw std::out_of_range(
+                Formatter() << "CompressedConnectivity: row " << static_cast<ssize_t>(it) - static_cast<ssize_t>(padded.nghost())
+                            << " has count " << cnt << " which does not fit in " << ncolumn << " columns");
+        }
+        optr[it + 1] = optr[it] + cnt;
+    }
+    offsets.set_nghost(padded.nghost());
+
+    // Second pass: copy the entries.
+    array_type indices(std::vector<size_t>{static_cast<size_t>(optr[nrow])});
+    index_type * iptr = indices.data();
+    for (size_t it = 0; it < nrow; ++it)
+    {
+        index_type const * row = src + it * ncolumn;
+        std::copy(row + 1, row + 1 + row[0], iptr + optr[it]);
+    }
+
+    return CompressedConnectivity(std::move(offsets), std::move(indices));
+}
+
+template <typename I>
+typename CompressedConnectivity<I>::array_type CompressedConnectivity<I>::to_padded(size_t ncolumn) const
+{
+    size_t const nmax = max_size();
+    if (nmax + 1 > ncolumn)
+    {
+        throw std::out_of_range(
+            Formatter() << "CompressedConnectivity: cannot pad rows of " << nmax << " entries into " << ncolumn << " columns");
+    }
+    array_type ret(std::vector<size_t>{nrow(), ncolumn}, -1);
+    index_type * dst = ret.data();
+    index_type const * optr = m_offsets.data();
+    index_type const * iptr = m_indices.data();
+    for (size_t it = 0; it < nrow(); ++it)
+    {
+        index_type * row = dst + it * ncolumn;
+        row[0] = optr[it + 1] - optr[it];
+        std::copy(iptr + optr[it], iptr + optr[it + 1], row + 1);
+    }
+    ret.set_nghost(nghost());
+    return ret;
+}
+
+template <typename I>
+void CompressedConnectivity<I>::validate() const
+{
+    if (m_offsets.ndim() != 1 || m_offsets.size() < 1)
+    {
+        throw std::invalid_argument("CompressedConnectivity: offsets must be 1D and have at least 1 element");
+    }
+    if (m_indices.ndim() != 1)
+    {
+        throw std::invalid_argument("CompressedConnectivity: indices must be 1D");
+    }
+    index_type const * optr = m_offsets.data();
+    if (optr[0] != 0)
+    {
+        throw std::invalid_argument(Formatter() << "CompressedConnectivity: the first offset " << optr[0] << " != 0");
+    }
+    for (size_t it = 0; it < nrow(); ++it)
+    {
+        if (optr[it + 1] < optr[it])
+        {
+            throw std::invalid_argument(
+                Formatter() << "CompressedConnectivity: offsets decrease at " << it << " (" << optr[it] << " > " << optr[it + 1] << ")");
+        }
+    }
+    if (static_cast<size_t>(optr[nrow()]) != m_indices.size())
+    {
+        throw std::invalid_argument(
+            Formatter() << "CompressedConnectivity: the last offset " << optr[nrow()] << " != number of indices " << m_indices.size());
+    }
+}
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -35,10 +35,13 @@
 #include <modmesh/base.hpp>
 #include <modmesh/toggle/toggle.hpp>
 #include <modmesh/buffer/buffer.hpp>
+#include <modmesh/mesh/CompressedConnectivity.hpp>
+#include <modmesh/parallel.hpp>
 
 #include <cmath>
 #include <vector>
 #include <numeric>
+#include <utility>
 
 namespace modmesh
 {
@@ -147,6 +150,51 @@ inline CellType CellType::by_id(uint8_t id)
 #undef MM_DECL_SWITCH_CELL_TYPE
 }
 
+/**
+ * Compile-time counterpart of CellType::by_id().  Kernels instantiated with
+ * the traits get the numbers of nodes and faces as constants.
+ */
+template <uint8_t ID>
+struct CellTypeTraits;
+
+#define MM_DECL_CELL_TYPE_TRAITS(TYPE, NDIM, NNODE, NEDGE, NSURFACE)                                 \
+    template <>                                                                                      \
+    struct CellTypeTraits<TYPE>                                                                      \
+    {                                                                                                \
+        static constexpr const uint8_t id = TYPE;                                                    \
+        static constexpr const uint8_t ndim = NDIM;                                                  \
+        static constexpr const uint8_t nnode = NNODE;                                                \
+        static constexpr const uint8_t nedge = NEDGE;                                                \
+        static constexpr const uint8_t nsurface = NSURFACE;                                          \
+        static constexpr const uint8_t nface = 3 == NDIM ? NSURFACE : (2 == NDIM ? NEDGE : (1 == NDIM ? NNODE : 0)); \
+    };
+
+// clang-format off
+//                        id, ndim, nnode, nedge, nsurface
+MM_DECL_CELL_TYPE_TRAITS(  0,    0,     0,     0,        0 ) // non-type
+MM_DECL_CELL_TYPE_TRAITS(  1,    0,     1,     0,        0 ) // point/node/vertex
+MM_DECL_CELL_TYPE_TRAITS(  2,    1,     2,     0,        0 ) // line/edge
+MM_DECL_CELL_TYPE_TRAITS(  3,    2,     4,     4,        0 ) // quadrilateral
+MM_DECL_CELL_TYPE_TRAITS(  4,    2,     3,     3,        0 ) // triangle
+MM_DECL_CELL_TYPE_TRAITS(  5,    3,     8,    12,        6 ) // hexahedron/brick
+MM_DECL_CELL_TYPE_TRAITS(  6,    3,     4,     6,        4 ) // tetrahedron
+MM_DECL_CELL_TYPE_TRAITS(  7,    3,     6,     9,        5 ) // prism
+MM_DECL_CELL_TYPE_TRAITS(  8,    3,     5,     8,        5 ) // pyramid
+// clang-format on
+
+#undef MM_DECL_CELL_TYPE_TRAITS
+
+namespace detail
+{
+
+template <typename C, typename F, uint8_t... IDS>
+void for_each_cell_type(C const & tpcls, F & func, std::integer_sequence<uint8_t, IDS...>)
+{
+    ((tpcls.size(IDS) > 0 ? (func(CellTypeTraits<IDS>(), tpcls.begin(IDS), tpcls.end(IDS)), void()) : void()), ...);
+}
+
+} /* end namespace detail */
+
 struct StaticMeshConstant
 {
 
@@ -257,6 +305,7 @@ public:
     using int_type = typename number_base::int_type;
     using uint_type = typename number_base::uint_type;
     using real_type = typename number_base::real_type;
+    using connectivity_type = CompressedConnectivity<int_type>;
 
     template <typename... Args>
     static std::shared_ptr<StaticMesh> construct(Args &&... args)
@@ -332,6 +381,7 @@ public:
 
     void build_interior(bool do_metric, bool do_edge = true)
     {
+        check_padded("build_interior");
         build_faces_from_cells();
         if (do_metric)
         {
@@ -355,11 +405,161 @@ public:
 
     void build_boundary();
     void build_ghost();
+    void refill_ghost(bool do_metric = true);
 
 private:
 
+    /// Number of boundary faces or ghost entities processed in a batch.
+    static constexpr size_t GHOST_GRAIN = 256;
+
     std::tuple<size_t, size_t, size_t> count_ghost() const;
     void fill_ghost();
+    void mirror_ghost_node();
+    void calc_ghost_metric();
+
+    // Compressed (CSR) connectivity.
+public:
+
+    /**
+     * Build the compressed sparse-row copies of fcnds, clnds, and clfcs
+     * (including ghost rows).  The copies are not updated automatically; call
+     * the function again after building the interior or ghost data.
+     *
+     * When drop_padded is true, the padded tables are released afterward and
+     * the compressed copies become the only connectivity storage.  The
+     * builders reading the padded tables then throw until expand_csr()
+     * restores them.
+     */
+    void build_csr(bool drop_padded = false)
+    {
+        check_padded("build_csr");
+        connectivity_type::from_padded(m_fcnds).swap(m_fcnds_csr);
+        connectivity_type::from_padded(m_clnds).swap(m_clnds_csr);
+        connectivity_type::from_padded(m_clfcs).swap(m_clfcs_csr);
+        if (drop_padded)
+        {
+            SimpleArray<int_type>(std::vector<size_t>{0, FCMND + 1}).swap(m_fcnds);
+            SimpleArray<int_type>(std::vector<size_t>{0, CLMND + 1}).swap(m_clnds);
+            SimpleArray<int_type>(std::vector<size_t>{0, CLMFC + 1}).swap(m_clfcs);
+            m_padded_dropped = true;
+        }
+    }
+
+    /**
+     * Overwrite the padded fcnds, clnds, and clfcs with the expansion of
+     * their compressed copies.  This also restores the padded tables released
+     * by build_csr(true).
+     */
+    void expand_csr()
+    {
+        if (m_fcnds_csr.nrow() != m_ngstface + m_nface || m_clnds_csr.nrow() != m_ngstcell + m_ncell || m_clfcs_csr.nrow() != m_ngstcell + m_ncell)
+        {
+            throw std::out_of_range("StaticMesh: compressed connectivity does not match the mesh; call build_csr() first");
+        }
+        m_fcnds_csr.to_padded(FCMND + 1).swap(m_fcnds);
+        m_clnds_csr.to_padded(CLMND + 1).swap(m_clnds);
+        m_clfcs_csr.to_padded(CLMFC + 1).swap(m_clfcs);
+        m_padded_dropped = false;
+    }
+
+    /// False after build_csr(true) released the padded connectivity tables.
+    bool has_padded_connectivity() const { return !m_padded_dropped; }
+
+    connectivity_type const & fcnds_csr() const { return m_fcnds_csr; }
+    connectivity_type & fcnds_csr() { return m_fcnds_csr; }
+    connectivity_type const & clnds_csr() const { return m_clnds_csr; }
+    connectivity_type & clnds_csr() { return m_clnds_csr; }
+    connectivity_type const & clfcs_csr() const { return m_clfcs_csr; }
+    connectivity_type & clfcs_csr() { return m_clfcs_csr; }
+
+private:
+
+    void check_padded(char const * caller) const
+    {
+        if (m_padded_dropped)
+        {
+            throw std::runtime_error(Formatter() << "StaticMesh::" << caller << ": padded connectivity is dropped; call expand_csr() first");
+        }
+    }
+
+    connectivity_type m_fcnds_csr;
+    connectivity_type m_clnds_csr;
+    connectivity_type m_clfcs_csr;
+    bool m_padded_dropped = false;
+
+    // Adjacency tables derived from the connectivity.  They are built on
+    // demand, cached, and invalidated when the interior or ghost data are
+    // rebuilt.
+public:
+
+    /**
+     * Build (if not cached) and return the node-to-cell table.  Row ind lists
+     * the interior cells using interior node ind, in ascending order.
+     */
+    connectivity_type const & build_node_cells();
+
+    /**
+     * Build (if not cached) and return the cell-to-cell table.  Row icl lists
+     * the cells sharing a face with interior cell icl, in the order of clfcs.
+     * Ghost cells (negative indices) are included when the ghost data have
+     * been built.
+     */
+    connectivity_type const & build_cell_neighbors();
+
+    /**
+     * Build (if not cached) and return the node-to-node table.  Row ind lists
+     * the interior nodes connected to interior node ind by an edge of a face
+     * (by a cell in 1D), in ascending order.
+     */
+    connectivity_type const & build_node_neighbors();
+
+    /**
+     * Build (if not cached) and return the type-to-cell table.  Row t lists
+     * the interior cells of type id t (0 to CellType::NTYPE), in ascending
+     * order.  The indices are a stable permutation of the cells sorted by
+     * type, and the offsets are the range of each type in it.  A cell of an
+     * unknown type id is in no row.
+     */
+    connectivity_type const & build_type_cells();
+
+    /**
+     * Call func(CellTypeTraits<ID>(), begin, end) for each cell type having
+     * interior cells, in the order of the type id.  [begin, end) points to
+     * the int_type indices of the cells of the type.  A generic lambda is
+     * instantiated for each type, so that the kernel loops over the cells of
+     * a group with the compile-time numbers of nodes and faces.
+     */
+    template <typename F>
+    void for_each_cell_type(F && func)
+    {
+        detail::for_each_cell_type(build_type_cells(), func, std::make_integer_sequence<uint8_t, CellType::NTYPE + 1>());
+    }
+
+    /// Drop the cached adjacency tables.  Call it after modifying the mesh arrays directly.
+    void invalidate_adjacency()
+    {
+        connectivity_type().swap(m_ndcls);
+        connectivity_type().swap(m_clcls);
+        connectivity_type().swap(m_ndnds);
+        connectivity_type().swap(m_tpcls);
+        m_has_ndcls = m_has_clcls = m_has_ndnds = m_has_tpcls = false;
+    }
+
+    bool has_node_cells() const { return m_has_ndcls; }
+    bool has_cell_neighbors() const { return m_has_clcls; }
+    bool has_node_neighbors() const { return m_has_ndnds; }
+    bool has_type_cells() const { return m_has_tpcls; }
+
+private:
+
+    connectivity_type m_ndcls; ///< Node-to-cell.
+    connectivity_type m_clcls; ///< Cell-to-cell.
+    connectivity_type m_ndnds; ///< Node-to-node.
+    connectivity_type m_tpcls; ///< Type-to-cell.
+    bool m_has_ndcls = false;
+    bool m_has_clcls = false;
+    bool m_has_ndnds = false;
+    bool m_has_tpcls = false;
 
     // Shape data.
 private:
@@ -388,6 +588,29 @@ public:                                                                 \
 private:                                                                \
     SimpleArray<TYPE> m_##NAME
 
+// The padded connectivity tables may be released by build_csr(true).  The
+// whole-array accessors throw then; the element accessors are left unchecked
+// for the kernels.
+#define MM_DECL_StaticMesh_PADDED_ARRAY(TYPE, NAME)                     \
+public:                                                                 \
+    SimpleArray<TYPE> const & NAME() const                              \
+    {                                                                   \
+        check_padded(#NAME);                                            \
+        return m_##NAME;                                                \
+    }                                                                   \
+    SimpleArray<TYPE> & NAME()                                          \
+    {                                                                   \
+        check_padded(#NAME);                                            \
+        return m_##NAME;                                                \
+    }                                                                   \
+    template <typename... Args>                                         \
+    TYPE const & NAME(Args... args) const { return m_##NAME(args...); } \
+    template <typename... Args>                                         \
+    TYPE & NAME(Args... args) { return m_##NAME(args...); }             \
+                                                                        \
+private:                                                                \
+    SimpleArray<TYPE> m_##NAME
+
     // geometry arrays.
     MM_DECL_StaticMesh_ARRAY(real_type, ndcrd);
     MM_DECL_StaticMesh_ARRAY(real_type, fccnd);
@@ -400,16 +623,17 @@ private:                                                                \
     MM_DECL_StaticMesh_ARRAY(int_type, cltpn);
     MM_DECL_StaticMesh_ARRAY(int_type, clgrp);
     // connectivity arrays.
-    MM_DECL_StaticMesh_ARRAY(int_type, fcnds);
+    MM_DECL_StaticMesh_PADDED_ARRAY(int_type, fcnds);
     MM_DECL_StaticMesh_ARRAY(int_type, fccls);
-    MM_DECL_StaticMesh_ARRAY(int_type, clnds);
-    MM_DECL_StaticMesh_ARRAY(int_type, clfcs);
+    MM_DECL_StaticMesh_PADDED_ARRAY(int_type, clnds);
+    MM_DECL_StaticMesh_PADDED_ARRAY(int_type, clfcs);
     MM_DECL_StaticMesh_ARRAY(int_type, ednds);
     // boundary information.
     MM_DECL_StaticMesh_ARRAY(int_type, bndfcs);
     std::vector<StaticMeshBC> m_bcs;
 
 #undef MM_DECL_StaticMesh_ARRAY
+#undef MM_DECL_StaticMesh_PADDED_ARRAY
 
 }; /* end class StaticMesh */
 
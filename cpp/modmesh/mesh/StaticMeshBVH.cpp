@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <modmesh/mesh/StaticMeshBVH.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace modmesh
+{
+
+namespace detail
+{
+
+/// Fixed-size stack for the depth-first traversal of the BVH.
+template <typename I>
+class BVHStack
+{
+public:
+    void push(I value) { m_data[m_size++] = value; }
+    I pop() { return m_data[--m_size]; }
+    bool empty() const { return 0 == m_size; }
+
+private:
+    // The tree is balanced by the median split, so 128 levels are never
+    // reached.
+    std::array<I, 256> m_data;
+    size_t m_size = 0;
+}; /* end class BVHStack */
+
+} /* end namespace detail */
+
+StaticMeshBVH::StaticMeshBVH(std::shared_ptr<StaticMesh> const & mesh, real_type tolerance, ctor_passkey const &)
+    : m_mesh(mesh)
+    , m_tolerance(tolerance)
+{
+    if (!m_mesh)
+    {
+        throw std::invalid_argument("StaticMeshBVH: mesh is null");
+    }
+    m_ndim = m_mesh->ndim();
+    if (m_ndim != 2 && m_ndim != 3)
+    {
+        throw std::invalid_argument(Formatter() << "StaticMeshBVH: ndim = " << static_cast<int>(m_ndim)
+                                                << " is not supported (must be 2 or 3)");
+    }
+    if (!m_mesh->has_padded_connectivity())
+    {
+        throw std::invalid_argument("StaticMeshBVH: padded connectivity of the mesh is dropped; call expand_csr() first");
+    }
+
+    StaticMesh const & mh = *m_mesh;
+    size_t const ncell = mh.ncell();
+
+    // Bounding box of each cell: 3 lower and 3 upper coordinates.
+    std::vector<real_type> clbox(ncell * 6, 0.0);
+    parallel_for(
+        0, ncell, [&](size_t ibegin, size_t iend)
+        {
+            for (size_t icl = ibegin; icl < iend; ++icl)
+            {
+                real_type * box = clbox.data() + icl * 6;
+                for (size_t idm = 0; idm < m_ndim; ++idm)
+                {
+                    box[idm] = std::numeric_limits<real_type>::max();
+                    box[idm + 3] = std::numeric_limits<real_type>::lowest();
+                }
+                for (int_type inl = 1; inl <= mh.clnds(icl, 0); ++inl)
+                {
+                    int_type const ind = mh.clnds(icl, inl);
+                    for (size_t idm = 0; idm < m_ndim; ++idm)
+                    {
+                        box[idm] = std::min(box[idm], mh.ndcrd(ind, idm));
+                        box[idm + 3] = std::max(box[idm + 3], mh.ndcrd(ind, idm));
+                    }
+                }
+            } },
+        1024);
+
+    m_order.resize(ncell);
+    std::iota(m_order.begin(), m_order.end(), 0);
+    if (ncell > 0)
+    {
+        m_nodes.reserve(2 * (ncell / LEAF_SIZE + 1));
+        build_node(0, static_cast<int_type>(ncell), 1, clbox);
+    }
+}
+
+StaticMeshBVH::int_type StaticMeshBVH::build_node(int_type begin, int_type end, size_t depth, std::vector<real_type> const & clbox)
+{
+    m_depth = std::max(m_depth, depth);
+    int_type const inode = static_cast<int_type>(m_nodes.size());
+    m_nodes.emplace_back();
+    {
+        Node & node = m_nodes.back();
+        node.lower = {0.0, 0.0, 0.0};
+        node.upper = {0.0, 0.0, 0.0};
+        for (size_t idm = 0; idm < m_ndim; ++idm)
+        {
+            node.lower[idm] = std::numeric_limits<real_type>::max();
+            node.upper[idm] = std::numeric_limits<real_type>::lowest();
+        }
+        for (int_type it = begin; it < end; ++it)
+        {
+            real_type const * box = clbox.data() + m_order[it] * 6;
+            for (size_t idm = 0; idm < m_ndim; ++idm)
+            {
+                node.lower[idm] = std::min(node.lower[idm], box[idm]);
+                node.upper[idm] = std::max(node.upper[idm], box[idm + 3]);
+            }
+        }
+        node.left = node.right = -1;
+        node.begin = begin;
+        node.end = end;
+    }
+    if (static_cast<size_t>(end - begin) <= LEAF_SIZE)
+    {
+        return inode;
+    }
+
+    // Split at the median of the box centers along the longest axis.
+    size_t axis = 0;
+    real_type extent = -1;
+    for (size_t idm = 0; idm < m_ndim; ++idm)
+    {
+        real_type const len = m_nodes[inode].upper[idm] - m_nodes[inode].lower[idm];
+        if (len > extent)
+        {
+            extent = len;
+            axis = idm;
+        }
+    }
+    int_type const mid = begin + (end - begin) / 2;
+    std::nth_element(
+        m_order.begin() + begin,
+        m_order.begin() + mid,
+        m_order.begin() + end,
+        [&clbox, axis](int_type lhs, int_type rhs)
+        {
+            return (clbox[lhs * 6 + axis] + clbox[lhs * 6 + axis + 3]) < (clbox[rhs * 6 + axis] + clbox[rhs * 6 + axis + 3]);
+        });
+
+    int_type const left = build_node(begin, mid, depth + 1, clbox);
+    int_type const right = build_node(mid, end, depth + 1, clbox);
+    m_nodes[inode].left = left;
+    m_nodes[inode].right = right;
+    return inode;
+}
+
+/**
+ * The point is in a convex cell when it is behind all the faces of the cell.
+ * fcnml points outward from the first cell in fccls, so it is flipped for the
+ * second cell.
+ */
+bool StaticMeshBVH::contains(int_type icl, real_type const * point) const
+{
+    StaticMesh const & mh = *m_mesh;
+    for (int_type ifl = 1; ifl <= mh.clfcs(icl, 0); ++ifl)
+    {
+        int_type const ifc = mh.clfcs(icl, ifl);
+        real_type dist = 0.0;
+        for (size_t idm = 0; idm < m_ndim; ++idm)
+        {
+            dist += (point[idm] - mh.fccnd(ifc, idm)) * mh.fcnml(ifc, idm);
+        }
+        if (mh.fcicl(ifc) != icl)
+        {
+            dist = -dist;
+        }
+        if (dist > m_tolerance)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+StaticMeshBVH::int_type StaticMeshBVH::locate_point(real_type const * point) const
+{
+    if (m_nodes.empty())
+    {
+        return -1;
+    }
+    detail::BVHStack<int_type> stack;
+    stack.push(0);
+    while (!stack.empty())
+    {
+        Node const & node = m_nodes[stack.pop()];
+        bool inside = true;
+        for (size_t idm = 0; idm < m_ndim; ++idm)
+        {
+            if (point[idm] < node.lower[idm] - m_tolerance || point[idm] > node.upper[idm] + m_tolerance)
+            {
+                inside = false;
+                break;
+            }
+        }
+        if (!inside)
+        {
+            continue;
+        }
+        if (node.is_leaf())
+        {
+            for (int_type it = node.begin; it < node.end; ++it)
+            {
+                if (contains(m_order[it], point))
+                {
+                    return m_order[it];
+                }
+            }
+        }
+        else
+        {
+            stack.push(node.right);
+            stack.push(node.left);
+        }
+    }
+    return -1;
+}
+
+StaticMeshBVH::int_type StaticMeshBVH::nearest_cell(real_type const * point) const
+{
+    if (m_nodes.empty())
+    {
+        return -1;
+    }
+    StaticMesh const & mh = *m_mesh;
+
+    // Squared distance from the point to the bounding box of a node.
+    auto box_distance = [this, point](Node const & node)
+    {
+        real_type ret = 0.0;
+        for (size_t idm = 0; idm < m_ndim; ++idm)
+        {
+            real_type const delta = std::max({node.lower[idm] - point[idm], real_type(0), point[idm] - node.upper[idm]});
+            ret += delta * delta;
+        }
+        return ret;
+    };
+
+    int_type best = -1;
+    real_type best_distance = std::numeric_limits<real_type>::max();
+    detail::BVHStack<int_type> stack;
+    stack.push(0);
+    while (!stack.empty())
+    {
+        Node const & node = m_nodes[stack.pop()];
+        if (box_distance(node) > best_distance)
+        {
+            continue;
+        }
+        if (node.is_leaf())
+        {
+            for (int_type it = node.begin; it < node.end; ++it)
+            {
+                int_type const icl = m_order[it];
+                real_type distance = 0.0;
+                for (size_t idm = 0; idm < m_ndim; ++idm)
+                {
+                    real_type const delta = mh.clcnd(icl, idm) - point[idm];
+                    distance += delta * delta;
+                }
+                if (distance < best_distance || (distance == best_distance && icl < best))
+                {
+                    best_distance = distance;
+                    best = icl;
+                }
+            }
+        }
+        else
+        {
+            // Visit the nearer child first.
+            real_type const dleft = box_distance(m_nodes[node.left]);
+            real_type const dright = box_distance(m_nodes[node.right]);
+            if (dleft <= dright)
+            {
+                stack.push(node.right);
+                stack.push(node.left);
+            }
+            else
+            {
+                stack.push(node.left);
+                stack.push(node.right);
+            }
+        }
+    }
+    return best;
+}
+
+void StaticMeshBVH::check_points(SimpleArray<real_type> const & points) const
+{
+    if (points.ndim() != 2 || points.shape(1) != m_ndim)
+    {
+        throw std::invalid_argument(Formatter() << "StaticMeshBVH: points must be in the shape of (npoint, " << static_cast<int>(m_ndim) << ")");
+    }
+}
+
+SimpleArray<StaticMeshBVH::int_type> StaticMeshBVH::locate_points(SimpleArray<real_type> const & points) const
+{
+    check_points(points);
+    size_t const npoint = points.shape(0);
+    SimpleArray<int_type> ret(std::vector<size_t>{npoint}, -1);
+    parallel_for(
+        0, npoint, [&](size_t ibegin, size_t iend)
+        {
+            std::array<real_type, 3> point{0.0, 0.0, 0.0};
+            for (size_t ipt = ibegin; ipt < iend; ++ipt)
+            {
+                for (size_t idm = 0; idm < m_ndim; ++idm)
+                {
+                    point[idm] = points(ipt, idm);
+                }
+                ret(ipt) = locate_point(point.data());
+            } },
+        256);
+    return ret;
+}
+
+SimpleArray<StaticMeshBVH::int_type> StaticMeshBVH::nearest_cells(SimpleArray<real_type> const & points) const
+{
+    check_points(points);
+    size_t const npoint = points.shape(0);
+    SimpleArray<int_type> ret(std::vector<size_t>{npoint}, -1);
+    parallel_for(
+        0, npoint, [&](size_t ibegin, size_t iend)
+        {
+            std::array<real_type, 3> point{0.0, 0.0, 0.0};
+            for (size_t ipt = ibegin; ipt < iend; ++ipt)
+            {
+                for (size_t idm = 0; idm < m_ndim; ++idm)
+                {
+                    point[idm] = points(ipt, idm);
+                }
+                ret(ipt) = nearest_cell(point.data());
+            } },
+        256);
+    return ret;
+}
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -0,0 +1,151 @@
+#pragma once
+
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Spatial search over the cells of StaticMesh.
+ */
+
+#include <modmesh/mesh/StaticMesh.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace modmesh
+{
+
+/**
+ * Bounding volume hierarchy (BVH) over the interior cells of a StaticMesh.
+ * Each node of the tree holds the axis-aligned bounding box of its cells, and
+ * a leaf holds at most LEAF_SIZE cells.  The tree is built top-down by
+ * splitting the cell centroids at the median of the longest axis.
+ *
+ * Point location tests a point against the faces of the candidate cells, so
+ * the metric of the mesh (fccnd, fcnml) must have been built, and the cells
+ * are assumed to be convex.  Batched queries run in parallel.  The index is
+ * not updated when the mesh changes; construct a new one instead.
+ */
+class StaticMeshBVH
+    : public NumberBase<int32_t, double>
+    , public std::enable_shared_from_this<StaticMeshBVH>
+{
+
+private:
+
+    class ctor_passkey
+    {
+    };
+
+public:
+
+    using number_base = NumberBase<int32_t, double>;
+    using int_type = typename number_base::int_type;
+    using real_type = typename number_base::real_type;
+
+    static constexpr size_t LEAF_SIZE = 4;
+
+    struct Node
+    {
+        std::array<real_type, 3> lower; ///< Lower corner of the bounding box.
+        std::array<real_type, 3> upper; ///< Upper corner of the bounding box.
+        int_type left; ///< Index of the left child, or -1 for a leaf.
+        int_type right; ///< Index of the right child, or -1 for a leaf.
+        int_type begin; ///< Start of the cells of a leaf in cell_order().
+        int_type end; ///< End of the cells of a leaf in cell_order().
+        bool is_leaf() const { return left < 0; }
+    }; /* end struct Node */
+
+    template <typename... Args>
+    static std::shared_ptr<StaticMeshBVH> construct(Args &&... args)
+    {
+        return std::make_shared<StaticMeshBVH>(std::forward<Args>(args)..., ctor_passkey());
+    }
+
+    StaticMeshBVH(std::shared_ptr<StaticMesh> const & mesh, real_type tolerance, ctor_passkey const &);
+    StaticMeshBVH(std::shared_ptr<StaticMesh> const & mesh, ctor_passkey const & key)
+        : StaticMeshBVH(mesh, 1.e-12, key)
+    {
+    }
+
+    StaticMeshBVH() = delete;
+    StaticMeshBVH(StaticMeshBVH const &) = delete;
+    StaticMeshBVH(StaticMeshBVH &&) = delete;
+    StaticMeshBVH & operator=(StaticMeshBVH const &) = delete;
+    StaticMeshBVH & operator=(StaticMeshBVH &&) = delete;
+    ~StaticMeshBVH() = default;
+
+    std::shared_ptr<StaticMesh> const & mesh() const { return m_mesh; }
+    real_type tolerance() const { return m_tolerance; }
+    size_t nnode() const { return m_nodes.size(); }
+    size_t depth() const { return m_depth; }
+    Node const & node(size_t it) const { return m_nodes.at(it); }
+    std::vector<int_type> const & cell_order() const { return m_order; }
+
+    /// Return the index of the cell containing the point, or -1 if none.
+    int_type locate_point(real_type const * point) const;
+
+    /// Return the index of the cell whose centroid is nearest to the point.
+    int_type nearest_cell(real_type const * point) const;
+
+    /**
+     * Locate a batch of points.
+     *
+     * @param[in] points (npoint, ndim) array of coordinates.
+     * @return           (npoint,) array of cell indices; -1 for the points
+     *                   outside of the mesh.
+     */
+    SimpleArray<int_type> locate_points(SimpleArray<real_type> const & points) const;
+
+    /**
+     * Find the cells with the centroids nearest to a batch of points.
+     *
+     * @param[in] points (npoint, ndim) array of coordinates.
+     * @return           (npoint,) array of cell indices.
+     */
+    SimpleArray<int_type> nearest_cells(SimpleArray<real_type> const & points) const;
+
+private:
+
+    int_type build_node(int_type begin, int_type end, size_t depth, std::vector<real_type> const & clbox);
+    bool contains(int_type icl, real_type const * point) const;
+    void check_points(SimpleArray<real_type> const & points) const;
+
+    std::shared_ptr<StaticMesh> m_mesh;
+    real_type m_tolerance = 0;
+    uint8_t m_ndim = 0;
+    size_t m_depth = 0;
+    std::vector<Node> m_nodes;
+    std::vector<int_type> m_order;
+
+}; /* end class StaticMeshBVH */
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
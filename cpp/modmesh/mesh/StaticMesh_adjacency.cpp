@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <modmesh/mesh/StaticMesh.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+namespace modmesh
+{
+
+namespace detail
+{
+
+/**
+ * Two-pass construction of a CSR table.  count(irow) returns the number of
+ * entries in the row, and fill(irow, ptr) writes them to ptr.  Both passes
+ * run in parallel over rows.
+ */
+template <typename I, typename C, typename F>
+CompressedConnectivity<I> make_csr_by_row(size_t nrow, C && count, F && fill)
+{
+    using array_type = SimpleArray<I>;
+    constexpr size_t grain = 1024;
+
+    array_type offsets(std::vector<size_t>{nrow + 1});
+    I * optr = offsets.data();
+    optr[0] = 0;
+    parallel_for(
+        0, nrow, [&](size_t ibegin, size_t iend)
+        {
+            for (size_t irow = ibegin; irow < iend; ++irow)
+            {
+                optr[irow + 1] = static_cast<I>(count(irow));
+            } },
+        grain);
+    for (size_t irow = 0; irow < nrow; ++irow)
+    {
+        optr[irow + 1] += optr[irow];
+    }
+
+    array_type indices(std::vector<size_t>{static_cast<size_t>(optr[nrow])});
+    I * iptr = indices.data();
+    parallel_for(
+        0, nrow, [&](size_t ibegin, size_t iend)
+        {
+            for (size_t irow = ibegin; irow < iend; ++irow)
+            {
+                fill(irow, iptr + optr[irow]);
+            } },
+        grain);
+
+    return CompressedConnectivity<I>(std::move(offsets), std::move(indices));
+}
+
+} /* end namespace detail */
+
+/**
+ * The node-to-cell table is the transpose of the interior part of clnds.
+ * Counting and scattering run in parallel over cells with atomic counters,
+ * and each row is sorted afterward so that the result does not depend on the
+ * scheduling.
+ */
+StaticMesh::connectivity_type const & StaticMesh::build_node_cells()
+{
+    if (m_has_ndcls)
+    {
+        return m_ndcls;
+    }
+    check_padded("build_node_cells");
+
+    constexpr size_t grain = 1024;
+    size_t const nnd = nnode();
+    size_t const ncl = ncell();
+
+    // First pass: count cells for each node.
+    std::vector<std::atomic<int_type>> cursor(nnd + 1);
+    for (auto & val : cursor)
+    {
+        val.store(0, std::memory_order_relaxed);
+    }
+    parallel_for(
+        0, ncl, [&](size_t ibegin, size_t iend)
+        {
+            for (size_t icl = ibegin; icl < iend; ++icl)
+            {
+                int_type const * nds = m_clnds.vptr(icl, 0);
+                for (int_type inl = 1; inl <= nds[0]; ++inl)
+                {
+                    int_type const ind = nds[inl];
+                    if (ind >= 0 && static_cast<size_t>(ind) < nnd)
+                    {
+                        cursor[ind].fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            } },
+        grain);
+
+    SimpleArray<int_type> offsets(std::vector<size_t>{nnd + 1});
+    int_type * optr = offsets.data();
+    optr[0] = 0;
+    for (size_t ind = 0; ind < nnd; ++ind)
+    {
+        optr[ind + 1] = optr[ind] + cursor[ind].load(std::memory_order_relaxed);
+        cursor[ind].store(optr[ind], std::memory_order_relaxed);
+    }
+
+    // Second pass: scatter cell indices.
+    SimpleArray<int_type> indices(std::vector<size_t>{static_cast<size_t>(optr[nnd])});
+    int_type * iptr = indices.data();
+    parallel_for(
+        0, ncl, [&](size_t ibegin, size_t iend)
+        {
+            for (size_t icl = ibegin; icl < iend; ++icl)
+            {
+                int_type const * nds = m_clnds.vptr(icl, 0);
+                for (int_type inl = 1; inl <= nds[0]; ++inl)
+                {
+                    int_type const ind = nds[inl];
+                    if (ind >= 0 && static_cast<size_t>(ind) < nnd)
+                    {
+                        iptr[cursor[ind].fetch_add(1, std::memory_order_relaxed)] = static_cast<int_type>(icl);
+                    }
+                }
+            } },
+        grain);
+    parallel_for(
+        0, nnd, [&](size_t ibegin, size_t iend)
+        {
+            for (size_t ind = ibegin; ind < iend; ++ind)
+            {
+                std::sort(iptr + optr[ind], iptr + optr[ind + 1]);
+            } },
+        grain);
+
+    connectivity_type(std::move(offsets), std::move(indices)).swap(m_ndcls);
+    m_has_ndcls = true;
+    return m_ndcls;
+}
+
+StaticMesh::connectivity_type const & StaticMesh::build_cell_neighbors()
+{
+    if (m_has_clcls)
+    {
+        return m_clcls;
+    }
+    check_padded("build_cell_neighbors");
+
+    // Before the ghost cells exist, a negative related cell means no neighbor.
+    bool const with_ghost = 0 != m_ngstcell;
+    auto neighbor = [this](int_type icl, int_type ifc)
+    {
+        int_type const * cls = m_fccls.vptr(ifc, 0);
+        return cls[0] == icl ? cls[1] : cls[0];
+    };
+
+    detail::make_csr_by_row<int_type>(
+        ncell(),
+        [&](size_t icl)
+        {
+            int_type const * fcs = m_clfcs.vptr(icl, 0);
+            size_t cnt = 0;
+            for (int_type ifl = 1; ifl <= fcs[0]; ++ifl)
+            {
+                if (with_ghost || neighbor(static_cast<int_type>(icl), fcs[ifl]) >= 0)
+                {
+                    ++cnt;
+                }
+            }
+            return cnt;
+        },
+        [&](size_t icl, int_type * out)
+        {
+            int_type const * fcs = m_clfcs.vptr(icl, 0);
+            for (int_type ifl = 1; ifl <= fcs[0]; ++ifl)
+            {
+                int_type const jcl = neighbor(static_cast<int_type>(icl), fcs[ifl]);
+                if (with_ghost || jcl >= 0)
+                {
+                    *out++ = jcl;
+                }
+            }
+        })
+        .swap(m_clcls);
+    m_has_clcls = true;
+    return m_clcls;
+}
+
+/**
+ * The neighbors of a node are collected from the faces of the cells around
+ * it: the nodes before and after it in the face node list are connected to it
+ * by an edge.  In 1D the faces are points, and the other nodes of the cells
+ * are used instead.
+ */
+StaticMesh::connectivity_type const & StaticMesh::build_node_neighbors()
+{
+    if (m_has_ndnds)
+    {
+        return m_ndnds;
+    }
+    check_padded("build_node_neighbors");
+    connectivity_type const & ndcls = build_node_cells();
+
+    // Collect the sorted and unique neighbors of node ind into buf.
+    auto collect = [this, &ndcls](int_type ind, std::vector<int_type> & buf)
+    {
+        buf.clear();
+        for (int_type const icl : ndcls.row(ind))
+        {
+            if (m_ndim == 1)
+            {
+                int_type const * nds = m_clnds.vptr(icl, 0);
+                for (int_type inl = 1; inl <= nds[0]; ++inl)
+                {
+                    buf.push_back(nds[inl]);
+                }
+                continue;
+            }
+            int_type const * fcs = m_clfcs.vptr(icl, 0);
+            for (int_type ifl = 1; ifl <= fcs[0]; ++ifl)
+            {
+                int_type const * nds = m_fcnds.vptr(fcs[ifl], 0);
+                int_type const nnd = nds[0];
+                for (int_type inf = 1; inf <= nnd; ++inf)
+                {
+                    if (nds[inf] == ind)
+                    {
+                        buf.push_back(nds[(inf == 1) ? nnd : inf - 1]);
+                        buf.push_back(nds[(inf == nnd) ? 1 : inf + 1]);
+                        break;
+                    }
+                }
+            }
+        }
+        std::sort(buf.begin(), buf.end());
+        buf.erase(std::unique(buf.begin(), buf.end()), buf.end());
+        buf.erase(std::remove(buf.begin(), buf.end(), ind), buf.end());
+    };
+
+    detail::make_csr_by_row<int_type>(
+        nnode(),
+        [&collect](size_t ind)
+        {
+            thread_local std::vector<int_type> buf;
+            collect(static_cast<int_type>(ind), buf);
+            return buf.size();
+        },
+        [&collect](size_t ind, int_type * out)
+        {
+            thread_local std::vector<int_type> buf;
+            collect(static_cast<int_type>(ind), buf);
+            std::copy(buf.begin(), buf.end(), out);
+        })
+        .swap(m_ndnds);
+    m_has_ndnds = true;
+    return m_ndnds;
+}
+
+/**
+ * The type-to-cell table is a counting sort of the interior cells by cltpn.
+ * It is sequential and stable; a single pass over the cells is cheaper than
+ * the synchronization of a parallel scatter.  A cell of an unknown type is
+ * skipped like the face builder does, and is in no row.
+ */
+StaticMesh::connectivity_type const & StaticMesh::build_type_cells()
+{
+    if (m_has_tpcls)
+    {
+        return m_tpcls;
+    }
+
+    constexpr size_t ntype = CellType::NTYPE + 1;
+    size_t const ncl = ncell();
+
+    auto const known = [ntype](int_type tpn)
+    { return tpn >= 0 && static_cast<size_t>(tpn) < ntype; };
+
+    SimpleArray<int_type> offsets(std::vector<size_t>{ntype + 1}, 0);
+    int_type * optr = offsets.data();
+    for (size_t icl = 0; icl < ncl; ++icl)
+    {
+        int_type const tpn = m_cltpn(icl);
+        if (known(tpn))
+        {
+            ++optr[tpn + 1];
+        }
+    }
+    for (size_t itp = 0; itp < ntype; ++itp)
+    {
+        optr[itp + 1] += optr[itp];
+    }
+
+    SimpleArray<int_type> indices(std::vector<size_t>{static_cast<size_t>(optr[ntype])});
+    std::vector<int_type> cursor(optr, optr + ntype);
+    for (size_t icl = 0; icl < ncl; ++icl)
+    {
+        int_type const tpn = m_cltpn(icl);
+        if (known(tpn))
+        {
+            indices(cursor[tpn]++) = static_cast<int_type>(icl);
+        }
+    }
+
+    connectivity_type(std::move(offsets), std::move(indices)).swap(m_tpcls);
+    m_has_tpcls = true;
+    return m_tpcls;
+}
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -28,6 +28,8 @@
 
 #include <modmesh/mesh/StaticMesh.hpp>
 
+#include <algorithm>
+
 namespace modmesh
 {
 
@@ -44,6 +46,7 @@ namespace modmesh
 /* NOLINTNEXTLINE(readability-function-cognitive-complexity) */
 void StaticMesh::build_boundary()
 {
+    check_padded("build_boundary");
     assert(0 == m_nbound); // nothing should touch m_nbound beforehand.
     for (size_t it = 0; it < fccls().shape(0); ++it)
     {
@@ -121,6 +124,8 @@ void StaticMesh::build_boundary()
 /* NOLINTNEXTLINE(readability-function-cognitive-complexity) */
 void StaticMesh::build_ghost()
 {
+    check_padded("build_ghost");
+    invalidate_adjacency();
 
     auto count_ghost_tuple = count_ghost();
     m_ngstnode = static_cast<uint_type>(std::get<0>(count_ghost_tuple));
@@ -201,12 +206,13 @@ std::tuple<size_t, size_t, size_t> StaticMesh::count_ghost() const
  * cells.  The action includes:
  *
  * 1. define indices and build connectivities for ghost nodes, faces,
- *    and cells.  In the same loop, mirror the coordinates of interior
- *    nodes to ghost nodes.
- * 2. compute center coordinates for faces for ghost cells.
- * 3. compute normal vectors and areas for faces for ghost cells.
- * 4. compute center coordinates for ghost cells.
- * 5. compute volume for ghost cells.
+ *    and cells.
+ * 2. mirror the coordinates of interior nodes to ghost nodes.
+ * 3. compute the metric of ghost faces and cells.
+ *
+ * The ghost indices of each boundary face are determined by a prefix sum
+ * beforehand, so that the boundary faces are processed in parallel batches
+ * while the numbering stays the same as the sequential algorithm.
  *
  * NOTE: all the metric, type and connnectivities data passed in this
  * subroutine are SHARED arrays rather than interior arrays.  The
@@ -216,342 +222,494 @@ std::tuple<size_t, size_t, size_t> StaticMesh::count_ghost() const
 /* NOLINTNEXTLINE(readability-function-cognitive-complexity) */
 inline void StaticMesh::fill_ghost()
 {
-    std::vector<int_type> gstndmap(nnode(), nnode());
+    size_t const ngcl = ngstcell();
 
-    // create ghost entities and buil connectivities and by the way mirror node
-    // coordinate.
-    int_type ignd = -1;
-    int_type igfc = -1;
-    for (int_type igcl = -1; igcl >= -static_cast<int_type>(ngstcell()); --igcl)
-    {
-        int_type const ibfc = m_bndfcs(-igcl - 1, 0);
-        int_type const icl = m_fccls(ibfc, 0);
-        // copy cell type and group.
-        m_cltpn(igcl) = m_cltpn(icl);
-        m_clgrp(igcl) = m_clgrp(icl);
-        // process node list in ghost cell.
-        for (size_t inl = 0; inl <= CLMND; ++inl) // copy nodes from current in-cell.
-        {
-            m_clnds(igcl, inl) = m_clnds(icl, inl);
-        }
-        for (size_t inl = 1; inl <= static_cast<size_t>(m_clnds(icl, 0)); ++inl)
+    // Count ghost nodes and faces for each boundary face, and turn the counts
+    // into the starting ghost indices.
+    std::vector<size_t> gndbeg(ngcl + 1, 0);
+    std::vector<size_t> gfcbeg(ngcl + 1, 0);
+    parallel_for(
+        0, ngcl, [&](size_t ibegin, size_t iend)
         {
-            int_type const ind = m_clnds(icl, inl);
-            // try to find the node in the boundary face.
-            bool mk_found = false;
-            for (size_t inf = 1; inf <= static_cast<size_t>(m_fcnds(ibfc, 0)); ++inf)
+            for (size_t ibnd = ibegin; ibnd < iend; ++ibnd)
             {
-                if (ind == m_fcnds(ibfc, inf))
+                int_type const ibfc = m_bndfcs(ibnd, 0);
+                int_type const icl = m_fccls(ibfc, 0);
+                int_type const * clnds = m_clnds.vptr(icl, 0);
+                int_type const * fcnds = m_fcnds.vptr(ibfc, 0);
+                size_t ngnd = 0;
+                for (int_type inl = 1; inl <= clnds[0]; ++inl)
                 {
-                    mk_found = true;
-                    break;
+                    if (std::find(fcnds + 1, fcnds + 1 + fcnds[0], clnds[inl]) == fcnds + 1 + fcnds[0])
+                    {
+                        ++ngnd;
+                    }
                 }
-            }
-            // if not found, it should be a ghost node.
-            if (!mk_found)
+                gndbeg[ibnd + 1] = ngnd;
+                gfcbeg[ibnd + 1] = static_cast<size_t>(m_clfcs(icl, 0)) - 1;
+            } },
+        GHOST_GRAIN);
+    for (size_t ibnd = 0; ibnd < ngcl; ++ibnd)
+    {
+        gndbeg[ibnd + 1] += gndbeg[ibnd];
+        gfcbeg[ibnd + 1] += gfcbeg[ibnd];
+    }
+
+    // create ghost entities and build connectivities.
+    parallel_for(
+        0, ngcl, [&](size_t ibegin, size_t iend)
+        {
+            // map from interior node to ghost node in the current cell.
+            std::array<std::pair<int_type, int_type>, CLMND> gstndmap; // NOLINT(cppcoreguidelines-pro-type-member-init)
+            for (size_t ibnd = ibegin; ibnd < iend; ++ibnd)
             {
-                gstndmap[ind] = ignd; // record map for face processing.
-                m_clnds(igcl, inl) = ignd; // save to clnds.
-                // mirror coordinate of ghost cell.
-                // NOTE: fcnml always points outward.
-                real_type dist = 0.0;
-                for (size_t idm = 0; idm < m_ndim; ++idm)
+                int_type const igcl = -1 - static_cast<int_type>(ibnd);
+                int_type ignd = -1 - static_cast<int_type>(gndbeg[ibnd]);
+                int_type igfc = -1 - static_cast<int_type>(gfcbeg[ibnd]);
+                int_type const ibfc = m_bndfcs(ibnd, 0);
+                int_type const icl = m_fccls(ibfc, 0);
+                size_t nmap = 0;
+                // copy cell type and group.
+                m_cltpn(igcl) = m_cltpn(icl);
+                m_clgrp(igcl) = m_clgrp(icl);
+                // process node list in ghost cell.
+                for (size_t inl = 0; inl <= CLMND; ++inl) // copy nodes from current in-cell.
+                {
+                    m_clnds(igcl, inl) = m_clnds(icl, inl);
+                }
+                for (size_t inl = 1; inl <= static_cast<size_t>(m_clnds(icl, 0)); ++inl)
+                {
+                    int_type const ind = m_clnds(icl, inl);
+                    // try to find the node in the boundary face.
+                    bool mk_found = false;
+                    for (size_t inf = 1; inf <= static_cast<size_t>(m_fcnds(ibfc, 0)); ++inf)
+                    {
+                        if (ind == m_fcnds(ibfc, inf))
+                        {
+                            mk_found = true;
+                            break;
+                        }
+                    }
+                    // if not found, it should be a ghost node.
+                    if (!mk_found)
+                    {
+                        gstndmap[nmap++] = std::make_pair(ind, ignd); // record map for face processing.
+                        m_clnds(igcl, inl) = ignd; // save to clnds.
+                        // decrement ghost node counter.
+                        ignd -= 1;
+                    }
+                }
+                // set the relating cell as ghost cell.
+                m_fccls(ibfc, 1) = igcl;
+                // process face list in ghost cell.
+                for (size_t ifl = 0; ifl <= CLMFC; ++ifl)
                 {
-                    dist += (m_fccnd(ibfc, idm) - m_ndcrd(ind, idm)) * m_fcnml(ibfc, idm);
+                    m_clfcs(igcl, ifl) = m_clfcs(icl, ifl); // copy in-face to ghost.
                 }
-                for (size_t idm = 0; idm < m_ndim; ++idm)
+                for (size_t ifl = 1; ifl <= static_cast<size_t>(m_clfcs(icl, 0)); ++ifl)
                 {
-                    m_ndcrd(ignd, idm) = m_ndcrd(ind, idm) + 2 * dist * m_fcnml(ibfc, idm);
+                    int_type const ifc = m_clfcs(icl, ifl); // the face to be processed.
+                    if (ifc == ibfc)
+                    {
+                        continue;
+                    } // if boundary face then skip.
+                    m_fctpn(igfc) = m_fctpn(ifc); // copy face type.
+                    m_fccls(igfc, 0) = igcl; // save to ghost fccls.
+                    m_clfcs(igcl, ifl) = igfc; // save to ghost clfcs.
+                    // face-to-node connectivity.
+                    for (size_t inf = 0; inf <= FCMND; ++inf)
+                    {
+                        m_fcnds(igfc, inf) = m_fcnds(ifc, inf);
+                    }
+                    for (size_t inf = 1; inf <= static_cast<size_t>(m_fcnds(igfc, 0)); ++inf)
+                    {
+                        int_type const ind = m_fcnds(igfc, inf);
+                        for (size_t imap = 0; imap < nmap; ++imap)
+                        {
+                            if (gstndmap[imap].first == ind)
+                            {
+                                m_fcnds(igfc, inf) = gstndmap[imap].second; // save gstnode to fcnds.
+                                break;
+                            }
+                        }
+                    }
+                    // decrement ghost face counter.
+                    igfc -= 1;
                 }
-                // decrement ghost node counter.
-                ignd -= 1;
-            }
-        }
-        // set the relating cell as ghost cell.
-        m_fccls(ibfc, 1) = igcl;
-        // process face list in ghost cell.
-        for (size_t ifl = 0; ifl <= CLMFC; ++ifl)
-        {
-            m_clfcs(igcl, ifl) = m_clfcs(icl, ifl); // copy in-face to ghost.
-        }
-        for (size_t ifl = 1; ifl <= static_cast<size_t>(m_clfcs(icl, 0)); ++ifl)
+            } },
+        GHOST_GRAIN);
+
+    mirror_ghost_node();
+    calc_ghost_metric();
+}
+
+/**
+ * Update the coordinates and the metric of the ghost entities after the
+ * interior nodes are moved, without rebuilding the ghost connectivity.  The
+ * interior metric is recalculated first when do_metric is true; the mirror
+ * transforms are taken from the boundary faces.
+ */
+void StaticMesh::refill_ghost(bool do_metric)
+{
+    check_padded("refill_ghost");
+    if (0 == m_ngstcell)
+    {
+        throw std::runtime_error("StaticMesh::refill_ghost: ghost data is not built; call build_ghost() first");
+    }
+    if (do_metric)
+    {
+        calc_metric();
+    }
+    mirror_ghost_node();
+    calc_ghost_metric();
+}
+
+/**
+ * Mirror the interior nodes of the cells next to the boundary faces to the
+ * ghost nodes.  The mirror transform of each boundary face (unit normal n and
+ * plane offset d = n dot fccnd) is computed once in a batch, and a node x is
+ * then mirrored to x + 2 (d - n dot x) n.
+ *
+ * NOTE: fcnml always points outward.
+ */
+void StaticMesh::mirror_ghost_node()
+{
+    size_t const ngcl = ngstcell();
+    size_t const ndim = m_ndim;
+
+    // precompute the mirror transform for each boundary face.
+    SimpleArray<real_type> mirror(std::vector<size_t>{ngcl, ndim + 1});
+    parallel_for(
+        0, ngcl, [&](size_t ibegin, size_t iend)
         {
-            int_type const ifc = m_clfcs(icl, ifl); // the face to be processed.
-            if (ifc == ibfc)
-            {
-                continue;
-            } // if boundary face then skip.
-            m_fctpn(igfc) = m_fctpn(ifc); // copy face type.
-            m_fccls(igfc, 0) = igcl; // save to ghost fccls.
-            m_clfcs(igcl, ifl) = igfc; // save to ghost clfcs.
-            // face-to-node connectivity.
-            for (size_t inf = 0; inf <= FCMND; ++inf)
+            for (size_t ibnd = ibegin; ibnd < iend; ++ibnd)
             {
-                m_fcnds(igfc, inf) = m_fcnds(ifc, inf);
-            }
-            for (size_t inf = 1; inf <= static_cast<size_t>(m_fcnds(igfc, 0)); ++inf)
-            {
-                int_type const ind = m_fcnds(igfc, inf);
-                if (gstndmap[ind] != static_cast<int_type>(nnode()))
+                int_type const ibfc = m_bndfcs(ibnd, 0);
+                real_type * mir = mirror.vptr(ibnd, 0);
+                real_type dist = 0.0;
+                for (size_t idm = 0; idm < ndim; ++idm)
                 {
-                    m_fcnds(igfc, inf) = gstndmap[ind]; // save gstnode to fcnds.
+                    mir[idm] = m_fcnml(ibfc, idm);
+                    dist += m_fccnd(ibfc, idm) * m_fcnml(ibfc, idm);
                 }
-            }
-            // decrement ghost face counter.
-            igfc -= 1;
-        }
-        // erase node map record.
-        for (size_t inl = 1; inl <= static_cast<size_t>(m_clnds(icl, 0)); ++inl)
+                mir[ndim] = dist;
+            } },
+        GHOST_GRAIN);
+
+    // mirror coordinate of ghost nodes.
+    parallel_for(
+        0, ngcl, [&](size_t ibegin, size_t iend)
         {
-            gstndmap[m_clnds(icl, inl)] = nnode();
-        }
-    }
+            for (size_t ibnd = ibegin; ibnd < iend; ++ibnd)
+            {
+                int_type const igcl = -1 - static_cast<int_type>(ibnd);
+                int_type const icl = m_fccls(m_bndfcs(ibnd, 0), 0);
+                real_type const * mir = mirror.vptr(ibnd, 0);
+                for (size_t inl = 1; inl <= static_cast<size_t>(m_clnds(icl, 0)); ++inl)
+                {
+                    int_type const ignd = m_clnds(igcl, inl);
+                    if (ignd >= 0)
+                    {
+                        continue; // node on the boundary face.
+                    }
+                    int_type const ind = m_clnds(icl, inl);
+                    real_type dist = mir[ndim];
+                    for (size_t idm = 0; idm < ndim; ++idm)
+                    {
+                        dist -= m_ndcrd(ind, idm) * mir[idm];
+                    }
+                    for (size_t idm = 0; idm < ndim; ++idm)
+                    {
+                        m_ndcrd(ignd, idm) = m_ndcrd(ind, idm) + 2 * dist * mir[idm];
+                    }
+                }
+            } },
+        GHOST_GRAIN);
+}
+
+/**
+ * Compute the metric of the ghost faces and cells.  Each loop runs in
+ * parallel over the ghost entities.
+ */
+/* NOLINTNEXTLINE(readability-function-cognitive-complexity) */
+void StaticMesh::calc_ghost_metric()
+{
+    size_t const ngfc = ngstface();
+    size_t const ngcl = ngstcell();
 
     // compute ghost face centroids.
     if (m_ndim == 2)
     {
         // 2D faces must be edge.
-        for (int_type ifc = -1; ifc >= -static_cast<int_type>(ngstface()); --ifc)
-        {
-            // point 1.
-            int_type ind = m_fcnds(ifc, 1);
-            m_fccnd(ifc, 0) = m_ndcrd(ind, 0);
-            m_fccnd(ifc, 1) = m_ndcrd(ind, 1);
-            // point 2.
-            ind = m_fcnds(ifc, 2);
-            m_fccnd(ifc, 0) += m_ndcrd(ind, 0);
-            m_fccnd(ifc, 1) += m_ndcrd(ind, 1);
-            // average.
-            m_fccnd(ifc, 0) /= 2;
-            m_fccnd(ifc, 1) /= 2;
-        }
+        parallel_for(
+            0, ngfc, [&](size_t ibegin, size_t iend)
+            {
+                for (int_type ifc = -1 - static_cast<int_type>(ibegin); ifc > -1 - static_cast<int_type>(iend); --ifc)
+                {
+                    // point 1.
+                    int_type ind = m_fcnds(ifc, 1);
+                    m_fccnd(ifc, 0) = m_ndcrd(ind, 0);
+                    m_fccnd(ifc, 1) = m_ndcrd(ind, 1);
+                    // point 2.
+                    ind = m_fcnds(ifc, 2);
+                    m_fccnd(ifc, 0) += m_ndcrd(ind, 0);
+                    m_fccnd(ifc, 1) += m_ndcrd(ind, 1);
+                    // average.
+                    m_fccnd(ifc, 0) /= 2;
+                    m_fccnd(ifc, 1) /= 2;
+                } },
+            GHOST_GRAIN);
     }
     else if (m_ndim == 3)
     {
-        std::array<std::array<real_type, 3>, FCMND + 2> cfd; // NOLINT(cppcoreguidelines-pro-type-member-init)
-        for (int_type ifc = -1; ifc >= -static_cast<int_type>(ngstface()); --ifc)
-        {
-            // find averaged point.
-            cfd[0][0] = cfd[0][1] = cfd[0][2] = 0.0;
-            size_t const nnd = m_fcnds(ifc, 0);
-            for (size_t inf = 1; inf <= nnd; ++inf)
+        parallel_for(
+            0, ngfc, [&](size_t ibegin, size_t iend)
             {
-                int_type const ind = m_fcnds(ifc, inf);
-                cfd[inf][0] = m_ndcrd(ind, 0);
-                cfd[0][0] += m_ndcrd(ind, 0);
-                cfd[inf][1] = m_ndcrd(ind, 1);
-                cfd[0][1] += m_ndcrd(ind, 1);
-                cfd[inf][2] = m_ndcrd(ind, 2);
-                cfd[0][2] += m_ndcrd(ind, 2);
-            }
-            cfd[nnd + 1][0] = cfd[1][0];
-            cfd[nnd + 1][1] = cfd[1][1];
-            cfd[nnd + 1][2] = cfd[1][2];
-            cfd[0][0] /= nnd;
-            cfd[0][1] /= nnd;
-            cfd[0][2] /= nnd;
-            // calculate area.
-            m_fccnd(ifc, 0) = m_fccnd(ifc, 1) = m_fccnd(ifc, 2) = 0.0;
-            real_type voc = 0.0;
-            for (size_t inf = 1; inf <= nnd; ++inf)
-            {
-                std::array<real_type, 3> crd; // NOLINT(cppcoreguidelines-pro-type-member-init)
-                crd[0] = (cfd[0][0] + cfd[inf][0] + cfd[inf + 1][0]) / 3;
-                crd[1] = (cfd[0][1] + cfd[inf][1] + cfd[inf + 1][1]) / 3;
-                crd[2] = (cfd[0][2] + cfd[inf][2] + cfd[inf + 1][2]) / 3;
-                real_type const du0 = cfd[inf][0] - cfd[0][0];
-                real_type const du1 = cfd[inf][1] - cfd[0][1];
-                real_type const du2 = cfd[inf][2] - cfd[0][2];
-                real_type const dv0 = cfd[inf + 1][0] - cfd[0][0];
-                real_type const dv1 = cfd[inf + 1][1] - cfd[0][1];
-                real_type const dv2 = cfd[inf + 1][2] - cfd[0][2];
-                real_type const dw0 = du1 * dv2 - du2 * dv1;
-                real_type const dw1 = du2 * dv0 - du0 * dv2;
-                real_type const dw2 = du0 * dv1 - du1 * dv0;
-                real_type const vob = std::sqrt(dw0 * dw0 + dw1 * dw1 + dw2 * dw2);
-                m_fccnd(ifc, 0) += crd[0] * vob;
-                m_fccnd(ifc, 1) += crd[1] * vob;
-                m_fccnd(ifc, 2) += crd[2] * vob;
-                voc += vob;
-            }
-            m_fccnd(ifc, 0) /= voc;
-            m_fccnd(ifc, 1) /= voc;
-            m_fccnd(ifc, 2) /= voc;
-        }
+                std::array<std::array<real_type, 3>, FCMND + 2> cfd; // NOLINT(cppcoreguidelines-pro-type-member-init)
+                for (int_type ifc = -1 - static_cast<int_type>(ibegin); ifc > -1 - static_cast<int_type>(iend); --ifc)
+                {
+                    // find averaged point.
+                    cfd[0][0] = cfd[0][1] = cfd[0][2] = 0.0;
+                    size_t const nnd = m_fcnds(ifc, 0);
+                    for (size_t inf = 1; inf <= nnd; ++inf)
+                    {
+                        int_type const ind = m_fcnds(ifc, inf);
+                        cfd[inf][0] = m_ndcrd(ind, 0);
+                        cfd[0][0] += m_ndcrd(ind, 0);
+                        cfd[inf][1] = m_ndcrd(ind, 1);
+                        cfd[0][1] += m_ndcrd(ind, 1);
+                        cfd[inf][2] = m_ndcrd(ind, 2);
+                        cfd[0][2] += m_ndcrd(ind, 2);
+                    }
+                    cfd[nnd + 1][0] = cfd[1][0];
+                    cfd[nnd + 1][1] = cfd[1][1];
+                    cfd[nnd + 1][2] = cfd[1][2];
+                    cfd[0][0] /= nnd;
+                    cfd[0][1] /= nnd;
+                    cfd[0][2] /= nnd;
+                    // calculate area.
+                    m_fccnd(ifc, 0) = m_fccnd(ifc, 1) = m_fccnd(ifc, 2) = 0.0;
+                    real_type voc = 0.0;
+                    for (size_t inf = 1; inf <= nnd; ++inf)
+                    {
+                        std::array<real_type, 3> crd; // NOLINT(cppcoreguidelines-pro-type-member-init)
+                        crd[0] = (cfd[0][0] + cfd[inf][0] + cfd[inf + 1][0]) / 3;
+                        crd[1] = (cfd[0][1] + cfd[inf][1] + cfd[inf + 1][1]) / 3;
+                        crd[2] = (cfd[0][2] + cfd[inf][2] + cfd[inf + 1][2]) / 3;
+                        real_type const du0 = cfd[inf][0] - cfd[0][0];
+                        real_type const du1 = cfd[inf][1] - cfd[0][1];
+                        real_type const du2 = cfd[inf][2] - cfd[0][2];
+                        real_type const dv0 = cfd[inf + 1][0] - cfd[0][0];
+                        real_type const dv1 = cfd[inf + 1][1] - cfd[0][1];
+                        real_type const dv2 = cfd[inf + 1][2] - cfd[0][2];
+                        real_type const dw0 = du1 * dv2 - du2 * dv1;
+                        real_type const dw1 = du2 * dv0 - du0 * dv2;
+                        real_type const dw2 = du0 * dv1 - du1 * dv0;
+                        real_type const vob = std::sqrt(dw0 * dw0 + dw1 * dw1 + dw2 * dw2);
+                        m_fccnd(ifc, 0) += crd[0] * vob;
+                        m_fccnd(ifc, 1) += crd[1] * vob;
+                        m_fccnd(ifc, 2) += crd[2] * vob;
+                        voc += vob;
+                    }
+                    m_fccnd(ifc, 0) /= voc;
+                    m_fccnd(ifc, 1) /= voc;
+                    m_fccnd(ifc, 2) /= voc;
+                } },
+            GHOST_GRAIN);
     }
 
     // compute ghost face normal vector and area.
     if (m_ndim == 2)
     {
-        for (int_type ifc = -1; ifc >= -static_cast<int_type>(ngstface()); --ifc)
-        {
-            // 2D faces are always lines.
-            int_type const ind = m_fcnds(ifc, 1);
-            int_type const jnd = m_fcnds(ifc, 2);
-            // face normal.
-            m_fcnml(ifc, 0) = m_ndcrd(jnd, 1) - m_ndcrd(ind, 1);
-            m_fcnml(ifc, 1) = m_ndcrd(ind, 0) - m_ndcrd(jnd, 0);
-            // face ara.
-            m_fcara(ifc) = std::sqrt(m_fcnml(ifc, 0) * m_fcnml(ifc, 0) + m_fcnml(ifc, 1) * m_fcnml(ifc, 1));
-            // normalize face normal.
-            m_fcnml(ifc, 0) /= m_fcara(ifc);
-            m_fcnml(ifc, 1) /= m_fcara(ifc);
-        }
+        parallel_for(
+            0, ngfc, [&](size_t ibegin, size_t iend)
+            {
+                for (int_type ifc = -1 - static_cast<int_type>(ibegin); ifc > -1 - static_cast<int_type>(iend); --ifc)
+                {
+                    // 2D faces are always lines.
+                    int_type const ind = m_fcnds(ifc, 1);
+                    int_type const jnd = m_fcnds(ifc, 2);
+                    // face normal.
+                    m_fcnml(ifc, 0) = m_ndcrd(jnd, 1) - m_ndcrd(ind, 1);
+                    m_fcnml(ifc, 1) = m_ndcrd(ind, 0) - m_ndcrd(jnd, 0);
+                    // face ara.
+                    m_fcara(ifc) = std::sqrt(m_fcnml(ifc, 0) * m_fcnml(ifc, 0) + m_fcnml(ifc, 1) * m_fcnml(ifc, 1));
+                    // normalize face normal.
+                    m_fcnml(ifc, 0) /= m_fcara(ifc);
+                    m_fcnml(ifc, 1) /= m_fcara(ifc);
+                } },
+            GHOST_GRAIN);
     }
     else if (m_ndim == 3)
     {
-        std::array<std::array<real_type, 3>, FCMND> radvec; // NOLINT(cppcoreguidelines-pro-type-member-init)
-        for (int_type ifc = -1; ifc >= -static_cast<int_type>(ngstface()); --ifc)
-        {
-            // compute radial vector.
-            size_t const nnd = m_fcnds(ifc);
-            for (size_t inf = 0; inf < nnd; ++inf)
-            {
-                int_type const ind = m_fcnds(ifc, inf + 1);
-                radvec[inf][0] = m_ndcrd(ind, 0) - m_fccnd(ifc, 0);
-                radvec[inf][1] = m_ndcrd(ind, 1) - m_fccnd(ifc, 1);
-                radvec[inf][2] = m_ndcrd(ind, 2) - m_fccnd(ifc, 2);
-            }
-            // compute cross product.
-            m_fcnml(ifc, 0) = radvec[nnd - 1][1] * radvec[0][2] - radvec[nnd - 1][2] * radvec[0][1];
-            m_fcnml(ifc, 1) = radvec[nnd - 1][2] * radvec[0][0] - radvec[nnd - 1][0] * radvec[0][2];
-            m_fcnml(ifc, 2) = radvec[nnd - 1][0] * radvec[0][1] - radvec[nnd - 1][1] * radvec[0][0];
-            for (size_t ind = 1; ind < nnd; ++ind)
+        parallel_for(
+            0, ngfc, [&](size_t ibegin, size_t iend)
             {
-                m_fcnml(ifc, 0) += radvec[ind - 1][1] * radvec[ind][2] - radvec[ind - 1][2] * radvec[ind][1];
-                m_fcnml(ifc, 1) += radvec[ind - 1][2] * radvec[ind][0] - radvec[ind - 1][0] * radvec[ind][2];
-                m_fcnml(ifc, 2) += radvec[ind - 1][0] * radvec[ind][1] - radvec[ind - 1][1] * radvec[ind][0];
-            }
-            // compute face area.
-            m_fcara(ifc, 0) = std::sqrt(
-                m_fcnml(ifc, 0) * m_fcnml(ifc, 0) + m_fcnml(ifc, 1) * m_fcnml(ifc, 1) + m_fcnml(ifc, 2) * m_fcnml(ifc, 2));
-            // normalize normal vector.
-            m_fcnml(ifc, 0) /= m_fcnml(ifc);
-            m_fcnml(ifc, 1) /= m_fcnml(ifc);
-            m_fcnml(ifc, 2) /= m_fcnml(ifc);
-            // get real face area.
-            m_fcnml(ifc) /= 2.0;
-        }
+                std::array<std::array<real_type, 3>, FCMND> radvec; // NOLINT(cppcoreguidelines-pro-type-member-init)
+                for (int_type ifc = -1 - static_cast<int_type>(ibegin); ifc > -1 - static_cast<int_type>(iend); --ifc)
+                {
+                    // compute radial vector.
+                    size_t const nnd = m_fcnds(ifc, 0);
+                    for (size_t inf = 0; inf < nnd; ++inf)
+                    {
+                        int_type const ind = m_fcnds(ifc, inf + 1);
+                        radvec[inf][0] = m_ndcrd(ind, 0) - m_fccnd(ifc, 0);
+                        radvec[inf][1] = m_ndcrd(ind, 1) - m_fccnd(ifc, 1);
+                        radvec[inf][2] = m_ndcrd(ind, 2) - m_fccnd(ifc, 2);
+                    }
+                    // compute cross product.
+                    m_fcnml(ifc, 0) = radvec[nnd - 1][1] * radvec[0][2] - radvec[nnd - 1][2] * radvec[0][1];
+                    m_fcnml(ifc, 1) = radvec[nnd - 1][2] * radvec[0][0] - radvec[nnd - 1][0] * radvec[0][2];
+                    m_fcnml(ifc, 2) = radvec[nnd - 1][0] * radvec[0][1] - radvec[nnd - 1][1] * radvec[0][0];
+                    for (size_t ind = 1; ind < nnd; ++ind)
+                    {
+                        m_fcnml(ifc, 0) += radvec[ind - 1][1] * radvec[ind][2] - radvec[ind - 1][2] * radvec[ind][1];
+                        m_fcnml(ifc, 1) += radvec[ind - 1][2] * radvec[ind][0] - radvec[ind - 1][0] * radvec[ind][2];
+                        m_fcnml(ifc, 2) += radvec[ind - 1][0] * radvec[ind][1] - radvec[ind - 1][1] * radvec[ind][0];
+                    }
+                    // compute face area.
+                    m_fcara(ifc) = std::sqrt(
+                        m_fcnml(ifc, 0) * m_fcnml(ifc, 0) + m_fcnml(ifc, 1) * m_fcnml(ifc, 1) + m_fcnml(ifc, 2) * m_fcnml(ifc, 2));
+                    // normalize normal vector.
+                    m_fcnml(ifc, 0) /= m_fcara(ifc);
+                    m_fcnml(ifc, 1) /= m_fcara(ifc);
+                    m_fcnml(ifc, 2) /= m_fcara(ifc);
+                    // get real face area.
+                    m_fcara(ifc) /= 2.0;
+                } },
+            GHOST_GRAIN);
     }
 
     // compute cell centroids.
     if (m_ndim == 2)
     {
-        for (int_type icl = -1; icl >= -static_cast<int_type>(ngstcell()); --icl)
-        {
-            // averaged point.
-            std::array<real_type, 2> crd{0.0, 0.0};
-            crd[0] = crd[1] = 0.0;
-            size_t const nnd = m_clnds(icl, 0);
-            for (size_t inl = 1; inl <= nnd; ++inl)
+        parallel_for(
+            0, ngcl, [&](size_t ibegin, size_t iend)
             {
-                int_type const ind = m_clnds(icl, inl);
-                crd[0] += m_ndcrd(ind, 0);
-                crd[1] += m_ndcrd(ind, 1);
-            }
-            crd[0] /= nnd;
-            crd[1] /= nnd;
-            // weight centroid.
-            m_clcnd(icl, 0) = m_clcnd(icl, 1) = 0.0;
-            real_type voc = 0.0;
-            size_t const nfc = m_clfcs(icl, 0);
-            for (size_t ifl = 1; ifl <= nfc; ++ifl)
-            {
-                int_type const ifc = m_clfcs(icl, ifl);
-                real_type const du0 = crd[0] - m_fccnd(ifc, 0);
-                real_type const du1 = crd[1] - m_fccnd(ifc, 1);
-                real_type const vob = std::abs(du0 * m_fcnml(ifc, 0) + du1 * m_fcnml(ifc, 1)) * m_fcara(ifc);
-                voc += vob;
-                real_type const dv0 = m_fccnd(ifc, 0) + du0 / 3;
-                real_type const dv1 = m_fccnd(ifc, 1) + du1 / 3;
-                m_clcnd(icl, 0) += dv0 * vob;
-                m_clcnd(icl, 1) += dv1 * vob;
-            }
-            m_clcnd(icl, 0) /= voc;
-            m_clcnd(icl, 1) /= voc;
-        }
+                for (int_type icl = -1 - static_cast<int_type>(ibegin); icl > -1 - static_cast<int_type>(iend); --icl)
+                {
+                    // averaged point.
+                    std::array<real_type, 2> crd{0.0, 0.0};
+                    size_t const nnd = m_clnds(icl, 0);
+                    for (size_t inl = 1; inl <= nnd; ++inl)
+                    {
+                        int_type const ind = m_clnds(icl, inl);
+                        crd[0] += m_ndcrd(ind, 0);
+                        crd[1] += m_ndcrd(ind, 1);
+                    }
+                    crd[0] /= nnd;
+                    crd[1] /= nnd;
+                    // weight centroid.
+                    m_clcnd(icl, 0) = m_clcnd(icl, 1) = 0.0;
+                    real_type voc = 0.0;
+                    size_t const nfc = m_clfcs(icl, 0);
+                    for (size_t ifl = 1; ifl <= nfc; ++ifl)
+                    {
+                        int_type const ifc = m_clfcs(icl, ifl);
+                        real_type const du0 = crd[0] - m_fccnd(ifc, 0);
+                        real_type const du1 = crd[1] - m_fccnd(ifc, 1);
+                        real_type const vob = std::abs(du0 * m_fcnml(ifc, 0) + du1 * m_fcnml(ifc, 1)) * m_fcara(ifc);
+                        voc += vob;
+                        real_type const dv0 = m_fccnd(ifc, 0) + du0 / 3;
+                        real_type const dv1 = m_fccnd(ifc, 1) + du1 / 3;
+                        m_clcnd(icl, 0) += dv0 * vob;
+                        m_clcnd(icl, 1) += dv1 * vob;
+                    }
+                    m_clcnd(icl, 0) /= voc;
+                    m_clcnd(icl, 1) /= voc;
+                } },
+            GHOST_GRAIN);
     }
     else if (m_ndim == 3)
     {
-        for (int_type icl = -1; icl >= -static_cast<int_type>(ngstcell()); --icl)
-        {
-            // averaged point.
-            std::array<real_type, 3> crd{0.0, 0.0, 0.0};
-            size_t const nnd = m_clnds(icl, 0);
-            for (size_t inl = 1; inl <= nnd; ++inl)
-            {
-                int_type const ind = m_clnds(icl, inl);
-                crd[0] += m_ndcrd(ind, 0);
-                crd[1] += m_ndcrd(ind, 1);
-                crd[2] += m_ndcrd(ind, 2);
-            }
-            crd[0] /= nnd;
-            crd[1] /= nnd;
-            crd[2] /= nnd;
-            // weight centroid.
-            m_clcnd(icl, 0) = m_clcnd(icl, 1) = m_clcnd(icl, 2) = 0.0;
-            real_type voc = 0.0;
-            size_t const nfc = m_clfcs(icl, 0);
-            for (size_t ifl = 1; ifl <= nfc; ++ifl)
+        parallel_for(
+            0, ngcl, [&](size_t ibegin, size_t iend)
             {
-                int_type const ifc = m_clfcs(icl, ifl);
-                real_type const du0 = crd[0] - m_fccnd(ifc, 0);
-                real_type const du1 = crd[1] - m_fccnd(ifc, 1);
-                real_type const du2 = crd[2] - m_fccnd(ifc, 2);
-                // clang-format off
-                real_type const vob = std::fabs
-                (
-                    (du0*m_fcnml(ifc, 0) + du1*m_fcnml(ifc, 1) + du2*m_fcnml(ifc, 2))
-                  * m_fcara(ifc)
-                );
-                // clang-format on
-                voc += vob;
-                real_type const dv0 = m_fccnd(ifc, 0) + du0 / 4;
-                real_type const dv1 = m_fccnd(ifc, 1) + du1 / 4;
-                real_type const dv2 = m_fccnd(ifc, 2) + du2 / 4;
-                m_clcnd(icl, 0) += dv0 * vob;
-                m_clcnd(icl, 1) += dv1 * vob;
-                m_clcnd(icl, 2) += dv2 * vob;
-            }
-            m_clcnd(icl, 0) /= voc;
-            m_clcnd(icl, 1) /= voc;
-            m_clcnd(icl, 2) /= voc;
-        }
+                for (int_type icl = -1 - static_cast<int_type>(ibegin); icl > -1 - static_cast<int_type>(iend); --icl)
+                {
+                    // averaged point.
+                    std::array<real_type, 3> crd{0.0, 0.0, 0.0};
+                    size_t const nnd = m_clnds(icl, 0);
+                    for (size_t inl = 1; inl <= nnd; ++inl)
+                    {
+                        int_type const ind = m_clnds(icl, inl);
+                        crd[0] += m_ndcrd(ind, 0);
+                        crd[1] += m_ndcrd(ind, 1);
+                        crd[2] += m_ndcrd(ind, 2);
+                    }
+                    crd[0] /= nnd;
+                    crd[1] /= nnd;
+                    crd[2] /= nnd;
+                    // weight centroid.
+                    m_clcnd(icl, 0) = m_clcnd(icl, 1) = m_clcnd(icl, 2) = 0.0;
+                    real_type voc = 0.0;
+                    size_t const nfc = m_clfcs(icl, 0);
+                    for (size_t ifl = 1; ifl <= nfc; ++ifl)
+                    {
+                        int_type const ifc = m_clfcs(icl, ifl);
+                        real_type const du0 = crd[0] - m_fccnd(ifc, 0);
+                        real_type const du1 = crd[1] - m_fccnd(ifc, 1);
+                        real_type const du2 = crd[2] - m_fccnd(ifc, 2);
+                        // clang-format off
+                        real_type const vob = std::fabs
+                        (
+                            (du0*m_fcnml(ifc, 0) + du1*m_fcnml(ifc, 1) + du2*m_fcnml(ifc, 2))
+                          * m_fcara(ifc)
+                        );
+                        // clang-format on
+                        voc += vob;
+                        real_type const dv0 = m_fccnd(ifc, 0) + du0 / 4;
+                        real_type const dv1 = m_fccnd(ifc, 1) + du1 / 4;
+                        real_type const dv2 = m_fccnd(ifc, 2) + du2 / 4;
+                        m_clcnd(icl, 0) += dv0 * vob;
+                        m_clcnd(icl, 1) += dv1 * vob;
+                        m_clcnd(icl, 2) += dv2 * vob;
+                    }
+                    m_clcnd(icl, 0) /= voc;
+                    m_clcnd(icl, 1) /= voc;
+                    m_clcnd(icl, 2) /= voc;
+                } },
+            GHOST_GRAIN);
     }
 
-    // compute volume for each ghost cell.
-    for (int_type icl = -1; icl >= -static_cast<int_type>(ngstcell()); --icl)
-    {
-        m_clvol(icl) = 0.0;
-        for (size_t it = 1; it <= static_cast<size_t>(m_clfcs(icl, 0)); ++it)
+    // compute volume for each ghost cell.  A ghost face belongs to only one
+    // ghost cell, so flipping its normal does not race.
+    parallel_for(
+        0, ngcl, [&](size_t ibegin, size_t iend)
         {
-            int_type const ifc = m_clfcs(icl, it);
-            // calculate volume associated with each face.
-            real_type vol = 0.0;
-            for (size_t idm = 0; idm < m_ndim; ++idm)
+            for (int_type icl = -1 - static_cast<int_type>(ibegin); icl > -1 - static_cast<int_type>(iend); --icl)
             {
-                vol += (m_fccnd(ifc, idm) - m_clcnd(icl, idm)) * m_fcnml(ifc, idm);
-            }
-            vol *= m_fcara(ifc);
-            // check if need to reorder node definition and connecting cell
-            // list for the face.
-            if (vol < 0.0)
-            {
-                if (m_fccls(ifc, 0) == icl)
+                m_clvol(icl) = 0.0;
+                for (size_t it = 1; it <= static_cast<size_t>(m_clfcs(icl, 0)); ++it)
                 {
+                    int_type const ifc = m_clfcs(icl, it);
+                    // calculate volume associated with each face.
+                    real_type vol = 0.0;
                     for (size_t idm = 0; idm < m_ndim; ++idm)
                     {
-                        m_fcnml(ifc, idm) = -m_fcnml(ifc, idm);
+                        vol += (m_fccnd(ifc, idm) - m_clcnd(icl, idm)) * m_fcnml(ifc, idm);
+                    }
+                    vol *= m_fcara(ifc);
+                    // check if need to reorder node definition and connecting cell
+                    // list for the face.
+                    if (vol < 0.0)
+                    {
+                        if (m_fccls(ifc, 0) == icl)
+                        {
+                            for (size_t idm = 0; idm < m_ndim; ++idm)
+                            {
+                                m_fcnml(ifc, idm) = -m_fcnml(ifc, idm);
+                            }
+                        }
+                        vol = -vol;
                     }
+                    // accumulate the volume for the cell.
+                    m_clvol(icl) += vol;
                 }
-                vol = -vol;
-            }
-            // accumulate the volume for the cell.
-            m_clvol(icl) += vol;
-        }
-        // calculate the real volume.
-        m_clvol(icl) /= m_ndim;
-    }
+                // calculate the real volume.
+                m_clvol(icl) /= m_ndim;
+            } },
+        GHOST_GRAIN);
 }
 
 } /* end namespace modmesh */
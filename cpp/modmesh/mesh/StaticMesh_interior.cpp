@@ -28,6 +28,7 @@
 
 #include <modmesh/mesh/StaticMesh.hpp>
 
+#include <numeric>
 #include <set>
 
 namespace modmesh
@@ -343,7 +344,7 @@ struct FaceBuilder
     std::vector<uint_type> dedupmap{};
 
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-    FaceBuilder(size_t nnode_in, SimpleArray<int_type> const & cltpn_in, SimpleArray<int_type> const & clnds_in)
+    FaceBuilder(size_t nnode_in, SimpleArray<int_type> const & cltpn_in, SimpleArray<int_type> const & clnds_in, CompressedConnectivity<int_type> const & tpcls)
         : nnode(nnode_in)
         , nface(count_mface(cltpn_in))
         , mface(nface)
@@ -355,7 +356,7 @@ struct FaceBuilder
         , fccls(small_vector<size_t>{mface, FCREL}, -1)
         , dedupmap(mface)
     {
-        populate();
+        populate(tpcls);
         make_dedupmap();
         remap_face();
     }
@@ -371,41 +372,59 @@ struct FaceBuilder
         // clang-format on
     }
 
-    void populate()
+    /// The number of faces add_cell<ID>() extracts from a cell.
+    template <uint8_t ID>
+    static constexpr size_t cell_nface()
     {
-        int_type ifc = 0;
-        for (int icl = 0; icl < static_cast<int_type>(cltpn.nbody()); ++icl)
+        if constexpr (CellType::POINT == ID) { return 1; }
+        else { return CellTypeTraits<ID>::nface; }
+    }
+
+    template <uint8_t ID>
+    size_t add_cell(int_type icl, int_type ifc)
+    {
+        if constexpr (CellType::POINT == ID) { return add_point(icl, ifc); }
+        else if constexpr (CellType::LINE == ID) { return add_line(icl, ifc); }
+        else if constexpr (CellType::QUADRILATERAL == ID) { return add_quadrilateral(icl, ifc); }
+        else if constexpr (CellType::TRIANGLE == ID) { return add_triangle(icl, ifc); }
+        else if constexpr (CellType::HEXAHEDRON == ID) { return add_hexahedron(icl, ifc); }
+        else if constexpr (CellType::TETRAHEDRON == ID) { return add_tetrahedron(icl, ifc); }
+        else if constexpr (CellType::PRISM == ID) { return add_prism(icl, ifc); }
+        else if constexpr (CellType::PYRAMID == ID) { return add_pyramid(icl, ifc); }
+        else { return 0; }
+    }
+
+    /**
+     * Extract the faces of the cells type by type, so that each group calls
+     * the add function of its type without a per-cell switch.  The first face
+     * of a cell is the running sum of the face counts in cell order, and the
+     * face numbering is the same as visiting the cells in order.  The face
+     * counts are filled group by group, and a cell of an unknown type is in
+     * no group and has no face.
+     */
+    void populate(CompressedConnectivity<int_type> const & tpcls)
+    {
+        size_t const ncell = cltpn.nbody();
+        // clfco[icl + 1] holds the face count of cell icl before the sum.
+        std::vector<int_type> clfco(ncell + 1, 0);
+        auto count = [&clfco](auto traits, int_type const * begin, int_type const * end)
         {
-            switch (cltpn(icl))
+            constexpr auto nfc = static_cast<int_type>(cell_nface<decltype(traits)::id>());
+            for (int_type const * it = begin; it != end; ++it)
             {
-            case CellType::POINT:
-                ifc += static_cast<int_type>(add_point(icl, ifc));
-                break;
-            case CellType::LINE:
-                ifc += static_cast<int_type>(add_line(icl, ifc));
-                break;
-            case CellType::QUADRILATERAL:
-                ifc += static_cast<int_type>(add_quadrilateral(icl, ifc));
-                break;
-            case CellType::TRIANGLE:
-                ifc += static_cast<int_type>(add_triangle(icl, ifc));
-                break;
-            case CellType::HEXAHEDRON:
-                ifc += static_cast<int_type>(add_hexahedron(icl, ifc));
-                break;
-            case CellType::TETRAHEDRON:
-                ifc += static_cast<int_type>(add_tetrahedron(icl, ifc));
-                break;
-            case CellType::PRISM:
-                ifc += static_cast<int_type>(add_prism(icl, ifc));
-                break;
-            case CellType::PYRAMID:
-                ifc += static_cast<int_type>(add_pyramid(icl, ifc));
-                break;
-            default:
-                break;
+                clfco[*it + 1] = nfc;
             }
-        }
+        };
+        detail::for_each_cell_type(tpcls, count, std::make_integer_sequence<uint8_t, CellType::NTYPE + 1>());
+        std::partial_sum(clfco.begin(), clfco.end(), clfco.begin());
+        auto add = [this, &clfco](auto traits, int_type const * begin, int_type const * end)
+        {
+            for (int_type const * it = begin; it != end; ++it)
+            {
+                this->template add_cell<decltype(traits)::id>(*it, clfco[*it]);
+            }
+        };
+        detail::for_each_cell_type(tpcls, add, std::make_integer_sequence<uint8_t, CellType::NTYPE + 1>());
     }
 
     SimpleArray<int_type> make_ndfcs()
@@ -565,6 +584,115 @@ struct FaceBuilder
 
 }; /* end struct FaceBuilder */
 
+/**
+ * Calculate the centroids of the cells in [begin, end), which are all of the
+ * type T.  The numbers of nodes and faces are compile-time constants when the
+ * type matches the dimension of the mesh, and are read from clnds and clfcs
+ * otherwise.
+ */
+template <size_t NDIM, typename T>
+void calc_cell_centroid(StaticMesh & mh, StaticMesh::int_type const * begin, StaticMesh::int_type const * end)
+{
+    using int_type = StaticMesh::int_type;
+    using real_type = StaticMesh::real_type;
+    constexpr bool fixed = NDIM == T::ndim;
+
+    for (int_type const * it = begin ; it != end ; ++it)
+    {
+        int_type const icl = *it;
+        // averaged point.
+        std::array<real_type, NDIM> crd; // NOLINT(cppcoreguidelines-pro-type-member-init)
+        crd.fill(0.0);
+        size_t const nnd = fixed ? T::nnode : mh.clnds(icl, 0);
+        for (size_t inc = 1 ; inc <= nnd ; ++inc)
+        {
+            int_type const ind = mh.clnds(icl, inc);
+            for (size_t idm = 0 ; idm < NDIM ; ++idm)
+            {
+                crd[idm] += mh.ndcrd(ind, idm);
+            }
+        }
+        for (size_t idm = 0 ; idm < NDIM ; ++idm)
+        {
+            crd[idm] /= nnd;
+        }
+        // weight centroid.
+        real_type voc = 0.0;
+        std::array<real_type, NDIM> cnd; // NOLINT(cppcoreguidelines-pro-type-member-init)
+        cnd.fill(0.0);
+        size_t const nfc = fixed ? T::nface : mh.clfcs(icl, 0);
+        for (size_t ifl = 1 ; ifl <= nfc ; ++ifl)
+        {
+            int_type const ifc = mh.clfcs(icl, ifl);
+            std::array<real_type, NDIM> du; // NOLINT(cppcoreguidelines-pro-type-member-init)
+            real_type dot = 0.0;
+            for (size_t idm = 0 ; idm < NDIM ; ++idm)
+            {
+                du[idm] = crd[idm] - mh.fccnd(ifc, idm);
+                dot += du[idm] * mh.fcnml(ifc, idm);
+            }
+            real_type const vob = fabs(dot) * mh.fcara(ifc);
+            voc += vob;
+            for (size_t idm = 0 ; idm < NDIM ; ++idm)
+            {
+                cnd[idm] += (mh.fccnd(ifc, idm) + du[idm]/(NDIM+1)) * vob;
+            }
+        }
+        for (size_t idm = 0 ; idm < NDIM ; ++idm)
+        {
+            mh.clcnd(icl, idm) = cnd[idm] / voc;
+        }
+    }
+}
+
+/**
+ * Calculate the volumes of the cells in [begin, end), which are all of the
+ * type T, and flip the faces whose normal does not point outward from their
+ * first cell with reorder(ifc).  The number of faces is a compile-time
+ * constant when the type matches the dimension of the mesh.
+ */
+template <size_t NDIM, typename T, typename F>
+void calc_cell_volume(StaticMesh & mh, StaticMesh::int_type const * begin, StaticMesh::int_type const * end, F && reorder)
+{
+    using int_type = StaticMesh::int_type;
+    using real_type = StaticMesh::real_type;
+    constexpr bool fixed = NDIM == T::ndim;
+
+    for (int_type const * it = begin ; it != end ; ++it)
+    {
+        int_type const icl = *it;
+        real_type clvol = 0.0;
+        size_t const nfc = fixed ? T::nface : mh.clfcs(icl, 0);
+        for (size_t ifl = 1 ; ifl <= nfc ; ++ifl)
+        {
+            int_type const ifc = mh.clfcs(icl, ifl);
+            // calculate volume associated with each face.
+            real_type vol = 0.0;
+            for (size_t idm = 0 ; idm < NDIM ; ++idm)
+            {
+                vol += (mh.fccnd(ifc, idm) - mh.clcnd(icl, idm)) * mh.fcnml(ifc, idm);
+            }
+            vol *= mh.fcara(ifc);
+            // check if need to reorder node definition and connecting cell
+            // list for the face.
+            int_type const this_fcl = mh.fccls(ifc, 0);
+            if (vol < 0.0)
+            {
+                if (this_fcl == icl) { reorder(ifc); }
+                vol = -vol;
+            }
+            else
+            {
+                if (this_fcl != icl) { reorder(ifc); }
+            }
+            // accumulate the volume for the cell.
+            clvol += vol;
+        }
+        // calculate the real volume.
+        mh.clvol(icl) = clvol / NDIM;
+    }
+}
+
 } /* end namespace detail */
 
 /**
@@ -573,7 +701,8 @@ struct FaceBuilder
  */
 void StaticMesh::build_faces_from_cells()
 {
-    detail::FaceBuilder<number_base> fb(m_nnode, m_cltpn, m_clnds);
+    invalidate_adjacency();
+    detail::FaceBuilder<number_base> fb(m_nnode, m_cltpn, m_clnds, build_type_cells());
     m_nface = static_cast<uint_type>(fb.nface);
 
     // recreate member tables.
@@ -588,6 +717,7 @@ void StaticMesh::build_faces_from_cells()
 
 void StaticMesh::build_edge()
 {
+    check_padded("build_edge");
     using etype = std::pair<int32_t, int32_t>;
     std::set<etype> known_edges;
     std::vector<etype> edges;
@@ -786,159 +916,107 @@ void StaticMesh::calc_metric()
         }
     }
 
-    // compute cell centers.
-    if (m_ndim == 2)
-    {
-        for (size_t icl = 0 ; icl < ncell() ; ++icl)
-        {
-            if ((use_incenter()) && (CellType::TRIANGLE == m_cltpn(icl)))
-            {
-                real_type voc = 0.0;
-                {
-                    int_type const ind = m_clnds(icl, 1);
-                    real_type const vob = m_fcara(m_clfcs(icl, 2));
-                    voc += vob;
-                    m_clcnd(icl, 0) = vob*m_ndcrd(ind, 0);
-                    m_clcnd(icl, 1) = vob*m_ndcrd(ind, 1);
-                }
-                {
-                    int_type const ind = m_clnds(icl, 2);
-                    real_type const vob = m_fcara(m_clfcs(icl, 3));
-                    voc += vob;
-                    m_clcnd(icl, 0) += vob*m_ndcrd(ind, 0);
-                    m_clcnd(icl, 1) += vob*m_ndcrd(ind, 1);
-                }
-                {
-                    int_type const ind = m_clnds(icl, 3);
-                    real_type const vob = m_fcara(m_clfcs(icl, 1));
-                    voc += vob;
-                    m_clcnd(icl, 0) += vob*m_ndcrd(ind, 0);
-                    m_clcnd(icl, 1) += vob*m_ndcrd(ind, 1);
-                }
-                m_clcnd(icl, 0) /= voc;
-                m_clcnd(icl, 1) /= voc;
-            }
-            else // centroids.
-            {
-                // averaged point.
-                std::array<real_type, 2> crd; // NOLINT(cppcoreguidelines-pro-type-member-init)
-                crd[0] = crd[1] = 0.0;
-                size_t const nnd = m_clnds(icl, 0);
-                for (size_t inc = 1 ; inc <= nnd ; ++inc)
-                {
-                    int_type const ind = m_clnds(icl, inc);
-                    crd[0] += m_ndcrd(ind, 0);
-                    crd[1] += m_ndcrd(ind, 1);
-                }
-                crd[0] /= nnd;
-                crd[1] /= nnd;
-                // weight centroid.
-                real_type voc = 0.0;
-                m_clcnd(icl, 0) = m_clcnd(icl, 1) = 0.0;
-                size_t const nfc = m_clfcs(icl, 0);
-                for (size_t ifl = 1 ; ifl <= nfc ; ++ifl)
-                {
-                    int_type const ifc = m_clfcs(icl, ifl);
-                    real_type const du0 = crd[0] - m_fccnd(ifc, 0);
-                    real_type const du1 = crd[1] - m_fccnd(ifc, 1);
-                    real_type const vob = fabs(du0*m_fcnml(ifc, 0) + du1*m_fcnml(ifc, 1)) * m_fcara(ifc);
-                    voc += vob;
-                    real_type const dv0 = m_fccnd(ifc, 0) + du0/3;
-                    real_type const dv1 = m_fccnd(ifc, 1) + du1/3;
-                    m_clcnd(icl, 0) += dv0 * vob;
-                    m_clcnd(icl, 1) += dv1 * vob;
-                }
-                m_clcnd(icl, 0) /= voc;
-                m_clcnd(icl, 1) /= voc;
-            }
-        }
-    }
-    else if (m_ndim == 3)
+    // compute cell centers.  The cells are visited by type, so that the
+    // kernels are instantiated with the compile-time numbers of nodes and
+    // faces.
+    if (m_ndim == 2 || m_ndim == 3)
     {
-        for (size_t icl = 0 ; icl < ncell() ; ++icl)
-        {
-            if ((use_incenter()) && (CellType::TETRAHEDRON == m_cltpn(icl)))
+        for_each_cell_type(
+            [this](auto traits, int_type const * begin, int_type const * end)
             {
-                real_type voc = 0.0;
+                using traits_type = decltype(traits);
+                if (m_ndim == 2)
                 {
-                    int_type const ind = m_clnds(icl, 1);
-                    real_type const vob = m_fcara(m_clfcs(icl, 4));
-                    voc += vob;
-                    m_clcnd(icl, 0) = vob*m_ndcrd(ind, 0);
-                    m_clcnd(icl, 1) = vob*m_ndcrd(ind, 1);
-                    m_clcnd(icl, 2) = vob*m_ndcrd(ind, 2);
-                }
-                {
-                    int_type const ind = m_clnds(icl, 2);
-                    real_type const vob = m_fcara(m_clfcs(icl, 3));
-                    voc += vob;
-                    m_clcnd(icl, 0) = vob*m_ndcrd(ind, 0);
-                    m_clcnd(icl, 1) = vob*m_ndcrd(ind, 1);
-                    m_clcnd(icl, 2) = vob*m_ndcrd(ind, 2);
-                }
-                {
-                    int_type const ind = m_clnds(icl, 3);
-                    real_type const vob = m_fcara(m_clfcs(icl, 2));
-                    voc += vob;
-                    m_clcnd(icl, 0) = vob*m_ndcrd(ind, 0);
-                    m_clcnd(icl, 1) = vob*m_ndcrd(ind, 1);
-                    m_clcnd(icl, 2) = vob*m_ndcrd(ind, 2);
-                }
-                {
-                    int_type const ind = m_clnds(icl, 4);
-                    real_type const vob = m_fcara(m_clfcs(icl, 1));
-                    voc += vob;
-                    m_clcnd(icl, 0) = vob*m_ndcrd(ind, 0);
-                    m_clcnd(icl, 1) = vob*m_ndcrd(ind, 1);
-                    m_clcnd(icl, 2) = vob*m_ndcrd(ind, 2);
-                }
-                m_clcnd(icl, 0) /= voc;
-                m_clcnd(icl, 1) /= voc;
-                m_clcnd(icl, 2) /= voc;
-            }
-            else // centroids.
-            {
-                // averaged point.
-                std::array<real_type, 3> crd; // NOLINT(cppcoreguidelines-pro-type-member-init)
-                crd[0] = crd[1] = crd[2] = 0.0;
-                size_t const nnd = m_clnds(icl, 0);
-                for (size_t inc = 1 ; inc <= nnd ; ++inc)
-                {
-                    int_type const ind = m_clnds(icl, inc);
-                    crd[0] += m_ndcrd(ind, 0);
-                    crd[1] += m_ndcrd(ind, 1);
-                    crd[2] += m_ndcrd(ind, 2);
+                    if (use_incenter() && CellType::TRIANGLE == traits_type::id)
+                    {
+                        for (int_type const * it = begin ; it != end ; ++it)
+                        {
+                            int_type const icl = *it;
+                            real_type voc = 0.0;
+                            {
+                                int_type const ind = m_clnds(icl, 1);
+                                real_type const vob = m_fcara(m_clfcs(icl, 2));
+                                voc += vob;
+                                m_clcnd(icl, 0) = vob*m_ndcrd(ind, 0);
+                                m_clcnd(icl, 1) = vob*m_ndcrd(ind, 1);
+                            }
+                            {
+                                int_type const ind = m_clnds(icl, 2);
+                                real_type const vob = m_fcara(m_clfcs(icl, 3));
+                                voc += vob;
+                                m_clcnd(icl, 0) += vob*m_ndcrd(ind, 0);
+                                m_clcnd(icl, 1) += vob*m_ndcrd(ind, 1);
+                            }
+                            {
+                                int_type const ind = m_clnds(icl, 3);
+                                real_type const vob = m_fcara(m_clfcs(icl, 1));
+                                voc += vob;
+                                m_clcnd(icl, 0) += vob*m_ndcrd(ind, 0);
+                                m_clcnd(icl, 1) += vob*m_ndcrd(ind, 1);
+                            }
+                            m_clcnd(icl, 0) /= voc;
+                            m_clcnd(icl, 1) /= voc;
+                        }
+                    }
+                    else // centroids.
+                    {
+                        detail::calc_cell_centroid<2, traits_type>(*this, begin, end);
+                    }
                 }
-                crd[0] /= nnd;
-                crd[1] /= nnd;
-                crd[2] /= nnd;
-                // weight centroid.
-                real_type voc = 0.0;
-                m_clcnd(icl, 0) = m_clcnd(icl, 1) = m_clcnd(icl, 2) = 0.0;
-                size_t const nfc = m_clfcs(icl, 0);
-                for (size_t ifl = 1 ; ifl <= nfc ; ++ifl)
+                else
                 {
-                    int_type const ifc = m_clfcs(icl, ifl);
-                    real_type const du0 = crd[0] - m_fccnd(ifc, 0);
-                    real_type const du1 = crd[1] - m_fccnd(ifc, 1);
-                    real_type const du2 = crd[2] - m_fccnd(ifc, 2);
-                    real_type const vob = fabs(du0*m_fcnml(ifc, 0) + du1*m_fcnml(ifc, 1) + du2*m_fcnml(ifc, 2)) * m_fcara(ifc);
-                    voc += vob;
-                    real_type const dv0 = m_fccnd(ifc, 0) + du0/4;
-                    real_type const dv1 = m_fccnd(ifc, 1) + du1/4;
-                    real_type const dv2 = m_fccnd(ifc, 2) + du2/4;
-                    m_clcnd(icl, 0) += dv0 * vob;
-                    m_clcnd(icl, 1) += dv1 * vob;
-                    m_clcnd(icl, 2) += dv2 * vob;
+                    if (use_incenter() && CellType::TETRAHEDRON == traits_type::id)
+                    {
+                        for (int_type const * it = begin ; it != end ; ++it)
+                        {
+                            int_type const icl = *it;
+                            real_type voc = 0.0;
+                            {
+                                int_type const ind = m_clnds(icl, 1);
+                                real_type const vob = m_fcara(m_clfcs(icl, 4));
+                                voc += vob;
+                                m_clcnd(icl, 0) = vob*m_ndcrd(ind, 0);
+                                m_clcnd(icl, 1) = vob*m_ndcrd(ind, 1);
+                                m_clcnd(icl, 2) = vob*m_ndcrd(ind, 2);
+                            }
+                            {
+                                int_type const ind = m_clnds(icl, 2);
+                                real_type const vob = m_fcara(m_clfcs(icl, 3));
+                                voc += vob;
+                                m_clcnd(icl, 0) = vob*m_ndcrd(ind, 0);
+                                m_clcnd(icl, 1) = vob*m_ndcrd(ind, 1);
+                                m_clcnd(icl, 2) = vob*m_ndcrd(ind, 2);
+                            }
+                            {
+                                int_type const ind = m_clnds(icl, 3);
+                                real_type const vob = m_fcara(m_clfcs(icl, 2));
+                                voc += vob;
+                                m_clcnd(icl, 0) = vob*m_ndcrd(ind, 0);
+                                m_clcnd(icl, 1) = vob*m_ndcrd(ind, 1);
+                                m_clcnd(icl, 2) = vob*m_ndcrd(ind, 2);
+                            }
+                            {
+                                int_type const ind = m_clnds(icl, 4);
+                                real_type const vob = m_fcara(m_clfcs(icl, 1));
+                                voc += vob;
+                                m_clcnd(icl, 0) = vob*m_ndcrd(ind, 0);
+                                m_clcnd(icl, 1) = vob*m_ndcrd(ind, 1);
+                                m_clcnd(icl, 2) = vob*m_ndcrd(ind, 2);
+                            }
+                            m_clcnd(icl, 0) /= voc;
+                            m_clcnd(icl, 1) /= voc;
+                            m_clcnd(icl, 2) /= voc;
+                        }
+                    }
+                    else // centroids.
+                    {
+                        detail::calc_cell_centroid<3, traits_type>(*this, begin, end);
+                    }
                 }
-                m_clcnd(icl, 0) /= voc;
-                m_clcnd(icl, 1) /= voc;
-                m_clcnd(icl, 2) /= voc;
-            }
-        }
+            });
     }
 
-    // compute volume for each cell.
+    // compute volume for each cell, type by type.
     auto reorder_face = [this](int_type ifc)
     {
         size_t const nnd = m_fcnds(ifc, 0);
@@ -956,38 +1034,25 @@ void StaticMesh::calc_metric()
             m_fcnml(ifc, idm) = -m_fcnml(ifc, idm);
         }
     };
-    for (size_t icl = 0 ; icl < ncell() ; ++icl)
-    {
-        m_clvol(icl) = 0.0;
-        size_t const nfc = m_clfcs(icl, 0);
-        for (size_t it = 1 ; it <= nfc ; ++it)
+    for_each_cell_type(
+        [this, &reorder_face](auto traits, int_type const * begin, int_type const * end)
         {
-            int_type const ifc = m_clfcs(icl, it);
-            // calculate volume associated with each face.
-            real_type vol = 0.0;
-            for (size_t idm = 0 ; idm < m_ndim ; ++idm)
+            using traits_type = decltype(traits);
+            switch (m_ndim)
             {
-                vol += (m_fccnd(ifc, idm) - m_clcnd(icl, idm)) * m_fcnml(ifc, idm);
-            }
-            vol *= m_fcara(ifc);
-            // check if need to reorder node definition and connecting cell
-            // list for the face.
-            size_t const this_fcl = m_fccls(ifc, 0);
-            if (vol < 0.0)
-            {
-                if (this_fcl == icl) { reorder_face(ifc); }
-                vol = -vol;
-            }
-            else
-            {
-                if (this_fcl != icl) { reorder_face(ifc); }
+            case 1:
+                detail::calc_cell_volume<1, traits_type>(*this, begin, end, reorder_face);
+                break;
+            case 2:
+                detail::calc_cell_volume<2, traits_type>(*this, begin, end, reorder_face);
+                break;
+            case 3:
+                detail::calc_cell_volume<3, traits_type>(*this, begin, end, reorder_face);
+                break;
+            default:
+                break;
             }
-            // accumulate the volume for the cell.
-            m_clvol(icl) += vol;
-        }
-        // calculate the real volume.
-        m_clvol(icl) /= m_ndim;
-    }
+        });
 }
 
 } /* end namespace modmesh */
@@ -32,6 +32,8 @@
  * The interface master header file for the unstructured mesh.
  */
 
+#include <modmesh/mesh/CompressedConnectivity.hpp>
 #include <modmesh/mesh/StaticMesh.hpp>
+#include <modmesh/mesh/StaticMeshBVH.hpp>
 
 // vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -48,7 +48,9 @@ void initialize_mesh(pybind11::module & mod)
     auto initialize_impl = [](pybind11::module & mod)
     {
         wrap_StaticGrid(mod);
+        wrap_CompressedConnectivity(mod);
         wrap_StaticMesh(mod);
+        wrap_StaticMeshBVH(mod);
     };
 
     OneTimeInitializer<mesh_pymod_tag>::me()(mod, initialize_impl);
@@ -43,6 +43,8 @@ namespace python
 void initialize_mesh(pybind11::module & mod);
 void wrap_StaticGrid(pybind11::module & mod);
 void wrap_StaticMesh(pybind11::module & mod);
+void wrap_CompressedConnectivity(pybind11::module & mod);
+void wrap_StaticMeshBVH(pybind11::module & mod);
 
 } /* end namespace python */
 
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <modmesh/mesh/pymod/mesh_pymod.hpp> // Must be the first include.
+#include <modmesh/modmesh.hpp>
+
+namespace modmesh
+{
+
+namespace python
+{
+
+namespace detail
+{
+
+inline void check_row(CompressedConnectivity<int32_t> const & self, ssize_t irow)
+{
+    if (irow < -static_cast<ssize_t>(self.nghost()) || irow >= static_cast<ssize_t>(self.nbody()))
+    {
+        throw std::out_of_range(Formatter() << "CompressedConnectivity: row " << irow << " is out of range [-"
+                                            << self.nghost() << ", " << self.nbody() << ")");
+    }
+}
+
+} /* end namespace detail */
+
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapCompressedConnectivity
+    : public WrapBase<WrapCompressedConnectivity, CompressedConnectivity<int32_t>>
+{
+
+public:
+
+    using base_type = WrapBase<WrapCompressedConnectivity, CompressedConnectivity<int32_t>>;
+    using wrapped_type = typename base_type::wrapped_type;
+    using array_type = typename wrapped_type::array_type;
+
+    friend root_base_type;
+
+protected:
+
+    WrapCompressedConnectivity(pybind11::module & mod, char const * pyname, char const * pydoc);
+
+}; /* end class WrapCompressedConnectivity */
+
+WrapCompressedConnectivity::WrapCompressedConnectivity(pybind11::module & mod, char const * pyname, char const * pydoc)
+    : base_type(mod, pyname, pydoc)
+{
+    namespace py = pybind11;
+
+    (*this)
+        .def(
+            py::init(
+                [](array_type const & offsets, array_type const & indices)
+                { return std::make_unique<wrapped_type>(offsets, indices); }),
+            py::arg("offsets"),
+            py::arg("indices"))
+        .def_static("from_padded", &wrapped_type::from_padded, py::arg("padded"))
+        .def("to_padded", &wrapped_type::to_padded, py::arg("ncolumn"))
+        //
+        ;
+
+    (*this)
+        .def_property_readonly("nghost", &wrapped_type::nghost)
+        .def_property_readonly("nbody", &wrapped_type::nbody)
+        .def_property_readonly("nrow", &wrapped_type::nrow)
+        .def_property_readonly("nnz", &wrapped_type::nnz)
+        .def_property_readonly("nbytes", &wrapped_type::nbytes)
+        .def_property_readonly("max_size", &wrapped_type::max_size)
+        .def_property_readonly(
+            "offsets",
+            [](wrapped_type const & self)
+            { return self.offsets(); })
+        .def_property_readonly(
+            "indices",
+            [](wrapped_type const & self)
+            { return self.indices(); })
+        .def("__len__", &wrapped_type::nrow)
+        .def(
+            "size",
+            [](wrapped_type const & self, ssize_t irow)
+            {
+                detail::check_row(self, irow);
+                return self.size(irow);
+            },
+            py::arg("irow"))
+        .def(
+            "row",
+            [](wrapped_type const & self, ssize_t irow)
+            {
+                detail::check_row(self, irow);
+                auto const row = self.row(irow);
+                return array_type(row.begin(), row.end());
+            },
+            py::arg("irow"))
+        //
+        ;
+}
+
+void wrap_CompressedConnectivity(pybind11::module & mod)
+{
+    WrapCompressedConnectivity::commit(mod, "CompressedConnectivity", "Compressed sparse-row connectivity table");
+}
+
+} /* end namespace python */
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -120,33 +120,216 @@ WrapStaticGrid1d::WrapStaticGrid1d(pybind11::module & mod, char const * pyname,
         ;
 }
 
-// clang-format off
-#define MM_DECL_StaticGridMD(NDIM) \
-class \
-MODMESH_PYTHON_WRAPPER_VISIBILITY \
-WrapStaticGrid ## NDIM ## d \
-  : public WrapStaticGridBase< WrapStaticGrid ## NDIM ## d, StaticGrid ## NDIM ## d > \
-{ \
-\
-public: \
-\
-      friend root_base_type; \
-\
-    using base_type = WrapStaticGridBase< WrapStaticGrid ## NDIM ## d, StaticGrid ## NDIM ## d >; \
-\
-protected: \
-\
-    explicit WrapStaticGrid ## NDIM ## d(pybind11::module & mod, char const * pyname, char const * pydoc) \
-      : base_type(mod, pyname, pydoc) \
-    {} \
-\
+template <typename Wrapper, typename GT>
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapStaticGridMd
+    : public WrapStaticGridBase<Wrapper, GT>
+{
+
+public:
+
+    using base_type = WrapStaticGridBase<Wrapper, GT>;
+    using wrapped_type = typename base_type::wrapped_type;
+
+    using array_type = typename wrapped_type::array_type;
+    using value_type = typename wrapped_type::value_type;
+    using index_type = typename wrapped_type::index_type;
+
+    friend typename base_type::root_base_type;
+
+protected:
+
+    WrapStaticGridMd(pybind11::module & mod, char const * pyname, char const * pydoc)
+        : base_type(mod, pyname, pydoc)
+    {
+        namespace py = pybind11;
+
+        (*this)
+            .def_property_readonly_static(
+                "EDGE",
+                [](py::object const &)
+                { return static_cast<uint8_t>(wrapped_type::EDGE); })
+            .def_property_readonly_static(
+                "PERIODIC",
+                [](py::object const &)
+                { return static_cast<uint8_t>(wrapped_type::PERIODIC); })
+            .def_property_readonly_static(
+                "ALIGNMENT",
+                [](py::object const &)
+                { return wrapped_type::ALIGNMENT; })
+            .def_property_readonly("nghost", &wrapped_type::nghost)
+            .def_property_readonly(
+                "shape",
+                [](wrapped_type const & self)
+                {
+                    py::tuple ret(wrapped_type::NDIM);
+                    for (size_t it = 0; it < wrapped_type::NDIM; ++it)
+                    {
+                        ret[it] = self.shape(it);
+                    }
+                    return ret;
+                })
+            .def("__len__", &wrapped_type::size)
+            .def_property_readonly("pitch", &wrapped_type::pitch)
+            .def_property_readonly("field_size", &wrapped_type::field_size)
+            .def("make_field", &wrapped_type::make_field, py::arg("value") = 0)
+            .def(
+                "view",
+                [](wrapped_type const & self, array_type & field, bool ghost)
+                {
+                    self.check_field(field, "field");
+                    // The ndarray skips the row padding and shares the buffer.
+                    size_t const nghost = ghost ? 0 : self.nghost();
+                    std::vector<size_t> shape(wrapped_type::NDIM);
+                    std::vector<size_t> stride(wrapped_type::NDIM);
+                    for (size_t it = 0; it < wrapped_type::NDIM; ++it)
+                    {
+                        shape[it] = self.shape(it) + 2 * (self.nghost() - nghost);
+                        stride[it] = self.stride(it) * sizeof(value_type);
+                    }
+                    index_type origin;
+                    origin.fill(-static_cast<ssize_t>(self.nghost() - nghost));
+                    return py::array(
+                        py::dtype::of<value_type>(),
+                        shape,
+                        stride,
+                        field.data() + self.offset(origin),
+                        py::cast(field.buffer().shared_from_this()));
+                },
+                py::arg("field"),
+                py::arg("ghost") = false)
+            .def(
+                "fill_ghost",
+                [](wrapped_type const & self, array_type & field, uint8_t type)
+                { self.fill_ghost(field, static_cast<typename wrapped_type::GhostType>(type)); },
+                py::arg("field"),
+                py::arg("type"))
+            .def(
+                "apply_stencil",
+                [](wrapped_type const & self,
+                   array_type const & src,
+                   array_type & dst,
+                   py::array_t<int64_t, py::array::c_style | py::array::forcecast> const & offsets,
+                   py::array_t<value_type, py::array::c_style | py::array::forcecast> const & weights)
+                {
+                    if (offsets.ndim() != 2 || offsets.shape(1) != wrapped_type::NDIM)
+                    {
+                        throw std::invalid_argument(Formatter() << "offsets must be in shape (nstencil, "
+                                                                << int(wrapped_type::NDIM) << ")");
+                    }
+                    std::vector<index_type> offs(offsets.shape(0));
+                    auto const oacc = offsets.template unchecked<2>();
+                    for (ssize_t is = 0; is < offsets.shape(0); ++is)
+                    {
+                        for (ssize_t it = 0; it < offsets.shape(1); ++it)
+                        {
+                            offs[is][it] = oacc(is, it);
+                        }
+                    }
+                    std::vector<value_type> wgts(weights.data(), weights.data() + weights.size());
+                    py::gil_scoped_release const release;
+                    self.apply_stencil(src, dst, offs, wgts);
+                },
+                py::arg("src"),
+                py::arg("dst"),
+                py::arg("offsets"),
+                py::arg("weights"))
+            //
+            ;
+    }
+
+}; /* end class WrapStaticGridMd */
+
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapStaticGrid2d
+    : public WrapStaticGridMd<WrapStaticGrid2d, StaticGrid2d>
+{
+
+public:
+
+    friend root_base_type;
+
+    using base_type = WrapStaticGridMd<WrapStaticGrid2d, StaticGrid2d>;
+
+protected:
+
+    WrapStaticGrid2d(pybind11::module & mod, char const * pyname, char const * pydoc);
+
+}; /* end class WrapStaticGrid2d */
+
+WrapStaticGrid2d::WrapStaticGrid2d(pybind11::module & mod, char const * pyname, char const * pydoc)
+    : base_type(mod, pyname, pydoc)
+{
+    namespace py = pybind11;
+
+    (*this)
+        .def_timed(
+            py::init(
+                [](serial_type nx, serial_type ny, serial_type nghost)
+                { return std::make_unique<StaticGrid2d>(nx, ny, nghost); }),
+            py::arg("nx"),
+            py::arg("ny"),
+            py::arg("nghost") = 1)
+        .def_property_readonly("nx", &wrapped_type::nx)
+        .def_property_readonly("ny", &wrapped_type::ny)
+        .expose_SimpleArray(
+            "xcoord",
+            [](wrapped_type & self) -> decltype(auto)
+            { return self.coord(0); })
+        .expose_SimpleArray(
+            "ycoord",
+            [](wrapped_type & self) -> decltype(auto)
+            { return self.coord(1); })
+        //
+        ;
 }
-// clang-format on
 
-MM_DECL_StaticGridMD(2);
-MM_DECL_StaticGridMD(3);
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapStaticGrid3d
+    : public WrapStaticGridMd<WrapStaticGrid3d, StaticGrid3d>
+{
+
+public:
+
+    friend root_base_type;
+
+    using base_type = WrapStaticGridMd<WrapStaticGrid3d, StaticGrid3d>;
+
+protected:
+
+    WrapStaticGrid3d(pybind11::module & mod, char const * pyname, char const * pydoc);
+
+}; /* end class WrapStaticGrid3d */
+
+WrapStaticGrid3d::WrapStaticGrid3d(pybind11::module & mod, char const * pyname, char const * pydoc)
+    : base_type(mod, pyname, pydoc)
+{
+    namespace py = pybind11;
 
-#undef MM_DECL_StaticGridMD
+    (*this)
+        .def_timed(
+            py::init(
+                [](serial_type nx, serial_type ny, serial_type nz, serial_type nghost)
+                { return std::make_unique<StaticGrid3d>(nx, ny, nz, nghost); }),
+            py::arg("nx"),
+            py::arg("ny"),
+            py::arg("nz"),
+            py::arg("nghost") = 1)
+        .def_property_readonly("nx", &wrapped_type::nx)
+        .def_property_readonly("ny", &wrapped_type::ny)
+        .def_property_readonly("nz", &wrapped_type::nz)
+        .expose_SimpleArray(
+            "xcoord",
+            [](wrapped_type & self) -> decltype(auto)
+            { return self.coord(0); })
+        .expose_SimpleArray(
+            "ycoord",
+            [](wrapped_type & self) -> decltype(auto)
+            { return self.coord(1); })
+        .expose_SimpleArray(
+            "zcoord",
+            [](wrapped_type & self) -> decltype(auto)
+            { return self.coord(2); })
+        //
+        ;
+}
 
 void wrap_StaticGrid(pybind11::module & mod)
 {
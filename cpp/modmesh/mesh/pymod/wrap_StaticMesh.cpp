@@ -102,7 +102,36 @@ WrapStaticMesh::WrapStaticMesh(pybind11::module & mod, char const * pyname, char
         .def_timed("build_interior", &wrapped_type::build_interior, py::arg("_do_metric") = true, py::arg("_build_edge") = true)
         .def_timed("build_boundary", &wrapped_type::build_boundary)
         .def_timed("build_ghost", &wrapped_type::build_ghost)
-        .def_timed("build_edge", &wrapped_type::build_edge);
+        .def_timed("refill_ghost", &wrapped_type::refill_ghost, py::arg("do_metric") = true)
+        .def_timed("build_edge", &wrapped_type::build_edge)
+        .def_timed("build_csr", &wrapped_type::build_csr, py::arg("drop_padded") = false)
+        .def_timed("expand_csr", &wrapped_type::expand_csr)
+        .def_property_readonly("has_padded_connectivity", &wrapped_type::has_padded_connectivity)
+        .def_timed("build_node_cells", &wrapped_type::build_node_cells, py::return_value_policy::reference_internal)
+        .def_timed("build_cell_neighbors", &wrapped_type::build_cell_neighbors, py::return_value_policy::reference_internal)
+        .def_timed("build_node_neighbors", &wrapped_type::build_node_neighbors, py::return_value_policy::reference_internal)
+        .def_timed("build_type_cells", &wrapped_type::build_type_cells, py::return_value_policy::reference_internal)
+        .def("invalidate_adjacency", &wrapped_type::invalidate_adjacency)
+        .def_property_readonly("has_node_cells", &wrapped_type::has_node_cells)
+        .def_property_readonly("has_cell_neighbors", &wrapped_type::has_cell_neighbors)
+        .def_property_readonly("has_node_neighbors", &wrapped_type::has_node_neighbors)
+        .def_property_readonly("has_type_cells", &wrapped_type::has_type_cells);
+
+#define MM_DECL_CSR(NAME)                                                  \
+    .def_property_readonly(                                                \
+        #NAME,                                                             \
+        [](wrapped_type & self) -> decltype(auto) { return self.NAME(); }, \
+        py::return_value_policy::reference_internal)
+
+    // clang-format off
+        (*this)
+            MM_DECL_CSR(fcnds_csr)
+            MM_DECL_CSR(clnds_csr)
+            MM_DECL_CSR(clfcs_csr)
+        ;
+    // clang-format on
+
+#undef MM_DECL_CSR
 
 #define MM_DECL_ARRAY(NAME) \
     .expose_SimpleArray(#NAME, [](wrapped_type & self) -> decltype(auto) { return self.NAME(); })
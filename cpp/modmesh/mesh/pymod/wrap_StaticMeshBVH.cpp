@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <modmesh/mesh/pymod/mesh_pymod.hpp> // Must be the first include.
+#include <modmesh/modmesh.hpp>
+
+namespace modmesh
+{
+
+namespace python
+{
+
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapStaticMeshBVH
+    : public WrapBase<WrapStaticMeshBVH, StaticMeshBVH, std::shared_ptr<StaticMeshBVH>>
+{
+
+public:
+
+    using base_type = WrapBase<WrapStaticMeshBVH, StaticMeshBVH, std::shared_ptr<StaticMeshBVH>>;
+    using wrapped_type = typename base_type::wrapped_type;
+
+    friend root_base_type;
+
+protected:
+
+    WrapStaticMeshBVH(pybind11::module & mod, char const * pyname, char const * pydoc);
+
+}; /* end class WrapStaticMeshBVH */
+
+WrapStaticMeshBVH::WrapStaticMeshBVH(pybind11::module & mod, char const * pyname, char const * pydoc)
+    : base_type(mod, pyname, pydoc)
+{
+    namespace py = pybind11;
+
+    using real_type = typename wrapped_type::real_type;
+
+    (*this)
+        .def_timed(
+            py::init(
+                [](std::shared_ptr<StaticMesh> const & mesh, real_type tolerance)
+                { return wrapped_type::construct(mesh, tolerance); }),
+            py::arg("mesh"),
+            py::arg("tolerance") = 1.e-12)
+        //
+        ;
+
+    (*this)
+        .def_property_readonly("mesh", &wrapped_type::mesh)
+        .def_property_readonly("tolerance", &wrapped_type::tolerance)
+        .def_property_readonly("nnode", &wrapped_type::nnode)
+        .def_property_readonly("depth", &wrapped_type::depth)
+        .def_timed("locate_points", &wrapped_type::locate_points, py::arg("points"))
+        .def_timed("nearest_cells", &wrapped_type::nearest_cells, py::arg("points"))
+        //
+        ;
+}
+
+void wrap_StaticMeshBVH(pybind11::module & mod)
+{
+    WrapStaticMeshBVH::commit(mod, "StaticMeshBVH", "Bounding volume hierarchy over the cells of StaticMesh");
+}
+
+} /* end namespace python */
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -37,6 +37,7 @@
 #include <modmesh/math/math.hpp>
 #include <modmesh/buffer/buffer.hpp>
 #include <modmesh/grid.hpp>
+#include <modmesh/parallel.hpp>
 #include <modmesh/mesh/mesh.hpp>
 #include <modmesh/toggle/toggle.hpp>
 #include <modmesh/transform/transform.hpp>
@@ -0,0 +1,1079 @@
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <modmesh/multidim/euler.hpp>
+#include <modmesh/parallel.hpp>
+#include <modmesh/toggle/profile.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+namespace modmesh
+{
+
+namespace detail
+{
+
+/**
+ * Flux of the NDIM-dimensional Euler equations at a state, projected onto an
+ * area vector.  The primitive variables of the state are calculated once and
+ * shared by all the projections.
+ */
+template <uint8_t NDIM>
+struct EulerFlux
+{
+
+    static constexpr uint8_t NEQ = NDIM + 2;
+
+    EulerFlux(double gamma, double const * u)
+        : m_gamma(gamma)
+        , m_rho(u[0])
+        , m_rho_inv(1.0 / u[0])
+    {
+        m_v2 = 0.0;
+        for (uint8_t idm = 0; idm < NDIM; ++idm)
+        {
+            m_m[idm] = u[1 + idm];
+            m_v[idm] = u[1 + idm] * m_rho_inv;
+            m_v2 += m_v[idm] * m_v[idm];
+        }
+        m_p = (gamma - 1.0) * (u[NDIM + 1] - 0.5 * m_rho * m_v2);
+        m_h = u[NDIM + 1] + m_p;
+    }
+
+    /// f = (F(u) + dF/du du) . nml, the flux linearly expanded from the state.
+    void expand(double const * nml, double const * du, double * f) const
+    {
+        double vn = 0.0;
+        double dmn = 0.0;
+        double vdm = 0.0;
+        for (uint8_t idm = 0; idm < NDIM; ++idm)
+        {
+            vn += m_v[idm] * nml[idm];
+            dmn += du[1 + idm] * nml[idm];
+            vdm += m_v[idm] * du[1 + idm];
+        }
+        double const dvn = (dmn - vn * du[0]) * m_rho_inv;
+        double const pdp = m_p + (m_gamma - 1.0) * (du[NDIM + 1] - vdm + 0.5 * m_v2 * du[0]);
+        f[0] = m_rho * vn + dmn;
+        for (uint8_t idm = 0; idm < NDIM; ++idm)
+        {
+            f[1 + idm] = (m_m[idm] + du[1 + idm]) * vn + m_m[idm] * dvn + pdp * nml[idm];
+        }
+        f[NDIM + 1] = (m_h + du[NDIM + 1] + pdp - m_p) * vn + m_h * dvn;
+    }
+
+    /// f += (dF/du du) . nml
+    void add_derivative(double const * nml, double const * du, double * f) const
+    {
+        double vn = 0.0;
+        double dmn = 0.0;
+        double vdm = 0.0;
+        for (uint8_t idm = 0; idm < NDIM; ++idm)
+        {
+            vn += m_v[idm] * nml[idm];
+            dmn += du[1 + idm] * nml[idm];
+            vdm += m_v[idm] * du[1 + idm];
+        }
+        double const dvn = (dmn - vn * du[0]) * m_rho_inv;
+        double const dp = (m_gamma - 1.0) * (du[NDIM + 1] - vdm + 0.5 * m_v2 * du[0]);
+        f[0] += dmn;
+        for (uint8_t idm = 0; idm < NDIM; ++idm)
+        {
+            f[1 + idm] += du[1 + idm] * vn + m_m[idm] * dvn + dp * nml[idm];
+        }
+        f[NDIM + 1] += (du[NDIM + 1] + dp) * vn + m_h * dvn;
+    }
+
+    double wave_speed() const
+    {
+        return std::sqrt(m_v2) + std::sqrt(std::max(m_gamma * m_p * m_rho_inv, 0.0));
+    }
+
+    double m_gamma;
+    double m_rho;
+    double m_rho_inv;
+    double m_m[NDIM];
+    double m_v[NDIM];
+    double m_v2;
+    double m_p;
+    double m_h; ///< Total energy plus pressure.
+
+}; /* end struct EulerFlux */
+
+/// Accumulate the volume and the first moment of a simplex.
+template <uint8_t NDIM>
+void add_simplex(std::array<double const *, NDIM + 1> const & pts, double & vol, double * mom)
+{
+    double dx[NDIM][NDIM];
+    for (uint8_t ivt = 0; ivt < NDIM; ++ivt)
+    {
+        for (uint8_t idm = 0; idm < NDIM; ++idm)
+        {
+            dx[ivt][idm] = pts[ivt + 1][idm] - pts[0][idm];
+        }
+    }
+    double val;
+    if constexpr (2 == NDIM)
+    {
+        val = std::fabs(dx[0][0] * dx[1][1] - dx[0][1] * dx[1][0]) / 2;
+    }
+    else
+    {
+        val = std::fabs(dx[0][0] * (dx[1][1] * dx[2][2] - dx[1][2] * dx[2][1])
+                        - dx[0][1] * (dx[1][0] * dx[2][2] - dx[1][2] * dx[2][0])
+                        + dx[0][2] * (dx[1][0] * dx[2][1] - dx[1][1] * dx[2][0]))
+              / 6;
+    }
+    vol += val;
+    for (uint8_t idm = 0; idm < NDIM; ++idm)
+    {
+        double cnd = 0.0;
+        for (uint8_t ivt = 0; ivt <= NDIM; ++ivt)
+        {
+            cnd += pts[ivt][idm];
+        }
+        mom[idm] += val * cnd / (NDIM + 1);
+    }
+}
+
+/// Invert the NDIM x NDIM matrix and return the determinant.
+template <uint8_t NDIM>
+double invert(double const (&mat)[NDIM][NDIM], double (&inv)[NDIM][NDIM])
+{
+    double det;
+    if constexpr (2 == NDIM)
+    {
+        det = mat[0][0] * mat[1][1] - mat[0][1] * mat[1][0];
+        inv[0][0] = mat[1][1];
+        inv[0][1] = -mat[0][1];
+        inv[1][0] = -mat[1][0];
+        inv[1][1] = mat[0][0];
+    }
+    else
+    {
+        for (uint8_t irw = 0; irw < 3; ++irw)
+        {
+            for (uint8_t icn = 0; icn < 3; ++icn)
+            {
+                // Cofactor of mat[icn][irw] by the cyclic permutation.
+                uint8_t const r1 = (icn + 1) % 3;
+                uint8_t const r2 = (icn + 2) % 3;
+                uint8_t const c1 = (irw + 1) % 3;
+                uint8_t const c2 = (irw + 2) % 3;
+                inv[irw][icn] = mat[r1][c1] * mat[r2][c2] - mat[r1][c2] * mat[r2][c1];
+            }
+        }
+        det = mat[0][0] * inv[0][0] + mat[0][1] * inv[1][0] + mat[0][2] * inv[2][0];
+    }
+    if (det != 0.0)
+    {
+        for (uint8_t irw = 0; irw < NDIM; ++irw)
+        {
+            for (uint8_t icn = 0; icn < NDIM; ++icn)
+            {
+                inv[irw][icn] /= det;
+            }
+        }
+    }
+    return det;
+}
+
+} /* end namespace detail */
+
+EulerCore::EulerCore(std::shared_ptr<StaticMesh> const & mesh, real_type time_increment, ctor_passkey const &)
+    : m_mesh(mesh)
+    , m_time_increment(time_increment)
+{
+    if (!m_mesh)
+    {
+        throw std::invalid_argument("EulerCore: mesh is null");
+    }
+    uint8_t const nd = m_mesh->ndim();
+    if (nd != 2 && nd != 3)
+    {
+        throw std::invalid_argument(Formatter() << "EulerCore: ndim = " << static_cast<int>(nd) << " is not 2 or 3");
+    }
+    if (m_mesh->ncell() > 0 && (0 == m_mesh->nbound() || m_mesh->ngstcell() != m_mesh->nbound()))
+    {
+        throw std::invalid_argument(
+            Formatter() << "EulerCore: the mesh has " << m_mesh->nbound() << " boundary faces and "
+                        << m_mesh->ngstcell() << " ghost cells; call build_boundary() and build_ghost() first");
+    }
+    if (!m_mesh->has_padded_connectivity())
+    {
+        throw std::invalid_argument("EulerCore: padded connectivity of the mesh is dropped; call expand_csr() first");
+    }
+
+    m_bctype.assign(m_mesh->nbcs(), NONREFLECTING);
+    m_bcinlet_prim.remake(small_vector<size_t>{m_mesh->nbcs(), neq()}, 0);
+    m_bcinlet.remake(small_vector<size_t>{m_mesh->nbcs(), neq()}, 0);
+
+    size_t const ngst = m_mesh->ngstcell();
+    size_t const nrow = ngst + m_mesh->ncell();
+    auto const make = [ngst](SimpleArray<real_type> & arr, small_vector<size_t> const & shape)
+    {
+        arr.remake(shape, 0);
+        arr.set_nghost(ngst);
+    };
+    make(m_soln, small_vector<size_t>{nrow, neq()});
+    make(m_usoln, small_vector<size_t>{nrow, neq()});
+    make(m_dsoln, small_vector<size_t>{nrow, neq(), nd});
+    make(m_udsoln, small_vector<size_t>{nrow, neq(), nd});
+    make(m_solt, small_vector<size_t>{nrow, neq()});
+    m_cfl.remake(small_vector<size_t>{m_mesh->ncell()}, 0);
+
+    build_geometry();
+}
+
+void EulerCore::set_gamma(real_type gamma)
+{
+    if (!(gamma > 1.0))
+    {
+        throw std::invalid_argument(Formatter() << "EulerCore::set_gamma: gamma = " << gamma << " is not greater than 1");
+    }
+    m_gamma = gamma;
+    for (size_t ibc = 0; ibc < nbc(); ++ibc)
+    {
+        if (INLET == m_bctype[ibc])
+        {
+            update_bc_inlet(ibc);
+        }
+    }
+}
+
+EulerCore::BoundaryType EulerCore::bc_type(size_t ibc) const
+{
+    if (ibc >= nbc())
+    {
+        throw std::out_of_range(Formatter() << "EulerCore::bc_type: ibc " << ibc << " >= nbc " << nbc());
+    }
+    return m_bctype[ibc];
+}
+
+void EulerCore::set_bc(size_t ibc, BoundaryType type)
+{
+    if (ibc >= nbc())
+    {
+        throw std::out_of_range(Formatter() << "EulerCore::set_bc: ibc " << ibc << " >= nbc " << nbc());
+    }
+    if (type > INLET)
+    {
+        throw std::invalid_argument(Formatter() << "EulerCore::set_bc: invalid type " << static_cast<int>(type));
+    }
+    m_bctype[ibc] = type;
+}
+
+void EulerCore::set_bc_inlet(size_t ibc, real_type density, SimpleArray<real_type> const & velocity, real_type pressure)
+{
+    if (velocity.size() != ndim())
+    {
+        throw std::invalid_argument(
+            Formatter() << "EulerCore::set_bc_inlet: velocity size " << velocity.size() << " != ndim " << static_cast<int>(ndim()));
+    }
+    set_bc(ibc, INLET);
+    m_bcinlet_prim(ibc, 0) = density;
+    for (size_t idm = 0; idm < ndim(); ++idm)
+    {
+        m_bcinlet_prim(ibc, 1 + idm) = velocity.data()[idm];
+    }
+    m_bcinlet_prim(ibc, ndim() + 1) = pressure;
+    update_bc_inlet(ibc);
+}
+
+void EulerCore::update_bc_inlet(size_t ibc)
+{
+    real_type const density = m_bcinlet_prim(ibc, 0);
+    real_type v2 = 0.0;
+    for (size_t idm = 0; idm < ndim(); ++idm)
+    {
+        real_type const vel = m_bcinlet_prim(ibc, 1 + idm);
+        m_bcinlet(ibc, 1 + idm) = density * vel;
+        v2 += vel * vel;
+    }
+    m_bcinlet(ibc, 0) = density;
+    m_bcinlet(ibc, ndim() + 1) = m_bcinlet_prim(ibc, ndim() + 1) / (m_gamma - 1.0) + 0.5 * density * v2;
+}
+
+void EulerCore::set_primitive(SimpleArray<real_type> const & density, SimpleArray<real_type> const & velocity, SimpleArray<real_type> const & pressure)
+{
+    size_t const ncl = ncell();
+    uint8_t const nd = ndim();
+    if (density.size() != ncl || pressure.size() != ncl || velocity.size() != ncl * nd)
+    {
+        throw std::invalid_argument(
+            Formatter() << "EulerCore::set_primitive: sizes of density " << density.size() << ", velocity "
+                        << velocity.size() << ", and pressure " << pressure.size() << " do not match ncell "
+                        << ncl << " and ndim " << static_cast<int>(nd));
+    }
+    real_type const * rho = density.data();
+    real_type const * vel = velocity.data();
+    real_type const * pre = pressure.data();
+    parallel_for(
+        0, ncl, [&](size_t ibegin, size_t iend)
+        {
+            for (size_t icl = ibegin; icl < iend; ++icl)
+            {
+                real_type * u = m_soln.vptr(icl, 0);
+                real_type v2 = 0.0;
+                for (size_t idm = 0; idm < nd; ++idm)
+                {
+                    real_type const v = vel[icl * nd + idm];
+                    u[1 + idm] = rho[icl] * v;
+                    v2 += v * v;
+                }
+                u[0] = rho[icl];
+                u[nd + 1] = pre[icl] / (m_gamma - 1.0) + 0.5 * rho[icl] * v2;
+                std::fill(m_dsoln.vptr(icl, 0, 0), m_dsoln.vptr(icl, 0, 0) + (nd + 2) * nd, 0.0);
+            } },
+        MARCH_GRAIN);
+}
+
+SimpleArray<EulerCore::real_type> EulerCore::density() const
+{
+    SimpleArray<real_type> ret(small_vector<size_t>{ncell()});
+    for (size_t icl = 0; icl < ncell(); ++icl)
+    {
+        ret(icl) = m_soln(icl, 0);
+    }
+    return ret;
+}
+
+SimpleArray<EulerCore::real_type> EulerCore::velocity() const
+{
+    uint8_t const nd = ndim();
+    SimpleArray<real_type> ret(small_vector<size_t>{ncell(), nd});
+    for (size_t icl = 0; icl < ncell(); ++icl)
+    {
+        for (size_t idm = 0; idm < nd; ++idm)
+        {
+            ret(icl, idm) = m_soln(icl, 1 + idm) / m_soln(icl, 0);
+        }
+    }
+    return ret;
+}
+
+SimpleArray<EulerCore::real_type> EulerCore::pressure() const
+{
+    uint8_t const nd = ndim();
+    SimpleArray<real_type> ret(small_vector<size_t>{ncell()});
+    for (size_t icl = 0; icl < ncell(); ++icl)
+    {
+        real_type m2 = 0.0;
+        for (size_t idm = 0; idm < nd; ++idm)
+        {
+            m2 += m_soln(icl, 1 + idm) * m_soln(icl, 1 + idm);
+        }
+        ret(icl) = (m_gamma - 1.0) * (m_soln(icl, nd + 1) - 0.5 * m2 / m_soln(icl, 0));
+    }
+    return ret;
+}
+
+void EulerCore::build_geometry()
+{
+    MODMESH_TIME("EulerCore::build_geometry");
+    StaticMesh & mh = *m_mesh;
+    mh.for_each_cell_type(
+        [&](auto traits, int_type const *, int_type const *)
+        {
+            if (decltype(traits)::ndim != mh.ndim())
+            {
+                throw std::invalid_argument(
+                    Formatter() << "EulerCore: cell type " << static_cast<int>(decltype(traits)::id)
+                                << " does not match ndim " << static_cast<int>(mh.ndim()));
+            }
+        });
+    if (2 == mh.ndim())
+    {
+        build_geometry_nd<2>();
+        build_group_nd<2>();
+    }
+    else
+    {
+        build_geometry_nd<3>();
+        build_group_nd<3>();
+    }
+}
+
+/**
+ * Each BCE is decomposed into the simplices spanned by the face centroid, a
+ * node (2D) or an edge (3D) of the face, and either of the cell centroids.
+ * The lateral surfaces of the BCE on the side of the neighboring cell are
+ * spanned by the same node or edge and the neighboring centroid.
+ */
+template <uint8_t NDIM>
+void EulerCore::build_geometry_nd()
+{
+    StaticMesh const & mh = *m_mesh;
+    size_t const ngst = mh.ngstcell();
+    size_t const ncl = mh.ncell();
+
+    m_cecnd.remake(small_vector<size_t>{ngst + ncl, CLMFC + 1, NDIM}, 0);
+    m_cecnd.set_nghost(ngst);
+    m_cevol.remake(small_vector<size_t>{ngst + ncl, CLMFC + 1}, 0);
+    m_cevol.set_nghost(ngst);
+    m_sfmrc.remake(small_vector<size_t>{ncl, CLMFC, FCMND, 2, NDIM}, 0);
+
+    parallel_for(
+        0, ncl, [&](size_t ibegin, size_t iend)
+        {
+            for (size_t icl = ibegin; icl < iend; ++icl)
+            {
+                real_type const * crdi = mh.clcnd().vptr(icl, 0);
+                real_type ctot[NDIM] = {};
+                real_type vtot = 0.0;
+                for (int_type ifl = 1; ifl <= mh.clfcs(icl, 0); ++ifl)
+                {
+                    int_type const ifc = mh.clfcs(icl, ifl);
+                    int_type const jcl = mh.fccls(ifc, 0) + mh.fccls(ifc, 1) - static_cast<int_type>(icl);
+                    real_type const * crdj = mh.clcnd().vptr(jcl, 0);
+                    real_type const * crdf = mh.fccnd().vptr(ifc, 0);
+                    int_type const nnd = mh.fcnds(ifc, 0);
+                    real_type vol = 0.0;
+                    real_type mom[NDIM] = {};
+                    for (int_type inf = 0; inf < nnd; ++inf)
+                    {
+                        real_type const * crd0 = mh.ndcrd().vptr(mh.fcnds(ifc, 1 + inf), 0);
+                        real_type const * crd1 = mh.ndcrd().vptr(mh.fcnds(ifc, 1 + (inf + 1) % nnd), 0);
+                        real_type * mid = m_sfmrc.vptr(icl, ifl - 1, inf, 0, 0);
+                        real_type * nml = m_sfmrc.vptr(icl, ifl - 1, inf, 1, 0);
+                        if constexpr (2 == NDIM)
+                        {
+                            detail::add_simplex<NDIM>({crdf, crd0, crdi}, vol, mom);
+                            detail::add_simplex<NDIM>({crdf, crd0, crdj}, vol, mom);
+                            for (uint8_t idm = 0; idm < NDIM; ++idm)
+                            {
+                                mid[idm] = (crd0[idm] + crdj[idm]) / 2;
+                            }
+                            nml[0] = crdj[1] - crd0[1];
+                            nml[1] = crd0[0] - crdj[0];
+                        }
+                        else
+                        {
+                            detail::add_simplex<NDIM>({crdf, crd0, crd1, crdi}, vol, mom);
+                            detail::add_simplex<NDIM>({crdf, crd0, crd1, crdj}, vol, mom);
+                            real_type dx0[NDIM];
+                            real_type dx1[NDIM];
+                            for (uint8_t idm = 0; idm < NDIM; ++idm)
+                            {
+                                mid[idm] = (crd0[idm] + crd1[idm] + crdj[idm]) / 3;
+                                dx0[idm] = crd1[idm] - crd0[idm];
+                                dx1[idm] = crdj[idm] - crd0[idm];
+                            }
+                            nml[0] = (dx0[1] * dx1[2] - dx0[2] * dx1[1]) / 2;
+                            nml[1] = (dx0[2] * dx1[0] - dx0[0] * dx1[2]) / 2;
+                            nml[2] = (dx0[0] * dx1[1] - dx0[1] * dx1[0]) / 2;
+                        }
+                        // The face centroid is the vertex of the simplex opposite to the surface.
+                        real_type dot = 0.0;
+                        for (uint8_t idm = 0; idm < NDIM; ++idm)
+                        {
+                            dot += nml[idm] * (crdf[idm] - mid[idm]);
+                        }
+                        if (dot > 0.0)
+                        {
+                            for (uint8_t idm = 0; idm < NDIM; ++idm)
+                            {
+                                nml[idm] = -nml[idm];
+                            }
+                        }
+                    }
+                    m_cevol(icl, ifl) = vol;
+                    vtot += vol;
+                    for (uint8_t idm = 0; idm < NDIM; ++idm)
+                    {
+                        m_cecnd(icl, ifl, idm) = mom[idm] / vol;
+                        ctot[idm] += mom[idm];
+                    }
+                }
+                m_cevol(icl, 0) = vtot;
+                for (uint8_t idm = 0; idm < NDIM; ++idm)
+                {
+                    m_cecnd(icl, 0, idm) = ctot[idm] / vtot;
+                }
+            } },
+        MARCH_GRAIN);
+
+    // The solution point of a ghost cell mirrors that of the interior cell.
+    parallel_for(
+        0, mh.nbound(), [&](size_t ibegin, size_t iend)
+        {
+            for (size_t ibnd = ibegin; ibnd < iend; ++ibnd)
+            {
+                int_type const ifc = mh.bndfcs(ibnd, 0);
+                int_type const icl = mh.fccls(ifc, 0);
+                int_type const jcl = mh.fccls(ifc, 1);
+                real_type dist = 0.0;
+                for (uint8_t idm = 0; idm < NDIM; ++idm)
+                {
+                    dist += (m_cecnd(icl, 0, idm) - mh.fccnd(ifc, idm)) * mh.fcnml(ifc, idm);
+                }
+                for (uint8_t idm = 0; idm < NDIM; ++idm)
+                {
+                    m_cecnd(jcl, 0, idm) = m_cecnd(icl, 0, idm) - 2 * dist * mh.fcnml(ifc, idm);
+                }
+                m_cevol(jcl, 0) = m_cevol(icl, 0);
+            } },
+        MARCH_GRAIN);
+}
+
+/**
+ * A group consists of NDIM faces whose neighboring solution points span a
+ * well-conditioned simplex with the solution point of the cell.  The groups
+ * are ranked by the sine-like ratio of the determinant to the product of the
+ * lengths, and the degenerate ones (e.g., opposite faces of a quadrilateral)
+ * are dropped.
+ */
+template <uint8_t NDIM>
+void EulerCore::build_group_nd()
+{
+    static constexpr real_type RATIO_MIN = 0.1;
+
+    StaticMesh const & mh = *m_mesh;
+    size_t const ncl = mh.ncell();
+
+    m_cllen.remake(small_vector<size_t>{ncl}, 0);
+    m_grpnum.remake(small_vector<size_t>{ncl}, 0);
+    m_grpfcs.remake(small_vector<size_t>{ncl, NGROUP_MAX, NDIM}, 0);
+    m_grpmat.remake(small_vector<size_t>{ncl, NGROUP_MAX, NDIM, NDIM}, 0);
+
+    parallel_for(
+        0, ncl, [&](size_t ibegin, size_t iend)
+        {
+            for (size_t icl = ibegin; icl < iend; ++icl)
+            {
+                int_type const nfc = mh.clfcs(icl, 0);
+                real_type dx[CLMFC][NDIM];
+                real_type len[CLMFC];
+                real_type lmin = std::numeric_limits<real_type>::max();
+                for (int_type ifl = 0; ifl < nfc; ++ifl)
+                {
+                    int_type const ifc = mh.clfcs(icl, ifl + 1);
+                    int_type const jcl = mh.fccls(ifc, 0) + mh.fccls(ifc, 1) - static_cast<int_type>(icl);
+                    len[ifl] = 0.0;
+                    for (uint8_t idm = 0; idm < NDIM; ++idm)
+                    {
+                        dx[ifl][idm] = m_cecnd(jcl, 0, idm) - m_cecnd(icl, 0, idm);
+                        len[ifl] += dx[ifl][idm] * dx[ifl][idm];
+                    }
+                    len[ifl] = std::sqrt(len[ifl]);
+                    lmin = std::min(lmin, len[ifl]);
+                }
+                m_cllen(icl) = lmin;
+
+                // Enumerate the combinations of NDIM faces.
+                struct group_type
+                {
+                    real_type ratio;
+                    std::array<uint8_t, NDIM> fcs;
+                };
+                std::vector<group_type> groups;
+                std::array<uint8_t, NDIM> fcs{};
+                for (uint8_t idm = 0; idm < NDIM; ++idm)
+                {
+                    fcs[idm] = idm;
+                }
+                while (fcs[0] + NDIM <= nfc)
+                {
+                    real_type mat[NDIM][NDIM];
+                    real_type inv[NDIM][NDIM];
+                    real_type lprod = 1.0;
+                    for (uint8_t irw = 0; irw < NDIM; ++irw)
+                    {
+                        for (uint8_t idm = 0; idm < NDIM; ++idm)
+                        {
+                            mat[irw][idm] = dx[fcs[irw]][idm];
+                        }
+                        lprod *= len[fcs[irw]];
+                    }
+                    groups.push_back({std::fabs(detail::invert<NDIM>(mat, inv)) / lprod, fcs});
+                    // Advance to the next combination in lexicographical order.
+                    int ipos = NDIM - 1;
+                    while (ipos > 0 && fcs[ipos] + (NDIM - ipos) >= nfc)
+                    {
+                        --ipos;
+                    }
+                    ++fcs[ipos];
+                    for (uint8_t jpos = ipos + 1; jpos < NDIM; ++jpos)
+                    {
+                        fcs[jpos] = fcs[jpos - 1] + 1;
+                    }
+                }
+                std::stable_sort(
+                    groups.begin(), groups.end(), [](group_type const & a, group_type const & b)
+                    { return a.ratio > b.ratio; });
+
+                uint8_t ngrp = 0;
+                for (group_type const & grp : groups)
+                {
+                    if (ngrp >= NGROUP_MAX || (ngrp > 0 && grp.ratio < RATIO_MIN))
+                    {
+                        break;
+                    }
+                    real_type mat[NDIM][NDIM];
+                    real_type inv[NDIM][NDIM];
+                    for (uint8_t irw = 0; irw < NDIM; ++irw)
+                    {
+                        m_grpfcs(icl, ngrp, irw) = grp.fcs[irw];
+                        for (uint8_t idm = 0; idm < NDIM; ++idm)
+                        {
+                            mat[irw][idm] = dx[grp.fcs[irw]][idm];
+                        }
+                    }
+                    detail::invert<NDIM>(mat, inv);
+                    std::copy_n(&inv[0][0], NDIM * NDIM, m_grpmat.vptr(icl, ngrp, 0, 0));
+                    ++ngrp;
+                }
+                m_grpnum(icl) = ngrp;
+            } },
+        MARCH_GRAIN);
+}
+
+void EulerCore::calc_solt()
+{
+    MODMESH_TIME("EulerCore::calc_solt");
+    if (2 == ndim())
+    {
+        calc_solt_nd<2>();
+    }
+    else
+    {
+        calc_solt_nd<3>();
+    }
+}
+
+/// u_t = -sum_d A_d u_{x_d}, over the interior and the ghost cells.
+template <uint8_t NDIM>
+void EulerCore::calc_solt_nd()
+{
+    constexpr uint8_t NEQ = NDIM + 2;
+    int_type const ngst = static_cast<int_type>(ngstcell());
+    real_type const gamma = m_gamma;
+    parallel_for(
+        0, ngstcell() + ncell(), [&](size_t ibegin, size_t iend)
+        {
+            for (size_t irow = ibegin; irow < iend; ++irow)
+            {
+                int_type const icl = static_cast<int_type>(irow) - ngst;
+                detail::EulerFlux<NDIM> const flux(gamma, m_soln.vptr(icl, 0));
+                real_type const * du = m_dsoln.vptr(icl, 0, 0);
+                real_type ut[NEQ] = {};
+                for (uint8_t idm = 0; idm < NDIM; ++idm)
+                {
+                    real_type nml[NDIM] = {};
+                    nml[idm] = 1.0;
+                    real_type dux[NEQ];
+                    for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                    {
+                        dux[ieq] = du[ieq * NDIM + idm];
+                    }
+                    flux.add_derivative(nml, dux, ut);
+                }
+                real_type * solt = m_solt.vptr(icl, 0);
+                for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                {
+                    solt[ieq] = -ut[ieq];
+                }
+            } },
+        MARCH_GRAIN);
+}
+
+void EulerCore::update_cfl()
+{
+    MODMESH_TIME("EulerCore::update_cfl");
+    m_max_cfl = (2 == ndim()) ? update_cfl_nd<2>() : update_cfl_nd<3>();
+}
+
+template <uint8_t NDIM>
+EulerCore::real_type EulerCore::update_cfl_nd()
+{
+    real_type const hdt = 0.5 * m_time_increment;
+    real_type const gamma = m_gamma;
+    real_type ret = 0.0;
+    std::mutex ret_mutex;
+    parallel_for(
+        0, ncell(), [&](size_t ibegin, size_t iend)
+        {
+            real_type chunk_ret = 0.0;
+            for (size_t icl = ibegin; icl < iend; ++icl)
+            {
+                real_type const cfl = hdt * detail::EulerFlux<NDIM>(gamma, m_soln.vptr(icl, 0)).wave_speed() / m_cllen(icl);
+                m_cfl(icl) = cfl;
+                chunk_ret = std::max(chunk_ret, cfl);
+            }
+            std::lock_guard<std::mutex> const lock(ret_mutex);
+            ret = std::max(ret, chunk_ret); },
+        MARCH_GRAIN);
+    return ret;
+}
+
+void EulerCore::treat_boundary()
+{
+    MODMESH_TIME("EulerCore::treat_boundary");
+    if (2 == ndim())
+    {
+        treat_boundary_nd<2>();
+    }
+    else
+    {
+        treat_boundary_nd<3>();
+    }
+}
+
+template <uint8_t NDIM>
+void EulerCore::treat_boundary_nd()
+{
+    constexpr uint8_t NEQ = NDIM + 2;
+    StaticMesh const & mh = *m_mesh;
+    parallel_for(
+        0, mh.nbound(), [&](size_t ibegin, size_t iend)
+        {
+            for (size_t ibnd = ibegin; ibnd < iend; ++ibnd)
+            {
+                int_type const ifc = mh.bndfcs(ibnd, 0);
+                int_type const ibc = mh.bndfcs(ibnd, 1);
+                int_type const icl = mh.fccls(ifc, 0);
+                int_type const jcl = mh.fccls(ifc, 1);
+                real_type const * ui = m_soln.vptr(icl, 0);
+                real_type const * dui = m_dsoln.vptr(icl, 0, 0);
+                real_type * uj = m_soln.vptr(jcl, 0);
+                real_type * duj = m_dsoln.vptr(jcl, 0, 0);
+                switch (m_bctype[ibc])
+                {
+                case SLIPWALL:
+                {
+                    // Reflection matrix R = I - 2 n n^T by the wall.
+                    real_type const * nml = mh.fcnml().vptr(ifc, 0);
+                    real_type ref[NDIM][NDIM];
+                    for (uint8_t irw = 0; irw < NDIM; ++irw)
+                    {
+                        for (uint8_t icn = 0; icn < NDIM; ++icn)
+                        {
+                            ref[irw][icn] = (irw == icn ? 1.0 : 0.0) - 2.0 * nml[irw] * nml[icn];
+                        }
+                    }
+                    // The scalars and their gradients: u_g = u, grad u_g = R grad u.
+                    uj[0] = ui[0];
+                    uj[NDIM + 1] = ui[NDIM + 1];
+                    for (uint8_t ieq : {uint8_t(0), uint8_t(NDIM + 1)})
+                    {
+                        for (uint8_t irw = 0; irw < NDIM; ++irw)
+                        {
+                            real_type val = 0.0;
+                            for (uint8_t icn = 0; icn < NDIM; ++icn)
+                            {
+                                val += ref[irw][icn] * dui[ieq * NDIM + icn];
+                            }
+                            duj[ieq * NDIM + irw] = val;
+                        }
+                    }
+                    // The momentum and its gradient: m_g = R m, grad m_g = R (grad m) R.
+                    real_type tmp[NDIM][NDIM];
+                    for (uint8_t irw = 0; irw < NDIM; ++irw)
+                    {
+                        real_type val = 0.0;
+                        for (uint8_t icn = 0; icn < NDIM; ++icn)
+                        {
+                            val += ref[irw][icn] * ui[1 + icn];
+                            real_type prd = 0.0;
+                            for (uint8_t ikk = 0; ikk < NDIM; ++ikk)
+                            {
+                                prd += ref[irw][ikk] * dui[(1 + ikk) * NDIM + icn];
+                            }
+                            tmp[irw][icn] = prd;
+                        }
+                        uj[1 + irw] = val;
+                    }
+                    for (uint8_t irw = 0; irw < NDIM; ++irw)
+                    {
+                        for (uint8_t icn = 0; icn < NDIM; ++icn)
+                        {
+                            real_type prd = 0.0;
+                            for (uint8_t ikk = 0; ikk < NDIM; ++ikk)
+                            {
+                                prd += tmp[irw][ikk] * ref[ikk][icn];
+                            }
+                            duj[(1 + irw) * NDIM + icn] = prd;
+                        }
+                    }
+                    break;
+                }
+                case INLET:
+                    std::copy_n(m_bcinlet.vptr(ibc, 0), NEQ, uj);
+                    std::fill_n(duj, NEQ * NDIM, 0.0);
+                    break;
+                case NONREFLECTING:
+                default:
+                    std::copy_n(ui, NEQ, uj);
+                    std::fill_n(duj, NEQ * NDIM, 0.0);
+                    break;
+                }
+            } },
+        MARCH_GRAIN);
+}
+
+void EulerCore::setup_march()
+{
+    treat_boundary();
+    update_cfl();
+}
+
+template <size_t ALPHA>
+void EulerCore::march_half_alpha()
+{
+    MODMESH_TIME("EulerCore::march_half_alpha");
+    if (0 == ncell())
+    {
+        return;
+    }
+    if (!m_mesh->has_padded_connectivity())
+    {
+        throw std::runtime_error("EulerCore::march_half_alpha: padded connectivity of the mesh is dropped; call expand_csr() first");
+    }
+    calc_solt();
+    m_max_cfl = (2 == ndim()) ? march_half_nd<2, ALPHA>() : march_half_nd<3, ALPHA>();
+    m_soln.swap(m_usoln);
+    m_dsoln.swap(m_udsoln);
+    treat_boundary();
+}
+
+template <size_t ALPHA>
+void EulerCore::march_alpha(size_t steps)
+{
+    for (size_t istep = 0; istep < steps; ++istep)
+    {
+        march_half_alpha<ALPHA>();
+        real_type const cfl = m_max_cfl;
+        march_half_alpha<ALPHA>();
+        m_max_cfl = std::max(cfl, m_max_cfl);
+        m_time += m_time_increment;
+        ++m_nstep;
+    }
+}
+
+/// March the cells of each type with the kernel instantiated for its number of faces.
+template <uint8_t NDIM, size_t ALPHA>
+EulerCore::real_type EulerCore::march_half_nd()
+{
+    real_type ret = 0.0;
+    m_mesh->for_each_cell_type(
+        [&](auto traits, int_type const * begin, int_type const * end)
+        {
+            using traits_type = decltype(traits);
+            if constexpr (traits_type::ndim == NDIM)
+            {
+                real_type const cfl = march_cells<NDIM, traits_type::nface, ALPHA>(begin, static_cast<size_t>(end - begin));
+                ret = std::max(ret, cfl);
+            }
+        });
+    return ret;
+}
+
+/**
+ * The owner-computes kernel of a half step.  A cell gathers the bottom
+ * integrals and the lateral fluxes of its BCEs from the neighbors, writes
+ * its own new solution, gradient, and CFL number, and never scatters to a
+ * face or a neighbor, so that the cells are marched in parallel without
+ * coloring or atomics.
+ */
+template <uint8_t NDIM, uint8_t NFACE, size_t ALPHA>
+EulerCore::real_type EulerCore::march_cells(int_type const * cells, size_t ncl)
+{
+    constexpr uint8_t NEQ = NDIM + 2;
+    // Number of the nodes of a face, or 0 for the cells mixing triangular and quadrilateral faces.
+    constexpr int_type NSF = (2 == NDIM) ? 2 : (4 == NFACE ? 3 : (6 == NFACE ? 4 : 0));
+    using flux_type = detail::EulerFlux<NDIM>;
+
+    StaticMesh const & mh = *m_mesh;
+    real_type const hdt = 0.5 * m_time_increment;
+    real_type const qdt = 0.25 * m_time_increment;
+    real_type const gamma = m_gamma;
+
+    real_type ret = 0.0;
+    std::mutex ret_mutex;
+    parallel_for(
+        0, ncl, [&](size_t ibegin, size_t iend)
+        {
+            real_type chunk_ret = 0.0;
+            for (size_t it = ibegin; it < iend; ++it)
+            {
+                int_type const icl = cells[it];
+                real_type acc[NEQ] = {};
+                // Solution of the neighbors predicted to the new time level.
+                real_type upr[NFACE][NEQ];
+                for (uint8_t ifl = 0; ifl < NFACE; ++ifl)
+                {
+                    int_type const ifc = mh.clfcs(icl, ifl + 1);
+                    int_type const jcl = mh.fccls(ifc, 0) + mh.fccls(ifc, 1) - icl;
+                    real_type const * uj = m_soln.vptr(jcl, 0);
+                    real_type const * duj = m_dsoln.vptr(jcl, 0, 0);
+                    real_type const * utj = m_solt.vptr(jcl, 0);
+                    real_type const * xj = m_cecnd.vptr(jcl, 0, 0);
+
+                    // Bottom of the BCE.
+                    real_type const * xb = m_cecnd.vptr(icl, ifl + 1, 0);
+                    real_type const vol = m_cevol(icl, ifl + 1);
+                    for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                    {
+                        real_type val = uj[ieq];
+                        for (uint8_t idm = 0; idm < NDIM; ++idm)
+                        {
+                            val += duj[ieq * NDIM + idm] * (xb[idm] - xj[idm]);
+                        }
+                        acc[ieq] += vol * val;
+                        upr[ifl][ieq] = uj[ieq] + hdt * utj[ieq];
+                    }
+
+                    // Lateral surfaces of the BCE, at the middle of the half step.
+                    flux_type const flux(gamma, uj);
+                    int_type const nsf = NSF > 0 ? NSF : mh.fcnds(ifc, 0);
+                    real_type const * sfm = m_sfmrc.vptr(icl, ifl, 0, 0, 0);
+                    for (int_type isf = 0; isf < nsf; ++isf)
+                    {
+                        real_type const * mid = sfm + isf * 2 * NDIM;
+                        real_type const * nml = mid + NDIM;
+                        real_type du[NEQ];
+                        for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                        {
+                            real_type val = qdt * utj[ieq];
+                            for (uint8_t idm = 0; idm < NDIM; ++idm)
+                            {
+                                val += duj[ieq * NDIM + idm] * (mid[idm] - xj[idm]);
+                            }
+                            du[ieq] = val;
+                        }
+                        real_type fn[NEQ];
+                        flux.expand(nml, du, fn);
+                        for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                        {
+                            acc[ieq] -= hdt * fn[ieq];
+                        }
+                    }
+                }
+                real_type const vinv = 1.0 / m_cevol(icl, 0);
+                real_type ui[NEQ];
+                for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                {
+                    ui[ieq] = acc[ieq] * vinv;
+                }
+                std::copy_n(ui, NEQ, m_usoln.vptr(icl, 0));
+
+                // Gradient of each group, weighted by the inverse of its magnitude to the power alpha.
+                uint8_t const ngrp = m_grpnum(icl);
+                real_type gsum[NDIM][NEQ] = {};
+                real_type wsum[NEQ] = {};
+                for (uint8_t igp = 0; igp < ngrp; ++igp)
+                {
+                    uint8_t const * fls = m_grpfcs.vptr(icl, igp, 0);
+                    real_type const * inv = m_grpmat.vptr(icl, igp, 0, 0);
+                    real_type grd[NDIM][NEQ] = {};
+                    for (uint8_t irw = 0; irw < NDIM; ++irw)
+                    {
+                        real_type const * up = upr[fls[irw]];
+                        for (uint8_t idm = 0; idm < NDIM; ++idm)
+                        {
+                            real_type const coef = inv[idm * NDIM + irw];
+                            for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                            {
+                                grd[idm][ieq] += coef * (up[ieq] - ui[ieq]);
+                            }
+                        }
+                    }
+                    real_type wgt[NEQ];
+                    for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                    {
+                        wgt[ieq] = 1.0;
+                    }
+                    if constexpr (ALPHA > 0)
+                    {
+                        constexpr real_type TINY = 1.e-60;
+                        real_type mag[NEQ] = {};
+                        for (uint8_t idm = 0; idm < NDIM; ++idm)
+                        {
+                            for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                            {
+                                mag[ieq] += grd[idm][ieq] * grd[idm][ieq];
+                            }
+                        }
+                        for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                        {
+                            if constexpr (1 == ALPHA)
+                            {
+                                mag[ieq] = std::sqrt(mag[ieq]);
+                            }
+                            else if constexpr (ALPHA > 2)
+                            {
+                                mag[ieq] = std::pow(mag[ieq], static_cast<real_type>(ALPHA) / 2);
+                            }
+                            wgt[ieq] = 1.0 / (mag[ieq] + TINY);
+                        }
+                    }
+                    for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                    {
+                        wsum[ieq] += wgt[ieq];
+                    }
+                    for (uint8_t idm = 0; idm < NDIM; ++idm)
+                    {
+                        for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                        {
+                            gsum[idm][ieq] += wgt[ieq] * grd[idm][ieq];
+                        }
+                    }
+                }
+                real_type * dui = m_udsoln.vptr(icl, 0, 0);
+                for (uint8_t ieq = 0; ieq < NEQ; ++ieq)
+                {
+                    for (uint8_t idm = 0; idm < NDIM; ++idm)
+                    {
+                        dui[ieq * NDIM + idm] = gsum[idm][ieq] / wsum[ieq];
+                    }
+                }
+
+                real_type const cfl = hdt * flux_type(gamma, ui).wave_speed() / m_cllen(icl);
+                m_cfl(icl) = cfl;
+                chunk_ret = std::max(chunk_ret, cfl);
+            }
+            std::lock_guard<std::mutex> const lock(ret_mutex);
+            ret = std::max(ret, chunk_ret); },
+        MARCH_GRAIN);
+    return ret;
+}
+
+template void EulerCore::march_half_alpha<0>();
+template void EulerCore::march_half_alpha<1>();
+template void EulerCore::march_half_alpha<2>();
+template void EulerCore::march_alpha<0>(size_t);
+template void EulerCore::march_alpha<1>(size_t);
+template void EulerCore::march_alpha<2>(size_t);
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -34,9 +34,26 @@
 
 #include <modmesh/mesh/mesh.hpp>
 
+#include <vector>
+
 namespace modmesh
 {
 
+/**
+ * The CESE solver of the Euler equations for the calorically perfect gas on
+ * the two- or three-dimensional unstructured StaticMesh.
+ *
+ * The conservative variables of a cell are the density, the NDIM components
+ * of the momentum, and the total energy per unit volume.  A half step
+ * advances the solution of every interior cell by half of the time increment
+ * over its compounded conservation element (CCE), the union of the basic
+ * conservation elements (BCE) of the faces of the cell.  The BCE of a face is
+ * spanned by the face and the centroids of the two cells sharing it.  The
+ * solution on the bottom of a BCE and the space-time flux through its lateral
+ * surfaces are expanded from the neighboring cell across the face, so that
+ * the kernel gathers from the neighbors and writes only the owning cell.  The
+ * boundary conditions are imposed through the ghost cells of the mesh.
+ */
 class EulerCore
     : public NumberBase<int32_t, double>
     , public std::enable_shared_from_this<EulerCore>
@@ -55,17 +72,28 @@ public:
     using uint_type = typename number_base::uint_type;
     using real_type = typename number_base::real_type;
 
+    static constexpr uint8_t FCMND = StaticMesh::FCMND;
+    static constexpr uint8_t CLMFC = StaticMesh::CLMFC;
+    /// Maximum number of the neighbor groups used for the gradient of a cell.
+    static constexpr uint8_t NGROUP_MAX = 10;
+    /// Minimum number of cells marched by a thread.
+    static constexpr size_t MARCH_GRAIN = 1024;
+
+    /// Boundary conditions set through the ghost cells.
+    enum BoundaryType : uint8_t
+    {
+        NONREFLECTING = 0, ///< Copy the solution and zero the gradient.
+        SLIPWALL = 1, ///< Mirror the solution and the gradient by the wall.
+        INLET = 2, ///< Fix the solution and zero the gradient.
+    }; /* end enum BoundaryType */
+
     template <typename... Args>
     static std::shared_ptr<EulerCore> construct(Args &&... args)
     {
         return std::make_shared<EulerCore>(std::forward<Args>(args)..., ctor_passkey());
     }
 
-    EulerCore(std::shared_ptr<StaticMesh> const & mesh, real_type time_increment, ctor_passkey const &)
-        : m_mesh(mesh)
-        , m_time_increment(time_increment)
-    {
-    }
+    EulerCore(std::shared_ptr<StaticMesh> const & mesh, real_type time_increment, ctor_passkey const &);
 
     EulerCore() = delete;
     EulerCore(EulerCore const &) = delete;
@@ -74,10 +102,145 @@ public:
     EulerCore operator=(EulerCore &&) = delete;
     ~EulerCore() = default;
 
+    std::shared_ptr<StaticMesh> const & mesh() const { return m_mesh; }
+    uint8_t ndim() const { return m_mesh->ndim(); }
+    uint8_t neq() const { return m_mesh->ndim() + 2; }
+    uint_type ncell() const { return m_mesh->ncell(); }
+    uint_type ngstcell() const { return m_mesh->ngstcell(); }
+
+    real_type time_increment() const { return m_time_increment; }
+    void set_time_increment(real_type time_increment) { m_time_increment = time_increment; }
+
+    real_type time() const { return m_time; }
+    void set_time(real_type time) { m_time = time; }
+
+    size_t nstep() const { return m_nstep; }
+    void set_nstep(size_t nstep) { m_nstep = nstep; }
+
+    /// Ratio of the specific heats.
+    real_type gamma() const { return m_gamma; }
+    void set_gamma(real_type gamma);
+
+    /// Maximum CFL number calculated by the last half step or update_cfl().
+    real_type max_cfl() const { return m_max_cfl; }
+
+    // Boundary conditions, one for each of the StaticMeshBC of the mesh.
+public:
+
+    size_t nbc() const { return m_bctype.size(); }
+    BoundaryType bc_type(size_t ibc) const;
+    void set_bc(size_t ibc, BoundaryType type);
+    /// Set the boundary condition to INLET with the given primitive state.  The
+    /// state is kept in primitive variables and converted with the current
+    /// gamma, so a later set_gamma() applies to it.
+    void set_bc_inlet(size_t ibc, real_type density, SimpleArray<real_type> const & velocity, real_type pressure);
+
+    // Geometry of the conservation elements, calculated in the constructor.
+public:
+
+    /// (ngstcell + ncell, CLMFC + 1, ndim) centroids.  Item 0 of a cell is the
+    /// solution point (the centroid of the CCE) and item ifl + 1 the centroid
+    /// of the BCE of face ifl.
+    SimpleArray<real_type> const & cecnd() const { return m_cecnd; }
+    SimpleArray<real_type> & cecnd() { return m_cecnd; }
+    /// (ngstcell + ncell, CLMFC + 1) volumes of the CCE and the BCEs.
+    SimpleArray<real_type> const & cevol() const { return m_cevol; }
+    SimpleArray<real_type> & cevol() { return m_cevol; }
+    /// (ncell, CLMFC, FCMND, 2, ndim) centroids and area vectors of the
+    /// lateral surfaces of the BCEs, the latter pointing outward of the CCE.
+    SimpleArray<real_type> const & sfmrc() const { return m_sfmrc; }
+    SimpleArray<real_type> & sfmrc() { return m_sfmrc; }
+    /// (ncell) minimum distance from the solution point to the neighbors.
+    SimpleArray<real_type> const & cllen() const { return m_cllen; }
+    SimpleArray<real_type> & cllen() { return m_cllen; }
+
+    // Solution arrays.
+public:
+
+    /// (ngstcell + ncell, neq) conservative variables.
+    SimpleArray<real_type> const & soln() const { return m_soln; }
+    SimpleArray<real_type> & soln() { return m_soln; }
+    /// (ngstcell + ncell, neq, ndim) spatial derivatives of the variables.
+    SimpleArray<real_type> const & dsoln() const { return m_dsoln; }
+    SimpleArray<real_type> & dsoln() { return m_dsoln; }
+    /// (ngstcell + ncell, neq) temporal derivatives of the variables.
+    SimpleArray<real_type> const & solt() const { return m_solt; }
+    SimpleArray<real_type> & solt() { return m_solt; }
+    /// (ncell) CFL numbers.
+    SimpleArray<real_type> const & cfl() const { return m_cfl; }
+    SimpleArray<real_type> & cfl() { return m_cfl; }
+
+    /// Set the solution of the interior cells from the (ncell) density,
+    /// (ncell, ndim) velocity, and (ncell) pressure, and zero the gradient.
+    void set_primitive(SimpleArray<real_type> const & density, SimpleArray<real_type> const & velocity, SimpleArray<real_type> const & pressure);
+
+    SimpleArray<real_type> density() const;
+    SimpleArray<real_type> velocity() const;
+    SimpleArray<real_type> pressure() const;
+
+    // Marching.
+public:
+
+    void update_cfl();
+    void calc_solt();
+    void treat_boundary();
+    void setup_march();
+
+    template <size_t ALPHA>
+    void march_half_alpha();
+
+    template <size_t ALPHA>
+    void march_alpha(size_t steps);
+
 private:
 
+    void build_geometry();
+    template <uint8_t NDIM>
+    void build_geometry_nd();
+    template <uint8_t NDIM>
+    void build_group_nd();
+    template <uint8_t NDIM>
+    void calc_solt_nd();
+    template <uint8_t NDIM>
+    real_type update_cfl_nd();
+    template <uint8_t NDIM>
+    void treat_boundary_nd();
+    void update_bc_inlet(size_t ibc);
+    template <uint8_t NDIM, size_t ALPHA>
+    real_type march_half_nd();
+    template <uint8_t NDIM, uint8_t NFACE, size_t ALPHA>
+    real_type march_cells(int_type const * cells, size_t ncl);
+
     std::shared_ptr<StaticMesh> m_mesh;
     real_type m_time_increment = 0.0;
+    real_type m_time = 0.0;
+    size_t m_nstep = 0;
+    real_type m_gamma = 1.4;
+    real_type m_max_cfl = 0.0;
+
+    std::vector<BoundaryType> m_bctype;
+    /// (nbc, neq) density, velocity, and pressure of the INLET conditions.
+    SimpleArray<real_type> m_bcinlet_prim;
+    /// (nbc, neq) conservative variables converted from m_bcinlet_prim.
+    SimpleArray<real_type> m_bcinlet;
+
+    SimpleArray<real_type> m_cecnd;
+    SimpleArray<real_type> m_cevol;
+    SimpleArray<real_type> m_sfmrc;
+    SimpleArray<real_type> m_cllen;
+    /// Number of the neighbor groups of a cell.
+    SimpleArray<uint8_t> m_grpnum;
+    /// Local face indices of the ndim neighbors in a group.
+    SimpleArray<uint8_t> m_grpfcs;
+    /// Inverse of the matrix of the displacements to the neighbors in a group.
+    SimpleArray<real_type> m_grpmat;
+
+    SimpleArray<real_type> m_soln;
+    SimpleArray<real_type> m_dsoln;
+    SimpleArray<real_type> m_solt;
+    SimpleArray<real_type> m_usoln;
+    SimpleArray<real_type> m_udsoln;
+    SimpleArray<real_type> m_cfl;
 
 }; /* end class EulerCore */
 
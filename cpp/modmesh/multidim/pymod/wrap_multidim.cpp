@@ -65,6 +65,126 @@ protected:
                     }),
                 py::arg("mesh"),
                 py::arg("time_increment"));
+
+#define MM_DECL_STATIC(NAME) \
+    .def_property_readonly_static(#NAME, [](py::object const &) { return static_cast<uint8_t>(wrapped_type::NAME); })
+
+        // clang-format off
+        (*this)
+            MM_DECL_STATIC(NONREFLECTING)
+            MM_DECL_STATIC(SLIPWALL)
+            MM_DECL_STATIC(INLET)
+            MM_DECL_STATIC(NGROUP_MAX)
+        ;
+        // clang-format on
+
+#undef MM_DECL_STATIC
+
+        (*this)
+            .def_property_readonly("mesh", &wrapped_type::mesh)
+            .def_property_readonly("ndim", &wrapped_type::ndim)
+            .def_property_readonly("neq", &wrapped_type::neq)
+            .def_property_readonly("ncell", &wrapped_type::ncell)
+            .def_property_readonly("ngstcell", &wrapped_type::ngstcell)
+            .def_property("time_increment", &wrapped_type::time_increment, &wrapped_type::set_time_increment)
+            .def_property("time", &wrapped_type::time, &wrapped_type::set_time)
+            .def_property("nstep", &wrapped_type::nstep, &wrapped_type::set_nstep)
+            .def_property("gamma", &wrapped_type::gamma, &wrapped_type::set_gamma)
+            .def_property_readonly("max_cfl", &wrapped_type::max_cfl);
+
+        (*this)
+            .def_property_readonly("nbc", &wrapped_type::nbc)
+            .def(
+                "bc_type",
+                [](wrapped_type const & self, size_t ibc)
+                { return static_cast<uint8_t>(self.bc_type(ibc)); },
+                py::arg("ibc"))
+            .def(
+                "set_bc",
+                [](wrapped_type & self, size_t ibc, uint8_t type)
+                { self.set_bc(ibc, static_cast<wrapped_type::BoundaryType>(type)); },
+                py::arg("ibc"),
+                py::arg("type"))
+            .def(
+                "set_bc_inlet",
+                [](wrapped_type & self, size_t ibc, double density, py::array_t<double> & velocity, double pressure)
+                { self.set_bc_inlet(ibc, density, makeSimpleArray(velocity), pressure); },
+                py::arg("ibc"),
+                py::arg("density"),
+                py::arg("velocity"),
+                py::arg("pressure"));
+
+#define MM_DECL_ARRAY(NAME) \
+    .expose_SimpleArray(#NAME, [](wrapped_type & self) -> decltype(auto) { return self.NAME(); })
+
+        // clang-format off
+        (*this)
+            MM_DECL_ARRAY(cecnd)
+            MM_DECL_ARRAY(cevol)
+            MM_DECL_ARRAY(sfmrc)
+            MM_DECL_ARRAY(cllen)
+            MM_DECL_ARRAY(soln)
+            MM_DECL_ARRAY(dsoln)
+            MM_DECL_ARRAY(solt)
+            MM_DECL_ARRAY(cfl)
+        ;
+        // clang-format on
+
+#undef MM_DECL_ARRAY
+
+        (*this)
+            .def_timed(
+                "set_primitive",
+                [](wrapped_type & self, py::array_t<double> & density, py::array_t<double> & velocity, py::array_t<double> & pressure)
+                { self.set_primitive(makeSimpleArray(density), makeSimpleArray(velocity), makeSimpleArray(pressure)); },
+                py::arg("density"),
+                py::arg("velocity"),
+                py::arg("pressure"))
+            .def_property_readonly(
+                "density",
+                [](wrapped_type & self)
+                { return to_ndarray(self.density()); })
+            .def_property_readonly(
+                "velocity",
+                [](wrapped_type & self)
+                { return to_ndarray(self.velocity()); })
+            .def_property_readonly(
+                "pressure",
+                [](wrapped_type & self)
+                { return to_ndarray(self.pressure()); });
+
+        (*this)
+            .def_timed("update_cfl", &wrapped_type::update_cfl)
+            .def_timed("calc_solt", &wrapped_type::calc_solt)
+            .def_timed("treat_boundary", &wrapped_type::treat_boundary)
+            .def_timed("setup_march", &wrapped_type::setup_march)
+            .def_group_march<0>()
+            .def_group_march<1>()
+            .def_group_march<2>();
+    }
+
+    template <size_t ALPHA>
+    wrapper_type & def_group_march()
+    {
+        // NOLINTNEXTLINE(misc-unused-alias-decls)
+        namespace py = pybind11;
+
+        (*this)
+            .def_timed(
+                (Formatter() << "march_half_alpha" << ALPHA).str().c_str(),
+                [](wrapped_type & self)
+                {
+                    self.template march_half_alpha<ALPHA>();
+                })
+            .def_timed(
+                (Formatter() << "march_alpha" << ALPHA).str().c_str(),
+                [](wrapped_type & self, size_t steps)
+                {
+                    self.template march_alpha<ALPHA>(steps);
+                },
+                py::arg("steps"));
+
+        return *this;
     }
 
 }; /* end class WrapEulerCore */
@@ -0,0 +1,476 @@
+#pragma once
+
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * CESE solver of one-dimensional systems of conservation laws, generic over
+ * the flux policy.
+ */
+
+#include <modmesh/onedim/Conservation1DFlux.hpp>
+#include <modmesh/onedim/Euler1DCore.hpp>
+#include <modmesh/base.hpp>
+#include <modmesh/math/math.hpp>
+#include <modmesh/buffer/buffer.hpp>
+#include <modmesh/parallel.hpp>
+#include <modmesh/toggle/profile.hpp>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace modmesh
+{
+
+namespace onedim
+{
+
+namespace detail
+{
+
+template <typename F, size_t... I>
+inline void unroll(F && func, std::index_sequence<I...>)
+{
+    (func(I), ...);
+}
+
+} /* end namespace detail */
+
+/// Call func(i) for i in [0, N), unrolled at compile time.  The vectorizer
+/// does not see through a loop nest over the variables inside the loop over
+/// the lanes, so the kernel unrolls the loops over the variables by itself.
+template <size_t N, typename F>
+inline void unroll(F && func)
+{
+    detail::unroll(std::forward<F>(func), std::make_index_sequence<N>());
+}
+
+/**
+ * The CESE kernel of a solution element of the system defined by the flux
+ * policy P.  It is the generalization of Euler1DKernel: the loops over the
+ * NVAR variables are unrolled at compile time, and the policy functions are
+ * inlined.
+ */
+template <typename P>
+struct Conservation1DKernel
+{
+    static constexpr size_t NVAR = P::NVAR;
+    static constexpr double tiny = 1.e-100;
+
+    /// Calculate the CFL number of a solution element from the wave speed.
+    static double cfl(P const & policy, double const (&u)[NVAR], double hdt, double dxmin)
+    {
+        return hdt * policy.wave_speed(u) / dxmin;
+    }
+
+    /// Calculate the product of the Jacobian and a vector.
+    static void product(double const (&jac)[NVAR][NVAR], double const (&x)[NVAR], double (&y)[NVAR])
+    {
+        unroll<NVAR>(
+            [&](size_t iv)
+            {
+                y[iv] = 0;
+                unroll<NVAR>([&](size_t jv)
+                             { y[iv] += jac[iv][jv] * x[jv]; });
+            });
+    }
+
+    /**
+     * Calculate the fluxes through the lower-left and lower-right boundaries of
+     * the conservation elements next to a solution element, and the value at
+     * its t+ tip.  The output is 3 * NVAR values spaced by stride: flux_ll,
+     * flux_lr, and up, each for the NVAR variables.  geo is dxctr, deltax_ll,
+     * dxmid_ll, deltax_lr, and dxmid_lr of Euler1DMetric.
+     */
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    static void derive(P const & policy, double hdt, double qdt, double const (&geo)[5], double const (&u)[NVAR], double const (&ux)[NVAR], double * out, size_t stride)
+    {
+        double f[NVAR];
+        double jac[NVAR][NVAR];
+        policy.flux(u, f);
+        policy.jacobian(u, jac);
+
+        // ut = -fx = -d[f,u] \cdot ux
+        double ut[NVAR];
+        product(jac, ux, ut);
+        unroll<NVAR>([&](size_t iv)
+                     { ut[iv] = -ut[iv]; });
+
+        // ft = d[f,u] \cdot ut
+        double ft[NVAR];
+        product(jac, ut, ft);
+
+        unroll<NVAR>(
+            [&](size_t iv)
+            {
+                double const ht = hdt * (f[iv] - geo[0] * ut[iv] + qdt * ft[iv]);
+                out[iv * stride] = geo[1] * (u[iv] + geo[2] * ux[iv]) + ht;
+                out[(NVAR + iv) * stride] = geo[3] * (u[iv] + geo[4] * ux[iv]) - ht;
+                // Displacement in x and t.
+                out[(2 * NVAR + iv) * stride] = u[iv] + geo[0] * ux[iv] + hdt * ut[iv];
+            });
+    }
+}; /* end struct Conservation1DKernel */
+
+/**
+ * Evaluate Conservation1DKernel for W solution elements at once, in the same
+ * layout as Euler1DLanes.
+ */
+template <typename P, size_t W>
+struct Conservation1DLanes
+{
+    static constexpr size_t NVAR = P::NVAR;
+    static constexpr size_t WIDTH = W;
+    static constexpr size_t NVAL = 3 * NVAR;
+    static constexpr size_t NSLOT = W + 1;
+    static constexpr double tiny = Conservation1DKernel<P>::tiny;
+
+    explicit Conservation1DLanes(double time_increment)
+        : hdt(time_increment / 2.0)
+        , qdt(hdt / 2.0)
+    {
+    }
+
+    /// Derive the solution elements ic, ic+2, ..., ic+2*(W-1) into slots 1 to
+    /// W.  The elements beyond iclast repeat iclast.
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    void derive(P const & policy, int_type ic, int_type iclast, Euler1DMetric const & metric, SimpleArray<double> const & so0, SimpleArray<double> const & so1)
+    {
+        double geo[5][W];
+        double u[NVAR][W];
+        double ux[NVAR][W];
+        for (size_t il = 0; il < W; ++il)
+        {
+            int_type const jc = std::min(ic + static_cast<int_type>(2 * il), iclast);
+            geo[0][il] = metric.dxctr(jc);
+            geo[1][il] = metric.deltax_ll(jc);
+            geo[2][il] = metric.dxmid_ll(jc);
+            geo[3][il] = metric.deltax_lr(jc);
+            geo[4][il] = metric.dxmid_lr(jc);
+            for (size_t iv = 0; iv < NVAR; ++iv)
+            {
+                u[iv][il] = so0(jc, iv);
+                ux[iv][il] = so1(jc, iv);
+            }
+        }
+        // A local copy of the policy does not alias the stores to val.
+        P const lpolicy = policy;
+        for (size_t il = 0; il < W; ++il)
+        {
+            double const lgeo[5] = {geo[0][il], geo[1][il], geo[2][il], geo[3][il], geo[4][il]};
+            double lu[NVAR];
+            double lux[NVAR];
+            unroll<NVAR>(
+                [&](size_t iv)
+                {
+                    lu[iv] = u[iv][il];
+                    lux[iv] = ux[iv][il];
+                });
+            Conservation1DKernel<P>::derive(lpolicy, hdt, qdt, lgeo, lu, lux, &val[0][il + 1], NSLOT);
+        }
+    }
+
+    void advance()
+    {
+        for (size_t it = 0; it < NVAL; ++it)
+        {
+            val[it][0] = val[it][W];
+        }
+    }
+
+    double const * flux_ll(size_t iv) const { return val[iv]; }
+    double const * flux_lr(size_t iv) const { return val[NVAR + iv]; }
+    double const * up(size_t iv) const { return val[2 * NVAR + iv]; }
+
+    double hdt; //< Half of time increment.
+    double qdt; //< Quarter of time increment.
+    double val[NVAL][NSLOT]; //< flux_ll, flux_lr, and up of the slots.
+}; /* end struct Conservation1DLanes */
+
+/**
+ * Solver of a one-dimensional system of conservation laws by the CESE method.
+ * The system is defined by the flux policy P (see Conservation1DFlux.hpp),
+ * and the number of variables P::NVAR is fixed at compile time.  The grid,
+ * march, and non-reflecting boundary condition are the same as
+ * Euler1DCore, which is the hand-written solver of Euler1DFlux, and both
+ * march by Lanes1DMarch.  The solution is double, and the core has no
+ * checkpoint or adaptive time stepping of Euler1DCore.
+ */
+template <typename P>
+class Conservation1DCore
+    : public std::enable_shared_from_this<Conservation1DCore<P>>
+{
+
+public:
+
+    using policy_type = P;
+
+    constexpr static size_t BOUND_COUNT = 2;
+    static constexpr uint8_t NVAR = P::NVAR;
+    /// Number of solution elements evaluated together in the march.
+    static constexpr size_t LANES = 8;
+    /// Minimal number of conservation elements in a chunk of a parallel loop.
+    static constexpr size_t MARCH_GRAIN = 4096;
+
+private:
+
+    using lanes_type = Conservation1DLanes<P, LANES>;
+    using march_type = Lanes1DMarch<lanes_type>;
+
+    struct ctor_passkey
+    {
+    };
+
+public:
+
+    std::shared_ptr<Conservation1DCore> clone()
+    {
+        auto ret = std::make_shared<Conservation1DCore>(*this);
+        return ret;
+    }
+
+    template <class... Args>
+    static std::shared_ptr<Conservation1DCore> construct(Args &&... args)
+    {
+        return std::make_shared<Conservation1DCore>(std::forward<Args>(args)..., ctor_passkey());
+    }
+
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    Conservation1DCore(size_t ncoord, double time_increment, P const & policy, ctor_passkey const &)
+        : m_policy(policy)
+        , m_time_increment(time_increment)
+    {
+        initialize_data(ncoord);
+    }
+
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    Conservation1DCore(size_t ncoord, double time_increment, ctor_passkey const & passkey)
+        : Conservation1DCore(ncoord, time_increment, P(), passkey)
+    {
+    }
+
+    Conservation1DCore() = delete;
+    Conservation1DCore(Conservation1DCore const &) = default;
+    Conservation1DCore(Conservation1DCore &&) = default;
+    Conservation1DCore & operator=(Conservation1DCore const &) = default;
+    Conservation1DCore & operator=(Conservation1DCore &&) = default;
+    ~Conservation1DCore() = default;
+
+    void initialize_data(size_t ncoord);
+
+    /// The flux policy, which holds the constants of the system.
+    P const & policy() const { return m_policy; }
+    P & policy() { return m_policy; }
+
+    double time_increment() const { return m_time_increment; }
+    void set_time_increment(double time_increment) { m_time_increment = time_increment; }
+
+    /// Time marched by march_alpha().
+    double time() const { return m_time; }
+    void set_time(double time) { m_time = time; }
+
+    /// Number of steps marched by march_alpha().
+    size_t nstep() const { return m_nstep; }
+    void set_nstep(size_t nstep) { m_nstep = nstep; }
+
+    /// Maximum CFL number calculated by the last update_cfl().
+    double max_cfl() const { return m_max_cfl; }
+
+    size_t ncoord() const { return m_coord.size(); }
+    SimpleArray<double> const & coord() const { return m_coord; }
+    /// Return the coordinates for writing.  The geometric coefficients are
+    /// recomputed when the coordinates differ from the ones they were
+    /// computed from, so a write through a kept view is picked up as well.
+    SimpleArray<double> & coord()
+    {
+        return m_coord;
+    }
+
+    /// Geometric coefficients of the grid, refreshed for the current
+    /// coordinates.
+    Euler1DMetric const & metric() const
+    {
+        refresh_metric();
+        return m_metric;
+    }
+    /// Recompute the geometric coefficients.  setup_march() calls it, and
+    /// the march calls refresh_metric() to pick up changed coordinates.
+    void update_metric() const
+    {
+        m_metric.update(m_coord);
+        m_metric_coord.assign(m_coord.data(), m_coord.data() + m_coord.size());
+    }
+
+    SimpleArray<double> const & cfl() const { return m_cfl; }
+    SimpleArray<double> & cfl() { return m_cfl; }
+
+    SimpleArray<double> const & so0() const { return m_so0; }
+    SimpleArray<double> & so0() { return m_so0; }
+
+    SimpleArray<double> const & so1() const { return m_so1; }
+    SimpleArray<double> & so1() { return m_so1; }
+
+    void update_cfl(bool odd_plane);
+    void treat_boundary_so0() { march_type::copy_boundary(m_so0); }
+    void treat_boundary_so1() { march_type::copy_boundary(m_so1); }
+
+    void setup_march()
+    {
+        update_metric();
+        update_cfl(false);
+    }
+    template <size_t ALPHA>
+    void march_half_alpha(bool odd_plane);
+    template <size_t ALPHA>
+    void march_half1_alpha() { march_half_alpha<ALPHA>(/*odd_plane*/ false); }
+    template <size_t ALPHA>
+    void march_half2_alpha() { march_half_alpha<ALPHA>(/*odd_plane*/ true); }
+    template <size_t ALPHA>
+    void march_alpha(size_t steps);
+
+private:
+
+    void refresh_metric() const
+    {
+        if (m_metric_coord.size() != m_coord.size() || !std::equal(m_metric_coord.begin(), m_metric_coord.end(), m_coord.data()))
+        {
+            update_metric();
+        }
+    }
+    double cfl_at(int_type ic, double hdt) const;
+
+    P m_policy;
+    real_type m_time_increment = 0;
+    real_type m_time = 0;
+    real_type m_max_cfl = 0;
+    size_t m_nstep = 0;
+    SimpleArray<double> m_coord;
+    // Computed from the coordinates, so const accessors may refresh them.
+    mutable Euler1DMetric m_metric;
+    mutable std::vector<double> m_metric_coord;
+    SimpleArray<double> m_cfl;
+    SimpleArray<double> m_so0;
+    SimpleArray<double> m_so1;
+}; /* end class Conservation1DCore */
+
+using GenericEuler1DCore = Conservation1DCore<Euler1DFlux>;
+using IsothermalEuler1DCore = Conservation1DCore<IsothermalEuler1DFlux>;
+using ShallowWater1DCore = Conservation1DCore<ShallowWater1DFlux>;
+
+template <typename P>
+inline void Conservation1DCore<P>::initialize_data(size_t ncoord)
+{
+    if (0 == ncoord % 2)
+    {
+        throw std::invalid_argument("ncoord cannot be even");
+    }
+    m_coord = SimpleArray<double>(/*length*/ ncoord);
+    m_cfl = SimpleArray<double>(/*length*/ ncoord);
+    m_so0 = SimpleArray<double>(/*shape*/ small_vector<size_t>{ncoord, NVAR});
+    m_so1 = SimpleArray<double>(/*shape*/ small_vector<size_t>{ncoord, NVAR});
+    update_metric();
+}
+
+template <typename P>
+inline double Conservation1DCore<P>::cfl_at(int_type ic, double hdt) const
+{
+    double u[NVAR];
+    for (size_t iv = 0; iv < NVAR; ++iv)
+    {
+        u[iv] = m_so0(ic, iv);
+    }
+    return Conservation1DKernel<P>::cfl(m_policy, u, hdt, m_metric.dxmin(ic));
+}
+
+template <typename P>
+inline void Conservation1DCore<P>::update_cfl(bool odd_plane)
+{
+    MODMESH_TIME("Conservation1DCore::update_cfl");
+    refresh_metric();
+    const int_type start = BOUND_COUNT - (odd_plane ? 1 : 0);
+    const auto stop = static_cast<int_type>(ncoord() - BOUND_COUNT - (odd_plane ? 0 : 1));
+    const double hdt = m_time_increment / 2;
+    double max_cfl = 0;
+    for (int_type it = start; it < stop; it += 2)
+    {
+        const double cfl = cfl_at(it, hdt);
+        m_cfl(it) = cfl;
+        max_cfl = std::max(max_cfl, cfl);
+    }
+    m_max_cfl = max_cfl;
+}
+
+/**
+ * Calculate so0 and so1 at the next half time step, and the CFL number at
+ * the current plane, in one loop.
+ */
+template <typename P>
+template <size_t ALPHA>
+inline void Conservation1DCore<P>::march_half_alpha(bool odd_plane)
+{
+    MODMESH_TIME("Conservation1DCore::march_half_alpha");
+    refresh_metric();
+    double const hdt = m_time_increment / 2;
+    m_max_cfl = march_type::march(
+        odd_plane, ncoord(), m_time_increment, MARCH_GRAIN,
+        [this](lanes_type & lanes, int_type ic, int_type iclast)
+        { lanes.derive(m_policy, ic, iclast, m_metric, m_so0, m_so1); },
+        [this, hdt](int_type ic, lanes_type const & lanes, size_t nlane)
+        {
+            march_type::block_so0(ic, lanes, nlane, m_metric, m_so0);
+            double const max_cfl = march_type::block_cfl(
+                ic, nlane, [this, hdt](int_type jc)
+                { return cfl_at(jc, hdt); },
+                m_cfl);
+            march_type::template block_so1_alpha<ALPHA>(ic, lanes, nlane, m_metric, m_so0, m_so1);
+            return max_cfl;
+        });
+}
+
+template <typename P>
+template <size_t ALPHA>
+inline void Conservation1DCore<P>::march_alpha(size_t steps)
+{
+    for (size_t it = 0; it < steps; ++it)
+    {
+        march_half1_alpha<ALPHA>();
+        treat_boundary_so0();
+        treat_boundary_so1();
+        // In the second half step, no treating boundary conditions.
+        march_half2_alpha<ALPHA>();
+        m_time += m_time_increment;
+        ++m_nstep;
+    }
+}
+
+} /* end namespace onedim */
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
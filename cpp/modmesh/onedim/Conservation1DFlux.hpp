@@ -0,0 +1,178 @@
+#pragma once
+
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/**
+ * Flux policies of the one-dimensional conservation laws for
+ * Conservation1DCore.
+ */
+
+#include <modmesh/base.hpp>
+
+#include <cmath>
+
+namespace modmesh
+{
+
+namespace onedim
+{
+
+/**
+ * A flux policy defines a system of NVAR conservation laws u_t + f(u)_x = 0
+ * for Conservation1DCore.  It provides the following inline functions of the
+ * solution u of a point, and may hold the constants of the system:
+ *
+ * - flux(u, f): the flux f(u).
+ * - jacobian(u, jac): the Jacobian df/du, jac[i][j] = df_i/du_j.
+ * - wave_speed(u): the maximal absolute characteristic speed.
+ *
+ * NVAR is a compile-time constant, so that the loops over the variables in
+ * the core are unrolled and the policy is inlined.
+ */
+
+/// Euler equations of a calorically perfect gas.  The variables are density,
+/// momentum, and total energy per volume.
+struct Euler1DFlux
+{
+
+    static constexpr uint8_t NVAR = 3;
+    static constexpr double TINY = 1.e-100;
+
+    double gamma = 1.4; ///< Heat capacity ratio.
+
+    void flux(double const (&u)[NVAR], double (&f)[NVAR]) const
+    {
+        double const rho_inv = 1.0 / (u[0] + TINY);
+        double const v = u[1] * rho_inv;
+        double const e = u[2] * rho_inv;
+        double const v2 = v * v;
+        double const gm1 = gamma - 1.0;
+        f[0] = u[1];
+        f[1] = gm1 * u[2] + 0.5 * (3.0 - gamma) * u[1] * v;
+        f[2] = u[1] * (gamma * e - 0.5 * gm1 * v2);
+    }
+
+    void jacobian(double const (&u)[NVAR], double (&jac)[NVAR][NVAR]) const
+    {
+        double const rho_inv = 1.0 / (u[0] + TINY);
+        double const v = u[1] * rho_inv;
+        double const e = u[2] * rho_inv;
+        double const v2 = v * v;
+        double const gm1 = gamma - 1.0;
+        jac[0][0] = 0.0;
+        jac[0][1] = 1.0;
+        jac[0][2] = 0.0;
+        jac[1][0] = 0.5 * (gamma - 3.0) * v2;
+        jac[1][1] = (3.0 - gamma) * v;
+        jac[1][2] = gm1;
+        jac[2][0] = v * (gm1 * v2 - gamma * e);
+        jac[2][1] = gamma * e - 1.5 * gm1 * v2;
+        jac[2][2] = gamma * v;
+    }
+
+    double wave_speed(double const (&u)[NVAR]) const
+    {
+        double const rho_inv = 1.0 / u[0];
+        double pr = (gamma - 1.0) * (u[2] - 0.5 * u[1] * u[1] * rho_inv);
+        pr = (pr + std::abs(pr)) / 2.0;
+        return std::sqrt(gamma * pr * rho_inv) + std::abs(u[1]) * rho_inv;
+    }
+
+}; /* end struct Euler1DFlux */
+
+/// Isothermal Euler equations, whose pressure is sound_speed^2 * density.
+/// The variables are density and momentum.
+struct IsothermalEuler1DFlux
+{
+
+    static constexpr uint8_t NVAR = 2;
+    static constexpr double TINY = 1.e-100;
+
+    double sound_speed = 1.0;
+
+    void flux(double const (&u)[NVAR], double (&f)[NVAR]) const
+    {
+        double const v = u[1] / (u[0] + TINY);
+        f[0] = u[1];
+        f[1] = u[1] * v + sound_speed * sound_speed * u[0];
+    }
+
+    void jacobian(double const (&u)[NVAR], double (&jac)[NVAR][NVAR]) const
+    {
+        double const v = u[1] / (u[0] + TINY);
+        jac[0][0] = 0.0;
+        jac[0][1] = 1.0;
+        jac[1][0] = sound_speed * sound_speed - v * v;
+        jac[1][1] = 2.0 * v;
+    }
+
+    double wave_speed(double const (&u)[NVAR]) const
+    {
+        return std::abs(u[1] / (u[0] + TINY)) + sound_speed;
+    }
+
+}; /* end struct IsothermalEuler1DFlux */
+
+/// Shallow water equations.  The variables are depth and discharge (depth
+/// times velocity).
+struct ShallowWater1DFlux
+{
+
+    static constexpr uint8_t NVAR = 2;
+    static constexpr double TINY = 1.e-100;
+
+    double gravity = 9.80665; ///< Gravitational acceleration.
+
+    void flux(double const (&u)[NVAR], double (&f)[NVAR]) const
+    {
+        double const v = u[1] / (u[0] + TINY);
+        f[0] = u[1];
+        f[1] = u[1] * v + 0.5 * gravity * u[0] * u[0];
+    }
+
+    void jacobian(double const (&u)[NVAR], double (&jac)[NVAR][NVAR]) const
+    {
+        double const v = u[1] / (u[0] + TINY);
+        jac[0][0] = 0.0;
+        jac[0][1] = 1.0;
+        jac[1][0] = gravity * u[0] - v * v;
+        jac[1][1] = 2.0 * v;
+    }
+
+    double wave_speed(double const (&u)[NVAR]) const
+    {
+        double const h = u[0] > 0 ? u[0] : 0.0;
+        return std::abs(u[1] / (u[0] + TINY)) + std::sqrt(gravity * h);
+    }
+
+}; /* end struct ShallowWater1DFlux */
+
+} /* end namespace onedim */
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
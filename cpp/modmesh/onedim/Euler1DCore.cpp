@@ -27,8 +27,11 @@
  */
 
 #include <modmesh/onedim/Euler1DCore.hpp>
+#include <modmesh/serialization/Checkpoint.hpp>
 #include <modmesh/toggle/profile.hpp>
 #include <cmath>
+#include <iterator>
+#include <type_traits>
 
 namespace modmesh
 {
@@ -36,13 +39,130 @@ namespace modmesh
 namespace onedim
 {
 
-std::ostream & operator<<(std::ostream & os, const Euler1DCore & sol)
+namespace detail
 {
-    os << "Euler1DCore(ncoord=" << sol.ncoord() << ", time_increment=" << sol.time_increment() << ")";
+
+constexpr char const * euler1d_snapshot_fields[] = {
+    "coord", "so0", "so1", "cfl", "gamma", "density", "velocity", "pressure", "temperature", "internal_energy", "entropy"};
+
+/// Add a solution array to a checkpoint.  A float array is always stored in
+/// float32.
+template <typename T>
+void add_checkpoint_array(CheckpointWriter & writer, std::string const & name, SimpleArray<T> const & arr, bool float32)
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        writer.add_array(name, arr);
+    }
+    else
+    {
+        writer.add_array(name, arr, float32);
+    }
+}
+
+/// Convert an array read from a checkpoint to the storage type of the solver.
+template <typename T>
+SimpleArray<T> convert_checkpoint_array(SimpleArray<double> && arr)
+{
+    if constexpr (std::is_same_v<T, double>)
+    {
+        return std::move(arr);
+    }
+    else
+    {
+        SimpleArray<T> ret(arr.shape());
+        for (size_t it = 0; it < arr.size(); ++it)
+        {
+            ret.data(it) = static_cast<T>(arr.data(it));
+        }
+        return ret;
+    }
+}
+
+} /* end namespace detail */
+
+template <typename T>
+std::ostream & operator<<(std::ostream & os, const BasicEuler1DCore<T> & sol)
+{
+    os << (std::is_same_v<T, float> ? "Euler1DCoreFp32" : "Euler1DCore") << "(ncoord=" << sol.ncoord() << ", time_increment=" << sol.time_increment() << ")";
     return os;
 }
 
-void Euler1DCore::initialize_data(size_t ncoord)
+Euler1DPrimitives::Euler1DPrimitives(size_t ncoord)
+{
+    for (char const * name : FIELDS)
+    {
+        field(name) = SimpleArray<double>(ncoord);
+    }
+}
+
+Euler1DPrimitives::Euler1DPrimitives(size_t ncoord, std::vector<std::string> const & fields)
+{
+    for (std::string const & name : fields)
+    {
+        field(name) = SimpleArray<double>(ncoord);
+    }
+}
+
+SimpleArray<double> & Euler1DPrimitives::field(std::string const & name)
+{
+    if ("density" == name)
+    {
+        return density;
+    }
+    if ("velocity" == name)
+    {
+        return velocity;
+    }
+    if ("pressure" == name)
+    {
+        return pressure;
+    }
+    if ("temperature" == name)
+    {
+        return temperature;
+    }
+    if ("internal_energy" == name)
+    {
+        return internal_energy;
+    }
+    if ("entropy" == name)
+    {
+        return entropy;
+    }
+    throw std::invalid_argument(Formatter() << "Euler1DPrimitives: unknown field \"" << name << "\"");
+}
+
+void Euler1DMetric::update(SimpleArray<double> const & coord)
+{
+    MODMESH_TIME("Euler1DMetric::update");
+    size_t const ncoord = coord.size();
+    for (CopyOnWriteArray<double> * arr : {&dxctr, &deltax_ll, &dxmid_ll, &deltax_lr, &dxmid_lr, &dx_inv, &dxneg_inv, &dxpos_inv, &dxmin})
+    {
+        *arr = SimpleArray<double>(/*shape*/ small_vector<size_t>{ncoord}, /*value*/ 0.0);
+    }
+    for (size_t it = 1; it + 1 < ncoord; ++it)
+    {
+        double const x = coord(it);
+        double const xneg = coord(it - 1);
+        double const xpos = coord(it + 1);
+        double const xctr = (xpos + xneg) * 0.5;
+        double const dxneg = x - xneg;
+        double const dxpos = xpos - x;
+        dxctr(it) = x - xctr;
+        deltax_ll(it) = dxpos;
+        dxmid_ll(it) = 0.5 * (x + xpos) - xctr;
+        deltax_lr(it) = dxneg;
+        dxmid_lr(it) = 0.5 * (x + xneg) - xctr;
+        dx_inv(it) = 1.0 / (xpos - xneg);
+        dxneg_inv(it) = 1.0 / dxneg;
+        dxpos_inv(it) = 1.0 / dxpos;
+        dxmin(it) = dxpos < dxneg ? dxpos : dxneg;
+    }
+}
+
+template <typename T>
+void BasicEuler1DCore<T>::initialize_data(size_t ncoord)
 {
     MODMESH_TIME("Euler1DCore::initialize_data");
     if (0 == ncoord % 2)
@@ -50,182 +170,407 @@ void Euler1DCore::initialize_data(size_t ncoord)
         throw std::invalid_argument("ncoord cannot be even");
     }
     m_coord = SimpleArray<double>(/*length*/ ncoord);
-    m_cfl = SimpleArray<double>(/*length*/ ncoord);
-    m_so0 = SimpleArray<double>(/*shape*/ small_vector<size_t>{ncoord, NVAR});
-    m_so1 = SimpleArray<double>(/*shape*/ small_vector<size_t>{ncoord, NVAR});
-    m_gamma = SimpleArray<double>(/*shape*/ small_vector<size_t>{ncoord}, /*value*/ 1.4);
+    m_cfl = SimpleArray<T>(/*length*/ ncoord);
+    m_so0 = SimpleArray<T>(/*shape*/ small_vector<size_t>{ncoord, NVAR});
+    m_so1 = SimpleArray<T>(/*shape*/ small_vector<size_t>{ncoord, NVAR});
+    m_gamma = SimpleArray<T>(/*shape*/ small_vector<size_t>{ncoord}, /*value*/ static_cast<T>(1.4));
+    update_metric();
 }
 
-SimpleArray<double> Euler1DCore::density() const
+template <typename T>
+SimpleArray<double> BasicEuler1DCore<T>::density() const
 {
     MODMESH_TIME("Euler1DCore::density");
-    SimpleArray<double> ret(ncoord());
-    for (size_t it = 0; it < ncoord(); ++it)
-    {
-        ret(it) = density(it);
-    }
-    return ret;
+    Euler1DPrimitives prims;
+    prims.density = SimpleArray<double>(ncoord());
+    primitives(prims);
+    return std::move(prims.density);
 }
 
-SimpleArray<double> Euler1DCore::velocity() const
+template <typename T>
+SimpleArray<double> BasicEuler1DCore<T>::velocity() const
 {
     MODMESH_TIME("Euler1DCore::velocity");
-    SimpleArray<double> ret(ncoord());
-    for (size_t it = 0; it < ncoord(); ++it)
-    {
-        ret(it) = velocity(it);
-    }
-    return ret;
+    Euler1DPrimitives prims;
+    prims.velocity = SimpleArray<double>(ncoord());
+    primitives(prims);
+    return std::move(prims.velocity);
 }
 
-SimpleArray<double> Euler1DCore::pressure() const
+template <typename T>
+SimpleArray<double> BasicEuler1DCore<T>::pressure() const
 {
     MODMESH_TIME("Euler1DCore::pressure");
-    SimpleArray<double> ret(ncoord());
-    for (size_t it = 0; it < ncoord(); ++it)
-    {
-        ret(it) = pressure(it);
-    }
-    return ret;
+    Euler1DPrimitives prims;
+    prims.pressure = SimpleArray<double>(ncoord());
+    primitives(prims);
+    return std::move(prims.pressure);
 }
 
-void Euler1DCore::update_cfl(bool odd_plane)
+template <typename T>
+void BasicEuler1DCore<T>::update_cfl(bool odd_plane)
 {
     MODMESH_TIME("Euler1DCore::update_cfl");
+    refresh_metric();
+    m_cfl.detach();
     const int_type start = BOUND_COUNT - (odd_plane ? 1 : 0);
     const auto stop = static_cast<int_type>(ncoord() - BOUND_COUNT - (odd_plane ? 0 : 1));
     const double hdt = m_time_increment / 2;
+    double max_cfl = 0;
     for (int_type it = start; it < stop; it += 2)
     {
-        const double ga = m_gamma(it);
-        // TODO: I didn't verify the formula.
-        // wave speed.
-        double wspd = m_so0(it, 1);
-        wspd *= wspd;
-        const double ke = wspd / (2.0 * m_so0(it, 0));
-        double pr = (ga - 1.0) * (m_so0(it, 2) - ke);
-        pr = (pr + std::abs(pr)) / 2.0;
-        wspd = std::sqrt(ga * pr / m_so0(it, 0)) + std::sqrt(wspd) / m_so0(it, 0);
-        // CFL.
-        const double dxpos = m_coord(it + 1) - m_coord(it);
-        const double dxneg = m_coord(it) - m_coord(it - 1);
-        const double cfl = hdt * wspd / (dxpos < dxneg ? dxpos : dxneg);
-        // Set back.
-        m_cfl(it) = cfl;
+        const double cfl = Euler1DKernel::cfl(m_gamma(it), m_so0(it, 0), m_so0(it, 1), m_so0(it, 2), hdt, m_metric.dxmin(it));
+        m_cfl(it) = static_cast<T>(cfl);
+        max_cfl = std::max(max_cfl, cfl);
     }
+    m_max_cfl = max_cfl;
 }
 
-void Euler1DCore::march_half_so0(bool odd_plane)
+template <typename T>
+SimpleArray<double> BasicEuler1DCore<T>::time_history() const
 {
-    MODMESH_TIME("Euler1DCore::march_half_so0");
-    const int_type start = BOUND_COUNT - (odd_plane ? 1 : 0);
-    const auto stop = static_cast<int_type>(ncoord() - BOUND_COUNT - (odd_plane ? 0 : 1));
-    // Kernal at xneg solution element.
-    Euler1DKernel kernxn{};
-    kernxn
-        .set_time_increment(m_time_increment);
-    // Kernal at xpos solution element.
-    Euler1DKernel kernxp{};
-    kernxp
-        .set_time_increment(m_time_increment)
-        // Populate using the solution element.
-        .set_value(start, m_gamma, m_coord, m_so0, m_so1)
-        .derive();
-    for (int_type ic = start; ic < stop; ic += 2)
+    SimpleArray<double> ret(/*shape*/ small_vector<size_t>{m_time_history.size(), 3});
+    for (size_t it = 0; it < m_time_history.size(); ++it)
     {
-        // Update kernels (avoid duplicate expensiave calculation).
-        kernxn = kernxp;
-        kernxp
-            .set_value(ic + 2, m_gamma, m_coord, m_so0, m_so1)
-            .derive();
-        // Calculate flux through the lower left and lower right of conservation element.
-        const std::array<double, 3> flux_ll = kernxn.calc_flux_ll();
-        const std::array<double, 3> flux_lr = kernxp.calc_flux_lr();
-        // Calculate the variables using flux conservation.
-        double const xneg = m_coord(ic);
-        double const xpos = m_coord(ic + 2);
-        double const dx = xpos - xneg;
-        m_so0(ic + 1, 0) = (flux_ll[0] + flux_lr[0]) / dx;
-        m_so0(ic + 1, 1) = (flux_ll[1] + flux_lr[1]) / dx;
-        m_so0(ic + 1, 2) = (flux_ll[2] + flux_lr[2]) / dx;
+        ret(it, 0) = m_time_history[it][0];
+        ret(it, 1) = m_time_history[it][1];
+        ret(it, 2) = m_time_history[it][2];
     }
+    return ret;
 }
 
-void Euler1DCore::treat_boundary_so0()
+template <typename T>
+std::vector<std::string> BasicEuler1DCore<T>::shared_arrays() const
 {
-    /* Non-reflecting boundary condition (NRBC) type 3 with $\lambda=0$
-     * (the third set in Chang 05) */
-    // Set outside value from inside value.
+    std::vector<std::string> ret;
+    if (m_coord.is_shared())
+    {
+        ret.emplace_back("coord");
+    }
+    if (m_cfl.is_shared())
     {
-        // Left boundary.
-        size_t const ic = 1;
-        m_so0(ic, 0) = m_so0(ic + 1, 0);
-        m_so0(ic, 1) = m_so0(ic + 1, 1);
-        m_so0(ic, 2) = m_so0(ic + 1, 2);
+        ret.emplace_back("cfl");
     }
+    if (m_so0.is_shared())
     {
-        // Right boundary.
-        size_t const ic = ncoord() - 2;
-        m_so0(ic, 0) = m_so0(ic - 1, 0);
-        m_so0(ic, 1) = m_so0(ic - 1, 1);
-        m_so0(ic, 2) = m_so0(ic - 1, 2);
+        ret.emplace_back("so0");
     }
+    if (m_so1.is_shared())
+    {
+        ret.emplace_back("so1");
+    }
+    if (m_gamma.is_shared())
+    {
+        ret.emplace_back("gamma");
+    }
+    return ret;
+}
+
+template <typename T>
+void BasicEuler1DCore<T>::save_checkpoint(std::string const & path, bool float32) const
+{
+    MODMESH_TIME("Euler1DCore::save_checkpoint");
+    CheckpointWriter writer("onedim::Euler1DCore");
+    writer
+        .add_integer("nstep", m_nstep)
+        .add_real("time", m_time)
+        .add_real("time_increment", m_time_increment)
+        .add_array("coord", m_coord);
+    detail::add_checkpoint_array(writer, "so0", m_so0, float32);
+    detail::add_checkpoint_array(writer, "so1", m_so1, float32);
+    detail::add_checkpoint_array(writer, "cfl", m_cfl, float32);
+    detail::add_checkpoint_array(writer, "gamma", m_gamma, float32);
+    writer.write(path);
 }
 
-void Euler1DCore::treat_boundary_so1()
+template <typename T>
+void BasicEuler1DCore<T>::load_checkpoint(std::string const & path)
 {
-    /* Non-reflecting boundary condition (NRBC) type 3 with $\lambda=0$
-     * (the third set in Chang 05) */
-    // Set outside value from inside value.
+    MODMESH_TIME("Euler1DCore::load_checkpoint");
+    CheckpointReader const reader(path);
+    if (reader.kind() != "onedim::Euler1DCore")
     {
-        // Left boundary.
-        size_t const ic = 1;
-        m_so1(ic, 0) = m_so1(ic + 1, 0);
-        m_so1(ic, 1) = m_so1(ic + 1, 1);
-        m_so1(ic, 2) = m_so1(ic + 1, 2);
+        throw std::invalid_argument(Formatter() << "Euler1DCore::load_checkpoint: " << path << " is a checkpoint of "
+                                                << reader.kind());
     }
+    SimpleArray<double> coord = reader.array("coord");
+    SimpleArray<double> so0 = reader.array("so0");
+    SimpleArray<double> so1 = reader.array("so1");
+    SimpleArray<double> cfl = reader.array("cfl");
+    SimpleArray<double> gamma = reader.array("gamma");
+    size_t const ncoord = coord.size();
+    auto const check_shape = [&](char const * name, SimpleArray<double> const & arr, small_vector<size_t> const & shape)
     {
-        // Right boundary.
-        size_t const ic = ncoord() - 2;
-        m_so1(ic, 0) = m_so1(ic - 1, 0);
-        m_so1(ic, 1) = m_so1(ic - 1, 1);
-        m_so1(ic, 2) = m_so1(ic - 1, 2);
+        if (!(arr.shape() == shape))
+        {
+            throw std::invalid_argument(Formatter() << "Euler1DCore::load_checkpoint: shape of " << name << " in "
+                                                    << path << " does not match ncoord " << ncoord);
+        }
+    };
+    check_shape("coord", coord, small_vector<size_t>{ncoord});
+    check_shape("so0", so0, small_vector<size_t>{ncoord, NVAR});
+    check_shape("so1", so1, small_vector<size_t>{ncoord, NVAR});
+    check_shape("cfl", cfl, small_vector<size_t>{ncoord});
+    check_shape("gamma", gamma, small_vector<size_t>{ncoord});
+    if (0 == ncoord % 2)
+    {
+        throw std::invalid_argument("ncoord cannot be even");
+    }
+
+    m_coord = std::move(coord);
+    update_metric();
+    m_so0 = detail::convert_checkpoint_array<T>(std::move(so0));
+    m_so1 = detail::convert_checkpoint_array<T>(std::move(so1));
+    m_cfl = detail::convert_checkpoint_array<T>(std::move(cfl));
+    m_gamma = detail::convert_checkpoint_array<T>(std::move(gamma));
+    m_time_increment = reader.real("time_increment");
+    m_time = reader.real("time");
+    m_nstep = static_cast<size_t>(reader.integer("nstep"));
+    m_max_cfl = 0;
+    for (size_t it = 0; it < ncoord; ++it)
+    {
+        m_max_cfl = std::max(m_max_cfl, static_cast<double>(m_cfl(it)));
     }
+    m_time_history.clear();
 }
 
-SimpleArray<double> Euler1DCore::temperature() const
+template <typename T>
+void BasicEuler1DCore<T>::add_snapshot_field(CheckpointWriter & writer, std::string const & name, Euler1DPrimitives const & prims) const
 {
-    MODMESH_TIME("Euler1DCore::temperature");
-    SimpleArray<double> ret(ncoord());
-    for (size_t it = 0; it < ncoord(); ++it)
+    if ("coord" == name)
     {
-        ret(it) = temperature(it);
+        writer.add_array(name, m_coord);
+    }
+    else if ("so0" == name)
+    {
+        writer.add_array(name, m_so0);
+    }
+    else if ("so1" == name)
+    {
+        writer.add_array(name, m_so1);
+    }
+    else if ("cfl" == name)
+    {
+        writer.add_array(name, m_cfl);
+    }
+    else if ("gamma" == name)
+    {
+        writer.add_array(name, m_gamma);
+    }
+    else
+    {
+        writer.add_array(name, prims.field(name));
     }
-    return ret;
 }
 
-SimpleArray<double> Euler1DCore::internal_energy() const
+template <typename T>
+void BasicEuler1DCore<T>::set_snapshot(std::shared_ptr<inout::SnapshotWriter> const & writer, size_t interval, std::vector<std::string> const & fields)
 {
-    MODMESH_TIME("Euler1DCore::internal_energy");
-    SimpleArray<double> ret(ncoord());
-    for (size_t it = 0; it < ncoord(); ++it)
+    if (0 == interval)
     {
-        ret(it) = internal_energy(it);
+        throw std::invalid_argument("Euler1DCore::set_snapshot: interval cannot be zero");
     }
-    return ret;
+    for (std::string const & name : fields)
+    {
+        auto const * const begin = std::begin(detail::euler1d_snapshot_fields);
+        auto const * const end = std::end(detail::euler1d_snapshot_fields);
+        if (end == std::find(begin, end, name))
+        {
+            throw std::invalid_argument(Formatter() << "Euler1DCore::set_snapshot: unknown field \"" << name << "\"");
+        }
+    }
+    m_snapshot_writer = writer;
+    m_snapshot_interval = interval;
+    m_snapshot_next = (m_nstep / interval + 1) * interval;
+    m_snapshot_fields = fields;
+}
+
+template <typename T>
+void BasicEuler1DCore<T>::take_snapshot()
+{
+    MODMESH_TIME("Euler1DCore::take_snapshot");
+    if (!m_snapshot_writer)
+    {
+        throw std::runtime_error("Euler1DCore::take_snapshot: no snapshot writer");
+    }
+    CheckpointWriter snapshot("onedim::Euler1DCore");
+    snapshot
+        .add_integer("nstep", m_nstep)
+        .add_real("time", m_time)
+        .add_real("time_increment", m_time_increment);
+    // Compute the requested primitive variables in one pass.
+    Euler1DPrimitives prims;
+    for (std::string const & name : m_snapshot_fields)
+    {
+        auto const * const begin = std::begin(Euler1DPrimitives::FIELDS);
+        auto const * const end = std::end(Euler1DPrimitives::FIELDS);
+        if (end != std::find(begin, end, name))
+        {
+            prims.field(name) = SimpleArray<double>(ncoord());
+        }
+    }
+    primitives(prims);
+    for (std::string const & name : m_snapshot_fields)
+    {
+        add_snapshot_field(snapshot, name, prims);
+    }
+    m_snapshot_writer->push(std::move(snapshot));
+    m_snapshot_next = (m_nstep / m_snapshot_interval + 1) * m_snapshot_interval;
+}
+
+template <typename T>
+void BasicEuler1DCore<T>::march_half_so0(bool odd_plane)
+{
+    MODMESH_TIME("Euler1DCore::march_half_so0");
+    refresh_metric();
+    m_so0.detach();
+    march_lanes(
+        odd_plane,
+        [this](int_type ic, lanes_type const & lanes, size_t nlane)
+        {
+            march_type::block_so0(ic, lanes, nlane, m_metric, m_so0);
+            return 0.0;
+        });
+}
+
+template <typename T>
+void BasicEuler1DCore<T>::treat_boundary_so0()
+{
+    m_so0.detach();
+    march_type::copy_boundary(m_so0);
+}
+
+template <typename T>
+void BasicEuler1DCore<T>::treat_boundary_so1()
+{
+    m_so1.detach();
+    march_type::copy_boundary(m_so1);
+}
+
+template <typename T>
+SimpleArray<double> BasicEuler1DCore<T>::temperature() const
+{
+    MODMESH_TIME("Euler1DCore::temperature");
+    Euler1DPrimitives prims;
+    prims.temperature = SimpleArray<double>(ncoord());
+    primitives(prims);
+    return std::move(prims.temperature);
+}
+
+template <typename T>
+SimpleArray<double> BasicEuler1DCore<T>::internal_energy() const
+{
+    MODMESH_TIME("Euler1DCore::internal_energy");
+    Euler1DPrimitives prims;
+    prims.internal_energy = SimpleArray<double>(ncoord());
+    primitives(prims);
+    return std::move(prims.internal_energy);
 }
 
-SimpleArray<double> Euler1DCore::entropy() const
+template <typename T>
+SimpleArray<double> BasicEuler1DCore<T>::entropy() const
 {
     MODMESH_TIME("Euler1DCore::entropy");
-    SimpleArray<double> ret(ncoord());
-    for (size_t it = 0; it < ncoord(); ++it)
+    Euler1DPrimitives prims;
+    prims.entropy = SimpleArray<double>(ncoord());
+    primitives(prims);
+    return std::move(prims.entropy);
+}
+
+/**
+ * The grid points are processed in blocks.  A block first computes the
+ * velocity, internal energy, and pressure of its points into local arrays
+ * with one division per point, and then writes the requested buffers.
+ */
+template <typename T>
+void BasicEuler1DCore<T>::primitives(Euler1DPrimitives & out) const
+{
+    MODMESH_TIME("Euler1DCore::primitives");
+    size_t const ncrd = ncoord();
+    double * dst[std::size(Euler1DPrimitives::FIELDS)];
+    for (size_t it = 0; it < std::size(Euler1DPrimitives::FIELDS); ++it)
     {
-        ret(it) = entropy(it);
+        char const * name = Euler1DPrimitives::FIELDS[it];
+        SimpleArray<double> & arr = out.field(name);
+        if (arr.size() != 0 && arr.size() != ncrd)
+        {
+            throw std::invalid_argument(Formatter() << "Euler1DCore::primitives: " << name << " has " << arr.size()
+                                                    << " elements but ncoord is " << ncrd);
+        }
+        dst[it] = arr.size() != 0 ? arr.data() : nullptr;
     }
-    return ret;
+    double * const density = dst[0];
+    double * const velocity = dst[1];
+    double * const pressure = dst[2];
+    double * const temperature = dst[3];
+    double * const internal_energy = dst[4];
+    double * const entropy = dst[5];
+    T const * const so0 = m_so0.data();
+    T const * const gamma = m_gamma.data();
+
+    parallel_for(
+        0, ncrd, [&](size_t ibegin, size_t iend)
+        {
+            constexpr size_t BLOCK = 64;
+            double vel[BLOCK];
+            double ien[BLOCK];
+            double pre[BLOCK];
+            for (size_t ib = ibegin; ib < iend; ib += BLOCK)
+            {
+                size_t const nb = std::min(BLOCK, iend - ib);
+                T const * const u = so0 + NVAR * ib;
+                T const * const ga = gamma + ib;
+                for (size_t it = 0; it < nb; ++it)
+                {
+                    double const rho_inv = 1.0 / (u[NVAR * it] + TINY);
+                    double const v = u[NVAR * it + 1] * rho_inv;
+                    double const ke = 0.5 * v * v;
+                    vel[it] = v;
+                    ien[it] = u[NVAR * it + 2] * rho_inv - ke;
+                    pre[it] = (ga[it] - 1.0) * (u[NVAR * it + 2] - u[NVAR * it] * ke);
+                }
+                if (density)
+                {
+                    for (size_t it = 0; it < nb; ++it)
+                    {
+                        density[ib + it] = u[NVAR * it];
+                    }
+                }
+                if (velocity)
+                {
+                    std::copy_n(vel, nb, velocity + ib);
+                }
+                if (pressure)
+                {
+                    std::copy_n(pre, nb, pressure + ib);
+                }
+                if (temperature)
+                {
+                    for (size_t it = 0; it < nb; ++it)
+                    {
+                        temperature[ib + it] = (ga[it] - 1.0) / R * ien[it];
+                    }
+                }
+                if (internal_energy)
+                {
+                    std::copy_n(ien, nb, internal_energy + ib);
+                }
+                if (entropy)
+                {
+                    for (size_t it = 0; it < nb; ++it)
+                    {
+                        entropy[ib + it] = pre[it] / std::pow(static_cast<double>(u[NVAR * it]), static_cast<double>(ga[it]));
+                    }
+                }
+            } },
+        MARCH_GRAIN);
 }
 
+template class BasicEuler1DCore<float>;
+template class BasicEuler1DCore<double>;
+template std::ostream & operator<<(std::ostream & os, const BasicEuler1DCore<float> & sol);
+template std::ostream & operator<<(std::ostream & os, const BasicEuler1DCore<double> & sol);
+
 } /* end namespace onedim */
 } /* end namespace modmesh */
 
@@ -32,8 +32,17 @@
 #include <modmesh/base.hpp>
 #include <modmesh/math/math.hpp>
 #include <modmesh/buffer/buffer.hpp>
+#include <modmesh/inout/snapshot.hpp>
+#include <modmesh/parallel.hpp>
 #include <modmesh/toggle/profile.hpp>
+#include <modmesh/toggle/HotCounter.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace modmesh
 {
@@ -41,16 +50,103 @@ namespace modmesh
 namespace onedim
 {
 
-class Euler1DCore
-    : public std::enable_shared_from_this<Euler1DCore>
+template <size_t W>
+struct Euler1DLanes;
+
+template <typename L>
+struct Lanes1DMarch;
+
+/**
+ * Caller-owned buffers of the primitive variables, which
+ * BasicEuler1DCore::primitives() fills in one pass.  An empty buffer is
+ * skipped, and the others must have one element per grid point.  The buffers
+ * are kept across calls, so that refilling them does not allocate.  The
+ * buffers are double regardless of the storage of the solver.
+ */
+struct Euler1DPrimitives
+{
+
+    static constexpr char const * FIELDS[] = {"density", "velocity", "pressure", "temperature", "internal_energy", "entropy"};
+
+    Euler1DPrimitives() = default;
+    /// Allocate the buffers of all fields.
+    explicit Euler1DPrimitives(size_t ncoord);
+    /// Allocate the buffers of the named fields.
+    Euler1DPrimitives(size_t ncoord, std::vector<std::string> const & fields);
+
+    /// Return the buffer of the named field.
+    SimpleArray<double> & field(std::string const & name);
+    SimpleArray<double> const & field(std::string const & name) const
+    {
+        return const_cast<Euler1DPrimitives *>(this)->field(name);
+    }
+
+    SimpleArray<double> density;
+    SimpleArray<double> velocity;
+    SimpleArray<double> pressure;
+    SimpleArray<double> temperature;
+    SimpleArray<double> internal_energy;
+    SimpleArray<double> entropy;
+
+}; /* end struct Euler1DPrimitives */
+
+/**
+ * Geometric coefficients of the grid points, which the march streams instead
+ * of subtracting and dividing the coordinates of the neighbors every half
+ * step.  update() computes them from the coordinates, one array per
+ * coefficient.  x is a grid point, xneg and xpos its neighbors, and xctr the
+ * center of the neighbors.  The first and the last points have no
+ * coefficients and are zero.
+ */
+struct Euler1DMetric
+{
+
+    /// Number of the coefficients.
+    static constexpr size_t NCOEFF = 9;
+
+    /// Compute the coefficients from the coordinates.
+    void update(SimpleArray<double> const & coord);
+
+    size_t size() const { return dxctr.size(); }
+    size_t nbytes() const { return NCOEFF * dxctr.nbytes(); }
+
+    CopyOnWriteArray<double> dxctr; ///< x - xctr.
+    CopyOnWriteArray<double> deltax_ll; ///< xpos - x.
+    CopyOnWriteArray<double> dxmid_ll; ///< (x + xpos) / 2 - xctr.
+    CopyOnWriteArray<double> deltax_lr; ///< x - xneg.
+    CopyOnWriteArray<double> dxmid_lr; ///< (x + xneg) / 2 - xctr.
+    CopyOnWriteArray<double> dx_inv; ///< 1 / (xpos - xneg).
+    CopyOnWriteArray<double> dxneg_inv; ///< 1 / (x - xneg).
+    CopyOnWriteArray<double> dxpos_inv; ///< 1 / (xpos - x).
+    CopyOnWriteArray<double> dxmin; ///< min(xpos - x, x - xneg).
+
+}; /* end struct Euler1DMetric */
+
+/**
+ * Solver of the one-dimensional Euler equation by the CESE method.  The
+ * solution, CFL number, and heat capacity ratio are stored in T, while the
+ * kernel loads them into and accumulates the fluxes in double.  The float
+ * storage halves the memory traffic of the march at the cost of rounding the
+ * solution to single precision after every half step.  The coordinates stay
+ * in double.
+ */
+template <typename T>
+class BasicEuler1DCore
+    : public std::enable_shared_from_this<BasicEuler1DCore<T>>
 {
 
 public:
 
+    using value_type = T;
+
     constexpr static size_t BOUND_COUNT = 2;
     static constexpr uint8_t NVAR = 3;
     static constexpr double TINY = 1.e-100;
     static constexpr double R = 8.31446261815324;
+    /// Number of solution elements evaluated together in the march.
+    static constexpr size_t LANES = 8;
+    /// Minimal number of conservation elements in a chunk of a parallel loop.
+    static constexpr size_t MARCH_GRAIN = 4096;
 
 private:
 
@@ -60,57 +156,151 @@ private:
 
 public:
 
-    std::shared_ptr<Euler1DCore> clone()
+    /**
+     * Copy the solver.  The copy shares the arrays with this solver until
+     * either one writes them: marching copies so0, so1, and cfl, while coord
+     * and gamma are copied only when taken by the non-const accessors.
+     * References to the arrays taken before clone() are shared as well, so
+     * take them again after clone().  The copy has no snapshot writer, so
+     * that it does not push frames into the stream of this solver.
+     */
+    std::shared_ptr<BasicEuler1DCore> clone()
     {
-        auto ret = std::make_shared<Euler1DCore>(*this);
+        auto ret = std::make_shared<BasicEuler1DCore>(*this);
+        ret->clear_snapshot();
         return ret;
     }
 
     template <class... Args>
-    static std::shared_ptr<Euler1DCore> construct(Args &&... args)
+    static std::shared_ptr<BasicEuler1DCore> construct(Args &&... args)
     {
-        return std::make_shared<Euler1DCore>(std::forward<Args>(args)..., ctor_passkey());
+        return std::make_shared<BasicEuler1DCore>(std::forward<Args>(args)..., ctor_passkey());
     }
 
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-    Euler1DCore(size_t ncoord, double time_increment, ctor_passkey const &)
+    BasicEuler1DCore(size_t ncoord, double time_increment, ctor_passkey const &)
         : m_time_increment(time_increment)
     {
         initialize_data(ncoord);
     }
 
-    explicit Euler1DCore(ctor_passkey const &);
+    explicit BasicEuler1DCore(ctor_passkey const &);
 
-    Euler1DCore() = delete;
-    Euler1DCore(Euler1DCore const &) = default;
-    Euler1DCore(Euler1DCore &&) = default;
-    Euler1DCore & operator=(Euler1DCore const &) = default;
-    Euler1DCore & operator=(Euler1DCore &&) = default;
-    ~Euler1DCore() = default;
+    BasicEuler1DCore() = delete;
+    BasicEuler1DCore(BasicEuler1DCore const &) = default;
+    BasicEuler1DCore(BasicEuler1DCore &&) = default;
+    BasicEuler1DCore & operator=(BasicEuler1DCore const &) = default;
+    BasicEuler1DCore & operator=(BasicEuler1DCore &&) = default;
+    ~BasicEuler1DCore() = default;
 
     void initialize_data(size_t ncoord);
 
     double time_increment() const { return m_time_increment; }
+    void set_time_increment(double time_increment) { m_time_increment = time_increment; }
+
+    /// Time marched by march_alpha() and march_alpha_adaptive().
+    double time() const { return m_time; }
+    void set_time(double time) { m_time = time; }
+
+    /// Number of steps marched by march_alpha() and march_alpha_adaptive().
+    size_t nstep() const { return m_nstep; }
+    void set_nstep(size_t nstep) { m_nstep = nstep; }
+
+    /// Maximum CFL number calculated by the last update_cfl().
+    double max_cfl() const { return m_max_cfl; }
+
+    /// (nstep, 3) array of time, time increment, and maximum CFL number of
+    /// the steps marched by march_alpha_adaptive().
+    SimpleArray<double> time_history() const;
+    void clear_time_history() { m_time_history.clear(); }
+
+    /**
+     * Write the coordinates, solution, CFL number, heat capacity ratio, time
+     * increment, time, and step count to a checkpoint file.  With float32 the
+     * arrays other than the coordinates are stored in single precision.
+     */
+    void save_checkpoint(std::string const & path, bool float32 = false) const;
+    /// Restore the state written by save_checkpoint(), including the number
+    /// of grid points.
+    void load_checkpoint(std::string const & path);
+
+    /**
+     * Push a snapshot of the named fields to the writer every interval steps
+     * marched.  The fields are coord, so0, so1, cfl, gamma, density, velocity,
+     * pressure, temperature, internal_energy, and entropy.
+     */
+    void set_snapshot(std::shared_ptr<inout::SnapshotWriter> const & writer, size_t interval, std::vector<std::string> const & fields);
+    void clear_snapshot()
+    {
+        m_snapshot_writer.reset();
+        m_snapshot_interval = 0;
+        m_snapshot_next = 0;
+        m_snapshot_fields.clear();
+    }
+    std::shared_ptr<inout::SnapshotWriter> const & snapshot_writer() const { return m_snapshot_writer; }
+    /// Push a snapshot of the current solution to the writer.
+    void take_snapshot();
 
     size_t ncoord() const { return m_coord.size(); }
     SimpleArray<double> const & coord() const { return m_coord; }
-    SimpleArray<double> & coord() { return m_coord; }
+    /// Return the coordinates for writing.  The geometric coefficients are
+    /// recomputed when the coordinates differ from the ones they were
+    /// computed from, so a write through a kept view is picked up as well.
+    SimpleArray<double> & coord()
+    {
+        m_coord.detach();
+        return m_coord;
+    }
+
+    /// Geometric coefficients of the grid, refreshed for the current
+    /// coordinates.
+    Euler1DMetric const & metric() const
+    {
+        refresh_metric();
+        return m_metric;
+    }
+    /// Recompute the geometric coefficients.  setup_march() calls it, and
+    /// the march calls refresh_metric() to pick up changed coordinates.
+    void update_metric() const
+    {
+        m_metric.update(m_coord);
+        m_metric_coord.assign(m_coord.data(), m_coord.data() + m_coord.size());
+    }
+
+    SimpleArray<T> const & cfl() const { return m_cfl; }
+    SimpleArray<T> & cfl()
+    {
+        m_cfl.detach();
+        return m_cfl;
+    }
 
-    SimpleArray<double> const & cfl() const { return m_cfl; }
-    SimpleArray<double> & cfl() { return m_cfl; }
+    SimpleArray<T> const & so0() const { return m_so0; }
+    SimpleArray<T> & so0()
+    {
+        m_so0.detach();
+        return m_so0;
+    }
 
-    SimpleArray<double> const & so0() const { return m_so0; }
-    SimpleArray<double> & so0() { return m_so0; }
+    SimpleArray<T> const & so1() const { return m_so1; }
+    SimpleArray<T> & so1()
+    {
+        m_so1.detach();
+        return m_so1;
+    }
 
-    SimpleArray<double> const & so1() const { return m_so1; }
-    SimpleArray<double> & so1() { return m_so1; }
+    SimpleArray<T> const & gamma() const { return m_gamma; }
+    SimpleArray<T> & gamma()
+    {
+        m_gamma.detach();
+        return m_gamma;
+    }
 
-    SimpleArray<double> const & gamma() const { return m_gamma; }
-    SimpleArray<double> & gamma() { return m_gamma; }
+    /// Names of the arrays still shared with a clone or the origin of it.
+    std::vector<std::string> shared_arrays() const;
 
-    double density(size_t it) const { return m_so0(it, 0); }
+    double density(size_t it) const { return static_cast<double>(m_so0(it, 0)); }
     SimpleArray<double> density() const;
-    double velocity(size_t it) const { return m_so0(it, 1) / (m_so0(it, 0) + TINY); }
+    double velocity(size_t it) const { return static_cast<double>(m_so0(it, 1)) / (m_so0(it, 0) + TINY); }
     SimpleArray<double> velocity() const;
     double pressure(size_t it) const;
     SimpleArray<double> pressure() const;
@@ -120,6 +310,8 @@ public:
     SimpleArray<double> internal_energy() const;
     double entropy(size_t it) const { return pressure(it) / std::pow(density(it), m_gamma(it)); }
     SimpleArray<double> entropy() const;
+    /// Fill the non-empty buffers of the primitive variables in one pass.
+    void primitives(Euler1DPrimitives & out) const;
 
     void update_cfl(bool odd_plane);
     void march_half_so0(bool odd_plane);
@@ -128,27 +320,76 @@ public:
     void treat_boundary_so0();
     void treat_boundary_so1();
 
-    void setup_march() { update_cfl(false); }
+    void setup_march()
+    {
+        update_metric();
+        update_cfl(false);
+    }
+    template <size_t ALPHA>
+    void march_half_alpha(bool odd_plane);
     template <size_t ALPHA>
     void march_half1_alpha();
     template <size_t ALPHA>
     void march_half2_alpha();
     template <size_t ALPHA>
     void march_alpha(size_t steps);
+    template <size_t ALPHA>
+    size_t march_alpha_adaptive(double time_stop, double target_cfl, double dt_min, double dt_max);
 
 private:
 
-    real_type m_time_increment = 0;
-    SimpleArray<double> m_coord;
-    SimpleArray<double> m_cfl;
-    SimpleArray<double> m_so0;
-    SimpleArray<double> m_so1;
-    SimpleArray<double> m_gamma;
-}; /* end class Euler1DCore */
+    using lanes_type = Euler1DLanes<LANES>;
+    using march_type = Lanes1DMarch<lanes_type>;
 
-std::ostream & operator<<(std::ostream & os, const Euler1DCore & sol);
+    void refresh_metric() const
+    {
+        if (m_metric_coord.size() != m_coord.size() || !std::equal(m_metric_coord.begin(), m_metric_coord.end(), m_coord.data()))
+        {
+            update_metric();
+        }
+    }
+
+    template <typename F>
+    double march_lanes(bool odd_plane, F && body) const;
+    double march_block_cfl(int_type ic, size_t nlane);
+
+    void add_snapshot_field(CheckpointWriter & writer, std::string const & name, Euler1DPrimitives const & prims) const;
+    void march_snapshot()
+    {
+        if (m_snapshot_writer && m_nstep >= m_snapshot_next)
+        {
+            take_snapshot();
+        }
+    }
 
-inline double Euler1DCore::pressure(size_t it) const
+    real_type m_time_increment = 0;
+    real_type m_time = 0;
+    real_type m_max_cfl = 0;
+    size_t m_nstep = 0;
+    std::vector<std::array<double, 3>> m_time_history;
+    CopyOnWriteArray<double> m_coord;
+    // Computed from the coordinates, so const accessors may refresh them.
+    mutable Euler1DMetric m_metric;
+    mutable std::vector<double> m_metric_coord;
+    CopyOnWriteArray<T> m_cfl;
+    CopyOnWriteArray<T> m_so0;
+    CopyOnWriteArray<T> m_so1;
+    CopyOnWriteArray<T> m_gamma;
+    std::shared_ptr<inout::SnapshotWriter> m_snapshot_writer;
+    size_t m_snapshot_interval = 0;
+    size_t m_snapshot_next = 0;
+    std::vector<std::string> m_snapshot_fields;
+}; /* end class BasicEuler1DCore */
+
+using Euler1DCoreFp32 = BasicEuler1DCore<float>;
+using Euler1DCoreFp64 = BasicEuler1DCore<double>;
+using Euler1DCore = Euler1DCoreFp64;
+
+template <typename T>
+std::ostream & operator<<(std::ostream & os, const BasicEuler1DCore<T> & sol);
+
+template <typename T>
+inline double BasicEuler1DCore<T>::pressure(size_t it) const
 {
     double ret = m_so0(it, 1);
     ret *= ret;
@@ -158,17 +399,24 @@ inline double Euler1DCore::pressure(size_t it) const
     return ret;
 }
 
-inline double Euler1DCore::temperature(size_t it) const
+template <typename T>
+inline double BasicEuler1DCore<T>::temperature(size_t it) const
 {
+    double const u0 = m_so0(it, 0);
+    double const u1 = m_so0(it, 1);
+    double const u2 = m_so0(it, 2);
     double ret = (m_gamma(it) - 1.0) / R;
-    ret *= m_so0(it, 2) / m_so0(it, 0) - 0.5 * pow<2>(m_so0(it, 1)) / pow<2>(m_so0(it, 0));
+    ret *= u2 / u0 - 0.5 * pow<2>(u1) / pow<2>(u0);
     return ret;
 }
 
-inline double Euler1DCore::internal_energy(size_t it) const
+template <typename T>
+inline double BasicEuler1DCore<T>::internal_energy(size_t it) const
 {
-    double ret = m_so0(it, 2) / m_so0(it, 0);
-    ret -= 0.5 * (pow<2>(m_so0(it, 1)) / pow<2>(m_so0(it, 0)));
+    double const u0 = m_so0(it, 0);
+    double const u1 = m_so0(it, 1);
+    double ret = static_cast<double>(m_so0(it, 2)) / u0;
+    ret -= 0.5 * (pow<2>(u1) / pow<2>(u0));
     return ret;
 }
 
@@ -176,163 +424,415 @@ struct Euler1DKernel
 {
     static constexpr double tiny = 1.e-100;
 
-    Euler1DKernel() = default;
+    /// Calculate the CFL number of a solution element from the wave speed.
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    static double cfl(double ga, double u0, double u1, double u2, double hdt, double dxmin)
+    {
+        // TODO: I didn't verify the formula.
+        double const rho_inv = 1.0 / u0;
+        double pr = (ga - 1.0) * (u2 - 0.5 * u1 * u1 * rho_inv);
+        pr = (pr + std::abs(pr)) / 2.0;
+        double const wspd = std::sqrt(ga * pr * rho_inv) + std::abs(u1) * rho_inv;
+        return hdt * wspd / dxmin;
+    }
 
-    Euler1DKernel & set_time_increment(double time_increment)
+    /**
+     * Calculate the fluxes through the lower-left and lower-right boundaries of
+     * the conservation elements next to a solution element, and the value at
+     * its t+ tip.  The output is 3 * NVAR values spaced by stride: flux_ll,
+     * flux_lr, and up, each for the 3 variables.
+     *
+     * The Jacobian d[f,u] is expanded in the velocity v = u1/u0 and the
+     * specific total energy e = u2/u0, so that an element takes one division.
+     * The first row of the Jacobian is (0, 1, 0) and the middle of the second
+     * row is gamma-1, and the products skip them.
+     */
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    static void derive(double ga, double hdt, double qdt, double dxctr, double deltax_ll, double dxmid_ll, double deltax_lr, double dxmid_lr, double u0, double u1, double u2, double ux0, double ux1, double ux2, double * out, size_t stride)
     {
-        hdt = time_increment / 2.0;
-        qdt = hdt / 2.0;
-        return *this;
+        double const rho_inv = 1.0 / (u0 + tiny);
+        double const v = u1 * rho_inv;
+        double const e = u2 * rho_inv;
+        double const v2 = v * v;
+        double const gm1 = ga - 1.0;
+
+        double const j10 = 0.5 * (ga - 3.0) * v2;
+        double const j11 = (3.0 - ga) * v;
+        double const j20 = v * (gm1 * v2 - ga * e);
+        double const j21 = ga * e - 1.5 * gm1 * v2;
+        double const j22 = ga * v;
+
+        double const f0 = u1;
+        double const f1 = gm1 * u2 + 0.5 * (3.0 - ga) * u1 * v;
+        double const f2 = u1 * (ga * e - 0.5 * gm1 * v2);
+
+        // ut = -fx = -d[f,u] \cdot ux
+        double const ut0 = -ux1;
+        double const ut1 = -(j10 * ux0 + j11 * ux1 + gm1 * ux2);
+        double const ut2 = -(j20 * ux0 + j21 * ux1 + j22 * ux2);
+
+        // ft = d[f,u] \cdot ut
+        double const ft0 = ut1;
+        double const ft1 = j10 * ut0 + j11 * ut1 + gm1 * ut2;
+        double const ft2 = j20 * ut0 + j21 * ut1 + j22 * ut2;
+
+        double const ht0 = hdt * (f0 - dxctr * ut0 + qdt * ft0);
+        double const ht1 = hdt * (f1 - dxctr * ut1 + qdt * ft1);
+        double const ht2 = hdt * (f2 - dxctr * ut2 + qdt * ft2);
+
+        out[0] = deltax_ll * (u0 + dxmid_ll * ux0) + ht0;
+        out[stride] = deltax_ll * (u1 + dxmid_ll * ux1) + ht1;
+        out[2 * stride] = deltax_ll * (u2 + dxmid_ll * ux2) + ht2;
+        out[3 * stride] = deltax_lr * (u0 + dxmid_lr * ux0) - ht0;
+        out[4 * stride] = deltax_lr * (u1 + dxmid_lr * ux1) - ht1;
+        out[5 * stride] = deltax_lr * (u2 + dxmid_lr * ux2) - ht2;
+        // Displacement in x and t.
+        out[6 * stride] = u0 + dxctr * ux0 + hdt * ut0;
+        out[7 * stride] = u1 + dxctr * ux1 + hdt * ut1;
+        out[8 * stride] = u2 + dxctr * ux2 + hdt * ut2;
     }
+}; /* end struct Euler1DKernel */
 
+/**
+ * Evaluate Euler1DKernel for W solution elements at once.  The solution is
+ * loaded from the (ncoord, NVAR) arrays into a structure of arrays, one array
+ * of W lanes per variable, so that the arithmetic loops over the lanes have
+ * a fixed trip count and no dependency, and the compiler vectorizes them for
+ * SSE/AVX or NEON.
+ *
+ * The derived values of W+1 consecutive solution elements on a plane are
+ * kept, and a conservation element between slots j and j+1 reads flux_ll of
+ * slot j and flux_lr of slot j+1.  advance() moves the last slot to the
+ * first, so that every solution element is derived once.
+ */
+template <size_t W>
+struct Euler1DLanes
+{
+    static constexpr size_t NVAR = Euler1DCore::NVAR;
+    static constexpr size_t WIDTH = W;
+    static constexpr size_t NVAL = 3 * NVAR;
+    static constexpr size_t NSLOT = W + 1;
+    static constexpr double tiny = Euler1DKernel::tiny;
+
+    explicit Euler1DLanes(double time_increment)
+        : hdt(time_increment / 2.0)
+        , qdt(hdt / 2.0)
+    {
+    }
+
+    /// Derive the solution elements ic, ic+2, ..., ic+2*(W-1) into slots 1 to
+    /// W.  The elements beyond iclast repeat iclast.  The solution of value
+    /// type U is loaded into double.
+    template <typename U>
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-    Euler1DKernel & set_value(size_t ic, SimpleArray<double> const & gamma, SimpleArray<double> const & coord, SimpleArray<double> const & so0, SimpleArray<double> const & so1)
+    void derive(int_type ic, int_type iclast, SimpleArray<U> const & gamma, Euler1DMetric const & metric, SimpleArray<U> const & so0, SimpleArray<U> const & so1)
     {
-        ga = gamma(ic);
-        x = coord(ic);
-        xneg = coord(ic - 1);
-        xpos = coord(ic + 1);
-        xctr = (xpos + xneg) * 0.5;
-        u[0] = so0(ic, 0);
-        u[1] = so0(ic, 1);
-        u[2] = so0(ic, 2);
-        ux[0] = so1(ic, 0);
-        ux[1] = so1(ic, 1);
-        ux[2] = so1(ic, 2);
-        return *this;
+        MODMESH_HOT_TIME("Euler1DLanes::derive", 64, W);
+        double ga[W];
+        double geo[5][W];
+        double u[3][W];
+        double ux[3][W];
+        for (size_t il = 0; il < W; ++il)
+        {
+            int_type const jc = std::min(ic + static_cast<int_type>(2 * il), iclast);
+            ga[il] = gamma(jc);
+            geo[0][il] = metric.dxctr(jc);
+            geo[1][il] = metric.deltax_ll(jc);
+            geo[2][il] = metric.dxmid_ll(jc);
+            geo[3][il] = metric.deltax_lr(jc);
+            geo[4][il] = metric.dxmid_lr(jc);
+            for (size_t iv = 0; iv < 3; ++iv)
+            {
+                u[iv][il] = so0(jc, iv);
+                ux[iv][il] = so1(jc, iv);
+            }
+        }
+        for (size_t il = 0; il < W; ++il)
+        {
+            Euler1DKernel::derive(
+                ga[il], hdt, qdt,
+                geo[0][il], geo[1][il], geo[2][il], geo[3][il], geo[4][il],
+                u[0][il], u[1][il], u[2][il], ux[0][il], ux[1][il], ux[2][il],
+                &val[0][il + 1], NSLOT);
+        }
     }
 
-    Euler1DKernel & derive()
+    void advance()
     {
-        MODMESH_TIME("Euler1DKernel::derive");
-
-        // TODO: reduce numerical calculation.
-        jac[0][0] = 0.0;
-        jac[0][1] = 1.0;
-        jac[0][2] = 0.0;
-        jac[1][0] = (ga - 3.0) / 2.0 * u[1] * u[1] / (u[0] * u[0] + tiny);
-        jac[1][1] = -(ga - 3.0) * u[1] / (u[0] + tiny);
-        jac[1][2] = ga - 1.0;
-        jac[2][0] = (ga - 1.0) * u[1] * u[1] * u[1] / (u[0] * u[0] * u[0] + tiny) - ga * u[1] * u[2] / (u[0] * u[0] + tiny);
-        jac[2][1] = ga * u[2] / (u[0] + tiny) - 3.0 / 2.0 * (ga - 1.0) * u[1] * u[1] / (u[0] * u[0] + tiny);
-        jac[2][2] = ga * u[1] / (u[0] + tiny);
-
-        f[0] = u[1];
-        f[1] = (ga - 1.0) * u[2] + (3.0 - ga) / 2.0 * u[1] * u[1] / (u[0] + tiny);
-        f[2] = ga * u[1] * u[2] / (u[0] + tiny) - (ga - 1.0) / 2.0 * u[1] * u[1] * u[1] / (u[0] * u[0] + tiny);
-
-        // Also ut = -fx
-        ut[0] = -jac[0][0] * ux[0] - jac[0][1] * ux[1] - jac[0][2] * ux[2];
-        ut[1] = -jac[1][0] * ux[0] - jac[1][1] * ux[1] - jac[1][2] * ux[2];
-        ut[2] = -jac[2][0] * ux[0] - jac[2][1] * ux[1] - jac[2][2] * ux[2];
+        for (size_t it = 0; it < NVAL; ++it)
+        {
+            val[it][0] = val[it][W];
+        }
+    }
 
-        // ft = d[f,u] \cdot ut
-        ft[0] = jac[0][0] * ut[0] + jac[0][1] * ut[1] + jac[0][2] * ut[2];
-        ft[1] = jac[1][0] * ut[0] + jac[1][1] * ut[1] + jac[1][2] * ut[2];
-        ft[2] = jac[2][0] * ut[0] + jac[2][1] * ut[1] + jac[2][2] * ut[2];
+    double const * flux_ll(size_t iv) const { return val[iv]; }
+    double const * flux_lr(size_t iv) const { return val[3 + iv]; }
+    double const * up(size_t iv) const { return val[6 + iv]; }
 
-        up[0] = u[0] + (x - xctr) * ux[0] /* displacement in x */ + hdt * ut[0] /* displacement in t */;
-        up[1] = u[1] + (x - xctr) * ux[1] /* displacement in x */ + hdt * ut[1] /* displacement in t */;
-        up[2] = u[2] + (x - xctr) * ux[2] /* displacement in x */ + hdt * ut[2] /* displacement in t */;
+    double hdt; //< Half of time increment.
+    double qdt; //< Quarter of time increment.
+    double val[NVAL][NSLOT]; //< flux_ll, flux_lr, and up of the slots.
+}; /* end struct Euler1DLanes */
+
+/**
+ * The march of the conservation elements of a plane in blocks of lanes,
+ * shared by BasicEuler1DCore and Conservation1DCore.  L is the lanes type,
+ * which evaluates the flux of the system for L::WIDTH solution elements at
+ * once: Euler1DLanes for the hand-written Euler kernel, or
+ * Conservation1DLanes for a flux policy.  The solution arrays may be float or
+ * double, and are loaded into double.
+ */
+template <typename L>
+struct Lanes1DMarch
+{
+    static constexpr size_t NVAR = L::NVAR;
+    static constexpr size_t W = L::WIDTH;
+    static constexpr int_type BOUND_COUNT = 2;
+
+    /**
+     * Loop over the conservation elements between the solution elements of
+     * a plane in blocks of W.  derive(lanes, ic, iclast) derives the solution
+     * elements from ic into the lanes.  The callback takes the grid point
+     * behind the first conservation element of the block, the lanes, and the
+     * number of the conservation elements in the block.  The lanes beyond
+     * the number repeat the last conservation element, so that the callback
+     * may compute all W and store the valid ones.  The callback returns a
+     * number, and the maximum of the returns is returned.
+     *
+     * The blocks are split into chunks marched in parallel.  A chunk derives
+     * the solution element before its first block, instead of taking it from
+     * the previous chunk, so the result does not depend on the number of
+     * threads.
+     */
+    template <typename D, typename F>
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    static double march(bool odd_plane, size_t ncoord, double time_increment, size_t grain, D && derive, F && body)
+    {
+        const int_type start = BOUND_COUNT - (odd_plane ? 1 : 0);
+        const int_type stop = static_cast<int_type>(ncoord - BOUND_COUNT - (odd_plane ? 0 : 1));
+        if (stop <= start)
+        {
+            return 0;
+        }
+        size_t const nce = static_cast<size_t>(stop - start + 1) / 2;
+        int_type const iclast = start + static_cast<int_type>(2 * nce);
+        size_t const nblock = (nce + W - 1) / W;
+
+        double ret = 0;
+        std::mutex ret_mutex;
+        parallel_for(
+            0, nblock, [&](size_t ibegin, size_t iend)
+            {
+                L lanes(time_increment);
+                int_type const icbegin = start + static_cast<int_type>(2 * W * ibegin);
+                derive(lanes, icbegin, icbegin);
+                double chunk_ret = 0;
+                for (size_t ice = ibegin * W; ice < std::min(iend * W, nce); ice += W)
+                {
+                    int_type const ic = start + static_cast<int_type>(2 * ice);
+                    lanes.advance();
+                    derive(lanes, ic + 2, iclast);
+                    chunk_ret = std::max(chunk_ret, body(ic, lanes, std::min(W, nce - ice)));
+                }
+                std::lock_guard<std::mutex> const lock(ret_mutex);
+                ret = std::max(ret, chunk_ret); },
+            grain / W);
+        return ret;
+    }
 
-        return *this;
+    /// Calculate so0 of a block from the fluxes through the lower left and
+    /// lower right of the conservation elements.
+    template <typename T>
+    static void block_so0(int_type ic, L const & lanes, size_t nlane, Euler1DMetric const & metric, SimpleArray<T> & so0)
+    {
+        double dx_inv[W];
+        for (size_t il = 0; il < W; ++il)
+        {
+            int_type const jc = ic + static_cast<int_type>(2 * std::min(il, nlane - 1));
+            dx_inv[il] = metric.dx_inv(jc + 1);
+        }
+        double utp[NVAR][W];
+        for (size_t iv = 0; iv < NVAR; ++iv)
+        {
+            double const * flux_ll = lanes.flux_ll(iv);
+            double const * flux_lr = lanes.flux_lr(iv) + 1;
+            for (size_t il = 0; il < W; ++il)
+            {
+                utp[iv][il] = (flux_ll[il] + flux_lr[il]) * dx_inv[il];
+            }
+        }
+        for (size_t il = 0; il < nlane; ++il)
+        {
+            int_type const jc = ic + static_cast<int_type>(2 * il);
+            for (size_t iv = 0; iv < NVAR; ++iv)
+            {
+                so0(jc + 1, iv) = static_cast<T>(utp[iv][il]);
+            }
+        }
     }
 
-    std::array<double, 3> calc_flux_ll()
+    /// Calculate so1 of a block by the weighted average of the one-sided
+    /// gradients, using so0 calculated by block_so0().
+    template <size_t ALPHA, typename T>
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    static void block_so1_alpha(int_type ic, L const & lanes, size_t nlane, Euler1DMetric const & metric, SimpleArray<T> const & so0, SimpleArray<T> & so1)
     {
-        const double deltax = xpos - x;
-        const double dxmid = 0.5 * (x + xpos) - xctr;
-        const double dxctr = x - xctr;
-        double const r0 = deltax * (u[0] + dxmid * ux[0]) + hdt * (f[0] - (dxctr * ut[0]) + (qdt * ft[0]));
-        double const r1 = deltax * (u[1] + dxmid * ux[1]) + hdt * (f[1] - (dxctr * ut[1]) + (qdt * ft[1]));
-        double const r2 = deltax * (u[2] + dxmid * ux[2]) + hdt * (f[2] - (dxctr * ut[2]) + (qdt * ft[2]));
-        return std::array<double, 3>{r0, r1, r2};
+        double dxn_inv[W];
+        double dxp_inv[W];
+        double utp[NVAR][W];
+        for (size_t il = 0; il < W; ++il)
+        {
+            int_type const jc = ic + static_cast<int_type>(2 * std::min(il, nlane - 1));
+            dxn_inv[il] = metric.dxneg_inv(jc + 1);
+            dxp_inv[il] = metric.dxpos_inv(jc + 1);
+            for (size_t iv = 0; iv < NVAR; ++iv)
+            {
+                utp[iv][il] = so0(jc + 1, iv);
+            }
+        }
+        double uxtp[NVAR][W];
+        for (size_t iv = 0; iv < NVAR; ++iv)
+        {
+            double const * upn = lanes.up(iv);
+            double const * upp = lanes.up(iv) + 1;
+            for (size_t il = 0; il < W; ++il)
+            {
+                const double duxn = (utp[iv][il] - upn[il]) * dxn_inv[il];
+                const double duxp = (upp[il] - utp[iv][il]) * dxp_inv[il];
+                const double fan = pow<ALPHA>(std::abs(duxn));
+                const double fap = pow<ALPHA>(std::abs(duxp));
+                uxtp[iv][il] = (fap * duxn + fan * duxp) / (fap + fan + L::tiny);
+            }
+        }
+        for (size_t il = 0; il < nlane; ++il)
+        {
+            int_type const jc = ic + static_cast<int_type>(2 * il);
+            for (size_t iv = 0; iv < NVAR; ++iv)
+            {
+                so1(jc + 1, iv) = static_cast<T>(uxtp[iv][il]);
+            }
+        }
     }
 
-    std::array<double, 3> calc_flux_lr()
+    /// Calculate the CFL number of the solution elements of a block by
+    /// cfl_at(ic), store it in cfl, and return the maximum.
+    template <typename T, typename C>
+    static double block_cfl(int_type ic, size_t nlane, C && cfl_at, SimpleArray<T> & cfl)
     {
-        const double deltax = x - xneg;
-        const double dxmid = 0.5 * (x + xneg) - xctr;
-        const double dxctr = x - xctr;
-        double const r0 = deltax * (u[0] + dxmid * ux[0]) - hdt * (f[0] - (dxctr * ut[0]) + (qdt * ft[0]));
-        double const r1 = deltax * (u[1] + dxmid * ux[1]) - hdt * (f[1] - (dxctr * ut[1]) + (qdt * ft[1]));
-        double const r2 = deltax * (u[2] + dxmid * ux[2]) - hdt * (f[2] - (dxctr * ut[2]) + (qdt * ft[2]));
-        return std::array<double, 3>{r0, r1, r2};
+        double val[W];
+        for (size_t il = 0; il < W; ++il)
+        {
+            int_type const jc = ic + static_cast<int_type>(2 * std::min(il, nlane - 1));
+            val[il] = cfl_at(jc);
+        }
+        double max_cfl = 0;
+        for (size_t il = 0; il < nlane; ++il)
+        {
+            int_type const jc = ic + static_cast<int_type>(2 * il);
+            cfl(jc) = static_cast<T>(val[il]);
+            max_cfl = std::max(max_cfl, val[il]);
+        }
+        return max_cfl;
     }
 
-    double ga; //< Heat capacity ratio.
-    double qdt; //< Quarter of time increment.
-    double hdt; //< Half of time increment.
-    double x; //< Grid point.
-    double xctr; //< Solution point.
-    double xneg; //< Left point of the solution element.
-    double xpos; //< Right point of the solution element.
-    std::array<double, 3> u; // Variable.
-    std::array<double, 3> ux; // First-order derivative of u with respect to space.
-    std::array<std::array<double, 3>, 3> jac; //< Jacobian.
-    std::array<double, 3> f; //< Function.
-    std::array<double, 3> ut; //< First-order derivative of u with respect to time.
-    std::array<double, 3> ft; //< First-order derivative of f with respect to time.
-    std::array<double, 3> up; //< Derived variable.
-}; /* end struct Euler1DKernel */
+    /// Non-reflecting boundary condition (NRBC) type 3 with $\lambda=0$ (the
+    /// third set in Chang 05): set the outside value from the inside value.
+    template <typename T>
+    static void copy_boundary(SimpleArray<T> & arr)
+    {
+        size_t const ir = arr.shape(0) - 2;
+        for (size_t iv = 0; iv < NVAR; ++iv)
+        {
+            arr(1, iv) = arr(2, iv);
+            arr(ir, iv) = arr(ir - 1, iv);
+        }
+    }
+}; /* end struct Lanes1DMarch */
+
+/// Loop over the conservation elements of a plane in blocks of LANES.  See
+/// Lanes1DMarch::march().
+template <typename T>
+template <typename F>
+inline double BasicEuler1DCore<T>::march_lanes(bool odd_plane, F && body) const
+{
+    return march_type::march(
+        odd_plane, ncoord(), m_time_increment, MARCH_GRAIN,
+        [this](lanes_type & lanes, int_type ic, int_type iclast)
+        { lanes.derive(ic, iclast, m_gamma, m_metric, m_so0, m_so1); },
+        std::forward<F>(body));
+}
+
+template <typename T>
+inline double BasicEuler1DCore<T>::march_block_cfl(int_type ic, size_t nlane)
+{
+    double const hdt = m_time_increment / 2;
+    return march_type::block_cfl(
+        ic, nlane,
+        [this, hdt](int_type jc)
+        { return Euler1DKernel::cfl(m_gamma(jc), m_so0(jc, 0), m_so0(jc, 1), m_so0(jc, 2), hdt, m_metric.dxmin(jc)); },
+        m_cfl);
+}
 
+template <typename T>
 template <size_t ALPHA>
-inline void Euler1DCore::march_half_so1_alpha(bool odd_plane)
+inline void BasicEuler1DCore<T>::march_half_so1_alpha(bool odd_plane)
 {
     MODMESH_TIME("Euler1DKernel::march_half_so1_alpha");
+    refresh_metric();
+    m_so1.detach();
+    march_lanes(
+        odd_plane,
+        [this](int_type ic, lanes_type const & lanes, size_t nlane)
+        {
+            march_type::template block_so1_alpha<ALPHA>(ic, lanes, nlane, m_metric, m_so0, m_so1);
+            return 0.0;
+        });
+}
 
-    const int_type start = BOUND_COUNT - (odd_plane ? 1 : 0);
-    const int_type stop = static_cast<int_type>(ncoord() - BOUND_COUNT - (odd_plane ? 0 : 1));
-    // Kernal at xneg solution element.
-    Euler1DKernel kernxn{};
-    kernxn
-        .set_time_increment(m_time_increment);
-    // Kernal at xpos solution element.
-    Euler1DKernel kernxp{};
-    kernxp
-        .set_time_increment(m_time_increment)
-        // Populate using the solution element.
-        .set_value(start, m_gamma, m_coord, m_so0, m_so1)
-        .derive();
-    for (int_type ic = start; ic < stop; ic += 2)
-    {
-        // Update kernels (avoid duplicate expensiave calculation).
-        kernxn = kernxp;
-        kernxp
-            .set_value(ic + 2, m_gamma, m_coord, m_so0, m_so1)
-            .derive();
-        // Calculate the gradient.
-        for (size_t iv = 0; iv < 3; ++iv)
+/**
+ * Calculate so0 and so1 at the next half time step, and the CFL number at
+ * the current plane, in one loop.  The result is the same as
+ * march_half_so0(), update_cfl(), and march_half_so1_alpha() in sequence,
+ * but a solution element is derived once instead of twice.
+ */
+template <typename T>
+template <size_t ALPHA>
+inline void BasicEuler1DCore<T>::march_half_alpha(bool odd_plane)
+{
+    MODMESH_TIME("Euler1DCore::march_half_alpha");
+    refresh_metric();
+    m_so0.detach();
+    m_so1.detach();
+    m_cfl.detach();
+    m_max_cfl = march_lanes(
+        odd_plane,
+        [this](int_type ic, lanes_type const & lanes, size_t nlane)
         {
-            const double utp = m_so0(ic + 1, iv);
-            const double duxn = (utp - kernxn.up[iv]) / (kernxn.xpos - kernxn.x);
-            const double duxp = (kernxp.up[iv] - utp) / (kernxp.x - kernxp.xneg);
-            const double fan = pow<ALPHA>(std::abs(duxn));
-            const double fap = pow<ALPHA>(std::abs(duxp));
-            m_so1(ic + 1, iv) = (fap * duxn + fan * duxp) / (fap + fan + Euler1DKernel::tiny);
-        }
-    }
+            march_type::block_so0(ic, lanes, nlane, m_metric, m_so0);
+            double const max_cfl = march_block_cfl(ic, nlane);
+            march_type::template block_so1_alpha<ALPHA>(ic, lanes, nlane, m_metric, m_so0, m_so1);
+            return max_cfl;
+        });
 }
 
+template <typename T>
 template <size_t ALPHA>
-inline void Euler1DCore::march_half1_alpha()
+inline void BasicEuler1DCore<T>::march_half1_alpha()
 {
-    march_half_so0(/*odd_plane*/ false);
-    update_cfl(/*odd_plane*/ false);
-    march_half_so1_alpha<ALPHA>(false);
+    march_half_alpha<ALPHA>(/*odd_plane*/ false);
 }
 
+template <typename T>
 template <size_t ALPHA>
-inline void Euler1DCore::march_half2_alpha()
+inline void BasicEuler1DCore<T>::march_half2_alpha()
 {
     // In the second half step, no treating boundary conditions.
-    march_half_so0(/*odd_plane*/ true);
-    update_cfl(/*odd_plane*/ true);
-    march_half_so1_alpha<ALPHA>(true);
+    march_half_alpha<ALPHA>(/*odd_plane*/ true);
 }
 
+template <typename T>
 template <size_t ALPHA>
-inline void Euler1DCore::march_alpha(size_t steps)
+inline void BasicEuler1DCore<T>::march_alpha(size_t steps)
 {
     for (size_t it = 0; it < steps; ++it)
     {
@@ -340,7 +840,75 @@ inline void Euler1DCore::march_alpha(size_t steps)
         treat_boundary_so0();
         treat_boundary_so1();
         march_half2_alpha<ALPHA>();
+        m_time += m_time_increment;
+        ++m_nstep;
+        march_snapshot();
+    }
+}
+
+/**
+ * March to time_stop while adjusting the time increment to hold the maximum
+ * CFL number at target_cfl.  The CFL number is proportional to the time
+ * increment, so the next time increment is scaled by the ratio of the target
+ * to the maximum CFL number of both half steps, and clamped in [dt_min,
+ * dt_max].  Before a step, the CFL number of the current solution is
+ * calculated with the candidate time increment, which is shrunk if the number
+ * exceeds the target, so that an oversized initial time increment is not
+ * marched.  The last one or two steps are shortened to stop at time_stop.
+ * Return the number of steps marched.
+ */
+template <typename T>
+template <size_t ALPHA>
+inline size_t BasicEuler1DCore<T>::march_alpha_adaptive(double time_stop, double target_cfl, double dt_min, double dt_max)
+{
+    MODMESH_TIME("Euler1DCore::march_alpha_adaptive");
+    if (!(target_cfl > 0))
+    {
+        throw std::invalid_argument(Formatter() << "Euler1DCore::march_alpha_adaptive: target_cfl " << target_cfl
+                                                << " must be positive");
+    }
+    if (!(dt_min > 0) || dt_min > dt_max)
+    {
+        throw std::invalid_argument(Formatter() << "Euler1DCore::march_alpha_adaptive: invalid bounds of time increment ["
+                                                << dt_min << ", " << dt_max << "]");
+    }
+    size_t steps = 0;
+    while (m_time < time_stop)
+    {
+        double dt = std::clamp(m_time_increment, dt_min, dt_max);
+        m_time_increment = dt;
+        update_cfl(false);
+        if (m_max_cfl > target_cfl)
+        {
+            dt = std::max(dt_min, dt * (target_cfl / m_max_cfl));
+        }
+        bool const last = dt >= time_stop - m_time;
+        if (last)
+        {
+            dt = time_stop - m_time;
+        }
+        else if (2 * dt > time_stop - m_time)
+        {
+            // Split the rest in two steps instead of leaving a tiny one.
+            dt = (time_stop - m_time) / 2;
+        }
+        m_time_increment = dt;
+
+        march_half1_alpha<ALPHA>();
+        double cfl = m_max_cfl;
+        treat_boundary_so0();
+        treat_boundary_so1();
+        march_half2_alpha<ALPHA>();
+        cfl = std::max(cfl, m_max_cfl);
+
+        m_time = last ? time_stop : m_time + dt;
+        m_time_history.push_back({m_time, dt, cfl});
+        ++m_nstep;
+        ++steps;
+        march_snapshot();
+        m_time_increment = cfl > 0 ? dt * (target_cfl / cfl) : dt_max;
     }
+    return steps;
 }
 
 } /* end namespace onedim */
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <modmesh/onedim/Euler1DEnsemble.hpp>
+
+namespace modmesh
+{
+
+namespace onedim
+{
+
+std::ostream & operator<<(std::ostream & os, const Euler1DEnsemble & ens)
+{
+    os << "Euler1DEnsemble(ncoord=" << ens.ncoord() << ", nmember=" << ens.nmember() << ")";
+    return os;
+}
+
+Euler1DEnsemble::Euler1DEnsemble(size_t ncoord, size_t nmember, double time_increment, ctor_passkey const &)
+    : m_nmember(nmember)
+{
+    MODMESH_TIME("Euler1DEnsemble::Euler1DEnsemble");
+    if (0 == ncoord % 2)
+    {
+        throw std::invalid_argument("ncoord cannot be even");
+    }
+    if (0 == nmember)
+    {
+        throw std::invalid_argument("nmember cannot be zero");
+    }
+    m_time_increment = SimpleArray<double>(/*shape*/ small_vector<size_t>{nmember}, /*value*/ time_increment);
+    m_coord = SimpleArray<double>(/*length*/ ncoord);
+    m_cfl = SimpleArray<double>(/*shape*/ small_vector<size_t>{ncoord, nmember});
+    m_so0 = SimpleArray<double>(/*shape*/ small_vector<size_t>{ncoord, nmember, NVAR});
+    m_so1 = SimpleArray<double>(/*shape*/ small_vector<size_t>{ncoord, nmember, NVAR});
+    m_gamma = SimpleArray<double>(/*shape*/ small_vector<size_t>{ncoord, nmember}, /*value*/ 1.4);
+}
+
+Euler1DEnsemble::Euler1DEnsemble(Euler1DCore const & core, size_t nmember, ctor_passkey const & key)
+    : Euler1DEnsemble(core.ncoord(), nmember, core.time_increment(), key)
+{
+    m_coord = core.coord();
+    for (size_t im = 0; im < nmember; ++im)
+    {
+        load_member(im, core);
+    }
+}
+
+void Euler1DEnsemble::check_member(size_t imember) const
+{
+    if (imember >= m_nmember)
+    {
+        throw std::out_of_range(Formatter() << "Euler1DEnsemble: member index " << imember
+                                            << " is out of range for nmember " << m_nmember);
+    }
+}
+
+void Euler1DEnsemble::check_core(Euler1DCore const & core) const
+{
+    if (core.ncoord() != ncoord())
+    {
+        throw std::invalid_argument(Formatter() << "Euler1DEnsemble: ncoord of the core (" << core.ncoord()
+                                                << ") differs from the ensemble (" << ncoord() << ")");
+    }
+    for (size_t ic = 0; ic < ncoord(); ++ic)
+    {
+        if (core.coord()(ic) != m_coord(ic))
+        {
+            throw std::invalid_argument(Formatter() << "Euler1DEnsemble: coord of the core differs from the ensemble at "
+                                                    << ic);
+        }
+    }
+}
+
+void Euler1DEnsemble::load_member(size_t imember, Euler1DCore const & core)
+{
+    check_member(imember);
+    check_core(core);
+    m_time_increment(imember) = core.time_increment();
+    for (size_t ic = 0; ic < ncoord(); ++ic)
+    {
+        m_cfl(ic, imember) = core.cfl()(ic);
+        m_gamma(ic, imember) = core.gamma()(ic);
+        for (size_t iv = 0; iv < NVAR; ++iv)
+        {
+            m_so0(ic, imember, iv) = core.so0()(ic, iv);
+            m_so1(ic, imember, iv) = core.so1()(ic, iv);
+        }
+    }
+}
+
+std::shared_ptr<Euler1DCore> Euler1DEnsemble::extract_member(size_t imember) const
+{
+    check_member(imember);
+    std::shared_ptr<Euler1DCore> core = Euler1DCore::construct(ncoord(), m_time_increment(imember));
+    core->coord() = m_coord;
+    core->update_metric();
+    for (size_t ic = 0; ic < ncoord(); ++ic)
+    {
+        core->cfl()(ic) = m_cfl(ic, imember);
+        core->gamma()(ic) = m_gamma(ic, imember);
+        for (size_t iv = 0; iv < NVAR; ++iv)
+        {
+            core->so0()(ic, iv) = m_so0(ic, imember, iv);
+            core->so1()(ic, iv) = m_so1(ic, imember, iv);
+        }
+    }
+    return core;
+}
+
+void Euler1DEnsemble::update_cfl(bool odd_plane)
+{
+    MODMESH_TIME("Euler1DEnsemble::update_cfl");
+    const int_type start = BOUND_COUNT - (odd_plane ? 1 : 0);
+    const auto stop = static_cast<int_type>(ncoord() - BOUND_COUNT - (odd_plane ? 0 : 1));
+    for (int_type it = start; it < stop; it += 2)
+    {
+        const double dxpos = m_coord(it + 1) - m_coord(it);
+        const double dxneg = m_coord(it) - m_coord(it - 1);
+        for (size_t im = 0; im < m_nmember; ++im)
+        {
+            const double hdt = m_time_increment(im) / 2;
+            m_cfl(it, im) = Euler1DKernel::cfl(m_gamma(it, im), m_so0(it, im, 0), m_so0(it, im, 1), m_so0(it, im, 2), hdt, dxpos < dxneg ? dxpos : dxneg);
+        }
+    }
+}
+
+void Euler1DEnsemble::treat_boundary_so0()
+{
+    // Non-reflecting boundary condition, the same as Euler1DCore.
+    size_t const nval = m_nmember * NVAR;
+    double * lo = m_so0.vptr(1, 0, 0);
+    double * hi = m_so0.vptr(ncoord() - 2, 0, 0);
+    for (size_t it = 0; it < nval; ++it)
+    {
+        lo[it] = lo[it + nval];
+        hi[it] = hi[it - nval];
+    }
+}
+
+void Euler1DEnsemble::treat_boundary_so1()
+{
+    // Non-reflecting boundary condition, the same as Euler1DCore.
+    size_t const nval = m_nmember * NVAR;
+    double * lo = m_so1.vptr(1, 0, 0);
+    double * hi = m_so1.vptr(ncoord() - 2, 0, 0);
+    for (size_t it = 0; it < nval; ++it)
+    {
+        lo[it] = lo[it + nval];
+        hi[it] = hi[it - nval];
+    }
+}
+
+void Euler1DEnsemble::derive(int_type ic, double const * hdt, double const * qdt, double * out) const
+{
+    MODMESH_HOT_TIME("Euler1DEnsemble::derive", 64, m_nmember);
+    size_t const nmember = m_nmember;
+    double const x = m_coord(ic);
+    double const xneg = m_coord(ic - 1);
+    double const xpos = m_coord(ic + 1);
+    double const xctr = (xpos + xneg) * 0.5;
+    double const dxctr = x - xctr;
+    double const deltax_ll = xpos - x;
+    double const dxmid_ll = 0.5 * (x + xpos) - xctr;
+    double const deltax_lr = x - xneg;
+    double const dxmid_lr = 0.5 * (x + xneg) - xctr;
+
+    double const * so0 = m_so0.vptr(ic, 0, 0);
+    double const * so1 = m_so1.vptr(ic, 0, 0);
+    double const * gamma = m_gamma.vptr(ic, 0);
+
+    // The same kernel as Euler1DCore keeps the results identical.
+    for (size_t im = 0; im < nmember; ++im)
+    {
+        double const * u = so0 + im * NVAR;
+        double const * ux = so1 + im * NVAR;
+        Euler1DKernel::derive(
+            gamma[im], hdt[im], qdt[im],
+            dxctr, deltax_ll, dxmid_ll, deltax_lr, dxmid_lr,
+            u[0], u[1], u[2], ux[0], ux[1], ux[2],
+            out + im, nmember);
+    }
+}
+
+} /* end namespace onedim */
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
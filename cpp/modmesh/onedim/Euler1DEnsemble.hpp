@@ -0,0 +1,252 @@
+#pragma once
+
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Ensemble of one-dimensional Euler solvers sharing a grid.
+ */
+
+#include <modmesh/onedim/Euler1DCore.hpp>
+#include <modmesh/parallel.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace modmesh
+{
+
+namespace onedim
+{
+
+/**
+ * March nmember independent solutions of the Euler equation on the same grid
+ * in one loop.  The solution arrays are interleaved in the [x][member][var]
+ * layout, so that the innermost loop over the members reads contiguous memory
+ * and may be vectorized, while the loop over the conservation elements is
+ * split into chunks for threads.  Every member has its own time increment,
+ * initial condition, and gamma.
+ *
+ * The arithmetic of each member is the same as Euler1DCore, and the result of
+ * a member is identical to marching it alone.
+ */
+class Euler1DEnsemble
+    : public std::enable_shared_from_this<Euler1DEnsemble>
+{
+
+public:
+
+    constexpr static size_t BOUND_COUNT = Euler1DCore::BOUND_COUNT;
+    static constexpr uint8_t NVAR = Euler1DCore::NVAR;
+    static constexpr double TINY = Euler1DCore::TINY;
+    /// Minimal number of (element, member) pairs in a chunk of a parallel loop.
+    static constexpr size_t MARCH_GRAIN = 4096;
+
+private:
+
+    struct ctor_passkey
+    {
+    };
+
+public:
+
+    template <class... Args>
+    static std::shared_ptr<Euler1DEnsemble> construct(Args &&... args)
+    {
+        return std::make_shared<Euler1DEnsemble>(std::forward<Args>(args)..., ctor_passkey());
+    }
+
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    Euler1DEnsemble(size_t ncoord, size_t nmember, double time_increment, ctor_passkey const &);
+
+    /// Replicate the grid, the solution, and the time increment of a core to all members.
+    Euler1DEnsemble(Euler1DCore const & core, size_t nmember, ctor_passkey const &);
+
+    Euler1DEnsemble() = delete;
+    Euler1DEnsemble(Euler1DEnsemble const &) = default;
+    Euler1DEnsemble(Euler1DEnsemble &&) = default;
+    Euler1DEnsemble & operator=(Euler1DEnsemble const &) = default;
+    Euler1DEnsemble & operator=(Euler1DEnsemble &&) = default;
+    ~Euler1DEnsemble() = default;
+
+    size_t ncoord() const { return m_coord.size(); }
+    size_t nmember() const { return m_nmember; }
+
+    SimpleArray<double> const & time_increment() const { return m_time_increment; }
+    SimpleArray<double> & time_increment() { return m_time_increment; }
+
+    SimpleArray<double> const & coord() const { return m_coord; }
+    SimpleArray<double> & coord() { return m_coord; }
+    SimpleArray<double> const & cfl() const { return m_cfl; }
+    SimpleArray<double> & cfl() { return m_cfl; }
+    SimpleArray<double> const & so0() const { return m_so0; }
+    SimpleArray<double> & so0() { return m_so0; }
+    SimpleArray<double> const & so1() const { return m_so1; }
+    SimpleArray<double> & so1() { return m_so1; }
+    SimpleArray<double> const & gamma() const { return m_gamma; }
+    SimpleArray<double> & gamma() { return m_gamma; }
+
+    /// Copy the solution, gamma, cfl, and time increment of a core to a member.
+    void load_member(size_t imember, Euler1DCore const & core);
+    /// Make a core holding the grid and the solution of a member.
+    std::shared_ptr<Euler1DCore> extract_member(size_t imember) const;
+
+    void update_cfl(bool odd_plane);
+    void treat_boundary_so0();
+    void treat_boundary_so1();
+
+    void setup_march() { update_cfl(false); }
+    template <size_t ALPHA>
+    void march_half_alpha(bool odd_plane);
+    template <size_t ALPHA>
+    void march_alpha(size_t steps);
+
+private:
+
+    void check_member(size_t imember) const;
+    void check_core(Euler1DCore const & core) const;
+
+    /**
+     * Calculate the fluxes and the t+ tip value of the solution element at
+     * ic for all members.  out holds 3 * NVAR arrays of nmember values:
+     * flux_ll, flux_lr, and up.
+     */
+    void derive(int_type ic, double const * hdt, double const * qdt, double * out) const;
+
+    size_t m_nmember = 0;
+    SimpleArray<double> m_time_increment;
+    SimpleArray<double> m_coord;
+    SimpleArray<double> m_cfl;
+    SimpleArray<double> m_so0;
+    SimpleArray<double> m_so1;
+    SimpleArray<double> m_gamma;
+
+}; /* end class Euler1DEnsemble */
+
+std::ostream & operator<<(std::ostream & os, const Euler1DEnsemble & ens);
+
+/**
+ * Calculate so0 and so1 at the next half time step and cfl at the current
+ * plane in one parallel loop over the conservation elements.  A chunk keeps
+ * the derived values of its last solution element to share between the two
+ * adjacent conservation elements, like Euler1DCore does.
+ */
+template <size_t ALPHA>
+inline void Euler1DEnsemble::march_half_alpha(bool odd_plane)
+{
+    MODMESH_TIME("Euler1DEnsemble::march_half_alpha");
+
+    size_t const nmember = m_nmember;
+    const int_type start = BOUND_COUNT - (odd_plane ? 1 : 0);
+    const auto stop = static_cast<int_type>(ncoord() - BOUND_COUNT - (odd_plane ? 0 : 1));
+    if (stop <= start)
+    {
+        return;
+    }
+    size_t const nce = static_cast<size_t>(stop - start + 1) / 2;
+
+    std::vector<double> hdt(nmember);
+    std::vector<double> qdt(nmember);
+    for (size_t im = 0; im < nmember; ++im)
+    {
+        hdt[im] = m_time_increment(im) / 2.0;
+        qdt[im] = hdt[im] / 2.0;
+    }
+
+    parallel_for(
+        0, nce, [&](size_t ibegin, size_t iend)
+        {
+            size_t const nslot = 3 * NVAR * nmember;
+            std::vector<double> buf(2 * nslot);
+            double * drvn = buf.data(); // Solution element at xneg.
+            double * drvp = buf.data() + nslot; // Solution element at xpos.
+            derive(start + static_cast<int_type>(2 * ibegin), hdt.data(), qdt.data(), drvp);
+            for (size_t ice = ibegin; ice < iend; ++ice)
+            {
+                int_type const ic = start + static_cast<int_type>(2 * ice);
+                std::swap(drvn, drvp);
+                derive(ic + 2, hdt.data(), qdt.data(), drvp);
+
+                double const dx_inv = 1.0 / (m_coord(ic + 2) - m_coord(ic));
+                double const dxn_inv = 1.0 / (m_coord(ic + 1) - m_coord(ic));
+                double const dxp_inv = 1.0 / (m_coord(ic + 2) - m_coord(ic + 1));
+                double * so0tp = m_so0.vptr(ic + 1, 0, 0);
+                double * so1tp = m_so1.vptr(ic + 1, 0, 0);
+                for (size_t iv = 0; iv < NVAR; ++iv)
+                {
+                    double const * flux_ll = drvn + iv * nmember;
+                    double const * flux_lr = drvp + (NVAR + iv) * nmember;
+                    double const * upn = drvn + (2 * NVAR + iv) * nmember;
+                    double const * upp = drvp + (2 * NVAR + iv) * nmember;
+                    for (size_t im = 0; im < nmember; ++im)
+                    {
+                        // Flux conservation.
+                        double const utp = (flux_ll[im] + flux_lr[im]) * dx_inv;
+                        so0tp[im * NVAR + iv] = utp;
+                        // Gradient by the alpha scheme.
+                        const double duxn = (utp - upn[im]) * dxn_inv;
+                        const double duxp = (upp[im] - utp) * dxp_inv;
+                        const double fan = pow<ALPHA>(std::abs(duxn));
+                        const double fap = pow<ALPHA>(std::abs(duxp));
+                        so1tp[im * NVAR + iv] = (fap * duxn + fan * duxp) / (fap + fan + Euler1DKernel::tiny);
+                    }
+                }
+
+                // CFL at the current plane.
+                double const dxpos = m_coord(ic + 1) - m_coord(ic);
+                double const dxneg = m_coord(ic) - m_coord(ic - 1);
+                double const dxmin = dxpos < dxneg ? dxpos : dxneg;
+                double const * u = m_so0.vptr(ic, 0, 0);
+                double const * ga = m_gamma.vptr(ic, 0);
+                double * cfl = m_cfl.vptr(ic, 0);
+                for (size_t im = 0; im < nmember; ++im)
+                {
+                    cfl[im] = Euler1DKernel::cfl(ga[im], u[im * NVAR], u[im * NVAR + 1], u[im * NVAR + 2], hdt[im], dxmin);
+                }
+            } },
+        std::max(size_t(1), MARCH_GRAIN / nmember));
+}
+
+template <size_t ALPHA>
+inline void Euler1DEnsemble::march_alpha(size_t steps)
+{
+    for (size_t it = 0; it < steps; ++it)
+    {
+        march_half_alpha<ALPHA>(/*odd_plane*/ false);
+        treat_boundary_so0();
+        treat_boundary_so1();
+        // In the second half step, no treating boundary conditions.
+        march_half_alpha<ALPHA>(/*odd_plane*/ true);
+    }
+}
+
+} /* end namespace onedim */
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
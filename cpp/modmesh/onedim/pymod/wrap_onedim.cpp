@@ -38,13 +38,72 @@ namespace python
 
 using namespace modmesh::onedim; // NOLINT(google-build-using-namespace)
 
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapEuler1DPrimitives
+    : public WrapBase<WrapEuler1DPrimitives, Euler1DPrimitives>
+{
+
+public:
+
+    using base_type = WrapBase<WrapEuler1DPrimitives, Euler1DPrimitives>;
+    using wrapper_type = typename base_type::wrapper_type;
+    using wrapped_type = typename base_type::wrapped_type;
+
+    friend base_type;
+
+protected:
+
+    WrapEuler1DPrimitives(pybind11::module & mod, const char * pyname, const char * clsdoc)
+        : base_type(mod, pyname, clsdoc)
+    {
+
+        namespace py = pybind11;
+
+        (*this)
+            .def(
+                py::init(
+                    [](size_t ncoord)
+                    { return std::make_unique<wrapped_type>(ncoord); }),
+                py::arg("ncoord"))
+            .def(
+                py::init(
+                    [](size_t ncoord, std::vector<std::string> const & fields)
+                    { return std::make_unique<wrapped_type>(ncoord, fields); }),
+                py::arg("ncoord"),
+                py::arg("fields"))
+            .def_property_readonly_static(
+                "fields",
+                [](py::handle const &)
+                { return std::vector<std::string>(std::begin(wrapped_type::FIELDS), std::end(wrapped_type::FIELDS)); });
+
+        for (char const * name : wrapped_type::FIELDS)
+        {
+            // The buffer is returned as an array sharing the memory, or None
+            // if the field is not requested.
+            (*this)
+                .def_property_readonly(
+                    name,
+                    [name](wrapped_type & self) -> py::object
+                    {
+                        SimpleArray<double> & arr = self.field(name);
+                        if (0 == arr.size())
+                        {
+                            return py::none();
+                        }
+                        return to_ndarray(arr);
+                    });
+        }
+    }
+
+}; /* end class WrapEuler1DPrimitives */
+
+template <typename T>
 class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapEuler1DCore
-    : public WrapBase<WrapEuler1DCore, Euler1DCore, std::shared_ptr<Euler1DCore>>
+    : public WrapBase<WrapEuler1DCore<T>, BasicEuler1DCore<T>, std::shared_ptr<BasicEuler1DCore<T>>>
 {
 
 public:
 
-    using base_type = WrapBase<WrapEuler1DCore, Euler1DCore, std::shared_ptr<Euler1DCore>>;
+    using base_type = WrapBase<WrapEuler1DCore<T>, BasicEuler1DCore<T>, std::shared_ptr<BasicEuler1DCore<T>>>;
     using wrapper_type = typename base_type::wrapper_type;
     using wrapped_type = typename base_type::wrapped_type;
 
@@ -69,11 +128,31 @@ protected:
                 py::arg("time_increment"))
             .def("__str__", &detail::to_str<wrapped_type>)
             .def_timed("clone", &wrapped_type::clone)
+            .def_property_readonly("shared_arrays", &wrapped_type::shared_arrays)
             .def_property_readonly_static(
                 "nvar",
                 [](py::handle const &)
                 { return size_t(wrapped_type::NVAR); })
-            .def_property_readonly("time_increment", &wrapped_type::time_increment)
+            .def_property("time_increment", &wrapped_type::time_increment, &wrapped_type::set_time_increment)
+            .def_property("time", &wrapped_type::time, &wrapped_type::set_time)
+            .def_property_readonly("max_cfl", &wrapped_type::max_cfl)
+            .def_property_readonly(
+                "time_history",
+                [](wrapped_type & self)
+                { return to_ndarray(self.time_history()); })
+            .def("clear_time_history", &wrapped_type::clear_time_history)
+            .def_property("nstep", &wrapped_type::nstep, &wrapped_type::set_nstep)
+            .def("save_checkpoint", &wrapped_type::save_checkpoint, py::arg("path"), py::arg("float32") = false)
+            .def("load_checkpoint", &wrapped_type::load_checkpoint, py::arg("path"))
+            .def(
+                "set_snapshot",
+                &wrapped_type::set_snapshot,
+                py::arg("writer"),
+                py::arg("interval"),
+                py::arg("fields"))
+            .def("clear_snapshot", &wrapped_type::clear_snapshot)
+            .def_property_readonly("snapshot_writer", &wrapped_type::snapshot_writer)
+            .def("take_snapshot", &wrapped_type::take_snapshot)
             .def_property_readonly("ncoord", &wrapped_type::ncoord);
 
         (*this)
@@ -100,7 +179,8 @@ protected:
             .def_property_readonly(
                 "entropy",
                 [](wrapped_type & self)
-                { return to_ndarray(self.entropy()); });
+                { return to_ndarray(self.entropy()); })
+            .def_timed("primitives", &wrapped_type::primitives, py::arg("out"));
 
         (*this)
             .def_property_readonly(
@@ -131,11 +211,12 @@ protected:
             .def_timed("march_half_so0", &wrapped_type::march_half_so0, py::arg("odd_plane"))
             .def_timed("treat_boundary_so0", &wrapped_type::treat_boundary_so0)
             .def_timed("treat_boundary_so1", &wrapped_type::treat_boundary_so1)
+            .def_timed("update_metric", &wrapped_type::update_metric)
             .def_timed("setup_march", &wrapped_type::setup_march);
 
         (*this)
-            .def_group_so1<1>()
-            .def_group_so1<2>();
+            .template def_group_so1<1>()
+            .template def_group_so1<2>();
     }
 
     template <size_t ALPHA>
@@ -170,18 +251,260 @@ protected:
                 {
                     self.template march_alpha<ALPHA>(steps);
                 },
-                py::arg("steps"));
+                py::arg("steps"))
+            .def_timed(
+                (Formatter() << "march_alpha" << ALPHA << "_adaptive").str().c_str(),
+                [](wrapped_type & self, double time_stop, double target_cfl, double dt_min, double dt_max)
+                {
+                    return self.template march_alpha_adaptive<ALPHA>(time_stop, target_cfl, dt_min, dt_max);
+                },
+                py::arg("time_stop"),
+                py::arg("target_cfl"),
+                py::arg("dt_min"),
+                py::arg("dt_max"));
 
         return *this;
     }
 
 }; /* end class WrapEuler1DCore */
 
+template <typename P>
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapConservation1DCore
+    : public WrapBase<WrapConservation1DCore<P>, Conservation1DCore<P>, std::shared_ptr<Conservation1DCore<P>>>
+{
+
+public:
+
+    using base_type = WrapBase<WrapConservation1DCore<P>, Conservation1DCore<P>, std::shared_ptr<Conservation1DCore<P>>>;
+    using wrapper_type = typename base_type::wrapper_type;
+    using wrapped_type = typename base_type::wrapped_type;
+
+    friend base_type;
+
+    /// Define the read-write property of a constant of the flux policy.
+    wrapper_type & def_policy_property(char const * name, double P::*member)
+    {
+        return (*this)
+            .def_property(
+                name,
+                [member](wrapped_type const & self)
+                { return self.policy().*member; },
+                [member](wrapped_type & self, double value)
+                { self.policy().*member = value; });
+    }
+
+protected:
+
+    WrapConservation1DCore(pybind11::module & mod, const char * pyname, const char * clsdoc)
+        : base_type(mod, pyname, clsdoc)
+    {
+
+        namespace py = pybind11;
+
+        (*this)
+            .def(
+                py::init(
+                    [](size_t ncoord, double time_increment)
+                    {
+                        return wrapped_type::construct(ncoord, time_increment);
+                    }),
+                py::arg("ncoord"),
+                py::arg("time_increment"))
+            .def_timed("clone", &wrapped_type::clone)
+            .def_property_readonly_static(
+                "nvar",
+                [](py::handle const &)
+                { return size_t(wrapped_type::NVAR); })
+            .def_property("time_increment", &wrapped_type::time_increment, &wrapped_type::set_time_increment)
+            .def_property("time", &wrapped_type::time, &wrapped_type::set_time)
+            .def_property_readonly("max_cfl", &wrapped_type::max_cfl)
+            .def_property("nstep", &wrapped_type::nstep, &wrapped_type::set_nstep)
+            .def_property_readonly("ncoord", &wrapped_type::ncoord);
+
+        (*this)
+            .def_property_readonly(
+                "coord",
+                [](wrapped_type & self)
+                { return to_ndarray(self.coord()); })
+            .def_property_readonly(
+                "cfl",
+                [](wrapped_type & self)
+                { return to_ndarray(self.cfl()); })
+            .def_property_readonly(
+                "so0",
+                [](wrapped_type & self)
+                { return to_ndarray(self.so0()); })
+            .def_property_readonly(
+                "so1",
+                [](wrapped_type & self)
+                { return to_ndarray(self.so1()); });
+
+        (*this)
+            .def_timed("update_cfl", &wrapped_type::update_cfl, py::arg("odd_plane"))
+            .def_timed("treat_boundary_so0", &wrapped_type::treat_boundary_so0)
+            .def_timed("treat_boundary_so1", &wrapped_type::treat_boundary_so1)
+            .def_timed("update_metric", &wrapped_type::update_metric)
+            .def_timed("setup_march", &wrapped_type::setup_march);
+
+        (*this)
+            .template def_group_march<1>()
+            .template def_group_march<2>();
+    }
+
+    template <size_t ALPHA>
+    wrapper_type & def_group_march()
+    {
+        // NOLINTNEXTLINE(misc-unused-alias-decls)
+        namespace py = pybind11;
+
+        (*this)
+            .def_timed(
+                (Formatter() << "march_half_alpha" << ALPHA).str().c_str(),
+                [](wrapped_type & self, bool odd_plane)
+                {
+                    self.template march_half_alpha<ALPHA>(odd_plane);
+                },
+                py::arg("odd_plane"))
+            .def_timed(
+                (Formatter() << "march_alpha" << ALPHA).str().c_str(),
+                [](wrapped_type & self, size_t steps)
+                {
+                    self.template march_alpha<ALPHA>(steps);
+                },
+                py::arg("steps"));
+
+        return *this;
+    }
+
+}; /* end class WrapConservation1DCore */
+
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapEuler1DEnsemble
+    : public WrapBase<WrapEuler1DEnsemble, Euler1DEnsemble, std::shared_ptr<Euler1DEnsemble>>
+{
+
+public:
+
+    using base_type = WrapBase<WrapEuler1DEnsemble, Euler1DEnsemble, std::shared_ptr<Euler1DEnsemble>>;
+    using wrapper_type = typename base_type::wrapper_type;
+    using wrapped_type = typename base_type::wrapped_type;
+
+    friend base_type;
+
+protected:
+
+    WrapEuler1DEnsemble(pybind11::module & mod, const char * pyname, const char * clsdoc)
+        : base_type(mod, pyname, clsdoc)
+    {
+
+        namespace py = pybind11;
+
+        (*this)
+            .def(
+                py::init(
+                    [](size_t ncoord, size_t nmember, double time_increment)
+                    {
+                        return wrapped_type::construct(ncoord, nmember, time_increment);
+                    }),
+                py::arg("ncoord"),
+                py::arg("nmember"),
+                py::arg("time_increment"))
+            .def(
+                py::init(
+                    [](Euler1DCore const & core, size_t nmember)
+                    {
+                        return wrapped_type::construct(core, nmember);
+                    }),
+                py::arg("core"),
+                py::arg("nmember"))
+            .def("__str__", &detail::to_str<wrapped_type>)
+            .def_property_readonly_static(
+                "nvar",
+                [](py::handle const &)
+                { return size_t(wrapped_type::NVAR); })
+            .def_property_readonly("ncoord", &wrapped_type::ncoord)
+            .def_property_readonly("nmember", &wrapped_type::nmember);
+
+        (*this)
+            .def_property_readonly(
+                "time_increment",
+                [](wrapped_type & self)
+                { return to_ndarray(self.time_increment()); })
+            .def_property_readonly(
+                "gamma",
+                [](wrapped_type & self)
+                { return to_ndarray(self.gamma()); })
+            .def_property_readonly(
+                "coord",
+                [](wrapped_type & self)
+                { return to_ndarray(self.coord()); })
+            .def_property_readonly(
+                "cfl",
+                [](wrapped_type & self)
+                { return to_ndarray(self.cfl()); })
+            .def_property_readonly(
+                "so0",
+                [](wrapped_type & self)
+                { return to_ndarray(self.so0()); })
+            .def_property_readonly(
+                "so1",
+                [](wrapped_type & self)
+                { return to_ndarray(self.so1()); });
+
+        (*this)
+            .def("load_member", &wrapped_type::load_member, py::arg("imember"), py::arg("core"))
+            .def("extract_member", &wrapped_type::extract_member, py::arg("imember"))
+            .def_timed("update_cfl", &wrapped_type::update_cfl, py::arg("odd_plane"))
+            .def_timed("treat_boundary_so0", &wrapped_type::treat_boundary_so0)
+            .def_timed("treat_boundary_so1", &wrapped_type::treat_boundary_so1)
+            .def_timed("setup_march", &wrapped_type::setup_march);
+
+        (*this)
+            .def_group_march<1>()
+            .def_group_march<2>();
+    }
+
+    template <size_t ALPHA>
+    wrapper_type & def_group_march()
+    {
+        // NOLINTNEXTLINE(misc-unused-alias-decls)
+        namespace py = pybind11;
+
+        (*this)
+            .def_timed(
+                (Formatter() << "march_half_alpha" << ALPHA).str().c_str(),
+                [](wrapped_type & self, bool odd_plane)
+                {
+                    self.template march_half_alpha<ALPHA>(odd_plane);
+                },
+                py::arg("odd_plane"))
+            .def_timed(
+                (Formatter() << "march_alpha" << ALPHA).str().c_str(),
+                [](wrapped_type & self, size_t steps)
+                {
+                    self.template march_alpha<ALPHA>(steps);
+                },
+                py::arg("steps"));
+
+        return *this;
+    }
+
+}; /* end class WrapEuler1DEnsemble */
+
 void wrap_onedim(pybind11::module & mod)
 {
     mod.doc() = "One-dimensional space-time CESE method code";
 
-    WrapEuler1DCore::commit(mod, "Euler1DCore", "Solve the Euler equation");
+    WrapEuler1DPrimitives::commit(mod, "Euler1DPrimitives", "Buffers of the primitive variables of Euler1DCore");
+    WrapEuler1DCore<double>::commit(mod, "Euler1DCore", "Solve the Euler equation");
+    mod.attr("Euler1DCoreFp64") = mod.attr("Euler1DCore");
+    WrapEuler1DCore<float>::commit(mod, "Euler1DCoreFp32", "Solve the Euler equation with the solution stored in float32");
+    WrapEuler1DEnsemble::commit(mod, "Euler1DEnsemble", "Solve an ensemble of the Euler equation on the same grid");
+    WrapConservation1DCore<Euler1DFlux>::commit(mod, "GenericEuler1DCore", "Solve the Euler equation with the generic conservation-law core")
+        .def_policy_property("gamma", &Euler1DFlux::gamma);
+    WrapConservation1DCore<IsothermalEuler1DFlux>::commit(mod, "IsothermalEuler1DCore", "Solve the isothermal Euler equation")
+        .def_policy_property("sound_speed", &IsothermalEuler1DFlux::sound_speed);
+    WrapConservation1DCore<ShallowWater1DFlux>::commit(mod, "ShallowWater1DCore", "Solve the shallow water equation")
+        .def_policy_property("gravity", &ShallowWater1DFlux::gravity);
 }
 
 } /* end namespace python */
@@ -0,0 +1,334 @@
+#pragma once
+
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Shared-memory parallel loops.
+ */
+
+#include <modmesh/base.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace modmesh
+{
+
+/**
+ * Process-wide pool of persistent worker threads.  The calling thread always
+ * takes part in the work, so a pool of nthread() threads starts
+ * nthread() - 1 workers.
+ *
+ * A call to run() returns after all of its tasks finish, and works as a
+ * barrier.  It wakes no more workers than it has tasks besides the one the
+ * calling thread takes.  A run() invoked from inside a task executes serially in the
+ * calling thread, so that nested parallel loops do not deadlock.
+ * set_nthread() may be called concurrently with run(); it waits for the
+ * running tasks to finish before resizing the pool.
+ */
+class ThreadPool
+{
+
+public:
+
+    static ThreadPool & me()
+    {
+        static ThreadPool instance;
+        return instance;
+    }
+
+    ThreadPool(ThreadPool const &) = delete;
+    ThreadPool(ThreadPool &&) = delete;
+    ThreadPool & operator=(ThreadPool const &) = delete;
+    ThreadPool & operator=(ThreadPool &&) = delete;
+
+    ~ThreadPool() { stop(); }
+
+    /// Number of threads including the calling thread.
+    size_t nthread() const { return m_nworker.load() + 1; }
+
+    /**
+     * Reset the number of threads (including the calling thread).  Zero means
+     * to use std::thread::hardware_concurrency().
+     */
+    void set_nthread(size_t nthread)
+    {
+        std::lock_guard<std::mutex> const run_lock(m_run_mutex);
+        if (0 == nthread)
+        {
+            nthread = default_nthread();
+        }
+        stop();
+        start(nthread);
+    }
+
+    /// True if the current thread is executing a task of the pool.
+    static bool in_task() { return in_task_flag(); }
+
+    /**
+     * Call func(itask) for itask in [0, ntask) and wait for all of them.  The
+     * first exception thrown by a task is rethrown after all tasks finish.
+     */
+    template <typename F>
+    void run(size_t ntask, F && func)
+    {
+        if (0 == ntask)
+        {
+            return;
+        }
+        // A nested run() must not take m_run_mutex, which the outer run()
+        // holds.
+        if (1 == ntask || in_task_flag())
+        {
+            run_serial(ntask, func);
+            return;
+        }
+        // set_nthread() resizes m_workers under m_run_mutex.
+        std::unique_lock<std::mutex> run_lock(m_run_mutex);
+        if (m_workers.empty())
+        {
+            run_lock.unlock();
+            run_serial(ntask, func);
+            return;
+        }
+
+        using func_type = std::remove_reference_t<F>;
+        m_context = static_cast<void *>(const_cast<std::remove_const_t<func_type> *>(&func));
+        m_invoke = [](void * ctx, size_t itask)
+        { (*static_cast<func_type *>(ctx))(itask); };
+        m_ntask = ntask;
+        m_next.store(0);
+        m_error = nullptr;
+        // The calling thread takes a task, and each woken worker takes a slot.
+        size_t const nwake = std::min(ntask - 1, m_workers.size());
+        {
+            std::lock_guard<std::mutex> const lock(m_mutex);
+            m_nslot = nwake;
+            ++m_generation;
+        }
+        for (size_t it = 0; it < nwake; ++it)
+        {
+            m_cv_start.notify_one();
+        }
+
+        in_task_flag() = true;
+        execute();
+        in_task_flag() = false;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            // All tasks are taken; a worker that has not joined yet has
+            // nothing to do.
+            m_nslot = 0;
+            m_cv_done.wait(lock, [this]
+                           { return 0 == m_nbusy; });
+        }
+        m_context = nullptr;
+        m_invoke = nullptr;
+        if (m_error)
+        {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+private:
+
+    ThreadPool() { start(default_nthread()); }
+
+    static size_t default_nthread()
+    {
+        // NOLINTNEXTLINE(concurrency-mt-unsafe)
+        char const * env = std::getenv("MODMESH_NUM_THREADS");
+        if (nullptr != env)
+        {
+            long const value = std::strtol(env, nullptr, 10);
+            if (value > 0)
+            {
+                return static_cast<size_t>(value);
+            }
+        }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    template <typename F>
+    static void run_serial(size_t ntask, F & func)
+    {
+        for (size_t it = 0; it < ntask; ++it)
+        {
+            func(it);
+        }
+    }
+
+    static bool & in_task_flag()
+    {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    void start(size_t nthread)
+    {
+        m_stop = false;
+        // Workers must start from the current generation; reading it in the
+        // new thread races with a following run().
+        size_t const generation = m_generation;
+        m_workers.reserve(nthread - 1);
+        for (size_t it = 1; it < nthread; ++it)
+        {
+            m_workers.emplace_back([this, generation]
+                                   { worker_loop(generation); });
+        }
+        m_nworker.store(m_workers.size());
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> const lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv_start.notify_all();
+        for (std::thread & worker : m_workers)
+        {
+            worker.join();
+        }
+        m_workers.clear();
+        m_nworker.store(0);
+    }
+
+    void worker_loop(size_t seen)
+    {
+        in_task_flag() = true;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv_start.wait(lock, [this, seen]
+                                { return m_stop || (m_generation != seen && m_nslot > 0); });
+                if (m_stop)
+                {
+                    return;
+                }
+                seen = m_generation;
+                --m_nslot;
+                ++m_nbusy;
+            }
+            execute();
+            {
+                std::lock_guard<std::mutex> const lock(m_mutex);
+                --m_nbusy;
+                if (0 == m_nbusy)
+                {
+                    m_cv_done.notify_one();
+                }
+            }
+        }
+    }
+
+    void execute()
+    {
+        while (true)
+        {
+            size_t const itask = m_next.fetch_add(1);
+            if (itask >= m_ntask)
+            {
+                break;
+            }
+            try
+            {
+                m_invoke(m_context, itask);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> const lock(m_mutex);
+                if (!m_error)
+                {
+                    m_error = std::current_exception();
+                }
+            }
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::atomic<size_t> m_nworker{0}; ///< Size of m_workers for nthread().
+    std::mutex m_run_mutex; ///< Serializes run() from different threads.
+    std::mutex m_mutex;
+    std::condition_variable m_cv_start;
+    std::condition_variable m_cv_done;
+    size_t m_generation = 0;
+    size_t m_nslot = 0; ///< Workers that may still join the current run().
+    size_t m_nbusy = 0; ///< Workers that joined and have not finished.
+    bool m_stop = false;
+
+    void * m_context = nullptr;
+    void (*m_invoke)(void *, size_t) = nullptr;
+    size_t m_ntask = 0;
+    std::atomic<size_t> m_next{0};
+    std::exception_ptr m_error;
+
+}; /* end class ThreadPool */
+
+/**
+ * Split [begin, end) into at most ThreadPool::me().nthread() contiguous
+ * chunks of at least grain elements and call func(ibegin, iend) for each
+ * chunk in parallel.  The chunk boundaries depend only on the range, the
+ * grain, and the number of threads.
+ */
+template <typename F>
+void parallel_for(size_t begin, size_t end, F && func, size_t grain = 1024)
+{
+    if (end <= begin)
+    {
+        return;
+    }
+    size_t const nelem = end - begin;
+    grain = std::max(grain, size_t(1));
+    ThreadPool & pool = ThreadPool::me();
+    size_t const nchunk = std::min(pool.nthread(), (nelem + grain - 1) / grain);
+    if (nchunk <= 1 || ThreadPool::in_task())
+    {
+        func(begin, end);
+        return;
+    }
+    pool.run(
+        nchunk,
+        [&](size_t ichunk)
+        {
+            func(begin + nelem * ichunk / nchunk, begin + nelem * (ichunk + 1) / nchunk);
+        });
+}
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <modmesh/serialization/Checkpoint.hpp>
+
+#include <cstring>
+#include <fstream>
+
+namespace modmesh
+{
+
+namespace detail
+{
+
+constexpr char checkpoint_magic[8] = {'M', 'M', 'C', 'K', 'P', 'T', '\0', '\n'};
+constexpr uint32_t checkpoint_version = 1;
+
+enum : uint32_t
+{
+    CHECKPOINT_FLOAT64 = 1,
+    CHECKPOINT_FLOAT32 = 2,
+    CHECKPOINT_UINT64 = 3
+};
+
+size_t checkpoint_itemsize(uint32_t dtype)
+{
+    return CHECKPOINT_FLOAT32 == dtype ? 4 : 8;
+}
+
+} /* end namespace detail */
+
+uint64_t checksum64(void const * data, size_t nbyte, uint64_t basis)
+{
+    constexpr uint64_t prime = 0x100000001b3ULL;
+    auto const * ptr = static_cast<unsigned char const *>(data);
+    uint64_t hash = basis;
+    size_t const nword = nbyte / sizeof(uint64_t);
+    for (size_t it = 0; it < nword; ++it)
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, ptr + it * sizeof(uint64_t), sizeof(uint64_t));
+        hash ^= word;
+        hash *= prime;
+    }
+    for (size_t it = nword * sizeof(uint64_t); it < nbyte; ++it)
+    {
+        hash ^= ptr[it];
+        hash *= prime;
+    }
+    return hash;
+}
+
+CheckpointWriter::CheckpointWriter(std::string const & kind)
+    : m_kind(kind)
+{
+}
+
+void CheckpointWriter::append(void const * data, size_t nbyte)
+{
+    auto const * ptr = static_cast<char const *>(data);
+    m_buffer.insert(m_buffer.end(), ptr, ptr + nbyte);
+}
+
+void CheckpointWriter::add_header(std::string const & name, uint32_t dtype, small_vector<size_t> const & shape)
+{
+    auto const nname = static_cast<uint32_t>(name.size());
+    append(&nname, sizeof(nname));
+    append(name.data(), name.size());
+    append(&dtype, sizeof(dtype));
+    auto const ndim = static_cast<uint32_t>(shape.size());
+    append(&ndim, sizeof(ndim));
+    for (size_t const len : shape)
+    {
+        auto const len64 = static_cast<uint64_t>(len);
+        append(&len64, sizeof(len64));
+    }
+    ++m_nrecord;
+}
+
+CheckpointWriter & CheckpointWriter::add_array(std::string const & name, SimpleArray<double> const & arr, bool float32)
+{
+    if (float32)
+    {
+        add_header(name, detail::CHECKPOINT_FLOAT32, arr.shape());
+        size_t const offset = m_buffer.size();
+        m_buffer.resize(offset + arr.size() * sizeof(float));
+        char * dst = m_buffer.data() + offset;
+        for (size_t it = 0; it < arr.size(); ++it)
+        {
+            auto const value = static_cast<float>(arr.data(it));
+            std::memcpy(dst + it * sizeof(float), &value, sizeof(float));
+        }
+    }
+    else
+    {
+        add_header(name, detail::CHECKPOINT_FLOAT64, arr.shape());
+        append(arr.data(), arr.nbytes());
+    }
+    return *this;
+}
+
+CheckpointWriter & CheckpointWriter::add_array(std::string const & name, SimpleArray<float> const & arr)
+{
+    add_header(name, detail::CHECKPOINT_FLOAT32, arr.shape());
+    append(arr.data(), arr.nbytes());
+    return *this;
+}
+
+CheckpointWriter & CheckpointWriter::add_real(std::string const & name, double value)
+{
+    add_header(name, detail::CHECKPOINT_FLOAT64, small_vector<size_t>());
+    append(&value, sizeof(value));
+    return *this;
+}
+
+CheckpointWriter & CheckpointWriter::add_integer(std::string const & name, uint64_t value)
+{
+    add_header(name, detail::CHECKPOINT_UINT64, small_vector<size_t>());
+    append(&value, sizeof(value));
+    return *this;
+}
+
+size_t CheckpointWriter::nbyte() const
+{
+    size_t const nkind = m_kind.size() + (8 - m_kind.size() % 8) % 8;
+    return sizeof(detail::checkpoint_magic) + sizeof(uint32_t) * 2 + nkind + sizeof(uint64_t) * 2 + m_buffer.size();
+}
+
+void CheckpointWriter::write(std::ostream & os) const
+{
+    std::vector<char> head(detail::checkpoint_magic, detail::checkpoint_magic + sizeof(detail::checkpoint_magic));
+    auto const push = [&head](void const * data, size_t nbyte)
+    {
+        auto const * ptr = static_cast<char const *>(data);
+        head.insert(head.end(), ptr, ptr + nbyte);
+    };
+    push(&detail::checkpoint_version, sizeof(detail::checkpoint_version));
+    auto const nkind = static_cast<uint32_t>(m_kind.size());
+    push(&nkind, sizeof(nkind));
+    push(m_kind.data(), m_kind.size());
+    // Pad the kind to 8 bytes for the header to be hashed in whole words.
+    head.resize(head.size() + (8 - m_kind.size() % 8) % 8, '\0');
+    auto const nrecord = static_cast<uint64_t>(m_nrecord);
+    push(&nrecord, sizeof(nrecord));
+
+    uint64_t const checksum = checksum64(m_buffer.data(), m_buffer.size(), checksum64(head.data(), head.size()));
+
+    os.write(head.data(), static_cast<std::streamsize>(head.size()));
+    os.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+    os.write(reinterpret_cast<char const *>(&checksum), sizeof(checksum)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+void CheckpointWriter::write(std::string const & path) const
+{
+    std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+    if (!ofs)
+    {
+        throw std::runtime_error(Formatter() << "CheckpointWriter: cannot open " << path << " for writing");
+    }
+    write(ofs);
+    ofs.close();
+    if (!ofs)
+    {
+        throw std::runtime_error(Formatter() << "CheckpointWriter: failed to write " << path);
+    }
+}
+
+CheckpointReader::CheckpointReader(std::string const & path)
+    : m_path(path)
+{
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    if (!ifs)
+    {
+        throw std::runtime_error(Formatter() << "CheckpointReader: cannot open " << path);
+    }
+    auto const nbyte = static_cast<size_t>(ifs.tellg());
+    ifs.seekg(0);
+    m_buffer.resize(nbyte);
+    ifs.read(m_buffer.data(), static_cast<std::streamsize>(nbyte));
+    if (!ifs)
+    {
+        throw std::runtime_error(Formatter() << "CheckpointReader: failed to read " << path);
+    }
+    parse();
+}
+
+CheckpointReader::CheckpointReader(std::vector<char> && buffer, std::string const & name)
+    : m_path(name)
+    , m_buffer(std::move(buffer))
+{
+    parse();
+}
+
+void CheckpointReader::parse()
+{
+    std::string const & path = m_path;
+    size_t const nbyte = m_buffer.size();
+    size_t const nmagic = sizeof(detail::checkpoint_magic);
+    if (nbyte < nmagic + sizeof(uint64_t) || 0 != std::memcmp(m_buffer.data(), detail::checkpoint_magic, nmagic))
+    {
+        throw std::runtime_error(Formatter() << "CheckpointReader: " << path << " is not a checkpoint file");
+    }
+    size_t const end = nbyte - sizeof(uint64_t);
+    uint64_t checksum = 0;
+    std::memcpy(&checksum, m_buffer.data() + end, sizeof(checksum));
+    if (checksum != checksum64(m_buffer.data(), end))
+    {
+        throw std::runtime_error(Formatter() << "CheckpointReader: checksum mismatch in " << path);
+    }
+
+    // The checksum passes, so that a truncated record means a bad writer.
+    size_t pos = nmagic;
+    auto const take = [&](void * data, size_t len)
+    {
+        if (pos + len > end)
+        {
+            throw std::runtime_error(Formatter() << "CheckpointReader: " << path << " is truncated");
+        }
+        std::memcpy(data, m_buffer.data() + pos, len);
+        pos += len;
+    };
+    auto const take_string = [&](std::string & str)
+    {
+        uint32_t len = 0;
+        take(&len, sizeof(len));
+        str.resize(len);
+        take(str.data(), len);
+    };
+
+    uint32_t version = 0;
+    take(&version, sizeof(version));
+    if (version != detail::checkpoint_version)
+    {
+        throw std::runtime_error(Formatter() << "CheckpointReader: unsupported version " << version << " of " << path);
+    }
+    take_string(m_kind);
+    pos += (8 - m_kind.size() % 8) % 8;
+    uint64_t nrecord = 0;
+    take(&nrecord, sizeof(nrecord));
+    for (uint64_t irec = 0; irec < nrecord; ++irec)
+    {
+        std::string name;
+        take_string(name);
+        Record rec{};
+        take(&rec.dtype, sizeof(rec.dtype));
+        if (rec.dtype < detail::CHECKPOINT_FLOAT64 || rec.dtype > detail::CHECKPOINT_UINT64)
+        {
+            throw std::runtime_error(Formatter() << "CheckpointReader: unknown data type " << rec.dtype
+                                                 << " of record \"" << name << "\" in " << path);
+        }
+        uint32_t ndim = 0;
+        take(&ndim, sizeof(ndim));
+        rec.shape = small_vector<size_t>(ndim);
+        size_t nelem = 1;
+        for (uint32_t idim = 0; idim < ndim; ++idim)
+        {
+            uint64_t len = 0;
+            take(&len, sizeof(len));
+            rec.shape[idim] = static_cast<size_t>(len);
+            nelem *= rec.shape[idim];
+        }
+        rec.offset = pos;
+        size_t const nbody = nelem * detail::checkpoint_itemsize(rec.dtype);
+        if (pos + nbody > end)
+        {
+            throw std::runtime_error(Formatter() << "CheckpointReader: " << path << " is truncated");
+        }
+        pos += nbody;
+        m_records[name] = std::move(rec);
+    }
+}
+
+CheckpointReader::Record const & CheckpointReader::get(std::string const & name, bool scalar, bool integer) const
+{
+    auto const found = m_records.find(name);
+    if (found == m_records.end())
+    {
+        throw std::out_of_range(Formatter() << "CheckpointReader: no record \"" << name << "\" in " << m_path);
+    }
+    Record const & rec = found->second;
+    if (rec.shape.empty() != scalar || (detail::CHECKPOINT_UINT64 == rec.dtype) != integer)
+    {
+        char const * what = !scalar ? "an array" : (integer ? "an integer" : "a real");
+        throw std::invalid_argument(Formatter() << "CheckpointReader: record \"" << name << "\" in " << m_path
+                                                << " is not " << what);
+    }
+    return rec;
+}
+
+SimpleArray<double> CheckpointReader::array(std::string const & name) const
+{
+    Record const & rec = get(name, /*scalar*/ false, /*integer*/ false);
+    SimpleArray<double> ret(rec.shape);
+    char const * src = m_buffer.data() + rec.offset;
+    if (detail::CHECKPOINT_FLOAT32 == rec.dtype)
+    {
+        for (size_t it = 0; it < ret.size(); ++it)
+        {
+            float value = 0;
+            std::memcpy(&value, src + it * sizeof(float), sizeof(float));
+            ret.data(it) = value;
+        }
+    }
+    else
+    {
+        std::memcpy(ret.data(), src, ret.nbytes());
+    }
+    return ret;
+}
+
+double CheckpointReader::real(std::string const & name) const
+{
+    Record const & rec = get(name, /*scalar*/ true, /*integer*/ false);
+    double ret = 0;
+    std::memcpy(&ret, m_buffer.data() + rec.offset, sizeof(ret));
+    return ret;
+}
+
+uint64_t CheckpointReader::integer(std::string const & name) const
+{
+    Record const & rec = get(name, /*scalar*/ true, /*integer*/ true);
+    uint64_t ret = 0;
+    std::memcpy(&ret, m_buffer.data() + rec.offset, sizeof(ret));
+    return ret;
+}
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
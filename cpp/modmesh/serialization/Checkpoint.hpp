@@ -0,0 +1,153 @@
+#pragma once
+
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Binary checkpoint container for the restart of solvers.
+ */
+
+#include <modmesh/buffer/buffer.hpp>
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace modmesh
+{
+
+/**
+ * Return the 64-bit FNV-1a hash of the data, taken a word of 8 bytes at a
+ * time.  Pass the return value of the previous call as the basis to continue
+ * the hash over discontiguous data, of which all but the last piece must be of
+ * a multiple of 8 bytes.
+ */
+uint64_t checksum64(void const * data, size_t nbyte, uint64_t basis = 0xcbf29ce484222325ULL);
+
+/**
+ * Build a checkpoint in memory and write it to a file in one buffered write.
+ *
+ * The file starts with the magic bytes, the format version, and the kind
+ * string of the writer padded to 8 bytes, followed by the records.  A record holds a name, a
+ * data type, a shape, and the raw data in the native byte order.  The file
+ * ends with the checksum64() of all the preceding bytes.  A float64 array may
+ * be stored in float32 to halve the file size, and a float32 array is stored
+ * as is.
+ */
+class CheckpointWriter
+{
+
+public:
+
+    explicit CheckpointWriter(std::string const & kind);
+
+    CheckpointWriter() = delete;
+    CheckpointWriter(CheckpointWriter const &) = delete;
+    CheckpointWriter(CheckpointWriter &&) = default;
+    CheckpointWriter & operator=(CheckpointWriter const &) = delete;
+    CheckpointWriter & operator=(CheckpointWriter &&) = default;
+    ~CheckpointWriter() = default;
+
+    CheckpointWriter & add_array(std::string const & name, SimpleArray<double> const & arr, bool float32 = false);
+    /// Add a float32 array without conversion.
+    CheckpointWriter & add_array(std::string const & name, SimpleArray<float> const & arr);
+    CheckpointWriter & add_real(std::string const & name, double value);
+    CheckpointWriter & add_integer(std::string const & name, uint64_t value);
+
+    size_t nrecord() const { return m_nrecord; }
+    /// Number of bytes of the written checkpoint.
+    size_t nbyte() const;
+
+    void write(std::string const & path) const;
+    void write(std::ostream & os) const;
+
+private:
+
+    void add_header(std::string const & name, uint32_t dtype, small_vector<size_t> const & shape);
+    void append(void const * data, size_t nbyte);
+
+    std::string m_kind;
+    size_t m_nrecord = 0;
+    std::vector<char> m_buffer;
+
+}; /* end class CheckpointWriter */
+
+/**
+ * Read a file written by CheckpointWriter.  The whole file is loaded and the
+ * magic bytes, version, and checksum are verified in the constructor, which
+ * throws std::runtime_error for a corrupted file.  A checkpoint may also be
+ * read from the bytes in memory, and the name is used in the messages.
+ */
+class CheckpointReader
+{
+
+public:
+
+    explicit CheckpointReader(std::string const & path);
+    CheckpointReader(std::vector<char> && buffer, std::string const & name);
+
+    CheckpointReader() = delete;
+    CheckpointReader(CheckpointReader const &) = delete;
+    CheckpointReader(CheckpointReader &&) = default;
+    CheckpointReader & operator=(CheckpointReader const &) = delete;
+    CheckpointReader & operator=(CheckpointReader &&) = default;
+    ~CheckpointReader() = default;
+
+    std::string const & kind() const { return m_kind; }
+    size_t nrecord() const { return m_records.size(); }
+    bool has(std::string const & name) const { return m_records.count(name) != 0; }
+
+    /// Return the array of the record in float64; float32 data is converted.
+    SimpleArray<double> array(std::string const & name) const;
+    double real(std::string const & name) const;
+    uint64_t integer(std::string const & name) const;
+
+private:
+
+    struct Record
+    {
+        uint32_t dtype;
+        small_vector<size_t> shape;
+        size_t offset; ///< Offset of the data in the buffer.
+    }; /* end struct Record */
+
+    void parse();
+    Record const & get(std::string const & name, bool scalar, bool integer) const;
+
+    std::string m_path;
+    std::string m_kind;
+    std::map<std::string, Record> m_records;
+    std::vector<char> m_buffer;
+
+}; /* end class CheckpointReader */
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
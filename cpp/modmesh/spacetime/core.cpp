@@ -90,6 +90,37 @@ void Grid::init_from_array(array_type const & xloc)
             m_agrid[ref + it] = m_agrid[ref] + m_agrid[ref] - m_agrid[ref - it];
         }
     }
+    update_metric();
+}
+
+void Grid::calc_metric() const
+{
+    const size_t nx = xsize();
+    // Write in place, so that the elements holding pointers into the array
+    // stay valid.
+    if (!(m_selm_metric.shape() == small_vector<size_t>{NMETRIC, nx}))
+    {
+        m_selm_metric = array_type(small_vector<size_t>{NMETRIC, nx}, 0.0);
+    }
+    for (size_t it = 1; it + 1 < nx; ++it)
+    {
+        const real_type x = m_agrid[it];
+        const real_type xneg = m_agrid[it - 1];
+        const real_type xpos = m_agrid[it + 1];
+        m_selm_metric(METRIC_DXNEG, it) = x - xneg;
+        m_selm_metric(METRIC_DXPOS, it) = xpos - x;
+        m_selm_metric(METRIC_XCTR, it) = (xneg + xpos) / 2;
+    }
+    m_metric_xcoord.assign(xptr(), xptr() + nx);
+}
+
+void Grid::refresh_metric() const
+{
+    const size_t nx = xsize();
+    if (m_metric_xcoord.size() != nx || !std::equal(m_metric_xcoord.begin(), m_metric_xcoord.end(), xptr()))
+    {
+        calc_metric();
+    }
 }
 
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
@@ -5,11 +5,19 @@
  * BSD 3-Clause License, see COPYING
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <memory>
 #include <vector>
 #include <functional>
+#include <type_traits>
+#include <utility>
 
 #include <modmesh/modmesh.hpp>
+#include <modmesh/serialization/Checkpoint.hpp>
+#include <modmesh/inout/snapshot.hpp>
 
 namespace modmesh
 {
@@ -20,6 +28,13 @@ namespace spacetime
 class Grid;
 class Field;
 
+/**
+ * An element is a cursor on the grid.  Besides the pointer to the coordinate
+ * it keeps the pointers to the solution arrays of the field at the same
+ * location, so that the accessors do not look up the index, and moving the
+ * element advances all of them.  An element is invalidated when the arrays of
+ * the field or the grid are replaced.
+ */
 template <class ET>
 class ElementBase
 {
@@ -29,9 +44,19 @@ public:
     using value_type = real_type;
     using base_type = ElementBase;
 
-    ElementBase(Field * field, value_type * xptr)
-        : m_field(field)
-        , m_xptr(xptr)
+    ElementBase(Field * field, value_type * xptr);
+
+    /// Create the element at the offset of xindex from another element.
+    template <class OET>
+    ElementBase(ElementBase<OET> const & other, ssize_t offset)
+        : m_field(other.m_field)
+        , m_xptr(other.m_xptr + offset)
+        , m_so0ptr(other.m_so0ptr + offset * static_cast<ssize_t>(other.m_nvar))
+        , m_so1ptr(other.m_so1ptr + offset * static_cast<ssize_t>(other.m_nvar))
+        , m_cflptr(other.m_cflptr + offset)
+        , m_mtptr(other.m_mtptr + offset)
+        , m_nvar(other.m_nvar)
+        , m_mtstride(other.m_mtstride)
     {
     }
 
@@ -56,7 +81,14 @@ public:
     ASAN_NO_SANITIZE_ADDRESS value_type xpos() const { return *(m_xptr + 1); }
     value_type xctr() const { return static_cast<ET const *>(this)->xctr(); }
 
-    void move(ssize_t offset) { m_xptr += offset; }
+    void move(ssize_t offset)
+    {
+        m_xptr += offset;
+        m_so0ptr += offset * static_cast<ssize_t>(m_nvar);
+        m_so1ptr += offset * static_cast<ssize_t>(m_nvar);
+        m_cflptr += offset;
+        m_mtptr += offset;
+    }
     void move_at(ssize_t offset) { static_cast<ET *>(this)->move_at(static_cast<int_type>(offset)); }
 
     void move_left() { move(-2); }
@@ -80,13 +112,27 @@ protected:
 
     size_t xindex() const;
 
+    value_type * so0ptr() const { return m_so0ptr; }
+    value_type * so1ptr() const { return m_so1ptr; }
+    value_type * cflptr() const { return m_cflptr; }
+    /// Return the geometric coefficient of Grid::selm_metric() at the element.
+    value_type metric(size_t im) const { return m_mtptr[im * m_mtstride]; }
+
 private:
 
     Field * m_field;
     value_type * m_xptr;
+    value_type * m_so0ptr;
+    value_type * m_so1ptr;
+    value_type * m_cflptr;
+    value_type const * m_mtptr;
+    size_t m_nvar;
+    size_t m_mtstride;
 
     friend Grid;
     friend Field;
+    template <class>
+    friend class ElementBase;
 
 }; /* end class ElementBase */
 
@@ -105,6 +151,12 @@ public:
     constexpr static size_t BOUND_COUNT = 2;
     static_assert(BOUND_COUNT >= 2, "BOUND_COUNT must be greater or equal to 2");
 
+    // Rows of selm_metric().
+    constexpr static size_t METRIC_DXNEG = 0;
+    constexpr static size_t METRIC_DXPOS = 1;
+    constexpr static size_t METRIC_XCTR = 2;
+    constexpr static size_t NMETRIC = 3;
+
 private:
 
     class ctor_passkey
@@ -144,8 +196,29 @@ public:
     size_t xsize() const { return m_agrid.size(); }
 
     array_type const & xcoord() const { return m_agrid.coord(); }
+    /// Return the coordinates for writing.  refresh_metric() picks up the
+    /// change.
     array_type & xcoord() { return m_agrid.coord(); }
 
+    /**
+     * (NMETRIC, xsize) array of the geometric coefficients of a solution
+     * element at each coordinate: dxneg, dxpos, and xctr.  The solution
+     * elements read them instead of recomputing from the neighboring
+     * coordinates.  The first and the last coordinates have no neighbor and
+     * their coefficients are zero.
+     */
+    array_type const & selm_metric() const { return m_selm_metric; }
+    /// Recompute selm_metric() in place.
+    void update_metric() { calc_metric(); }
+    /**
+     * Recompute selm_metric() if the coordinates differ from the ones it was
+     * computed from.  The coordinates are compared instead of tracking the
+     * accessors, so that a write through any path, including a kept ndarray
+     * view, is detected.  The marches and the geometric accessors of the
+     * solver call it.
+     */
+    void refresh_metric() const;
+
 public:
 
     class CelmPK
@@ -201,12 +274,17 @@ private:
     real_type const * xptr(size_t xindex) const { return m_agrid.data() + xindex; }
 
     void init_from_array(array_type const & xloc);
+    void calc_metric() const;
 
     real_type m_xmin;
     real_type m_xmax;
     size_t m_ncelm;
 
     AscendantGrid1d m_agrid;
+    // Cached from the coordinates, so refresh_metric() may update them from
+    // const accessors.
+    mutable array_type m_selm_metric;
+    mutable std::vector<real_type> m_metric_xcoord;
 
     template <class ET>
     friend class ElementBase;
@@ -219,6 +297,10 @@ inline size_t ElementBase<ET>::xindex() const { return m_xptr - grid().xptr(); }
 /**
  * Calculation kernel for the physical problem to be solved.  The kernel
  * defines how the solution elements calculate fluxes and other values.
+ *
+ * The hooks are std::function objects called by the generic Selm, so that
+ * the kernel can be written in Python.  A compiled kernel should derive from
+ * Selm and define the functions instead (see is_static_selm).
  */
 class Kernel
 {
@@ -432,6 +514,20 @@ inline SE Field::selm_at(int_type ielm, bool odd_plane)
     return elm;
 }
 
+template <class ET>
+inline ElementBase<ET>::ElementBase(Field * field, value_type * xptr)
+    : m_field(field)
+    , m_xptr(xptr)
+    , m_nvar(field->nvar())
+{
+    const auto xindex = static_cast<size_t>(m_xptr - field->grid().xptr());
+    m_so0ptr = field->so0().data() + xindex * m_nvar;
+    m_so1ptr = field->so1().data() + xindex * m_nvar;
+    m_cflptr = field->cfl().data() + xindex;
+    m_mtptr = field->grid().selm_metric().data() + xindex;
+    m_mtstride = field->grid().xsize();
+}
+
 template <class ET>
 inline Grid const & ElementBase<ET>::grid() const { return m_field->grid(); }
 
@@ -463,6 +559,13 @@ public:
     {
     }
 
+    /// Create the SE at the offset of xindex from an element (usually a CE).
+    template <class ET>
+    Selm(ElementBase<ET> const & elm, ssize_t offset)
+        : base_type(elm, offset)
+    {
+    }
+
     int_type index() const
     {
         static_assert(0 == (Grid::BOUND_COUNT % 2), "only work with even BOUND_COUNT");
@@ -475,20 +578,20 @@ public:
     bool on_even_plane() const { return !on_odd_plane(); }
     bool on_odd_plane() const { return static_cast<bool>((xindex() - Grid::BOUND_COUNT) & 1); }
 
-    value_type dxneg() const { return x() - xneg(); }
-    value_type dxpos() const { return xpos() - x(); }
-    value_type xctr() const { return (xneg() + xpos()) / 2; }
+    value_type dxneg() const { return metric(Grid::METRIC_DXNEG); }
+    value_type dxpos() const { return metric(Grid::METRIC_DXPOS); }
+    value_type xctr() const { return metric(Grid::METRIC_XCTR); }
 
     void move_at(int_type offset);
 
-    value_type const & so0(size_t iv) const { return field().so0(xindex(), iv); }
-    value_type & so0(size_t iv) { return field().so0(xindex(), iv); }
+    value_type const & so0(size_t iv) const { return so0ptr()[iv]; }
+    value_type & so0(size_t iv) { return so0ptr()[iv]; }
 
-    value_type const & so1(size_t iv) const { return field().so1(xindex(), iv); }
-    value_type & so1(size_t iv) { return field().so1(xindex(), iv); }
+    value_type const & so1(size_t iv) const { return so1ptr()[iv]; }
+    value_type & so1(size_t iv) { return so1ptr()[iv]; }
 
-    value_type const & cfl() const { return field().cfl(xindex()); }
-    value_type & cfl() { return field().cfl(xindex()); }
+    value_type const & cfl() const { return *cflptr(); }
+    value_type & cfl() { return *cflptr(); }
 
     value_type xn(size_t iv) const { return field().kernel().calc_xn(*this, iv); }
     value_type xp(size_t iv) const { return field().kernel().calc_xp(*this, iv); }
@@ -569,22 +672,24 @@ public:
     value_type hdt() const { return field().hdt(); }
     value_type qdt() const { return field().qdt(); }
 
+    // The SEs are next to the CE on the grid, and are created by the offset
+    // without calculating the indices.
     template <typename SE>
-    SE const selm_xn() const { return field().template selm<SE>(index(), on_odd_plane()); } // NOLINT(readability-const-return-type)
+    SE const selm_xn() const { return SE(*this, -1); } // NOLINT(readability-const-return-type)
     template <typename SE>
-    SE selm_xn() { return field().template selm<SE>(index(), on_odd_plane()); }
+    SE selm_xn() { return SE(*this, -1); }
     template <typename SE>
-    SE const selm_xp() const { return field().template selm<SE>(index() + 1, on_odd_plane()); } // NOLINT(readability-const-return-type)
+    SE const selm_xp() const { return SE(*this, 1); } // NOLINT(readability-const-return-type)
     template <typename SE>
-    SE selm_xp() { return field().template selm<SE>(index() + 1, on_odd_plane()); }
+    SE selm_xp() { return SE(*this, 1); }
     template <typename SE>
-    SE const selm_tn() const { return field().template selm<SE>(index() + on_odd_plane(), !on_odd_plane()); } // NOLINT(readability-const-return-type)
+    SE const selm_tn() const { return SE(*this, 0); } // NOLINT(readability-const-return-type)
     template <typename SE>
-    SE selm_tn() { return field().template selm<SE>(index() + on_odd_plane(), !on_odd_plane()); }
+    SE selm_tn() { return SE(*this, 0); }
     template <typename SE>
-    SE const selm_tp() const { return field().template selm<SE>(index() + on_odd_plane(), !on_odd_plane()); } // NOLINT(readability-const-return-type)
+    SE const selm_tp() const { return SE(*this, 0); } // NOLINT(readability-const-return-type)
     template <typename SE>
-    SE selm_tp() { return field().template selm<SE>(index() + on_odd_plane(), !on_odd_plane()); }
+    SE selm_tp() { return SE(*this, 0); }
 
     template <typename SE>
     value_type calc_so0(size_t iv) const;
@@ -670,9 +775,50 @@ inline typename Celm::value_type Celm::calc_so1_alpha(size_t iv) const
 
 class Selm;
 
+/**
+ * Tell whether the solution element type SE defines all the calculating
+ * functions by itself (usually by SPACETIME_DERIVED_SELM_BODY_DEFAULT).  The
+ * marching loops then call them directly and the compiler may inline them.
+ * Otherwise a call falls back to the std::function hooks in Kernel, which are
+ * for the kernels defined in Python with the generic Solver.
+ */
+template <typename SE>
+struct is_static_selm
+{
+    using value_type = Selm::value_type;
+    using calc_type1 = value_type (SE::*)(size_t) const;
+    using calc_type2 = void (SE::*)();
+    static constexpr bool value = !std::is_same_v<SE, Selm> &&
+                                  std::is_same_v<decltype(&SE::xn), calc_type1> &&
+                                  std::is_same_v<decltype(&SE::xp), calc_type1> &&
+                                  std::is_same_v<decltype(&SE::tn), calc_type1> &&
+                                  std::is_same_v<decltype(&SE::tp), calc_type1> &&
+                                  std::is_same_v<decltype(&SE::so0p), calc_type1> &&
+                                  std::is_same_v<decltype(&SE::update_cfl), calc_type2>;
+}; /* end struct is_static_selm */
+
+template <typename SE>
+inline constexpr bool is_static_selm_v = is_static_selm<SE>::value;
+
+template <typename ST>
+class SolverEnsemble;
+
 /**
  * Algorithmic definition for solution.  It holds the type information for the
  * CE and SE.
+ *
+ * A solver with a derived SE is compiled with the kernel: the SE must define
+ * all the calculating functions, or the compilation fails instead of silently
+ * using the run-time Kernel hooks.  Only the generic Solver (with Selm) uses
+ * the hooks.
+ *
+ * With a compiled kernel the element loops run in parallel on ThreadPool in
+ * static contiguous chunks.  Every CE writes only its selm_tp(), so the result
+ * does not depend on the number of threads.  march_half1_alpha() and
+ * march_half2_alpha() calculate so0, cfl, and so1 of a CE in one loop with a
+ * single barrier per half step, and therefore SE::update_cfl() may read only
+ * its own element.  The generic Solver keeps the serial loops because the
+ * Python hooks need the GIL.
  */
 template <typename ST, typename CE, typename SE>
 class SolverBase
@@ -686,6 +832,14 @@ public:
     using celm_type = CE;
     using selm_type = SE;
 
+    /// True if the marching loops call the SE functions without Kernel.
+    static constexpr bool static_kernel = is_static_selm_v<SE>;
+    /// Minimal number of elements in a chunk of a parallel loop.
+    static constexpr size_t MARCH_GRAIN = 4096;
+
+    static_assert(std::is_same_v<typename CE::selm_type, SE>, "CE must use SE as its solution element type");
+    static_assert(std::is_same_v<SE, Selm> || static_kernel, "derived SE must define xn, xp, tn, tp, so0p, and update_cfl");
+
 protected:
 
     class ctor_passkey
@@ -706,6 +860,8 @@ public:
          * static polymorphism. */
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
         auto ret = std::make_shared<ST>(*reinterpret_cast<ST *>(this));
+        // The clone must not push frames into the stream of this solver.
+        ret->clear_snapshot();
         if (grid)
         {
             std::shared_ptr<Grid> const new_grid = m_field.clone_grid();
@@ -774,6 +930,61 @@ public:
     real_type hdt() const { return m_field.hdt(); }
     real_type qdt() const { return m_field.qdt(); }
 
+    /// Time marched by the march_alpha*() functions.
+    real_type time() const { return m_time; }
+    void set_time(real_type time) { m_time = time; }
+
+    /// Number of steps marched by the march_alpha*() functions.
+    size_t nstep() const { return m_nstep; }
+    void set_nstep(size_t nstep) { m_nstep = nstep; }
+
+    /// Return the maximum CFL number of the SEs on the plane.
+    value_type max_cfl(bool odd_plane) const;
+
+    /// (nstep, 3) array of time, time increment, and maximum CFL number of
+    /// the steps marched by march_alpha_adaptive().
+    array_type time_history() const;
+    void clear_time_history() { m_time_history.clear(); }
+
+    /**
+     * Write the grid coordinates, solution, CFL number, time increment, time,
+     * and step count to a checkpoint file.  With float32 the arrays other than
+     * the coordinates are stored in single precision.
+     */
+    void save_checkpoint(std::string const & path, bool float32 = false) const;
+    /// Restore the state written by save_checkpoint() of a solver on the same
+    /// grid with the same number of variables.
+    void load_checkpoint(std::string const & path);
+
+    /**
+     * Push a snapshot of the named fields (xcoord, so0, so1, and cfl) to the
+     * writer every interval steps marched.  march_alpha_blocked() pushes only
+     * at the end of the blocks.
+     */
+    void set_snapshot(std::shared_ptr<inout::SnapshotWriter> const & writer, size_t interval, std::vector<std::string> const & fields);
+    void clear_snapshot()
+    {
+        m_snapshot_writer.reset();
+        m_snapshot_interval = 0;
+        m_snapshot_next = 0;
+        m_snapshot_fields.clear();
+    }
+    std::shared_ptr<inout::SnapshotWriter> const & snapshot_writer() const { return m_snapshot_writer; }
+    /// Push a snapshot of the current solution to the writer.
+    void take_snapshot();
+
+    /**
+     * Bin the positions into the levels of local time stepping (LTS) by the
+     * CFL number of time_increment().  Level l marches with time_increment()
+     * / 2^l, and a position takes the lowest level for the CFL numbers of
+     * itself and its neighbors to be no larger than cfl_limit.  Adjacent
+     * positions differ by at most one level.  The CFL numbers of all the SEs
+     * are recalculated with time_increment().  Return the number of levels.
+     */
+    size_t update_lts_level(value_type cfl_limit, size_t max_level);
+    /// LTS level of the 2*ncelm+1 positions set by update_lts_level().
+    SimpleArray<uint8_t> const & lts_level() const { return m_lts_level; }
+
     Kernel const & kernel() const { return m_field.kernel(); }
     Kernel & kernel() { return m_field.kernel(); }
 
@@ -805,10 +1016,122 @@ public:
     void march_half2_alpha();
     template <size_t ALPHA>
     void march_alpha(size_t steps);
+    template <size_t ALPHA>
+    void march_alpha_blocked(size_t steps, size_t block_steps, size_t tile_celm);
+    template <size_t ALPHA>
+    size_t march_alpha_adaptive(value_type time_stop, value_type target_cfl, value_type dt_min, value_type dt_max);
+    template <size_t ALPHA>
+    void march_alpha_lts(size_t steps, value_type cfl_limit, size_t max_level);
+
+    /**
+     * Sweep the CEs of index in [start, stop) on the plane and call func(ce)
+     * for each of them.  A chunk of the loop creates one CE and advances it
+     * by move_right(), so that the loop body works on the raw pointers.
+     */
+    template <typename F>
+    void for_each_celm(int_type start, int_type stop, bool odd_plane, F && func)
+    {
+        for_each_chunk(
+            start, stop, [this, odd_plane, &func](int_type ibegin, int_type iend)
+            {
+                CE ce = celm(ibegin, odd_plane);
+                for (int_type ic = ibegin; ic < iend; ++ic)
+                {
+                    func(ce);
+                    ce.move_right();
+                } });
+    }
+
+    /// Sweep the SEs of index in [start, stop) on the plane like for_each_celm().
+    template <typename F>
+    void for_each_selm(int_type start, int_type stop, bool odd_plane, F && func)
+    {
+        for_each_chunk(
+            start, stop, [this, odd_plane, &func](int_type ibegin, int_type iend)
+            {
+                SE se = selm(ibegin, odd_plane);
+                for (int_type ic = ibegin; ic < iend; ++ic)
+                {
+                    func(se);
+                    se.move_right();
+                } });
+    }
 
 private:
 
+    // SolverEnsemble marches the CEs of its members in one loop.
+    friend class SolverEnsemble<ST>;
+
+    /**
+     * Call func(ibegin, iend) for the chunks of [start, stop); in parallel for
+     * a compiled kernel and in one serial chunk for the run-time Kernel hooks.
+     */
+    template <typename F>
+    static void for_each_chunk(int_type start, int_type stop, F && func)
+    {
+        if (stop <= start)
+        {
+            return;
+        }
+        if constexpr (static_kernel)
+        {
+            parallel_for(
+                0, static_cast<size_t>(stop - start), [&](size_t ibegin, size_t iend)
+                { func(start + static_cast<int_type>(ibegin), start + static_cast<int_type>(iend)); },
+                MARCH_GRAIN);
+        }
+        else
+        {
+            func(start, stop);
+        }
+    }
+
+    template <size_t ALPHA>
+    static void march_celm_fused(CE & ce);
+    template <size_t ALPHA>
+    void march_half_fused(bool odd_plane);
+    template <size_t ALPHA>
+    void march_range_fused(bool odd_plane, int_type qbegin, int_type qend);
+    void treat_boundary_fused();
+
+    template <size_t ALPHA>
+    static void march_celm_lts(CE & ce, size_t nvar);
+    template <size_t ALPHA>
+    void march_step_lts(size_t nlevel);
+    template <size_t ALPHA>
+    void march_level_lts(std::vector<std::array<int_type, 2>> const & runs, bool odd_plane, int64_t tick, int64_t unit, std::vector<int64_t> & ticks, std::vector<std::array<int_type, 3>> const & zones, std::vector<value_type> & fluxreg);
+    std::vector<std::array<int_type, 3>> make_lts_zones() const;
+    void add_lts_zone_mass(std::vector<std::array<int_type, 3>> const & zones, value_type sign, std::vector<value_type> & fluxreg);
+    void march_snapshot()
+    {
+        if (m_snapshot_writer && m_nstep >= m_snapshot_next)
+        {
+            take_snapshot();
+        }
+    }
+    /// Advance the time and the step count after the two half steps.
+    void finish_step()
+    {
+        m_time += dt();
+        ++m_nstep;
+        march_snapshot();
+    }
+
+    SE selm_position(int_type ipos)
+    {
+        const int_type odd = ipos & 1;
+        return selm((ipos - odd) / 2, 0 != odd);
+    }
+
     Field m_field;
+    real_type m_time = 0;
+    size_t m_nstep = 0;
+    std::vector<std::array<value_type, 3>> m_time_history;
+    SimpleArray<uint8_t> m_lts_level;
+    std::shared_ptr<inout::SnapshotWriter> m_snapshot_writer;
+    size_t m_snapshot_interval = 0;
+    size_t m_snapshot_next = 0;
+    std::vector<std::string> m_snapshot_fields;
 
 }; /* end class SolverBase */
 
@@ -826,6 +1149,7 @@ template <typename ST, typename CE, typename SE>
 inline typename SolverBase<ST, CE, SE>::array_type
 SolverBase<ST, CE, SE>::xctr(bool odd_plane) const
 {
+    grid().refresh_metric();
     const uint_type nselm = static_cast<uint_type>(grid().nselm()) - static_cast<uint_type>(odd_plane);
     array_type ret(std::vector<size_t>{nselm});
     for (uint_type it = 0; it < nselm; ++it) { ret[it] = selm(it, odd_plane).xctr(); }
@@ -840,6 +1164,7 @@ SolverBase<ST, CE, SE>::get_so0p(size_t iv, bool odd_plane) const
     {
         throw std::out_of_range("get_so0p(): out of nvar range");
     }
+    grid().refresh_metric();
     const uint_type nselm = static_cast<uint_type>(grid().nselm()) - static_cast<uint_type>(odd_plane);
     array_type ret(std::vector<size_t>{nselm});
     for (uint_type it = 0; it < nselm; ++it) { ret[it] = selm(it, odd_plane).so0p(iv); }
@@ -941,41 +1266,255 @@ SolverBase<ST, CE, SE>::set_cfl(typename SolverBase<ST, CE, SE>::array_type cons
 }
 
 template <typename ST, typename CE, typename SE>
-inline void SolverBase<ST, CE, SE>::march_half_so0(bool odd_plane)
+inline typename SolverBase<ST, CE, SE>::value_type
+SolverBase<ST, CE, SE>::max_cfl(bool odd_plane) const
 {
     const int_type start = odd_plane ? -1 : 0;
-    const int_type stop = static_cast<int_type>(grid().ncelm());
-    for (int_type ic = start; ic < stop; ++ic)
+    const int_type stop = static_cast<int_type>(grid().nselm());
+    std::atomic<value_type> ret{0};
+    for_each_chunk(
+        start, stop, [this, odd_plane, &ret](int_type ibegin, int_type iend)
+        {
+            value_type local = 0;
+            SE se = selm(ibegin, odd_plane);
+            for (int_type ic = ibegin; ic < iend; ++ic)
+            {
+                local = std::max(local, se.cfl());
+                se.move_right();
+            }
+            value_type current = ret.load();
+            while (local > current && !ret.compare_exchange_weak(current, local)) {} });
+    return ret.load();
+}
+
+template <typename ST, typename CE, typename SE>
+inline typename SolverBase<ST, CE, SE>::array_type
+SolverBase<ST, CE, SE>::time_history() const
+{
+    array_type ret(std::vector<size_t>{m_time_history.size(), 3});
+    for (size_t it = 0; it < m_time_history.size(); ++it)
+    {
+        ret(it, 0) = m_time_history[it][0];
+        ret(it, 1) = m_time_history[it][1];
+        ret(it, 2) = m_time_history[it][2];
+    }
+    return ret;
+}
+
+template <typename ST, typename CE, typename SE>
+inline void SolverBase<ST, CE, SE>::save_checkpoint(std::string const & path, bool float32) const
+{
+    CheckpointWriter writer("spacetime::Solver");
+    writer
+        .add_integer("nvar", nvar())
+        .add_integer("nstep", m_nstep)
+        .add_real("time", m_time)
+        .add_real("time_increment", time_increment())
+        .add_array("xcoord", grid().xcoord())
+        .add_array("so0", so0(), float32)
+        .add_array("so1", so1(), float32)
+        .add_array("cfl", cfl(), float32);
+    writer.write(path);
+}
+
+template <typename ST, typename CE, typename SE>
+inline void SolverBase<ST, CE, SE>::load_checkpoint(std::string const & path)
+{
+    CheckpointReader const reader(path);
+    if (reader.kind() != "spacetime::Solver")
+    {
+        throw std::invalid_argument(Formatter() << "SolverBase::load_checkpoint: " << path << " is a checkpoint of "
+                                                << reader.kind());
+    }
+    if (reader.integer("nvar") != nvar())
+    {
+        throw std::invalid_argument(Formatter() << "SolverBase::load_checkpoint: nvar " << reader.integer("nvar")
+                                                << " in " << path << " does not match " << nvar());
+    }
+    array_type const xcoord = reader.array("xcoord");
+    array_type const & gxcoord = std::as_const(grid()).xcoord();
+    bool same_grid = xcoord.shape() == gxcoord.shape();
+    for (size_t it = 0; same_grid && it < xcoord.size(); ++it)
+    {
+        same_grid = xcoord.data(it) == gxcoord.data(it);
+    }
+    if (!same_grid)
+    {
+        throw std::invalid_argument(Formatter() << "SolverBase::load_checkpoint: grid in " << path
+                                                << " does not match the solver");
+    }
+    array_type const rso0 = reader.array("so0");
+    array_type const rso1 = reader.array("so1");
+    array_type const rcfl = reader.array("cfl");
+    if (!(rso0.shape() == so0().shape()) || !(rso1.shape() == so1().shape()) || !(rcfl.shape() == cfl().shape()))
+    {
+        throw std::invalid_argument(Formatter() << "SolverBase::load_checkpoint: shape of solution in " << path
+                                                << " does not match the solver");
+    }
+    // Copy into the existing buffers for the elements pointing to them.
+    std::copy_n(rso0.data(), rso0.size(), so0().data());
+    std::copy_n(rso1.data(), rso1.size(), so1().data());
+    std::copy_n(rcfl.data(), rcfl.size(), cfl().data());
+    set_time_increment(reader.real("time_increment"));
+    m_time = reader.real("time");
+    m_nstep = static_cast<size_t>(reader.integer("nstep"));
+    m_time_history.clear();
+}
+
+template <typename ST, typename CE, typename SE>
+inline void SolverBase<ST, CE, SE>::set_snapshot(std::shared_ptr<inout::SnapshotWriter> const & writer, size_t interval, std::vector<std::string> const & fields)
+{
+    if (0 == interval)
+    {
+        throw std::invalid_argument("SolverBase::set_snapshot: interval cannot be zero");
+    }
+    for (std::string const & name : fields)
     {
-        auto ce = celm(ic, odd_plane);
-        ce.selm_tp().so0(0) = ce.calc_so0(0);
+        if ("xcoord" != name && "so0" != name && "so1" != name && "cfl" != name)
+        {
+            throw std::invalid_argument(Formatter() << "SolverBase::set_snapshot: unknown field \"" << name << "\"");
+        }
     }
+    m_snapshot_writer = writer;
+    m_snapshot_interval = interval;
+    m_snapshot_next = (m_nstep / interval + 1) * interval;
+    m_snapshot_fields = fields;
+}
+
+template <typename ST, typename CE, typename SE>
+inline void SolverBase<ST, CE, SE>::take_snapshot()
+{
+    if (!m_snapshot_writer)
+    {
+        throw std::runtime_error("SolverBase::take_snapshot: no snapshot writer");
+    }
+    CheckpointWriter snapshot("spacetime::Solver");
+    snapshot
+        .add_integer("nstep", m_nstep)
+        .add_real("time", m_time)
+        .add_real("time_increment", time_increment());
+    for (std::string const & name : m_snapshot_fields)
+    {
+        if ("xcoord" == name)
+        {
+            snapshot.add_array(name, std::as_const(grid()).xcoord());
+        }
+        else if ("so0" == name)
+        {
+            snapshot.add_array(name, so0());
+        }
+        else if ("so1" == name)
+        {
+            snapshot.add_array(name, so1());
+        }
+        else
+        {
+            snapshot.add_array(name, cfl());
+        }
+    }
+    m_snapshot_writer->push(std::move(snapshot));
+    m_snapshot_next = (m_nstep / m_snapshot_interval + 1) * m_snapshot_interval;
+}
+
+template <typename ST, typename CE, typename SE>
+inline void SolverBase<ST, CE, SE>::march_half_so0(bool odd_plane)
+{
+    grid().refresh_metric();
+    const int_type start = odd_plane ? -1 : 0;
+    const int_type stop = static_cast<int_type>(grid().ncelm());
+    for_each_celm(
+        start, stop, odd_plane, [](CE & ce)
+        { ce.selm_tp().so0(0) = ce.calc_so0(0); });
 }
 
 template <typename ST, typename CE, typename SE>
 inline void SolverBase<ST, CE, SE>::update_cfl(bool odd_plane)
 {
+    grid().refresh_metric();
     const int_type start = odd_plane ? -1 : 0;
     const int_type stop = static_cast<int_type>(grid().nselm());
-    for (int_type ic = start; ic < stop; ++ic)
-    {
-        selm(ic, odd_plane).update_cfl();
-    }
+    for_each_selm(
+        start, stop, odd_plane, [](SE & se)
+        { se.update_cfl(); });
 }
 
 template <typename ST, typename CE, typename SE>
 template <size_t ALPHA>
 inline void SolverBase<ST, CE, SE>::march_half_so1_alpha(bool odd_plane)
 {
+    grid().refresh_metric();
     const int_type start = odd_plane ? -1 : 0;
     const int_type stop = static_cast<int_type>(grid().ncelm());
-    for (int_type ic = start; ic < stop; ++ic)
+    for_each_celm(
+        start, stop, odd_plane, [](CE & ce)
+        { ce.selm_tp().so1(0) = ce.template calc_so1_alpha<ALPHA>(0); });
+}
+
+/**
+ * Calculate so0, cfl, and so1 (in the order) at selm_tp() of each CE on the
+ * plane.  The SEs of the CEs on the even plane exclude the two outermost ones
+ * on the odd plane, and their cfl is left to the caller.
+ */
+template <typename ST, typename CE, typename SE>
+template <size_t ALPHA>
+inline void SolverBase<ST, CE, SE>::march_celm_fused(CE & ce)
+{
+    auto se = ce.selm_tp();
+    se.so0(0) = ce.calc_so0(0);
+    se.update_cfl();
+    se.so1(0) = ce.template calc_so1_alpha<ALPHA>(0);
+}
+
+template <typename ST, typename CE, typename SE>
+template <size_t ALPHA>
+inline void SolverBase<ST, CE, SE>::march_half_fused(bool odd_plane)
+{
+    grid().refresh_metric();
+    const int_type start = odd_plane ? -1 : 0;
+    const int_type stop = static_cast<int_type>(grid().ncelm());
+    for_each_celm(
+        start, stop, odd_plane, [](CE & ce)
+        { march_celm_fused<ALPHA>(ce); });
+}
+
+/**
+ * Serially march the CEs on the plane whose selm_tp() is at the position in
+ * [qbegin, qend).  The position of the SE at xindex is xindex - 2, so that
+ * the interior SEs of both planes take [0, 2*ncelm+1).
+ */
+template <typename ST, typename CE, typename SE>
+template <size_t ALPHA>
+inline void SolverBase<ST, CE, SE>::march_range_fused(bool odd_plane, int_type qbegin, int_type qend)
+{
+    const auto npos = static_cast<int_type>(2 * grid().ncelm() + 1);
+    qbegin = std::clamp(qbegin, int_type(0), npos);
+    qend = std::clamp(qend, int_type(0), npos);
+    // A CE on the odd plane writes at 2*ic+2, and on the even plane at 2*ic+1.
+    const int_type start = odd_plane ? (qbegin + 1) / 2 - 1 : qbegin / 2;
+    const int_type stop = odd_plane ? (qend + 1) / 2 - 1 : qend / 2;
+    if (start < stop)
     {
-        auto ce = celm(ic, odd_plane);
-        ce.selm_tp().so1(0) = ce.template calc_so1_alpha<ALPHA>(0);
+        CE ce = celm(start, odd_plane);
+        for (int_type ic = start; ic < stop; ++ic)
+        {
+            march_celm_fused<ALPHA>(ce);
+            ce.move_right();
+        }
     }
 }
 
+/**
+ * Set the two outermost SEs on the odd plane after march_half_fused<>(false).
+ */
+template <typename ST, typename CE, typename SE>
+inline void SolverBase<ST, CE, SE>::treat_boundary_fused()
+{
+    treat_boundary_so0();
+    selm(-1, true).update_cfl();
+    selm(static_cast<int_type>(grid().ncelm()), true).update_cfl();
+    treat_boundary_so1();
+}
+
 template <typename ST, typename CE, typename SE>
 inline void SolverBase<ST, CE, SE>::treat_boundary_so0()
 {
@@ -1004,11 +1543,19 @@ template <typename ST, typename CE, typename SE>
 template <size_t ALPHA>
 inline void SolverBase<ST, CE, SE>::march_half1_alpha()
 {
-    march_half_so0(false);
-    treat_boundary_so0();
-    update_cfl(true);
-    march_half_so1_alpha<ALPHA>(false);
-    treat_boundary_so1();
+    if constexpr (static_kernel)
+    {
+        march_half_fused<ALPHA>(false);
+        treat_boundary_fused();
+    }
+    else
+    {
+        march_half_so0(false);
+        treat_boundary_so0();
+        update_cfl(true);
+        march_half_so1_alpha<ALPHA>(false);
+        treat_boundary_so1();
+    }
 }
 
 template <typename ST, typename CE, typename SE>
@@ -1016,9 +1563,16 @@ template <size_t ALPHA>
 inline void SolverBase<ST, CE, SE>::march_half2_alpha()
 {
     // In the second half step, no treating boundary conditions.
-    march_half_so0(true);
-    update_cfl(false);
-    march_half_so1_alpha<ALPHA>(true);
+    if constexpr (static_kernel)
+    {
+        march_half_fused<ALPHA>(true);
+    }
+    else
+    {
+        march_half_so0(true);
+        update_cfl(false);
+        march_half_so1_alpha<ALPHA>(true);
+    }
 }
 
 template <typename ST, typename CE, typename SE>
@@ -1029,6 +1583,542 @@ inline void SolverBase<ST, CE, SE>::march_alpha(size_t steps)
     {
         march_half1_alpha<ALPHA>();
         march_half2_alpha<ALPHA>();
+        finish_step();
+    }
+}
+
+/**
+ * March to time_stop while adjusting the time increment to hold the maximum
+ * CFL number at target_cfl.  The CFL number is proportional to the time
+ * increment, so the next time increment is scaled by the ratio of the target
+ * to the maximum CFL number of both half steps, and clamped in [dt_min,
+ * dt_max].  Before a step, the CFL number of the current solution is
+ * calculated with the candidate time increment, which is shrunk if the number
+ * exceeds the target, so that an oversized initial time increment is not
+ * marched.  The last one or two steps are shortened to stop at time_stop.
+ * Return the number of steps marched.
+ */
+template <typename ST, typename CE, typename SE>
+template <size_t ALPHA>
+inline size_t SolverBase<ST, CE, SE>::march_alpha_adaptive(value_type time_stop, value_type target_cfl, value_type dt_min, value_type dt_max)
+{
+    if (!(target_cfl > 0))
+    {
+        throw std::invalid_argument(Formatter() << "march_alpha_adaptive(): target_cfl " << target_cfl
+                                                << " must be positive");
+    }
+    if (!(dt_min > 0) || dt_min > dt_max)
+    {
+        throw std::invalid_argument(Formatter() << "march_alpha_adaptive(): invalid bounds of time increment ["
+                                                << dt_min << ", " << dt_max << "]");
+    }
+    size_t steps = 0;
+    while (m_time < time_stop)
+    {
+        value_type dt = std::clamp(time_increment(), dt_min, dt_max);
+        set_time_increment(dt);
+        update_cfl(false);
+        const value_type cfl_now = max_cfl(false);
+        if (cfl_now > target_cfl)
+        {
+            dt = std::max(dt_min, dt * (target_cfl / cfl_now));
+        }
+        const bool last = dt >= time_stop - m_time;
+        if (last)
+        {
+            dt = time_stop - m_time;
+        }
+        else if (2 * dt > time_stop - m_time)
+        {
+            // Split the rest in two steps instead of leaving a tiny one.
+            dt = (time_stop - m_time) / 2;
+        }
+        set_time_increment(dt);
+
+        march_half1_alpha<ALPHA>();
+        value_type cfl = max_cfl(true);
+        march_half2_alpha<ALPHA>();
+        cfl = std::max(cfl, max_cfl(false));
+
+        m_time = last ? time_stop : m_time + dt;
+        m_time_history.push_back({m_time, dt, cfl});
+        ++m_nstep;
+        march_snapshot();
+        ++steps;
+        set_time_increment(cfl > 0 ? dt * (target_cfl / cfl) : dt_max);
+    }
+    return steps;
+}
+
+/**
+ * March like march_alpha() with temporal blocking: block_steps time steps are
+ * marched over a tile of tile_celm CEs before moving to the next tile, so that
+ * the working set stays in cache for a grid larger than the cache.  The result
+ * is bitwise identical to march_alpha().
+ *
+ * A block is done in two phases of trapezoid tiling on the 2*block_steps half
+ * steps (levels).  In the first phase each tile marches the trapezoid that
+ * shrinks by one position on each side per level, which needs only the data
+ * of the tile.  In the second phase the inverted triangle around each seam of
+ * the tiles fills the rest.  The seam at the ends of the grid handles the
+ * periodic boundary condition.  The tiles and the seams of a phase do not
+ * overlap and run in parallel.  A solver without a compiled kernel, or a grid
+ * smaller than a tile, falls back to march_alpha().
+ */
+template <typename ST, typename CE, typename SE>
+template <size_t ALPHA>
+inline void SolverBase<ST, CE, SE>::march_alpha_blocked(size_t steps, size_t block_steps, size_t tile_celm)
+{
+    if (0 == block_steps)
+    {
+        throw std::invalid_argument("march_alpha_blocked(): block_steps cannot be zero");
+    }
+    if (tile_celm < 2 * block_steps)
+    {
+        throw std::invalid_argument(Formatter() << "march_alpha_blocked(): tile_celm " << tile_celm
+                                                << " < 2 * block_steps " << 2 * block_steps);
+    }
+    grid().refresh_metric();
+    const auto npos = static_cast<int_type>(2 * grid().ncelm() + 1);
+    const auto width = static_cast<int_type>(2 * tile_celm);
+    if (!static_kernel || npos < width)
+    {
+        march_alpha<ALPHA>(steps);
+        return;
+    }
+    const auto ntile = static_cast<size_t>(npos / width);
+
+    for (size_t istep = 0; istep < steps; istep += block_steps)
+    {
+        const auto nlevel = static_cast<int_type>(2 * std::min(block_steps, steps - istep));
+        // Shrinking trapezoids in the tiles.
+        parallel_for(
+            0, ntile, [&](size_t ibegin, size_t iend)
+            {
+                for (size_t it = ibegin; it < iend; ++it)
+                {
+                    const auto begin = static_cast<int_type>(it) * width;
+                    const int_type end = it + 1 == ntile ? npos : begin + width;
+                    for (int_type ilevel = 1; ilevel <= nlevel; ++ilevel)
+                    {
+                        march_range_fused<ALPHA>(0 == ilevel % 2, begin + ilevel, end - ilevel);
+                    }
+                } },
+            1);
+        // Inverted triangles around the seams.
+        parallel_for(
+            0, ntile, [&](size_t ibegin, size_t iend)
+            {
+                for (size_t it = ibegin; it < iend; ++it)
+                {
+                    const auto seam = static_cast<int_type>(it) * width;
+                    for (int_type ilevel = 1; ilevel <= nlevel; ++ilevel)
+                    {
+                        const bool odd_plane = 0 == ilevel % 2;
+                        if (0 == it)
+                        {
+                            march_range_fused<ALPHA>(odd_plane, 0, ilevel);
+                            march_range_fused<ALPHA>(odd_plane, npos - ilevel, npos);
+                            if (!odd_plane)
+                            {
+                                treat_boundary_fused();
+                            }
+                        }
+                        else
+                        {
+                            march_range_fused<ALPHA>(odd_plane, seam - ilevel, seam + ilevel);
+                        }
+                    }
+                } },
+            1);
+        for (int_type ilevel = 0; ilevel < nlevel; ilevel += 2)
+        {
+            m_time += dt();
+            ++m_nstep;
+        }
+        march_snapshot();
+    }
+}
+
+template <typename ST, typename CE, typename SE>
+inline size_t SolverBase<ST, CE, SE>::update_lts_level(value_type cfl_limit, size_t max_level)
+{
+    if (!(cfl_limit > 0))
+    {
+        throw std::invalid_argument(Formatter() << "update_lts_level(): cfl_limit " << cfl_limit << " must be positive");
+    }
+    // The ticks of the finest level must fit in int64_t.
+    if (max_level > 60)
+    {
+        throw std::invalid_argument(Formatter() << "update_lts_level(): max_level " << max_level << " > 60");
+    }
+    const auto npos = static_cast<int_type>(2 * grid().ncelm() + 1);
+    update_cfl(false);
+    update_cfl(true);
+
+    std::vector<size_t> need(npos);
+    for (int_type ipos = 0; ipos < npos; ++ipos)
+    {
+        const value_type cfl = selm_position(ipos).cfl();
+        value_type limit = cfl_limit;
+        size_t ilevel = 0;
+        while (cfl > limit)
+        {
+            if (++ilevel > max_level)
+            {
+                throw std::invalid_argument(Formatter() << "update_lts_level(): CFL number " << cfl << " at position "
+                                                        << ipos << " needs more than max_level " << max_level);
+            }
+            limit *= 2;
+        }
+        need[ipos] = ilevel;
+    }
+
+    // A CE reads the SEs next to it.
+    std::vector<size_t> level(npos);
+    for (int_type ipos = 0; ipos < npos; ++ipos)
+    {
+        level[ipos] = need[ipos];
+        if (ipos > 0)
+        {
+            level[ipos] = std::max(level[ipos], need[ipos - 1]);
+        }
+        if (ipos + 1 < npos)
+        {
+            level[ipos] = std::max(level[ipos], need[ipos + 1]);
+        }
+    }
+    // Grade the levels.
+    for (int_type ipos = 1; ipos < npos; ++ipos)
+    {
+        level[ipos] = std::max(level[ipos], level[ipos - 1] - std::min(level[ipos - 1], size_t(1)));
+    }
+    for (int_type ipos = npos - 1; ipos > 0; --ipos)
+    {
+        level[ipos - 1] = std::max(level[ipos - 1], level[ipos] - std::min(level[ipos], size_t(1)));
+    }
+
+    m_lts_level = SimpleArray<uint8_t>(static_cast<size_t>(npos));
+    size_t nlevel = 0;
+    for (int_type ipos = 0; ipos < npos; ++ipos)
+    {
+        m_lts_level(ipos) = static_cast<uint8_t>(level[ipos]);
+        nlevel = std::max(nlevel, level[ipos] + 1);
+    }
+    return nlevel;
+}
+
+/**
+ * March with local time stepping (LTS).  Every step of time_increment() bins
+ * the positions by update_lts_level(), and a position of level l is updated
+ * 2^l times in the step.  The steps are scheduled on the ticks of the half
+ * step of the finest level, so that a CE always reads its neighbors of the
+ * same level at the time it needs.  At the interface of two levels, the SE of
+ * the other level is temporarily moved to the time by the temporal part of
+ * its own so0p() expansion, so that the two sides do not take the same mass
+ * through the interface.  A flux register makes up the difference at the end
+ * of every step (see make_lts_zones()), and the total mass is conserved to
+ * round-off.  With only one level it marches like march_alpha().
+ */
+template <typename ST, typename CE, typename SE>
+template <size_t ALPHA>
+inline void SolverBase<ST, CE, SE>::march_alpha_lts(size_t steps, value_type cfl_limit, size_t max_level)
+{
+    grid().refresh_metric();
+    for (size_t it = 0; it < steps; ++it)
+    {
+        const size_t nlevel = update_lts_level(cfl_limit, max_level);
+        march_step_lts<ALPHA>(nlevel);
+        m_time += dt();
+        ++m_nstep;
+        march_snapshot();
+    }
+}
+
+template <typename ST, typename CE, typename SE>
+template <size_t ALPHA>
+inline void SolverBase<ST, CE, SE>::march_celm_lts(CE & ce, size_t nvar)
+{
+    auto se = ce.selm_tp();
+    for (size_t iv = 0; iv < nvar; ++iv)
+    {
+        se.so0(iv) = ce.calc_so0(iv);
+    }
+    se.update_cfl();
+    for (size_t iv = 0; iv < nvar; ++iv)
+    {
+        se.so1(iv) = ce.template calc_so1_alpha<ALPHA>(iv);
+    }
+}
+
+template <typename ST, typename CE, typename SE>
+template <size_t ALPHA>
+inline void SolverBase<ST, CE, SE>::march_step_lts(size_t nlevel)
+{
+    const value_type time_increment = dt();
+    const auto npos = static_cast<int_type>(2 * grid().ncelm() + 1);
+
+    // Runs of the positions of the same level.
+    std::vector<std::vector<std::array<int_type, 2>>> runs(nlevel);
+    for (int_type begin = 0; begin < npos;)
+    {
+        int_type end = begin + 1;
+        while (end < npos && m_lts_level(end) == m_lts_level(begin))
+        {
+            ++end;
+        }
+        runs[m_lts_level(begin)].push_back({begin, end});
+        begin = end;
+    }
+
+    // Time of the solution at the positions in the ticks; the index is
+    // shifted by one for the ghost position at -1.  A position on the even
+    // plane is at the start of the step.  A position on the odd plane is
+    // written in the first tick before it is read.
+    std::vector<int64_t> ticks(npos + 2, 0);
+    for (int_type ipos = 1; ipos < npos; ipos += 2)
+    {
+        ticks[ipos + 1] = -(int64_t(1) << (nlevel - 1 - m_lts_level(ipos)));
+    }
+    ticks[0] = ticks[npos - 1];
+    ticks[npos + 1] = ticks[2];
+
+    // The flux register holds for each zone and variable the mass at the
+    // start, plus the mass taken in through the edges, minus the mass at the
+    // end.
+    std::vector<std::array<int_type, 3>> zones;
+    std::vector<value_type> fluxreg;
+    if (nlevel > 1)
+    {
+        zones = make_lts_zones();
+        fluxreg.assign(zones.size() * nvar(), 0);
+        add_lts_zone_mass(zones, 1, fluxreg);
+    }
+
+    const auto ntick = int64_t(1) << nlevel;
+    for (int64_t tick = 0; tick < ntick; ++tick)
+    {
+        // The coarser levels go first, and the finer levels see their
+        // updated solution.
+        for (size_t ilevel = 0; ilevel < nlevel; ++ilevel)
+        {
+            const auto unit = int64_t(1) << (nlevel - 1 - ilevel);
+            if (0 != tick % unit || runs[ilevel].empty())
+            {
+                continue;
+            }
+            m_field.set_time_increment(std::ldexp(time_increment, -static_cast<int>(ilevel)));
+            march_level_lts<ALPHA>(runs[ilevel], 1 == (tick / unit) % 2, tick, unit, ticks, zones, fluxreg);
+        }
+    }
+    m_field.set_time_increment(time_increment);
+
+    // Reflux: the coarse cell of a zone takes the mass that the zone gained
+    // or lost against what crossed its edges.
+    add_lts_zone_mass(zones, -1, fluxreg);
+    const size_t nvar = this->nvar();
+    for (size_t iz = 0; iz < zones.size(); ++iz)
+    {
+        SE se = selm_position(zones[iz][2]);
+        const value_type dx = se.dx();
+        for (size_t iv = 0; iv < nvar; ++iv)
+        {
+            se.so0(iv) += fluxreg[iz * nvar + iv] / dx;
+        }
+    }
+}
+
+/**
+ * Zones of the flux register of march_alpha_lts(), as {edge0, edge1, target}
+ * positions.  An edge is an odd position of the same level as both
+ * neighbors, so that the CEs around it march like march_alpha() and the mass
+ * they take through it is exact.  A zone spans the positions between the
+ * nearest edges around one or more interfaces of levels, and the target is
+ * the even position of the lowest level nearest to the first interface.  An
+ * interface without an edge between it and the boundary is not in a zone,
+ * because the boundary treatment does not conserve anyway.
+ */
+template <typename ST, typename CE, typename SE>
+inline std::vector<std::array<int_type, 3>>
+SolverBase<ST, CE, SE>::make_lts_zones() const
+{
+    const auto npos = static_cast<int_type>(2 * grid().ncelm() + 1);
+    auto const is_edge = [this, npos](int_type ipos)
+    {
+        return 1 == (ipos & 1) && 3 <= ipos && ipos <= npos - 4 &&
+               m_lts_level(ipos - 1) == m_lts_level(ipos) && m_lts_level(ipos + 1) == m_lts_level(ipos);
+    };
+    std::vector<std::array<int_type, 3>> zones;
+    for (int_type ipos = 1; ipos < npos; ++ipos)
+    {
+        if (m_lts_level(ipos - 1) == m_lts_level(ipos))
+        {
+            continue;
+        }
+        // The interface is between ipos - 1 and ipos.
+        int_type edge0 = ipos - 1;
+        while (0 <= edge0 && !is_edge(edge0))
+        {
+            --edge0;
+        }
+        int_type edge1 = ipos;
+        while (edge1 < npos && !is_edge(edge1))
+        {
+            ++edge1;
+        }
+        if (0 <= edge0 && edge1 < npos)
+        {
+            int_type target = edge0 + 1;
+            for (int_type jpos = target + 2; jpos < edge1; jpos += 2)
+            {
+                if (m_lts_level(jpos) < m_lts_level(target) ||
+                    (m_lts_level(jpos) == m_lts_level(target) && std::abs(jpos - ipos) < std::abs(target - ipos)))
+                {
+                    target = jpos;
+                }
+            }
+            zones.push_back({edge0, edge1, target});
+        }
+        // Skip the other interfaces in the zone.
+        ipos = edge1;
+    }
+    return zones;
+}
+
+/// Add sign times the mass of the even positions of the zones to the flux
+/// register.
+template <typename ST, typename CE, typename SE>
+inline void SolverBase<ST, CE, SE>::add_lts_zone_mass(
+    std::vector<std::array<int_type, 3>> const & zones, value_type sign, std::vector<value_type> & fluxreg)
+{
+    const size_t nvar = this->nvar();
+    for (size_t iz = 0; iz < zones.size(); ++iz)
+    {
+        for (int_type ipos = zones[iz][0] + 1; ipos < zones[iz][1]; ipos += 2)
+        {
+            SE se = selm_position(ipos);
+            const value_type dx = se.dx();
+            for (size_t iv = 0; iv < nvar; ++iv)
+            {
+                fluxreg[iz * nvar + iv] += sign * dx * se.so0(iv);
+            }
+        }
+    }
+}
+
+template <typename ST, typename CE, typename SE>
+template <size_t ALPHA>
+inline void SolverBase<ST, CE, SE>::march_level_lts(
+    std::vector<std::array<int_type, 2>> const & runs, bool odd_plane, int64_t tick, int64_t unit, std::vector<int64_t> & ticks, std::vector<std::array<int_type, 3>> const & zones, std::vector<value_type> & fluxreg)
+{
+    const value_type level_increment = dt();
+    const auto npos = static_cast<int_type>(2 * grid().ncelm() + 1);
+    const size_t nvar = this->nvar();
+    // A CE on the odd plane writes at an even position, and on the even plane
+    // at an odd position.
+    auto const is_written = [odd_plane](int_type ipos)
+    { return (0 == (ipos & 1)) == odd_plane; };
+
+    // Move the SEs of the other levels next to the runs to the time of the
+    // tick.
+    std::vector<int_type> neighbors;
+    for (auto const & run : runs)
+    {
+        if (is_written(run[0]))
+        {
+            neighbors.push_back(run[0] - 1);
+        }
+        if (is_written(run[1] - 1))
+        {
+            neighbors.push_back(run[1]);
+        }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    // The tick is the half time increment of the finest level.
+    const value_type tick_increment = level_increment / static_cast<value_type>(2 * unit);
+    std::vector<int_type> moved;
+    std::vector<value_type> saved;
+    std::vector<value_type> dso0(nvar);
+    for (int_type const ipos : neighbors)
+    {
+        const int64_t delta = tick - ticks[ipos + 1];
+        if (0 == delta)
+        {
+            continue;
+        }
+        // so0p() extrapolates by the half time increment.
+        m_field.set_time_increment(2 * static_cast<value_type>(delta) * tick_increment);
+        SE se = selm_position(ipos);
+        const value_type displacement = se.x() - se.xctr();
+        for (size_t iv = 0; iv < nvar; ++iv)
+        {
+            dso0[iv] = se.so0p(iv) - se.so0(iv) - displacement * se.so1(iv);
+        }
+        for (size_t iv = 0; iv < nvar; ++iv)
+        {
+            saved.push_back(se.so0(iv));
+            se.so0(iv) += dso0[iv];
+        }
+        moved.push_back(ipos);
+    }
+    m_field.set_time_increment(level_increment);
+
+    // Register the mass that the CEs of the level take through the edges of
+    // the zones.  A CE on the odd plane next to an edge reads the SE on the
+    // edge into the zone, and a CE on the even plane on an edge reads the SE
+    // next to it out of the zone.
+    const uint8_t level = m_lts_level(runs.front()[0]);
+    for (size_t iz = 0; iz < zones.size(); ++iz)
+    {
+        value_type * const flux = fluxreg.data() + iz * nvar;
+        const int_type edge0 = zones[iz][0];
+        const int_type edge1 = zones[iz][1];
+        if (level == m_lts_level(edge0))
+        {
+            SE se = selm_position(odd_plane ? edge0 : edge0 + 1);
+            for (size_t iv = 0; iv < nvar; ++iv)
+            {
+                flux[iv] += odd_plane ? se.xp(iv) + se.tp(iv) : -(se.xn(iv) - se.tp(iv));
+            }
+        }
+        if (level == m_lts_level(edge1))
+        {
+            SE se = selm_position(odd_plane ? edge1 : edge1 - 1);
+            for (size_t iv = 0; iv < nvar; ++iv)
+            {
+                flux[iv] += odd_plane ? se.xn(iv) - se.tp(iv) : -(se.xp(iv) + se.tp(iv));
+            }
+        }
+    }
+
+    bool boundary = false;
+    for (auto const & run : runs)
+    {
+        const int_type start = odd_plane ? (run[0] + 1) / 2 - 1 : run[0] / 2;
+        const int_type stop = odd_plane ? (run[1] + 1) / 2 - 1 : run[1] / 2;
+        for_each_celm(
+            start, stop, odd_plane, [&ticks, nvar, tick, unit, odd_plane](CE & ce)
+            {
+                march_celm_lts<ALPHA>(ce, nvar);
+                ticks[2 * ce.index() + (odd_plane ? 3 : 2)] = tick + unit; });
+        boundary = boundary || (run[0] <= 1 && 1 < run[1]) || (run[0] <= npos - 2 && npos - 2 < run[1]);
+    }
+
+    for (size_t it = 0; it < moved.size(); ++it)
+    {
+        SE se = selm_position(moved[it]);
+        for (size_t iv = 0; iv < nvar; ++iv)
+        {
+            se.so0(iv) = saved[it * nvar + iv];
+        }
+    }
+
+    if (boundary && !odd_plane)
+    {
+        treat_boundary_fused();
+        ticks[0] = ticks[npos - 1];
+        ticks[npos + 1] = ticks[2];
     }
 }
 
@@ -0,0 +1,200 @@
+#pragma once
+
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ * BSD 3-Clause License, see COPYING
+ */
+
+/**
+ * Ensemble of space-time CESE solvers sharing a grid.
+ */
+
+#include <modmesh/spacetime/core.hpp>
+#include <modmesh/spacetime/kernel/linear_scalar.hpp>
+#include <modmesh/spacetime/kernel/inviscid_burgers.hpp>
+#include <modmesh/parallel.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace modmesh
+{
+
+namespace spacetime
+{
+
+/**
+ * March nmember solvers of type ST on the same grid in one loop.  Every
+ * member is a solver with its own Field, and therefore its own solution and
+ * time increment.  A half step sweeps the CEs of all the members in a single
+ * parallel loop, so that a small grid still fills the threads and a half step
+ * takes one barrier instead of one per member.
+ *
+ * A member marches with the same arithmetic as SolverBase::march_alpha(), and
+ * the result is identical to marching it alone.  Only a solver with a
+ * compiled kernel may form an ensemble.
+ */
+template <typename ST>
+class SolverEnsemble
+    : public std::enable_shared_from_this<SolverEnsemble<ST>>
+{
+
+public:
+
+    using solver_type = ST;
+    using value_type = typename ST::value_type;
+    using celm_type = typename ST::celm_type;
+
+    static_assert(ST::static_kernel, "SolverEnsemble needs a solver with a compiled kernel");
+
+private:
+
+    class ctor_passkey
+    {
+    };
+
+public:
+
+    template <class... Args>
+    static std::shared_ptr<SolverEnsemble> construct(Args &&... args)
+    {
+        return std::make_shared<SolverEnsemble>(std::forward<Args>(args)..., ctor_passkey());
+    }
+
+    /// Create a member by ST::construct() on the grid for each time increment.
+    SolverEnsemble(std::shared_ptr<Grid> const & grid, std::vector<value_type> const & time_increments, ctor_passkey const &)
+    {
+        if (time_increments.empty())
+        {
+            throw std::invalid_argument("SolverEnsemble: nmember cannot be zero");
+        }
+        m_members.reserve(time_increments.size());
+        for (value_type const time_increment : time_increments)
+        {
+            m_members.push_back(ST::construct(grid, time_increment));
+        }
+    }
+
+    /// Take the solvers as the members.  They must be on the same grid.
+    SolverEnsemble(std::vector<std::shared_ptr<ST>> const & members, ctor_passkey const &)
+        : m_members(members)
+    {
+        if (m_members.empty())
+        {
+            throw std::invalid_argument("SolverEnsemble: nmember cannot be zero");
+        }
+        for (size_t im = 0; im < m_members.size(); ++im)
+        {
+            if (!m_members[im])
+            {
+                throw std::invalid_argument(Formatter() << "SolverEnsemble: member " << im << " is null");
+            }
+            if (&m_members[im]->grid() != &m_members.front()->grid())
+            {
+                throw std::invalid_argument(Formatter() << "SolverEnsemble: member " << im
+                                                        << " is not on the grid of member 0");
+            }
+        }
+    }
+
+    SolverEnsemble() = delete;
+    SolverEnsemble(SolverEnsemble const &) = default;
+    SolverEnsemble(SolverEnsemble &&) = default;
+    SolverEnsemble & operator=(SolverEnsemble const &) = default;
+    SolverEnsemble & operator=(SolverEnsemble &&) = default;
+    ~SolverEnsemble() = default;
+
+    size_t nmember() const { return m_members.size(); }
+    Grid const & grid() const { return m_members.front()->grid(); }
+    Grid & grid() { return m_members.front()->grid(); }
+
+    std::shared_ptr<ST> const & member(size_t imember) const
+    {
+        if (imember >= m_members.size())
+        {
+            throw std::out_of_range(Formatter() << "SolverEnsemble: member index " << imember
+                                                << " is out of range for nmember " << m_members.size());
+        }
+        return m_members[imember];
+    }
+
+    void setup_march()
+    {
+        for (std::shared_ptr<ST> const & svr : m_members)
+        {
+            svr->setup_march();
+        }
+    }
+    template <size_t ALPHA>
+    void march_half_alpha(bool odd_plane);
+    template <size_t ALPHA>
+    void march_alpha(size_t steps);
+
+private:
+
+    std::vector<std::shared_ptr<ST>> m_members;
+
+}; /* end class SolverEnsemble */
+
+/**
+ * Calculate so0, cfl, and so1 at selm_tp() of the CEs of all the members on
+ * the plane, like march_half1_alpha() or march_half2_alpha() of a member.
+ * The loop runs over (member, CE) pairs, and a chunk creates one CE per
+ * member it covers and advances it by move_right().
+ */
+template <typename ST>
+template <size_t ALPHA>
+inline void SolverEnsemble<ST>::march_half_alpha(bool odd_plane)
+{
+    grid().refresh_metric();
+    const int_type start = odd_plane ? -1 : 0;
+    const auto nce = static_cast<size_t>(static_cast<int_type>(grid().ncelm()) - start);
+    parallel_for(
+        0, m_members.size() * nce, [this, start, nce, odd_plane](size_t ibegin, size_t iend)
+        {
+            for (size_t it = ibegin; it < iend;)
+            {
+                const size_t im = it / nce;
+                const size_t itend = std::min(iend, (im + 1) * nce);
+                celm_type ce = m_members[im]->celm(start + static_cast<int_type>(it - im * nce), odd_plane);
+                for (; it < itend; ++it)
+                {
+                    ST::template march_celm_fused<ALPHA>(ce);
+                    ce.move_right();
+                }
+            } },
+        ST::MARCH_GRAIN);
+    if (!odd_plane)
+    {
+        for (std::shared_ptr<ST> const & svr : m_members)
+        {
+            svr->treat_boundary_fused();
+        }
+    }
+}
+
+template <typename ST>
+template <size_t ALPHA>
+inline void SolverEnsemble<ST>::march_alpha(size_t steps)
+{
+    for (size_t it = 0; it < steps; ++it)
+    {
+        march_half_alpha<ALPHA>(/*odd_plane*/ false);
+        // In the second half step, no treating boundary conditions.
+        march_half_alpha<ALPHA>(/*odd_plane*/ true);
+        for (std::shared_ptr<ST> const & svr : m_members)
+        {
+            svr->finish_step();
+        }
+    }
+}
+
+using LinearScalarEnsemble = SolverEnsemble<LinearScalarSolver>;
+using InviscidBurgersEnsemble = SolverEnsemble<InviscidBurgersSolver>;
+
+} /* end namespace spacetime */
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
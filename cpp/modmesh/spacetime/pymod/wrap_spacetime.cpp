@@ -73,7 +73,17 @@ class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapGrid
             .def_property_readonly("ncelm", &wrapped_type::ncelm)
             .def_property_readonly("nselm", &wrapped_type::nselm)
             .def_property_readonly(
-                "xcoord", static_cast<wrapped_type::array_type const & (wrapped_type::*)() const>(&wrapped_type::xcoord))
+                "xcoord",
+                [](wrapped_type & self) -> wrapped_type::array_type &
+                { return self.xcoord(); })
+            .def_property_readonly(
+                "selm_metric",
+                [](wrapped_type const & self) -> wrapped_type::array_type const &
+                {
+                    self.refresh_metric();
+                    return self.selm_metric();
+                })
+            .def("update_metric", &wrapped_type::update_metric)
             .def_property_readonly_static("BOUND_COUNT", [](py::object const &)
                                           { return Grid::BOUND_COUNT; });
     }
@@ -320,6 +330,88 @@ class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapLinearScalarSelm
 
 }; /* end class WrapLinearScalarSelm */
 
+template <typename ST>
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapSolverEnsemble
+    : public WrapBase<WrapSolverEnsemble<ST>, SolverEnsemble<ST>, std::shared_ptr<SolverEnsemble<ST>>>
+{
+
+public:
+
+    using base_type = WrapBase<WrapSolverEnsemble<ST>, SolverEnsemble<ST>, std::shared_ptr<SolverEnsemble<ST>>>;
+    using wrapper_type = typename base_type::wrapper_type;
+    using wrapped_type = typename base_type::wrapped_type;
+    using value_type = typename wrapped_type::value_type;
+
+    friend base_type;
+
+protected:
+
+    WrapSolverEnsemble(pybind11::module & mod, const char * pyname, const char * clsdoc)
+        : base_type(mod, pyname, clsdoc)
+    {
+        namespace py = pybind11;
+
+        (*this)
+            .def(
+                py::init(
+                    [](std::shared_ptr<Grid> const & grid, std::vector<value_type> const & time_increments)
+                    {
+                        return wrapped_type::construct(grid, time_increments);
+                    }),
+                py::arg("grid"),
+                py::arg("time_increments"))
+            .def(
+                py::init(
+                    [](std::vector<std::shared_ptr<ST>> const & members)
+                    {
+                        return wrapped_type::construct(members);
+                    }),
+                py::arg("members"))
+            .def_property_readonly("nmember", &wrapped_type::nmember)
+            .def_property_readonly(
+                "grid",
+                [](wrapped_type & self)
+                { return self.grid().shared_from_this(); })
+            .def(
+                "member",
+                [](wrapped_type const & self, size_t imember)
+                { return self.member(imember); },
+                py::arg("imember"))
+            .def("setup_march", &wrapped_type::setup_march);
+
+        (*this)
+            .def_march<0>()
+            .def_march<1>()
+            .def_march<2>();
+    }
+
+    template <size_t ALPHA>
+    wrapper_type & def_march()
+    {
+        // NOLINTNEXTLINE(misc-unused-alias-decls)
+        namespace py = pybind11;
+
+        (*this)
+            .def(
+                (Formatter() << "march_half_alpha" << ALPHA).str().c_str(),
+                [](wrapped_type & self, bool odd_plane)
+                {
+                    self.template march_half_alpha<ALPHA>(odd_plane);
+                },
+                py::arg("odd_plane"))
+            .def(
+                (Formatter() << "march_alpha" << ALPHA).str().c_str(),
+                [](wrapped_type & self, size_t steps)
+                {
+                    self.template march_alpha<ALPHA>(steps);
+                },
+                py::arg("steps"));
+
+        return *this;
+    }
+
+}; /* end class WrapSolverEnsemble */
+
 template <typename WST, typename WCET, typename WSET>
 void add_solver(pybind11::module & mod, const std::string & name, const std::string & desc)
 {
@@ -350,6 +442,9 @@ void wrap_spacetime(pybind11::module & mod)
         WrapInviscidBurgersSolver,
         WrapInviscidBurgersCelm,
         WrapInviscidBurgersSelm>(mod, "InviscidBurgers", "the inviscid Burgers equation");
+
+    WrapSolverEnsemble<LinearScalarSolver>::commit(mod, "LinearScalarEnsemble", "Ensemble of linear scalar solvers on the same grid");
+    WrapSolverEnsemble<InviscidBurgersSolver>::commit(mod, "InviscidBurgersEnsemble", "Ensemble of inviscid Burgers solvers on the same grid");
 }
 
 } /* end namespace python */
@@ -49,6 +49,21 @@ namespace modmesh
 namespace python
 {
 
+/**
+ * Wrap a const member function of an element to refresh Grid::selm_metric()
+ * before the call, since Python may have written the coordinates through an
+ * ndarray view since the last march.
+ */
+template <class WT, class ET, typename R, typename... Args>
+auto with_fresh_metric(R (ET::*func)(Args...) const)
+{
+    return [func](WT const & self, Args... args)
+    {
+        self.grid().refresh_metric();
+        return (self.*func)(args...);
+    };
+}
+
 template <class WT, class ET>
 class WrapElementBase
     : public WrapBase<WT, ET>
@@ -87,7 +102,7 @@ protected:
             .def_property_readonly("dx", &wrapped_type::dx)
             .def_property_readonly("xneg", &wrapped_type::xneg)
             .def_property_readonly("xpos", &wrapped_type::xpos)
-            .def_property_readonly("xctr", &wrapped_type::xctr)
+            .def_property_readonly("xctr", with_fresh_metric<wrapped_type>(&wrapped_type::xctr))
             .def_property_readonly("index", &wrapped_type::index)
             .def_property_readonly("on_even_plane", &wrapped_type::on_even_plane)
             .def_property_readonly("on_odd_plane", &wrapped_type::on_odd_plane)
@@ -138,13 +153,14 @@ protected:
             .def_property_readonly("selm_xp", static_cast<se_getter_type>(&wrapped_type::selm_xp))
             .def_property_readonly("selm_tn", static_cast<se_getter_type>(&wrapped_type::selm_tn))
             .def_property_readonly("selm_tp", static_cast<se_getter_type>(&wrapped_type::selm_tp))
-            .def("calc_so0", static_cast<calc_so_type>(&wrapped_type::calc_so0));
+            .def("calc_so0", with_fresh_metric<wrapped_type>(static_cast<calc_so_type>(&wrapped_type::calc_so0)));
 
 #define DECL_ST_WRAP_CALC_SO1_ALPHA(ALPHA)                  \
     .def(                                                   \
         "calc_so1_alpha" #ALPHA,                            \
         [](wrapped_type const & self, size_t iv)            \
         {                                                   \
+            self.grid().refresh_metric();                   \
             return self.template calc_so1_alpha<ALPHA>(iv); \
         })
 
@@ -179,8 +195,8 @@ protected:
         using so_getter_type = value_type const & (wrapped_type::*)(size_t) const;
         using cfl_getter_type = value_type const & (wrapped_type::*)() const;
         (*this)
-            .def_property_readonly("dxneg", &wrapped_type::dxneg)
-            .def_property_readonly("dxpos", &wrapped_type::dxpos)
+            .def_property_readonly("dxneg", with_fresh_metric<wrapped_type>(&wrapped_type::dxneg))
+            .def_property_readonly("dxpos", with_fresh_metric<wrapped_type>(&wrapped_type::dxpos))
             .def("get_so0", static_cast<so_getter_type>(&wrapped_type::so0))
             .def("get_so1", static_cast<so_getter_type>(&wrapped_type::so1))
             .def("get_cfl", static_cast<cfl_getter_type>(&wrapped_type::cfl))
@@ -193,12 +209,17 @@ protected:
             .def(
                 "set_cfl", [](wrapped_type & self, value_type val)
                 { self.cfl() = val; })
-            .def("xn", &wrapped_type::xn)
-            .def("xp", &wrapped_type::xp)
-            .def("tn", &wrapped_type::tn)
-            .def("tp", &wrapped_type::tp)
-            .def("so0p", &wrapped_type::so0p)
-            .def("update_cfl", &wrapped_type::update_cfl);
+            .def("xn", with_fresh_metric<wrapped_type>(&wrapped_type::xn))
+            .def("xp", with_fresh_metric<wrapped_type>(&wrapped_type::xp))
+            .def("tn", with_fresh_metric<wrapped_type>(&wrapped_type::tn))
+            .def("tp", with_fresh_metric<wrapped_type>(&wrapped_type::tp))
+            .def("so0p", with_fresh_metric<wrapped_type>(&wrapped_type::so0p))
+            .def(
+                "update_cfl", [](wrapped_type & self)
+                {
+                    self.grid().refresh_metric();
+                    self.update_cfl();
+                });
     }
 
 }; /* end class WrapSelmBase */
@@ -326,6 +347,9 @@ protected:
         (*this)
             .def("__str__", &detail::to_str<wrapped_type>)
             .def("clone", &wrapped_type::clone, py::arg("grid") = false)
+            .def_property_readonly_static(
+                "static_kernel", [](py::object const &)
+                { return wrapped_type::static_kernel; })
             .def_property_readonly("grid", [](wrapped_type & self)
                                    { return self.grid().shared_from_this(); });
 
@@ -349,6 +373,24 @@ protected:
             .def_property_readonly("dt", &wrapped_type::dt)
             .def_property_readonly("hdt", &wrapped_type::hdt)
             .def_property_readonly("qdt", &wrapped_type::qdt)
+            .def_property("time", &wrapped_type::time, &wrapped_type::set_time)
+            .def("max_cfl", &wrapped_type::max_cfl, py::arg("odd_plane") = false)
+            .def_property_readonly("time_history", &wrapped_type::time_history)
+            .def("clear_time_history", &wrapped_type::clear_time_history)
+            .def_property("nstep", &wrapped_type::nstep, &wrapped_type::set_nstep)
+            .def("save_checkpoint", &wrapped_type::save_checkpoint, py::arg("path"), py::arg("float32") = false)
+            .def("load_checkpoint", &wrapped_type::load_checkpoint, py::arg("path"))
+            .def(
+                "set_snapshot",
+                &wrapped_type::set_snapshot,
+                py::arg("writer"),
+                py::arg("interval"),
+                py::arg("fields"))
+            .def("clear_snapshot", &wrapped_type::clear_snapshot)
+            .def_property_readonly("snapshot_writer", &wrapped_type::snapshot_writer)
+            .def("take_snapshot", &wrapped_type::take_snapshot)
+            .def("update_lts_level", &wrapped_type::update_lts_level, py::arg("cfl_limit") = 1.0, py::arg("max_level") = 8)
+            .def_property_readonly("lts_level", &wrapped_type::lts_level)
             .def("celm", static_cast<celm_getter>(&wrapped_type::celm_at), py::arg("ielm"), py::arg("odd_plane") = false)
             .def("selm", static_cast<selm_getter>(&wrapped_type::selm_at), py::arg("ielm"), py::arg("odd_plane") = false)
             .def(
@@ -444,6 +486,27 @@ protected:
         "march_alpha"#ALPHA \
       , [](wrapped_type & self, size_t steps) { self.template march_alpha<ALPHA>(steps); } \
       , py::arg("steps") \
+    ) \
+    .def \
+    ( \
+        "march_alpha"#ALPHA"_blocked" \
+      , [](wrapped_type & self, size_t steps, size_t block_steps, size_t tile_celm) \
+        { self.template march_alpha_blocked<ALPHA>(steps, block_steps, tile_celm); } \
+      , py::arg("steps"), py::arg("block_steps") = 8, py::arg("tile_celm") = 4096 \
+    ) \
+    .def \
+    ( \
+        "march_alpha"#ALPHA"_adaptive" \
+      , [](wrapped_type & self, double time_stop, double target_cfl, double dt_min, double dt_max) \
+        { return self.template march_alpha_adaptive<ALPHA>(time_stop, target_cfl, dt_min, dt_max); } \
+      , py::arg("time_stop"), py::arg("target_cfl"), py::arg("dt_min"), py::arg("dt_max") \
+    ) \
+    .def \
+    ( \
+        "march_alpha"#ALPHA"_lts" \
+      , [](wrapped_type & self, size_t steps, double cfl_limit, size_t max_level) \
+        { self.template march_alpha_lts<ALPHA>(steps, cfl_limit, max_level); } \
+      , py::arg("steps"), py::arg("cfl_limit") = 1.0, py::arg("max_level") = 8 \
     )
 
         (*this)
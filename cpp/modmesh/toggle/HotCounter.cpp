@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <modmesh/toggle/HotCounter.hpp>
+
+#include <iomanip>
+#include <sstream>
+
+namespace modmesh
+{
+
+double tick_period()
+{
+    static double const period = []()
+    {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        // Calibrate the time-stamp counter against the steady clock.
+        using clock_type = std::chrono::steady_clock;
+        clock_type::time_point const start = clock_type::now();
+        uint64_t const tick0 = tick_count();
+        while (clock_type::now() - start < std::chrono::milliseconds(10))
+        {
+            // Busy wait to keep the processor from sleeping.
+        }
+        uint64_t const tick1 = tick_count();
+        double const elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+        return tick1 > tick0 ? elapsed / static_cast<double>(tick1 - tick0) : 0.0;
+#elif defined(__aarch64__)
+        uint64_t freq;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+        return 1.0 / static_cast<double>(freq);
+#else
+        using period_type = std::chrono::steady_clock::period;
+        return static_cast<double>(period_type::num) / static_cast<double>(period_type::den);
+#endif
+    }();
+    return period;
+}
+
+/**
+ * Slot block owned by a thread.  It attaches itself to the registry when the
+ * thread first uses a counter and folds its counts into the registry when
+ * the thread exits.  The generation tells which clear() the counts follow.
+ */
+class HotCounterRegistry::LocalBlock
+{
+
+public:
+
+    LocalBlock()
+        : m_registry(HotCounterRegistry::me())
+    {
+        m_registry.attach(this);
+    }
+
+    LocalBlock(LocalBlock const &) = delete;
+    LocalBlock(LocalBlock &&) = delete;
+    LocalBlock & operator=(LocalBlock const &) = delete;
+    LocalBlock & operator=(LocalBlock &&) = delete;
+
+    ~LocalBlock() { m_registry.detach(this); }
+
+    slot_block_type & slots() { return m_slots; }
+    slot_block_type const & slots() const { return m_slots; }
+
+    /// Generation of the counts; loaded by the registry to skip a stale block.
+    uint64_t generation() const { return m_generation.load(std::memory_order_acquire); }
+    void set_generation(uint64_t gen) { m_generation.store(gen, std::memory_order_release); }
+
+    /// Zero the slots if the registry was cleared since the last call.  Only the owner calls it.
+    void sync()
+    {
+        uint64_t const gen = m_registry.m_generation.load(std::memory_order_relaxed);
+        if (gen != m_generation.load(std::memory_order_relaxed))
+        {
+            for (HotCounterSlot & slot : m_slots)
+            {
+                slot.ncall.store(0, std::memory_order_relaxed);
+                slot.nitem.store(0, std::memory_order_relaxed);
+                slot.nsample.store(0, std::memory_order_relaxed);
+                slot.ticks.store(0, std::memory_order_relaxed);
+            }
+            // Publish the zeros before the generation that makes them visible.
+            set_generation(gen);
+        }
+    }
+
+private:
+
+    HotCounterRegistry & m_registry;
+    slot_block_type m_slots;
+    std::atomic<uint64_t> m_generation{0};
+
+}; /* end class HotCounterRegistry::LocalBlock */
+
+HotCounterRegistry & HotCounterRegistry::me()
+{
+    // Never destroyed: worker threads may exit and detach their slot blocks
+    // during static destruction.
+    static HotCounterRegistry * inst = new HotCounterRegistry();
+    return *inst;
+}
+
+HotCounterRegistry::slot_block_type & HotCounterRegistry::local()
+{
+    thread_local LocalBlock block;
+    block.sync();
+    return block.slots();
+}
+
+size_t HotCounterRegistry::add(std::string const & name, size_t sample)
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    for (size_t it = 0; it < m_records.size(); ++it)
+    {
+        if (m_records[it].name == name)
+        {
+            return it;
+        }
+    }
+    if (m_records.size() >= MAX_COUNTER)
+    {
+        throw std::out_of_range(Formatter() << "HotCounterRegistry: cannot add \"" << name << "\" beyond "
+                                            << MAX_COUNTER << " counters");
+    }
+    Record rec;
+    rec.name = name;
+    rec.sample = sample ? sample : 1;
+    m_records.push_back(rec);
+    return m_records.size() - 1;
+}
+
+size_t HotCounterRegistry::size() const
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    return m_records.size();
+}
+
+std::vector<std::string> HotCounterRegistry::names() const
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    std::vector<std::string> ret;
+    ret.reserve(m_records.size());
+    for (Record const & rec : m_records)
+    {
+        ret.push_back(rec.name);
+    }
+    return ret;
+}
+
+HotCounterRegistry::Record HotCounterRegistry::record(std::string const & name) const
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    for (size_t it = 0; it < m_records.size(); ++it)
+    {
+        if (m_records[it].name == name)
+        {
+            return collect(it);
+        }
+    }
+    throw std::out_of_range(Formatter() << "HotCounterRegistry: no counter named \"" << name << "\"");
+}
+
+std::vector<HotCounterRegistry::Record> HotCounterRegistry::records() const
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    std::vector<Record> ret;
+    ret.reserve(m_records.size());
+    for (size_t it = 0; it < m_records.size(); ++it)
+    {
+        ret.push_back(collect(it));
+    }
+    return ret;
+}
+
+std::string HotCounterRegistry::report() const
+{
+    std::ostringstream ostm;
+    ostm
+        << std::setw(40) << "Counter Name"
+        << std::setw(16) << "Call Count"
+        << std::setw(16) << "Item Count"
+        << std::setw(16) << "Sample Count"
+        << std::setw(20) << "Total Time (s)"
+        << std::setw(20) << "Per Item (ns)"
+        << std::endl;
+    for (Record const & rec : records())
+    {
+        double const time = rec.time();
+        ostm
+            << std::setw(40) << rec.name
+            << std::setw(16) << rec.ncall
+            << std::setw(16) << rec.nitem
+            << std::setw(16) << rec.nsample
+            << std::setw(20) << std::fixed << std::setprecision(6) << time
+            << std::setw(20) << std::setprecision(3) << (rec.nitem ? time * 1.e9 / static_cast<double>(rec.nitem) : 0.0)
+            << std::defaultfloat << std::endl;
+    }
+    return ostm.str();
+}
+
+void HotCounterRegistry::clear()
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    for (Record & rec : m_records)
+    {
+        rec.ncall = rec.nitem = rec.nsample = rec.ticks = 0;
+    }
+    // The owners zero their blocks when they see the new generation.
+    m_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+void HotCounterRegistry::attach(LocalBlock * block)
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    // A new block is zero and follows the latest clear().
+    block->set_generation(m_generation.load(std::memory_order_relaxed));
+    m_blocks.push_back(block);
+}
+
+void HotCounterRegistry::detach(LocalBlock * block)
+{
+    std::lock_guard<std::mutex> const lock(m_mutex);
+    bool const current = block->generation() == m_generation.load(std::memory_order_relaxed);
+    for (size_t it = 0; current && it < m_records.size(); ++it)
+    {
+        HotCounterSlot const & slot = block->slots()[it];
+        Record & rec = m_records[it];
+        rec.ncall += slot.ncall.load(std::memory_order_relaxed);
+        rec.nitem += slot.nitem.load(std::memory_order_relaxed);
+        rec.nsample += slot.nsample.load(std::memory_order_relaxed);
+        rec.ticks += slot.ticks.load(std::memory_order_relaxed);
+    }
+    for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+    {
+        if (*it == block)
+        {
+            m_blocks.erase(it);
+            break;
+        }
+    }
+}
+
+// The caller holds m_mutex.
+HotCounterRegistry::Record HotCounterRegistry::collect(size_t index) const
+{
+    Record ret = m_records[index];
+    uint64_t const gen = m_generation.load(std::memory_order_relaxed);
+    for (LocalBlock const * block : m_blocks)
+    {
+        if (block->generation() != gen)
+        {
+            continue; // Counted before the last clear().
+        }
+        HotCounterSlot const & slot = block->slots()[index];
+        ret.ncall += slot.ncall.load(std::memory_order_relaxed);
+        ret.nitem += slot.nitem.load(std::memory_order_relaxed);
+        ret.nsample += slot.nsample.load(std::memory_order_relaxed);
+        ret.ticks += slot.ticks.load(std::memory_order_relaxed);
+    }
+    return ret;
+}
+
+} /* end namespace modmesh */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
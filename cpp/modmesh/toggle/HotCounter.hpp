@@ -0,0 +1,302 @@
+#pragma once
+
+/*
+ * Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Low-overhead counters for the inner loops of the solvers.
+ */
+
+#include <modmesh/base.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+namespace modmesh
+{
+
+/**
+ * Read the cheapest monotonic tick source of the processor: the time-stamp
+ * counter on x86, the virtual counter on aarch64, and the steady clock
+ * elsewhere.  Use tick_period() to convert ticks to seconds.
+ */
+inline uint64_t tick_count()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t val;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(val));
+    return val;
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/// Return the seconds per tick of tick_count().  Calibrated on first call.
+double tick_period();
+
+/**
+ * Accumulator of a counter in one thread.  Only the owning thread writes to
+ * it, so the updates are plain loads and stores; the fields are atomic only
+ * to let HotCounterRegistry read them from another thread.  The registry
+ * never writes to a slot; see HotCounterRegistry::clear().
+ */
+struct HotCounterSlot
+{
+    std::atomic<uint64_t> ncall{0}; ///< Number of entries to the scope.
+    std::atomic<uint64_t> nitem{0}; ///< Number of items the scope processed.
+    std::atomic<uint64_t> nsample{0}; ///< Number of timed entries.
+    std::atomic<uint64_t> ticks{0}; ///< Ticks spent in the timed entries.
+    uint64_t countdown = 0; ///< Calls before the next timed entry.
+
+    static void bump(std::atomic<uint64_t> & value, uint64_t inc)
+    {
+        value.store(value.load(std::memory_order_relaxed) + inc, std::memory_order_relaxed);
+    }
+}; /* end struct HotCounterSlot */
+
+/**
+ * Registry of the hot-path counters.  A counter is registered by name once
+ * (normally through a function-local static HotCounterId at the call site)
+ * and is then addressed by its index, so that the hot path does no lookup.
+ * Each thread accumulates into its own block of slots, which the registry
+ * sums when asked for the results and folds into its totals when the thread
+ * exits.
+ */
+class HotCounterRegistry
+{
+
+public:
+
+    static constexpr size_t MAX_COUNTER = 256;
+
+    using slot_block_type = std::array<HotCounterSlot, MAX_COUNTER>;
+
+    struct Record
+    {
+        std::string name;
+        size_t sample = 1; ///< Time one of every this many calls.
+        uint64_t ncall = 0;
+        uint64_t nitem = 0;
+        uint64_t nsample = 0;
+        uint64_t ticks = 0;
+
+        /// Time spent in the sampled calls.
+        double sampled_time() const { return static_cast<double>(ticks) * tick_period(); }
+
+        /// Time spent in all calls, extrapolated from the samples.
+        double time() const
+        {
+            return nsample ? sampled_time() * static_cast<double>(ncall) / static_cast<double>(nsample) : 0.0;
+        }
+    }; /* end struct Record */
+
+    /// The singleton.
+    static HotCounterRegistry & me();
+
+    /// Return the slot block of the calling thread, zeroed if a clear() happened since the last call.
+    static slot_block_type & local();
+
+    /**
+     * Register a counter and return its index.  Registering an existing
+     * name returns the existing index and keeps the first sampling period.
+     */
+    size_t add(std::string const & name, size_t sample);
+
+    size_t size() const;
+    std::vector<std::string> names() const;
+    Record record(std::string const & name) const;
+    std::vector<Record> records() const;
+    std::string report() const;
+
+    /**
+     * Zero all counts; the registered names are kept.  The slot blocks of the
+     * live threads are not written here, because their owners update them
+     * with plain loads and stores.  Clearing advances a generation instead:
+     * the counts of a block from an older generation are not collected, and
+     * the owner zeroes its block the next time it enters a counter.  It is
+     * therefore safe to clear while the counting threads run; a timed scope
+     * straddling the clear loses its sample.
+     */
+    void clear();
+
+    HotCounterRegistry(HotCounterRegistry const &) = delete;
+    HotCounterRegistry(HotCounterRegistry &&) = delete;
+    HotCounterRegistry & operator=(HotCounterRegistry const &) = delete;
+    HotCounterRegistry & operator=(HotCounterRegistry &&) = delete;
+    ~HotCounterRegistry() = default;
+
+private:
+
+    HotCounterRegistry() = default;
+
+    class LocalBlock;
+    friend class LocalBlock;
+
+    void attach(LocalBlock * block);
+    void detach(LocalBlock * block);
+    Record collect(size_t index) const;
+
+    mutable std::mutex m_mutex;
+    std::vector<Record> m_records; ///< Names and the totals of exited threads.
+    std::vector<LocalBlock *> m_blocks; ///< Slot blocks of live threads.
+    std::atomic<uint64_t> m_generation{0}; ///< Number of clear() calls.
+
+}; /* end class HotCounterRegistry */
+
+/**
+ * Index of a registered hot-path counter.
+ */
+class HotCounterId
+{
+
+public:
+
+    HotCounterId(char const * name, size_t sample)
+        : m_index(HotCounterRegistry::me().add(name, sample))
+        , m_sample(sample ? sample : 1)
+    {
+    }
+
+    size_t index() const { return m_index; }
+    size_t sample() const { return m_sample; }
+
+private:
+
+    size_t m_index;
+    size_t m_sample;
+
+}; /* end class HotCounterId */
+
+/**
+ * Count the entries to a scope and the items it processes, and time one of
+ * every HotCounterId::sample() entries with tick_count().
+ */
+class HotScope
+{
+
+public:
+
+    HotScope() = delete;
+    HotScope(HotScope const &) = delete;
+    HotScope(HotScope &&) = delete;
+    HotScope & operator=(HotScope const &) = delete;
+    HotScope & operator=(HotScope &&) = delete;
+
+    HotScope(HotCounterId const & id, uint64_t nitem)
+        : m_slot(HotCounterRegistry::local()[id.index()])
+    {
+        HotCounterSlot::bump(m_slot.ncall, 1);
+        HotCounterSlot::bump(m_slot.nitem, nitem);
+        if (m_slot.countdown == 0)
+        {
+            m_slot.countdown = id.sample() - 1;
+            m_timed = true;
+            m_start = tick_count();
+        }
+        else
+        {
+            --m_slot.countdown;
+        }
+    }
+
+    ~HotScope()
+    {
+        if (m_timed)
+        {
+            uint64_t const stop = tick_count();
+            HotCounterSlot::bump(m_slot.ticks, stop - m_start);
+            HotCounterSlot::bump(m_slot.nsample, 1);
+        }
+    }
+
+private:
+
+    HotCounterSlot & m_slot;
+    bool m_timed = false;
+    uint64_t m_start = 0;
+
+}; /* end class HotScope */
+
+} /* end namespace modmesh */
+
+/*
+ * MODMESH_PROFILE defined: Enable hot-path counters.
+ *
+ * MODMESH_HOT_TIME(NAME, SAMPLE, NITEM) counts the entries to the enclosing
+ * scope and the NITEM items it processes, and times one of every SAMPLE
+ * entries.  MODMESH_HOT_COUNT(NAME, NITEM) only counts.  NAME must be a
+ * string literal.
+ */
+#ifdef MODMESH_PROFILE
+
+#define MODMESH_HOT_CONCAT_IMPL(A, B) A##B
+#define MODMESH_HOT_CONCAT(A, B) MODMESH_HOT_CONCAT_IMPL(A, B)
+
+#define MODMESH_HOT_TIME(NAME, SAMPLE, NITEM)                                                       \
+    static ::modmesh::HotCounterId const MODMESH_HOT_CONCAT(_local_hot_id_, __LINE__)(NAME, SAMPLE); \
+    ::modmesh::HotScope MODMESH_HOT_CONCAT(_local_hot_scope_, __LINE__)(MODMESH_HOT_CONCAT(_local_hot_id_, __LINE__), NITEM);
+
+#define MODMESH_HOT_COUNT(NAME, NITEM)                                                                      \
+    do                                                                                                      \
+    {                                                                                                       \
+        static ::modmesh::HotCounterId const _local_hot_count_id(NAME, 0);                                  \
+        ::modmesh::HotCounterSlot & _local_hot_slot = ::modmesh::HotCounterRegistry::local()[_local_hot_count_id.index()]; \
+        ::modmesh::HotCounterSlot::bump(_local_hot_slot.ncall, 1);                                          \
+        ::modmesh::HotCounterSlot::bump(_local_hot_slot.nitem, NITEM);                                      \
+    } while (0)
+
+/*
+ * No MODMESH_PROFILE defined: Disable hot-path counters.
+ */
+#else // MODMESH_PROFILE
+
+#define MODMESH_HOT_TIME(NAME, SAMPLE, NITEM)
+#define MODMESH_HOT_COUNT(NAME, NITEM) \
+    do                                 \
+    {                                  \
+    } while (0)
+
+#endif // MODMESH_PROFILE
+/*
+ * End MODMESH_PROFILE.
+ */
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
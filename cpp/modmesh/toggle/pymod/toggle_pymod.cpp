@@ -50,6 +50,7 @@ void initialize_toggle(pybind11::module & mod)
     {
         wrap_profile(mod);
         wrap_Toggle(mod);
+        wrap_ThreadPool(mod);
     };
 
     OneTimeInitializer<toggle_pymod_tag>::me()(mod, initialize_impl);
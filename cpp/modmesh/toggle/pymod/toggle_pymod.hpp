@@ -45,6 +45,7 @@ void wrap_profile(pybind11::module & mod);
 void wrap_StaticGrid(pybind11::module & mod);
 void wrap_StaticMesh(pybind11::module & mod);
 void wrap_Toggle(pybind11::module & mod);
+void wrap_ThreadPool(pybind11::module & mod);
 
 } /* end namespace python */
 
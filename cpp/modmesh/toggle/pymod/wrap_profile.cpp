@@ -166,6 +166,72 @@ protected:
 
 }; /* end class WrapTimeRegistry */
 
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapHotCounterRecord
+    : public WrapBase<WrapHotCounterRecord, HotCounterRegistry::Record>
+{
+
+public:
+
+    friend root_base_type;
+
+protected:
+
+    WrapHotCounterRecord(pybind11::module & mod, char const * pyname, char const * pydoc)
+        : root_base_type(mod, pyname, pydoc)
+    {
+        (*this)
+            .def_readonly("name", &wrapped_type::name)
+            .def_readonly("sample", &wrapped_type::sample)
+            .def_readonly("ncall", &wrapped_type::ncall)
+            .def_readonly("nitem", &wrapped_type::nitem)
+            .def_readonly("nsample", &wrapped_type::nsample)
+            .def_readonly("ticks", &wrapped_type::ticks)
+            .def_property_readonly("sampled_time", &wrapped_type::sampled_time)
+            .def_property_readonly("time", &wrapped_type::time)
+            //
+            ;
+    }
+
+}; /* end class WrapHotCounterRecord */
+
+class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapHotCounterRegistry
+    : public WrapBase<WrapHotCounterRegistry, HotCounterRegistry>
+{
+
+public:
+
+    friend root_base_type;
+
+protected:
+
+    WrapHotCounterRegistry(pybind11::module & mod, char const * pyname, char const * pydoc)
+        : root_base_type(mod, pyname, pydoc)
+    {
+        namespace py = pybind11;
+
+        (*this)
+            .def_property_readonly_static(
+                "me",
+                [](py::object const &) -> wrapped_type &
+                { return wrapped_type::me(); })
+            .def_property_readonly_static(
+                "tick_period",
+                [](py::object const &)
+                { return tick_period(); })
+            .def("clear", &wrapped_type::clear)
+            .def("record", &wrapped_type::record, py::arg("name"))
+            .def_property_readonly("records", &wrapped_type::records)
+            .def_property_readonly("names", &wrapped_type::names)
+            .def("report", &wrapped_type::report)
+            .def("__len__", &wrapped_type::size)
+            //
+            ;
+
+        mod.attr("hot_counter_registry") = mod.attr("HotCounterRegistry").attr("me");
+    }
+
+}; /* end class WrapHotCounterRegistry */
+
 class MODMESH_PYTHON_WRAPPER_VISIBILITY WrapCallProfiler : public WrapBase<WrapCallProfiler, CallProfiler>
 {
 public:
@@ -271,6 +337,8 @@ void wrap_profile(pybind11::module & mod)
     WrapStopWatch::commit(mod, "StopWatch", "StopWatch");
     WrapTimedEntry::commit(mod, "TimedEntry", "TimeEntry");
     WrapTimeRegistry::commit(mod, "TimeRegistry", "TimeRegistry");
+    WrapHotCounterRecord::commit(mod, "HotCounterRecord", "HotCounterRecord");
+    WrapHotCounterRegistry::commit(mod, "HotCounterRegistry", "HotCounterRegistry");
     WrapCallProfiler::commit(mod, "CallProfiler", "CallProfiler");
     WrapCallProfilerProbe::commit(mod, "CallProfilerProbe", "CallProfilerProbe");
 }
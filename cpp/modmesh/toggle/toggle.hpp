@@ -32,6 +32,7 @@
 #include <modmesh/buffer/buffer.hpp>
 #include <modmesh/toggle/profile.hpp>
 #include <modmesh/toggle/RadixTree.hpp>
+#include <modmesh/toggle/HotCounter.hpp>
 
 #include <string>
 #include <vector>
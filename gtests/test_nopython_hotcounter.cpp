@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <future>
+#include <thread>
+#include <vector>
+
+#ifdef Py_PYTHON_H
+#error "Python.h should not be included."
+#endif
+
+#include <modmesh/toggle/HotCounter.hpp>
+
+namespace modmesh
+{
+
+namespace detail
+{
+
+void hot_loop(HotCounterId const & id, size_t ncall)
+{
+    for (size_t it = 0; it < ncall; ++it)
+    {
+        HotScope const scope(id, 8);
+    }
+}
+
+} /* end namespace detail */
+
+TEST(HotCounter, tick)
+{
+    uint64_t const tick0 = tick_count();
+    uint64_t const tick1 = tick_count();
+    EXPECT_LE(tick0, tick1);
+    EXPECT_GT(tick_period(), 0.0);
+    EXPECT_LT(tick_period(), 1.e-6);
+}
+
+TEST(HotCounter, register_once)
+{
+    HotCounterRegistry & reg = HotCounterRegistry::me();
+    HotCounterId const id0("HotCounter.register_once", 4);
+    HotCounterId const id1("HotCounter.register_once", 16);
+    EXPECT_EQ(id0.index(), id1.index());
+    EXPECT_EQ(reg.record("HotCounter.register_once").sample, 4);
+    EXPECT_THROW(reg.record("HotCounter.no_such_name"), std::out_of_range);
+}
+
+TEST(HotCounter, sample)
+{
+    HotCounterRegistry & reg = HotCounterRegistry::me();
+    HotCounterId const id("HotCounter.sample", 16);
+    reg.clear();
+    detail::hot_loop(id, 100);
+    HotCounterRegistry::Record const rec = reg.record("HotCounter.sample");
+    EXPECT_EQ(rec.ncall, 100);
+    EXPECT_EQ(rec.nitem, 800);
+    // Calls 0, 16, ..., 96 are timed.
+    EXPECT_EQ(rec.nsample, 7);
+    EXPECT_GE(rec.time(), rec.sampled_time());
+}
+
+TEST(HotCounter, threads)
+{
+    HotCounterRegistry & reg = HotCounterRegistry::me();
+    HotCounterId const id("HotCounter.threads", 1);
+    reg.clear();
+    std::vector<std::thread> threads;
+    for (size_t it = 0; it < 4; ++it)
+    {
+        threads.emplace_back(detail::hot_loop, std::cref(id), 1000);
+    }
+    // Count in the main thread while the workers run.
+    detail::hot_loop(id, 500);
+    EXPECT_GE(reg.record("HotCounter.threads").ncall, 500);
+    for (std::thread & thread : threads)
+    {
+        thread.join();
+    }
+    // The counts of the exited threads are kept.
+    HotCounterRegistry::Record const rec = reg.record("HotCounter.threads");
+    EXPECT_EQ(rec.ncall, 4500);
+    EXPECT_EQ(rec.nsample, 4500);
+    EXPECT_EQ(rec.nitem, 36000);
+    reg.clear();
+    EXPECT_EQ(reg.record("HotCounter.threads").ncall, 0);
+}
+
+TEST(HotCounter, clear_running)
+{
+    HotCounterRegistry & reg = HotCounterRegistry::me();
+    HotCounterId const id("HotCounter.clear_running", 1);
+    reg.clear();
+    std::promise<void> counted;
+    std::promise<void> cleared;
+    std::promise<void> recounted;
+    std::promise<void> done;
+    std::thread worker(
+        [&]()
+        {
+            detail::hot_loop(id, 100);
+            counted.set_value();
+            cleared.get_future().wait();
+            detail::hot_loop(id, 30);
+            recounted.set_value();
+            done.get_future().wait();
+        });
+    counted.get_future().wait();
+    EXPECT_EQ(reg.record("HotCounter.clear_running").ncall, 100);
+    // The worker is alive and has not entered the counter since the clear.
+    reg.clear();
+    EXPECT_EQ(reg.record("HotCounter.clear_running").ncall, 0);
+    cleared.set_value();
+    recounted.get_future().wait();
+    // The worker zeroes its own slots and counts after the clear.
+    EXPECT_EQ(reg.record("HotCounter.clear_running").ncall, 30);
+    EXPECT_EQ(reg.record("HotCounter.clear_running").nsample, 30);
+    done.set_value();
+    worker.join();
+    EXPECT_EQ(reg.record("HotCounter.clear_running").ncall, 30);
+}
+
+} /* end namespace modmesh */
@@ -0,0 +1,142 @@
+#include <modmesh/parallel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef Py_PYTHON_H
+#error "Python.h should not be included."
+#endif
+
+TEST(ThreadPool, run_all_tasks)
+{
+    modmesh::ThreadPool & pool = modmesh::ThreadPool::me();
+    EXPECT_GE(pool.nthread(), 1u);
+    std::vector<int> hits(97, 0);
+    pool.run(hits.size(), [&](size_t it)
+             { hits[it] += 1; });
+    for (int const hit : hits)
+    {
+        EXPECT_EQ(1, hit);
+    }
+}
+
+TEST(ThreadPool, set_nthread)
+{
+    modmesh::ThreadPool & pool = modmesh::ThreadPool::me();
+    size_t const orig = pool.nthread();
+    pool.set_nthread(3);
+    EXPECT_EQ(3u, pool.nthread());
+    std::vector<int> hits(10, 0);
+    pool.run(hits.size(), [&](size_t it)
+             { hits[it] = static_cast<int>(it); });
+    EXPECT_EQ(45, std::accumulate(hits.begin(), hits.end(), 0));
+    pool.set_nthread(orig);
+    EXPECT_EQ(orig, pool.nthread());
+}
+
+TEST(ThreadPool, set_nthread_while_running)
+{
+    modmesh::ThreadPool & pool = modmesh::ThreadPool::me();
+    size_t const orig = pool.nthread();
+    std::atomic<bool> done{false};
+    std::thread resizer([&]
+                        {
+                            for (size_t it = 0; !done.load(); ++it)
+                            {
+                                pool.set_nthread(1 + it % 4);
+                            } });
+    for (size_t it = 0; it < 200; ++it)
+    {
+        std::vector<int> hits(16, 0);
+        pool.run(hits.size(), [&](size_t itask)
+                 { hits[itask] = 1; });
+        EXPECT_EQ(16, std::accumulate(hits.begin(), hits.end(), 0));
+    }
+    done.store(true);
+    resizer.join();
+    pool.set_nthread(orig);
+    EXPECT_EQ(orig, pool.nthread());
+}
+
+TEST(ThreadPool, few_tasks)
+{
+    modmesh::ThreadPool & pool = modmesh::ThreadPool::me();
+    size_t const orig = pool.nthread();
+    pool.set_nthread(8);
+    // A run with fewer tasks than threads wakes only some of the workers, and
+    // the others must join the following runs.
+    for (size_t it = 0; it < 500; ++it)
+    {
+        size_t const ntask = 1 + it % 10;
+        std::vector<int> hits(ntask, 0);
+        pool.run(ntask, [&](size_t itask)
+                 { hits[itask] += 1; });
+        EXPECT_EQ(std::vector<int>(ntask, 1), hits);
+    }
+    pool.set_nthread(orig);
+    EXPECT_EQ(orig, pool.nthread());
+}
+
+TEST(ThreadPool, rethrow)
+{
+    modmesh::ThreadPool & pool = modmesh::ThreadPool::me();
+    pool.set_nthread(4);
+    EXPECT_THROW(
+        pool.run(8, [](size_t it)
+                 {
+                     if (it == 5)
+                     {
+                         throw std::runtime_error("task 5");
+                     } }),
+        std::runtime_error);
+    // The pool remains usable after an exception.
+    std::vector<int> hits(8, 0);
+    pool.run(hits.size(), [&](size_t it)
+             { hits[it] = 1; });
+    EXPECT_EQ(8, std::accumulate(hits.begin(), hits.end(), 0));
+}
+
+TEST(parallel_for, chunks_cover_range)
+{
+    modmesh::ThreadPool::me().set_nthread(4);
+    std::vector<int> hits(10000, 0);
+    modmesh::parallel_for(
+        3, hits.size(), [&](size_t ibegin, size_t iend)
+        {
+            for (size_t it = ibegin; it < iend; ++it)
+            {
+                hits[it] += 1;
+            } },
+        100);
+    EXPECT_EQ(0, hits[0] + hits[1] + hits[2]);
+    EXPECT_EQ(static_cast<int>(hits.size() - 3), std::accumulate(hits.begin(), hits.end(), 0));
+}
+
+TEST(parallel_for, nested_runs_serially)
+{
+    modmesh::ThreadPool::me().set_nthread(4);
+    std::vector<int> hits(64, 0);
+    modmesh::parallel_for(
+        0, 8, [&](size_t ibegin, size_t iend)
+        {
+            for (size_t it = ibegin; it < iend; ++it)
+            {
+                modmesh::parallel_for(
+                    it * 8, (it + 1) * 8, [&](size_t jbegin, size_t jend)
+                    {
+                        for (size_t jt = jbegin; jt < jend; ++jt)
+                        {
+                            hits[jt] += 1;
+                        } },
+                    1);
+            } },
+        1);
+    EXPECT_EQ(64, std::accumulate(hits.begin(), hits.end(), 0));
+}
+
+// vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -5,6 +5,10 @@
 #endif
 
 #include <modmesh/serialization/SerializableItem.hpp>
+#include <modmesh/serialization/Checkpoint.hpp>
+
+#include <cstdio>
+#include <fstream>
 namespace modmesh
 {
 
@@ -322,6 +326,65 @@ TEST(Json, deserialize_with_unordered_map)
     EXPECT_EQ(item.pet_map["cat"].is_cat, true);
 }
 
+TEST(Checkpoint, round_trip)
+{
+    std::string const path = ::testing::TempDir() + "modmesh_checkpoint_round_trip.bin";
+    SimpleArray<double> arr(small_vector<size_t>{3, 2});
+    for (size_t it = 0; it < arr.size(); ++it)
+    {
+        arr.data(it) = 0.1 * static_cast<double>(it) + 1.0;
+    }
+    CheckpointWriter writer("test");
+    writer
+        .add_integer("nstep", 42)
+        .add_real("time", 0.25)
+        .add_array("f64", arr)
+        .add_array("f32", arr, /*float32*/ true);
+    EXPECT_EQ(writer.nrecord(), 4);
+    writer.write(path);
+
+    CheckpointReader const reader(path);
+    EXPECT_EQ(reader.kind(), "test");
+    EXPECT_EQ(reader.nrecord(), 4);
+    EXPECT_TRUE(reader.has("f32"));
+    EXPECT_FALSE(reader.has("f16"));
+    EXPECT_EQ(reader.integer("nstep"), 42);
+    EXPECT_EQ(reader.real("time"), 0.25);
+    SimpleArray<double> const f64 = reader.array("f64");
+    SimpleArray<double> const f32 = reader.array("f32");
+    EXPECT_EQ(f64.shape(), arr.shape());
+    EXPECT_EQ(f32.shape(), arr.shape());
+    for (size_t it = 0; it < arr.size(); ++it)
+    {
+        EXPECT_EQ(f64.data(it), arr.data(it));
+        EXPECT_EQ(f32.data(it), static_cast<double>(static_cast<float>(arr.data(it))));
+    }
+    EXPECT_THROW(reader.array("f16"), std::out_of_range);
+    EXPECT_THROW(reader.real("nstep"), std::invalid_argument);
+    EXPECT_THROW(reader.array("time"), std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+TEST(Checkpoint, corrupted)
+{
+    std::string const path = ::testing::TempDir() + "modmesh_checkpoint_corrupted.bin";
+    SimpleArray<double> arr(small_vector<size_t>{16}, 1.0);
+    CheckpointWriter("test").add_array("arr", arr).write(path);
+    {
+        std::fstream fs(path, std::ios::binary | std::ios::in | std::ios::out);
+        fs.seekp(-16, std::ios::end);
+        fs.put('\x7f');
+    }
+    EXPECT_THROW(CheckpointReader{path}, std::runtime_error);
+    {
+        std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+        ofs << "not a checkpoint file";
+    }
+    EXPECT_THROW(CheckpointReader{path}, std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(CheckpointReader{path}, std::runtime_error);
+}
+
 } // namespace modmesh
 
 // vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
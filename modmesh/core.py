@@ -44,6 +44,9 @@ __all__ = [  # noqa: F822
     'stop_watch',
     'TimeRegistry',
     'time_registry',
+    'HotCounterRecord',
+    'HotCounterRegistry',
+    'hot_counter_registry',
     'CallProfiler',
     'call_profiler',
     'CallProfilerProbe',
@@ -22,26 +22,57 @@ class Euler1DSolver:
     """
     Numerical solver for the one-dimensional Euler equation by using the CESE
     method.
+
+    The solution is stored in the precision of dtype, which is 'float64' by
+    default.  With 'float32' the storage is halved while the fluxes are still
+    summed in float64.
     """
 
     def __init__(self, xmin, xmax, ncoord, time_increment=0.05,
-                 keep_edge=False):
+                 keep_edge=False, dtype='float64'):
         self._core = self.init_solver(xmin, xmax, ncoord, time_increment,
-                                      gamma=1.4)
+                                      gamma=1.4, dtype=dtype)
         # gamma is 1.4 for air.
         _ = self.ncoord - 1
         start = 0 if keep_edge else 2
         stop = _ if keep_edge else (_ - 2)
         num = (stop - start) // 2 + 1
         self.xindices = np.linspace(start, stop, num, dtype='int32')
+        self._primitives = None
 
     def __getattr__(self, name):
         return getattr(self._core, name)
 
+    def primitives(self, out=None):
+        """
+        Compute the primitive variables in one pass.
+
+        :param out: :py:class:`Euler1DPrimitives` to fill.  By default, a
+            buffer of all the variables is allocated on the first call and
+            reused by the later calls.
+        :return: the filled :py:class:`Euler1DPrimitives`, whose arrays share
+            the memory of the buffers and change in the next call
+        """
+        if out is None:
+            if self._primitives is None:
+                self._primitives = _impl.Euler1DPrimitives(ncoord=self.ncoord)
+            out = self._primitives
+        self._core.primitives(out)
+        return out
+
     @staticmethod
-    def init_solver(xmin, xmax, ncoord, time_increment, gamma):
-        # Create the solver object.
-        svr = _impl.Euler1DCore(ncoord=ncoord, time_increment=time_increment)
+    def init_solver(xmin, xmax, ncoord, time_increment, gamma,
+                    dtype='float64'):
+        # Create the solver object of the storage precision.
+        dtype = np.dtype(dtype)
+        if dtype == np.float64:
+            core_type = _impl.Euler1DCoreFp64
+        elif dtype == np.float32:
+            core_type = _impl.Euler1DCoreFp32
+        else:
+            raise ValueError(f"dtype {dtype} is not supported; "
+                             f"use float32 or float64")
+        svr = core_type(ncoord=ncoord, time_increment=time_increment)
 
         # Initialize spatial grid.
         svr.coord[...] = np.linspace(xmin, xmax, num=ncoord)
@@ -122,7 +153,7 @@ class ShockTube:
         self.svr = None
 
     def build_numerical(self, xmin, xmax, ncoord, time_increment=0.05,
-                        xdiaphragm=0.0, keep_edge=False):
+                        xdiaphragm=0.0, keep_edge=False, dtype='float64'):
         """
         After :py:meth:`build_constant` is done, optionally build the
         numerical solver :py:attr:`svr`.
@@ -132,6 +163,8 @@ class ShockTube:
         :param ncoord:
         :param time_increment:
         :param xdiaphragm: It should be set to 0.0.
+        :param dtype: Storage precision of the solution, 'float64' or
+            'float32'.
         :return: None
         """
         if None is self.gamma:
@@ -140,7 +173,7 @@ class ShockTube:
         # Initialize the numerical solver.
         self.svr = Euler1DSolver(xmin, xmax, ncoord,
                                  time_increment=time_increment,
-                                 keep_edge=keep_edge)
+                                 keep_edge=keep_edge, dtype=dtype)
 
         # Fill gamma.
         self.svr.gamma.fill(self.gamma)
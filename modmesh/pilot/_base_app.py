@@ -600,28 +600,40 @@ class OneDimBaseApp(PilotFeature):
         """
         Updating plot after the solver finishes its computation each time.
         """
+        source = self.numerical_source() if self.plot_num else None
         if self.use_grid_layout:
             for [name, *_] in self.plot_data:
                 data = getattr(self, name)
-                self.update_plot_data(data)
+                self.update_plot_data(data, source)
         else:
             for [name, *_] in self.plot_data:
                 if self.plot_config[name]["line_selection"]:
                     data = getattr(self, name)
-                    self.update_plot_data(data)
+                    self.update_plot_data(data, source)
 
-    def update_plot_data(self, data):
+    def numerical_source(self):
+        """
+        Return the object holding the numerical data as attributes named
+        after the plotted quantities.
+        """
+        return self.st.svr
+
+    def update_plot_data(self, data, source=None):
         """
         Update analytical and numerical data.
 
         :param data (type: QuantityLine): property of solver
+        :param source: object holding the numerical data; default to
+            :py:meth:`numerical_source`
         """
         if self.plot_ana:
             ana_x = self.st.coord_field
             ana_y = getattr(self.st, data.name + "_field")
             data.update_ana(x=ana_x, y=ana_y)
         if self.plot_num:
-            num_y = getattr(self.st.svr, data.name)[self.st.svr.xindices]
+            if source is None:
+                source = self.numerical_source()
+            num_y = getattr(source, data.name)[self.st.svr.xindices]
             data.update_num(y=num_y)
 
 
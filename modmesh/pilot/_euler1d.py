@@ -146,6 +146,13 @@ class Euler1DApp(OneDimBaseApp):
                                 time_increment=_s["time_increment"]["value"])
         self.st.build_field(t=0)
 
+    def numerical_source(self):
+        """
+        Compute all the primitive variables in one pass into buffers reused
+        across frames.
+        """
+        return self.st.svr.primitives()
+
     def update_step(self, steps):
         """
         Update data at current step.
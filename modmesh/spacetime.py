@@ -21,6 +21,8 @@ _toload = [
     'Solver',
     'InviscidBurgersSolver',
     'LinearScalarSolver',
+    'InviscidBurgersEnsemble',
+    'LinearScalarEnsemble',
 ]
 
 
@@ -25,14 +25,231 @@
 # POSSIBILITY OF SUCH DAMAGE.
 
 import unittest
+import itertools
+
+import numpy as np
 
 import modmesh as mm
 
 
+def make_2d(nx, ny, lx, ly, triangle=False):
+    """Build a structured quadrilateral or triangular mesh with ghost."""
+    x, y = np.meshgrid(np.linspace(0, lx, nx + 1), np.linspace(0, ly, ny + 1))
+    ndcrd = np.stack([x.ravel(), y.ravel()], axis=1)
+    ind = np.arange((nx + 1) * (ny + 1)).reshape(ny + 1, nx + 1)
+    nd0 = ind[:-1, :-1].ravel()
+    nd1 = ind[:-1, 1:].ravel()
+    nd2 = ind[1:, 1:].ravel()
+    nd3 = ind[1:, :-1].ravel()
+    if triangle:
+        clnds = np.concatenate([np.stack([nd0, nd1, nd2], axis=1),
+                                np.stack([nd0, nd2, nd3], axis=1)])
+        cltpn = mm.StaticMesh.TRIANGLE
+    else:
+        clnds = np.stack([nd0, nd1, nd2, nd3], axis=1)
+        cltpn = mm.StaticMesh.QUADRILATERAL
+    return _build(2, ndcrd, cltpn, clnds)
+
+
+def make_3d(nx, ny, nz, lx, ly, lz, tetrahedron=False):
+    """Build a structured hexahedral or tetrahedral mesh with ghost."""
+    z, y, x = np.meshgrid(np.linspace(0, lz, nz + 1),
+                          np.linspace(0, ly, ny + 1),
+                          np.linspace(0, lx, nx + 1), indexing="ij")
+    ndcrd = np.stack([x.ravel(), y.ravel(), z.ravel()], axis=1)
+    ind = np.arange(ndcrd.shape[0]).reshape(nz + 1, ny + 1, nx + 1)
+
+    def corner(i, j, k):
+        return ind[k:k + nz, j:j + ny, i:i + nx].ravel()
+
+    if tetrahedron:
+        # Split each brick into 6 tetrahedra along its main diagonal.
+        tets = []
+        for perm in itertools.permutations(range(3)):
+            ijk = [0, 0, 0]
+            nds = [corner(*ijk)]
+            for axis in perm:
+                ijk[axis] = 1
+                nds.append(corner(*ijk))
+            tets.append(np.stack(nds, axis=1))
+        clnds = np.concatenate(tets)
+        crd = ndcrd[clnds]
+        vol = np.linalg.det(crd[:, 1:] - crd[:, :1])
+        flip = vol < 0
+        clnds[flip, 1], clnds[flip, 2] = clnds[flip, 2], clnds[flip, 1]
+        cltpn = mm.StaticMesh.TETRAHEDRON
+    else:
+        clnds = np.stack([corner(0, 0, 0), corner(1, 0, 0),
+                          corner(1, 1, 0), corner(0, 1, 0),
+                          corner(0, 0, 1), corner(1, 0, 1),
+                          corner(1, 1, 1), corner(0, 1, 1)], axis=1)
+        cltpn = mm.StaticMesh.HEXAHEDRON
+    return _build(3, ndcrd, cltpn, clnds)
+
+
+def _build(ndim, ndcrd, cltpn, clnds):
+    mh = mm.StaticMesh(ndim=ndim, nnode=ndcrd.shape[0], nface=0,
+                       ncell=clnds.shape[0])
+    mh.ndcrd.ndarray[:, :] = ndcrd
+    mh.cltpn.ndarray[:] = cltpn
+    mh.clnds.ndarray[:, :clnds.shape[1] + 1] = np.hstack(
+        [np.full((clnds.shape[0], 1), clnds.shape[1]), clnds])
+    mh.build_interior()
+    mh.build_boundary()
+    mh.build_ghost()
+    return mh
+
+
 class EulerCoreTC(unittest.TestCase):
 
+    def _set_uniform(self, core, density, velocity, pressure):
+        ncell = core.ncell
+        core.set_primitive(
+            density=np.full(ncell, density, dtype='float64'),
+            velocity=np.tile(np.array(velocity, dtype='float64'),
+                             (ncell, 1)),
+            pressure=np.full(ncell, pressure, dtype='float64'))
+
+    def _check_freestream(self, mh, velocity, bc):
+        core = mm.EulerCore(mesh=mh, time_increment=0.0)
+        for ibc in range(core.nbc):
+            core.set_bc(ibc, bc)
+        self.assertEqual(bc, core.bc_type(0))
+        core.time_increment = 0.2 * core.cllen.ndarray.min()
+        self._set_uniform(core, 1.0, velocity, 1.0)
+        core.setup_march()
+        core.march_alpha1(steps=10)
+        self.assertEqual(10, core.nstep)
+        self.assertAlmostEqual(10 * core.time_increment, core.time)
+        np.testing.assert_allclose(core.density, 1.0, atol=1.e-12)
+        np.testing.assert_allclose(core.pressure, 1.0, atol=1.e-12)
+        np.testing.assert_allclose(
+            core.velocity, np.tile(velocity, (core.ncell, 1)), atol=1.e-12)
+        self.assertGreater(core.max_cfl, 0.0)
+        self.assertLess(core.max_cfl, 1.0)
+
     def test_construct(self):
         mh = mm.StaticMesh(ndim=2, nnode=0)
-        mm.EulerCore(mesh=mh, time_increment=0.0)
+        core = mm.EulerCore(mesh=mh, time_increment=0.0)
+        self.assertEqual(2, core.ndim)
+        self.assertEqual(4, core.neq)
+        self.assertEqual(0, core.ncell)
+        # Marching an empty mesh does nothing.
+        core.march_alpha1(steps=1)
+
+    def test_construct_without_ghost(self):
+        mh = mm.StaticMesh(ndim=2, nnode=4, nface=0, ncell=3)
+        mh.ndcrd.ndarray[:, :] = (0, 0), (-1, -1), (1, -1), (0, 1)
+        mh.cltpn.ndarray[:] = mm.StaticMesh.TRIANGLE
+        mh.clnds.ndarray[:, :4] = (3, 0, 1, 2), (3, 0, 2, 3), (3, 0, 3, 1)
+        mh.build_interior()
+        with self.assertRaisesRegex(ValueError, "build_ghost"):
+            mm.EulerCore(mesh=mh, time_increment=0.0)
+
+    def test_construct_without_padded(self):
+        mh = make_2d(2, 1, 2.0, 1.0)
+        mh.build_csr(drop_padded=True)
+        with self.assertRaisesRegex(ValueError, "expand_csr"):
+            mm.EulerCore(mesh=mh, time_increment=0.1)
+        mh.expand_csr()
+        core = mm.EulerCore(mesh=mh, time_increment=0.1)
+        mh.build_csr(drop_padded=True)
+        with self.assertRaisesRegex(RuntimeError, "expand_csr"):
+            core.march_alpha1(steps=1)
+
+    def test_bc(self):
+        core = mm.EulerCore(mesh=make_2d(4, 2, 2.0, 1.0),
+                            time_increment=0.0)
+        self.assertEqual(1, core.nbc)
+        self.assertEqual(mm.EulerCore.NONREFLECTING, core.bc_type(0))
+        core.set_bc(0, mm.EulerCore.SLIPWALL)
+        self.assertEqual(mm.EulerCore.SLIPWALL, core.bc_type(0))
+        core.set_bc_inlet(0, density=1.0, velocity=[0.5, 0.0],
+                          pressure=1.0)
+        self.assertEqual(mm.EulerCore.INLET, core.bc_type(0))
+        with self.assertRaisesRegex(IndexError, "ibc 1 >= nbc 1"):
+            core.set_bc(1, mm.EulerCore.SLIPWALL)
+        with self.assertRaisesRegex(ValueError, "invalid type"):
+            core.set_bc(0, 3)
+
+    def test_geometry(self):
+        for mh in (make_2d(4, 3, 2.0, 1.5, triangle=True),
+                   make_3d(3, 2, 2, 1.5, 1.0, 1.0)):
+            core = mm.EulerCore(mesh=mh, time_increment=0.0)
+            ngst = core.ngstcell
+            # The BCE of a face is shared by the two cells, so that the CCEs
+            # cover the domain and the ghost half of the boundary BCEs twice.
+            cevol = core.cevol.ndarray[ngst:]
+            self.assertAlmostEqual(cevol[:, 1:].sum(), cevol[:, 0].sum())
+            self.assertGreater(cevol[:, 0].sum(),
+                               2 * mh.clvol.ndarray[mh.ngstcell:].sum())
+            # The lateral surfaces of a CCE are closed.
+            nml = core.sfmrc.ndarray[:, :, :, 1, :]
+            np.testing.assert_allclose(nml.sum(axis=(1, 2)), 0.0,
+                                       atol=1.e-14)
+
+    def test_freestream_2d(self):
+        for triangle in (False, True):
+            self._check_freestream(make_2d(8, 5, 2.0, 1.0, triangle),
+                                   [0.3, 0.2], mm.EulerCore.NONREFLECTING)
+
+    def test_freestream_3d(self):
+        for tetrahedron in (False, True):
+            self._check_freestream(
+                make_3d(4, 3, 3, 2.0, 1.5, 1.0, tetrahedron),
+                [0.3, 0.2, 0.1], mm.EulerCore.NONREFLECTING)
+
+    def test_inlet_after_set_gamma(self):
+        # The inlet state is converted with the gamma at the march, so that
+        # a uniform flow matching the inlet stays uniform.
+        core = mm.EulerCore(mesh=make_2d(8, 5, 2.0, 1.0), time_increment=0.0)
+        core.set_bc_inlet(0, density=1.0, velocity=[0.3, 0.2], pressure=1.0)
+        core.gamma = 1.2
+        core.time_increment = 0.2 * core.cllen.ndarray.min()
+        self._set_uniform(core, 1.0, [0.3, 0.2], 1.0)
+        core.setup_march()
+        core.march_alpha1(steps=10)
+        np.testing.assert_allclose(core.density, 1.0, atol=1.e-12)
+        np.testing.assert_allclose(core.pressure, 1.0, atol=1.e-12)
+
+    def test_rest_slipwall(self):
+        self._check_freestream(make_2d(8, 5, 2.0, 1.0, triangle=True),
+                               [0.0, 0.0], mm.EulerCore.SLIPWALL)
+        self._check_freestream(make_3d(3, 3, 3, 1.0, 1.0, 1.0, True),
+                               [0.0, 0.0, 0.0], mm.EulerCore.SLIPWALL)
+
+    def test_shock_tube(self):
+        nx, ny = 100, 2
+        dx = 1.0 / nx
+        mh = make_2d(nx, ny, 1.0, ny * dx)
+        core = mm.EulerCore(mesh=mh, time_increment=0.4 * dx)
+        core.set_bc(0, mm.EulerCore.SLIPWALL)
+        xcnd = mh.clcnd.ndarray[mh.ngstcell:, 0]
+        left = xcnd < 0.5
+        core.set_primitive(density=np.where(left, 1.0, 0.125),
+                           velocity=np.zeros((core.ncell, 2)),
+                           pressure=np.where(left, 1.0, 0.1))
+        core.setup_march()
+        vol = core.cevol.ndarray[core.ngstcell:, 0]
+        mass = (core.density * vol).sum()
+        core.march_alpha1(steps=50)
+        self.assertAlmostEqual(0.2, core.time)
+
+        density = core.density
+        velocity = core.velocity
+        pressure = core.pressure
+        # Mass is conserved before the waves reach the ends.
+        self.assertAlmostEqual(mass, (density * vol).sum(), places=12)
+        # The solution does not vary across the tube.
+        rho = density.reshape(ny, nx)
+        np.testing.assert_allclose(rho, rho[:1], atol=1.e-12)
+        np.testing.assert_allclose(velocity[:, 1], 0.0, atol=1.e-12)
+        self.assertGreaterEqual(density.min(), 0.125 - 1.e-4)
+        self.assertLessEqual(density.max(), 1.0 + 1.e-4)
+        # Contact plateau of the Sod problem at t = 0.2.
+        plateau = (xcnd > 0.55) & (xcnd < 0.62)
+        np.testing.assert_allclose(velocity[plateau, 0], 0.9274, atol=0.01)
+        np.testing.assert_allclose(pressure[plateau], 0.3031, atol=0.01)
+        np.testing.assert_allclose(density[plateau], 0.4263, atol=0.01)
 
 # vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -27,6 +27,8 @@
 
 import unittest
 
+import numpy as np
+
 import modmesh
 
 
@@ -38,4 +40,123 @@ class StaticGridTC(unittest.TestCase):
         self.assertEqual(2, modmesh.StaticGrid2d.NDIM)
         self.assertEqual(3, modmesh.StaticGrid3d.NDIM)
 
+
+class StaticGrid2dTC(unittest.TestCase):
+
+    def test_construct(self):
+
+        gd = modmesh.StaticGrid2d(5, 7, nghost=2)
+        self.assertEqual((5, 7), gd.shape)
+        self.assertEqual(5, gd.nx)
+        self.assertEqual(7, gd.ny)
+        self.assertEqual(2, gd.nghost)
+        self.assertEqual(35, len(gd))
+        # Rows are padded to the alignment.
+        self.assertEqual(16, gd.pitch)
+        self.assertEqual(9 * 16, gd.field_size)
+        self.assertEqual(list(range(-2, 7)), list(gd.xcoord.ndarray))
+        self.assertEqual(list(range(-2, 9)), list(gd.ycoord.ndarray))
+
+    def test_field(self):
+
+        gd = modmesh.StaticGrid2d(5, 7, nghost=2)
+        fd = gd.make_field(1.5)
+        self.assertEqual((9, gd.pitch), fd.ndarray.shape)
+        self.assertEqual(0, fd.ndarray.ctypes.data % gd.ALIGNMENT)
+        self.assertEqual((5, 7), gd.view(fd).shape)
+        self.assertEqual((9, 11), gd.view(fd, ghost=True).shape)
+        # The view shares the buffer.
+        gd.view(fd)[...] = np.arange(35).reshape((5, 7))
+        self.assertEqual(34, fd.ndarray[6, 8])
+        self.assertEqual(1.5, fd.ndarray[1, 8])
+
+        with self.assertRaisesRegex(
+                ValueError, r"StaticGrid2d: field is not a field of the grid"
+        ):
+            modmesh.StaticGrid2d(6, 7, nghost=2).view(fd)
+
+    def test_fill_ghost(self):
+
+        gd = modmesh.StaticGrid2d(4, 3, nghost=2)
+        fd = gd.make_field()
+        interior = np.arange(12, dtype='float64').reshape((4, 3))
+        gd.view(fd)[...] = interior
+
+        gd.fill_ghost(fd, gd.PERIODIC)
+        golden = np.pad(interior, 2, mode='wrap')
+        self.assertEqual(golden.tolist(), gd.view(fd, ghost=True).tolist())
+
+        gd.fill_ghost(fd, gd.EDGE)
+        golden = np.pad(interior, 2, mode='edge')
+        self.assertEqual(golden.tolist(), gd.view(fd, ghost=True).tolist())
+
+        with self.assertRaisesRegex(ValueError, r"invalid type 7"):
+            gd.fill_ghost(fd, 7)
+        with self.assertRaisesRegex(
+                ValueError, r"nghost 2 > 1 points along axis 0 for periodic"
+        ):
+            gd1 = modmesh.StaticGrid2d(1, 3, nghost=2)
+            gd1.fill_ghost(gd1.make_field(), gd1.PERIODIC)
+
+    def test_apply_stencil(self):
+
+        # Large enough to span several tiles along both axes.
+        gd = modmesh.StaticGrid2d(37, 1100, nghost=1)
+        src = gd.make_field()
+        dst = gd.make_field()
+        rng = np.random.default_rng(0)
+        gd.view(src)[...] = rng.random((37, 1100))
+        gd.fill_ghost(src, gd.PERIODIC)
+
+        offsets = [(0, 0), (1, 0), (-1, 0), (0, 1), (0, -1)]
+        weights = [-4.0, 1.0, 1.0, 1.0, 1.0]
+        gd.apply_stencil(src, dst, offsets, weights)
+        sv = gd.view(src, ghost=True)
+        golden = (-4 * sv[1:-1, 1:-1] + sv[2:, 1:-1] + sv[:-2, 1:-1]
+                  + sv[1:-1, 2:] + sv[1:-1, :-2])
+        np.testing.assert_allclose(golden, gd.view(dst), rtol=0, atol=1e-14)
+        # Ghost layers of the destination are not touched.
+        self.assertEqual(0, np.abs(gd.view(dst, ghost=True)[0]).max())
+
+        with self.assertRaisesRegex(
+                ValueError, r"offset 2 along axis 1 exceeds nghost 1"
+        ):
+            gd.apply_stencil(src, dst, [(0, 2)], [1.0])
+        with self.assertRaisesRegex(ValueError, r"share the buffer"):
+            gd.apply_stencil(src, src, offsets, weights)
+        with self.assertRaisesRegex(ValueError, r"5 offsets differ from 1"):
+            gd.apply_stencil(src, dst, offsets, [1.0])
+
+
+class StaticGrid3dTC(unittest.TestCase):
+
+    def test_fill_ghost(self):
+
+        gd = modmesh.StaticGrid3d(3, 4, 5, nghost=1)
+        self.assertEqual((3, 4, 5), gd.shape)
+        self.assertEqual(8, gd.pitch)
+        fd = gd.make_field()
+        self.assertEqual((5, 6, 8), fd.ndarray.shape)
+        interior = np.arange(60, dtype='float64').reshape((3, 4, 5))
+        gd.view(fd)[...] = interior
+        gd.fill_ghost(fd, gd.PERIODIC)
+        golden = np.pad(interior, 1, mode='wrap')
+        self.assertEqual(golden.tolist(), gd.view(fd, ghost=True).tolist())
+
+    def test_apply_stencil(self):
+
+        gd = modmesh.StaticGrid3d(6, 20, 9, nghost=1)
+        src = gd.make_field()
+        dst = gd.make_field()
+        x, y, z = np.meshgrid(gd.xcoord.ndarray, gd.ycoord.ndarray,
+                              gd.zcoord.ndarray, indexing='ij')
+        gd.view(src, ghost=True)[...] = x ** 2 + 2 * y ** 2 + 3 * z ** 2
+
+        offsets = np.array([(0, 0, 0), (1, 0, 0), (-1, 0, 0), (0, 1, 0),
+                            (0, -1, 0), (0, 0, 1), (0, 0, -1)])
+        weights = np.array([-6, 1, 1, 1, 1, 1, 1], dtype='float64')
+        gd.apply_stencil(src, dst, offsets, weights)
+        # The discrete Laplacian of the quadratic is exact.
+        self.assertEqual([12.0], np.unique(gd.view(dst)).tolist())
+
 # vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -201,6 +201,50 @@ class StaticMeshTC(unittest.TestCase):
                           nbound=4, ngstnode=4, ngstface=12, ngstcell=4,
                           nedge=6)
 
+    def test_3d_boundary_normal(self):
+        def _check(mh):
+            mh.build_interior()
+            mh.build_boundary()
+            mh.build_ghost()
+            ngf, ngc = mh.ngstface, mh.ngstcell
+            fcnml = mh.fcnml.ndarray
+            fccnd = mh.fccnd.ndarray
+            fcara = mh.fcara.ndarray
+            clcnd = mh.clcnd.ndarray
+            fccls = mh.fccls.ndarray
+            # Ghost faces are stored ahead of the interior ones (row = ifc +
+            # ngstface); so are the ghost cells.
+            for row in range(ngf + mh.nface):
+                nml = fcnml[row]
+                self.assertAlmostEqual(1.0, np.linalg.norm(nml))
+                outward = fccnd[row] - clcnd[fccls[row, 0] + ngc]
+                self.assertGreater(np.dot(nml, outward), 0)
+            # Each ghost cell mirrors the only interior cell, so both have the
+            # same face areas.
+            clfcs = mh.clfcs.ndarray
+            nfc = clfcs[ngc, 0]
+            golden = sorted(fcara[clfcs[ngc, 1:nfc + 1] + ngf])
+            for row in range(ngc):
+                self.assertEqual(nfc, clfcs[row, 0])
+                np.testing.assert_almost_equal(
+                    golden, sorted(fcara[clfcs[row, 1:nfc + 1] + ngf]))
+
+        mh = modmesh.StaticMesh(ndim=3, nnode=8, nface=0, ncell=1)
+        mh.ndcrd.ndarray[:, :] = [(0, 0, 0), (1, 0, 0), (1, 2, 0), (0, 2, 0),
+                                  (0, 0, 3), (1, 0, 3), (1, 2, 3), (0, 2, 3)]
+        mh.cltpn.ndarray[:] = modmesh.StaticMesh.HEXAHEDRON
+        mh.clnds.ndarray[:, :9] = [(8, 0, 1, 2, 3, 4, 5, 6, 7)]
+        _check(mh)
+        # The hexahedron has 6 boundary faces of areas 2, 3 and 6.
+        np.testing.assert_almost_equal(
+            sorted(mh.fcara.ndarray[mh.ngstface:]), [2, 2, 3, 3, 6, 6])
+
+        mh = modmesh.StaticMesh(ndim=3, nnode=4, nface=0, ncell=1)
+        mh.ndcrd.ndarray[:, :] = (0, 0, 0), (0, 1, 0), (-1, 1, 0), (0, 1, 1)
+        mh.cltpn.ndarray[:] = modmesh.StaticMesh.TETRAHEDRON
+        mh.clnds.ndarray[:, :5] = [(4, 0, 1, 2, 3)]
+        _check(mh)
+
     def test_1d_single_line(self):
         mh = modmesh.StaticMesh(ndim=1, nnode=2, nface=0, ncell=1)
         mh.ndcrd.ndarray[:] = [[0], [1]]
@@ -227,4 +271,242 @@ class StaticMeshTC(unittest.TestCase):
         self._check_metric_trivial(mh)
         # TODO: Need to add build_boundary and build_ghost to make sure
         #       Line type behavior.
+
+    def test_2d_refill_ghost(self):
+        def _make(ndcrd):
+            mh = modmesh.StaticMesh(ndim=2, nnode=4, nface=0, ncell=3)
+            mh.ndcrd.ndarray[:, :] = ndcrd
+            mh.cltpn.ndarray[:] = modmesh.StaticMesh.TRIANGLE
+            mh.clnds.ndarray[:, :4] = (3, 0, 1, 2), (3, 0, 2, 3), (3, 0, 3, 1)
+            mh.build_interior()
+            mh.build_boundary()
+            mh.build_ghost()
+            return mh
+
+        ndcrd = np.array([(0, 0), (-1, -1), (1, -1), (0, 1)], dtype='float64')
+        moved = ndcrd * 1.5 + [0.1, -0.2]
+        mh = _make(ndcrd)
+        clnds = mh.clnds.ndarray.copy()
+        mh.ndcrd.ndarray[mh.ngstnode:, :] = moved
+        mh.refill_ghost()
+        golden = _make(moved)
+
+        # Connectivity is kept while coordinates and metric are updated.
+        self.assertEqual(clnds.tolist(), mh.clnds.ndarray.tolist())
+        for name in ("ndcrd", "fccnd", "fcnml", "fcara", "clcnd", "clvol"):
+            np.testing.assert_almost_equal(
+                getattr(golden, name).ndarray, getattr(mh, name).ndarray)
+
+        mh = modmesh.StaticMesh(ndim=2, nnode=4, nface=0, ncell=3)
+        with self.assertRaisesRegex(RuntimeError, "ghost data is not built"):
+            mh.refill_ghost()
+
+    def test_2d_csr_connectivity(self):
+        mh = modmesh.StaticMesh(ndim=2, nnode=4, nface=0, ncell=3)
+        mh.ndcrd.ndarray[:, :] = (0, 0), (-1, -1), (1, -1), (0, 1)
+        mh.cltpn.ndarray[:] = modmesh.StaticMesh.TRIANGLE
+        mh.clnds.ndarray[:, :4] = (3, 0, 1, 2), (3, 0, 2, 3), (3, 0, 3, 1)
+        mh.build_interior()
+        mh.build_boundary()
+        mh.build_ghost()
+        mh.build_csr()
+
+        clnds = mh.clnds.ndarray
+        csr = mh.clnds_csr
+        self.assertEqual(3, csr.nghost)
+        self.assertEqual(3, csr.nbody)
+        self.assertEqual(6, csr.nrow)
+        self.assertEqual(18, csr.nnz)
+        self.assertEqual(3, csr.max_size)
+        self.assertEqual(list(range(0, 19, 3)), list(csr.offsets.ndarray))
+        for irow in range(-csr.nghost, csr.nbody):
+            self.assertEqual(3, csr.size(irow))
+            self.assertEqual(
+                list(clnds[irow + csr.nghost, 1:4]),
+                list(csr.row(irow).ndarray))
+        with self.assertRaisesRegex(IndexError, "row 3 is out of range"):
+            csr.row(3)
+
+        # Compressed tables are smaller than the padded ones.
+        for name in ("fcnds", "clnds", "clfcs"):
+            self.assertLess(getattr(mh, name + "_csr").nbytes,
+                            getattr(mh, name).nbytes)
+
+        # Round trip.
+        clfcs = mh.clfcs.ndarray.copy()
+        fcnds = mh.fcnds.ndarray.copy()
+        mh.expand_csr()
+        self.assertEqual(clfcs.tolist(), mh.clfcs.ndarray.tolist())
+        self.assertEqual(fcnds.tolist(), mh.fcnds.ndarray.tolist())
+
+        # Drop the padded tables and keep only the compressed ones.
+        clnds = mh.clnds.ndarray.copy()
+        mh.build_csr(drop_padded=True)
+        self.assertFalse(mh.has_padded_connectivity)
+        self.assertEqual(6, mh.clnds_csr.nrow)
+        with self.assertRaisesRegex(RuntimeError, "padded connectivity is"):
+            mh.build_node_cells()
+        with self.assertRaisesRegex(RuntimeError, "padded connectivity is"):
+            mh.build_csr()
+        for name in ("fcnds", "clnds", "clfcs"):
+            with self.assertRaisesRegex(RuntimeError,
+                                        "StaticMesh::" + name + ": padded"):
+                getattr(mh, name)
+        mh.expand_csr()
+        self.assertTrue(mh.has_padded_connectivity)
+        self.assertEqual(clnds.tolist(), mh.clnds.ndarray.tolist())
+        self.assertEqual(clfcs.tolist(), mh.clfcs.ndarray.tolist())
+        self.assertEqual([0, 1, 2], list(mh.build_node_cells().row(0).ndarray))
+
+
+    def test_2d_adjacency(self):
+        mh = modmesh.StaticMesh(ndim=2, nnode=4, nface=0, ncell=3)
+        mh.ndcrd.ndarray[:, :] = (0, 0), (-1, -1), (1, -1), (0, 1)
+        mh.cltpn.ndarray[:] = modmesh.StaticMesh.TRIANGLE
+        mh.clnds.ndarray[:, :4] = (3, 0, 1, 2), (3, 0, 2, 3), (3, 0, 3, 1)
+        mh.build_interior()
+        mh.build_boundary()
+
+        self.assertFalse(mh.has_node_cells)
+        ndcls = mh.build_node_cells()
+        self.assertTrue(mh.has_node_cells)
+        self.assertEqual(4, ndcls.nrow)
+        self.assertEqual([0, 1, 2], list(ndcls.row(0).ndarray))
+        self.assertEqual([0, 2], list(ndcls.row(1).ndarray))
+        self.assertEqual([0, 1], list(ndcls.row(2).ndarray))
+        self.assertEqual([1, 2], list(ndcls.row(3).ndarray))
+
+        # Without ghost cells the boundary faces have no neighbor.
+        clcls = mh.build_cell_neighbors()
+        self.assertEqual(3, clcls.nrow)
+        for icl in range(3):
+            self.assertEqual(2, clcls.size(icl))
+            self.assertEqual(
+                sorted(set(range(3)) - {icl}),
+                sorted(clcls.row(icl).ndarray))
+
+        ndnds = mh.build_node_neighbors()
+        self.assertEqual([1, 2, 3], list(ndnds.row(0).ndarray))
+        self.assertEqual([0, 2, 3], list(ndnds.row(1).ndarray))
+        self.assertEqual(2 * mh.nedge, ndnds.nnz)
+
+        # Building ghost cells invalidates the cache.
+        mh.build_ghost()
+        self.assertFalse(mh.has_node_cells)
+        self.assertFalse(mh.has_cell_neighbors)
+        self.assertFalse(mh.has_node_neighbors)
+        clcls = mh.build_cell_neighbors()
+        self.assertEqual(9, clcls.nnz)
+        self.assertEqual(
+            [-1, -2, -3],
+            sorted(v for v in clcls.indices.ndarray if v < 0))
+        mh.invalidate_adjacency()
+        self.assertFalse(mh.has_cell_neighbors)
+
+    def test_2d_type_cells(self):
+        mh = modmesh.StaticMesh(ndim=2, nnode=6, nface=0, ncell=3)
+        mh.ndcrd.ndarray[:, :] = (
+            (0, 0), (1, 0), (2, 0), (0, 1), (1, 1), (2, 1.5))
+        mh.cltpn.ndarray[:] = (modmesh.StaticMesh.TRIANGLE,
+                               modmesh.StaticMesh.QUADRILATERAL,
+                               modmesh.StaticMesh.TRIANGLE)
+        mh.clnds.ndarray[:, :5] = (
+            (3, 0, 1, 3, -1), (4, 1, 2, 5, 4), (3, 1, 4, 3, -1))
+        mh.build_interior()
+
+        # Calculating the metric groups the cells by type.
+        self.assertTrue(mh.has_type_cells)
+        tpcls = mh.build_type_cells()
+        self.assertEqual(modmesh.StaticMesh.PYRAMID + 1, tpcls.nrow)
+        self.assertEqual(3, tpcls.nnz)
+        self.assertEqual(
+            [1], list(tpcls.row(modmesh.StaticMesh.QUADRILATERAL).ndarray))
+        self.assertEqual(
+            [0, 2], list(tpcls.row(modmesh.StaticMesh.TRIANGLE).ndarray))
+        self.assertEqual(0, tpcls.size(modmesh.StaticMesh.TETRAHEDRON))
+
+        # The centroid of the triangle.
+        np.testing.assert_almost_equal(mh.clcnd.ndarray[0], (1 / 3, 1 / 3))
+        mh.invalidate_adjacency()
+        self.assertFalse(mh.has_type_cells)
+
+        # A cell of an unknown type is in no row.
+        mh.cltpn.ndarray[1] = 99
+        tpcls = mh.build_type_cells()
+        self.assertEqual(2, tpcls.nnz)
+        self.assertEqual(0, tpcls.size(modmesh.StaticMesh.QUADRILATERAL))
+        self.assertEqual(
+            [0, 2], list(tpcls.row(modmesh.StaticMesh.TRIANGLE).ndarray))
+
+
+class CompressedConnectivityTC(unittest.TestCase):
+
+    def test_from_to_padded(self):
+        narr = np.array([[2, 0, 1, -1], [3, 2, 3, 4], [1, 5, -1, -1]],
+                        dtype='int32')
+        padded = modmesh.SimpleArrayInt32(array=narr)
+        csr = modmesh.CompressedConnectivity.from_padded(padded)
+        self.assertEqual(0, csr.nghost)
+        self.assertEqual(3, csr.nrow)
+        self.assertEqual(6, csr.nnz)
+        self.assertEqual([0, 2, 5, 6], list(csr.offsets.ndarray))
+        self.assertEqual([0, 1, 2, 3, 4, 5], list(csr.indices.ndarray))
+        self.assertEqual([2, 3, 4], list(csr.row(1).ndarray))
+        self.assertEqual(narr.tolist(), csr.to_padded(4).ndarray.tolist())
+        self.assertEqual([[2, 0, 1, -1, -1], [3, 2, 3, 4, -1],
+                          [1, 5, -1, -1, -1]],
+                         csr.to_padded(5).ndarray.tolist())
+        with self.assertRaisesRegex(IndexError, "cannot pad rows of 3"):
+            csr.to_padded(3)
+
+    def test_construct(self):
+        offsets = modmesh.SimpleArrayInt32(
+            array=np.array([0, 1, 3], dtype='int32'))
+        indices = modmesh.SimpleArrayInt32(
+            array=np.array([7, 8, 9], dtype='int32'))
+        csr = modmesh.CompressedConnectivity(offsets=offsets, indices=indices)
+        self.assertEqual(2, len(csr))
+        self.assertEqual(2, csr.size(1))
+        self.assertEqual([8, 9], list(csr.row(1).ndarray))
+
+        bad = modmesh.SimpleArrayInt32(array=np.array([0, 2], dtype='int32'))
+        with self.assertRaisesRegex(ValueError, "last offset 2"):
+            modmesh.CompressedConnectivity(offsets=bad, indices=indices)
+
+
+class StaticMeshBVHTC(unittest.TestCase):
+
+    def _make_mesh(self):
+        mh = modmesh.StaticMesh(ndim=2, nnode=4, nface=0, ncell=3)
+        mh.ndcrd.ndarray[:, :] = (0, 0), (-1, -1), (1, -1), (0, 1)
+        mh.cltpn.ndarray[:] = modmesh.StaticMesh.TRIANGLE
+        mh.clnds.ndarray[:, :4] = (3, 0, 1, 2), (3, 0, 2, 3), (3, 0, 3, 1)
+        mh.build_interior()
+        return mh
+
+    def test_locate_points(self):
+        mh = self._make_mesh()
+        bvh = modmesh.StaticMeshBVH(mh)
+        self.assertIs(mh, bvh.mesh)
+        self.assertGreaterEqual(bvh.nnode, 1)
+        points = modmesh.SimpleArrayFloat64(array=np.array(
+            [(0, -0.5), (0.3, 0.2), (-0.3, 0.2), (2, 2)], dtype='float64'))
+        self.assertEqual([0, 1, 2, -1],
+                         list(bvh.locate_points(points).ndarray))
+
+    def test_nearest_cells(self):
+        mh = self._make_mesh()
+        bvh = modmesh.StaticMeshBVH(mh)
+        points = modmesh.SimpleArrayFloat64(array=np.array(
+            [(0, -2), (2, 2), (-2, 0.1)], dtype='float64'))
+        self.assertEqual([0, 1, 2], list(bvh.nearest_cells(points).ndarray))
+
+    def test_bad_points(self):
+        bvh = modmesh.StaticMeshBVH(self._make_mesh())
+        points = modmesh.SimpleArrayFloat64(
+            array=np.zeros((2, 3), dtype='float64'))
+        with self.assertRaisesRegex(ValueError, r"\(npoint, 2\)"):
+            bvh.locate_points(points)
+
+
 # vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
@@ -0,0 +1,99 @@
+# Copyright (c) 2024, Yung-Yu Chen <yyc@solvcon.net>
+# BSD 3-Clause License, see COPYING
+
+import unittest
+
+import numpy as np
+
+from modmesh.onedim import euler1d
+
+_impl = euler1d._impl
+
+
+class Conservation1DCoreTC(unittest.TestCase):
+
+    @staticmethod
+    def _build(core_type, ncoord, time_increment, so0, **constants):
+        core = core_type(ncoord=ncoord, time_increment=time_increment)
+        for name, value in constants.items():
+            setattr(core, name, value)
+        core.coord[...] = np.linspace(-1, 1, num=ncoord)
+        core.so0[...] = so0
+        core.so1.fill(0)
+        core.cfl.fill(0)
+        core.setup_march()
+        return core
+
+    def test_nvar(self):
+        self.assertEqual(3, _impl.GenericEuler1DCore.nvar)
+        self.assertEqual(2, _impl.IsothermalEuler1DCore.nvar)
+        self.assertEqual(2, _impl.ShallowWater1DCore.nvar)
+
+    def test_policy_property(self):
+        core = _impl.ShallowWater1DCore(ncoord=21, time_increment=0.01)
+        self.assertEqual(9.80665, core.gravity)
+        core.gravity = 1.0
+        self.assertEqual(1.0, core.clone().gravity)
+
+        core = _impl.IsothermalEuler1DCore(ncoord=21, time_increment=0.01)
+        self.assertEqual(1.0, core.sound_speed)
+
+        core = _impl.GenericEuler1DCore(ncoord=21, time_increment=0.01)
+        self.assertEqual(1.4, core.gamma)
+
+    def test_generic_euler(self):
+        st = euler1d.ShockTube()
+        st.build_constant(gamma=1.4, pressure1=1.0, density1=1.0,
+                          pressure5=0.1, density5=0.125)
+        st.build_numerical(xmin=-1, xmax=1, ncoord=201,
+                           time_increment=0.001)
+        svr = st.svr
+        svr.setup_march()
+
+        core = _impl.GenericEuler1DCore(ncoord=201, time_increment=0.001)
+        core.coord[...] = svr.coord
+        core.so0[...] = svr.so0
+        core.so1[...] = svr.so1
+        core.setup_march()
+
+        svr.march_alpha2(steps=50)
+        core.march_alpha2(steps=50)
+        # The generic kernel takes the same arithmetic as the hand-written
+        # one.
+        self.assertEqual(svr.so0.tolist(), core.so0.tolist())
+        self.assertEqual(svr.so1.tolist(), core.so1.tolist())
+        self.assertEqual(svr.max_cfl, core.max_cfl)
+
+    def test_shallow_water_dam_break(self):
+        ncoord = 201
+        so0 = np.zeros((ncoord, 2), dtype='float64')
+        so0[:, 0] = np.where(np.arange(ncoord) < ncoord // 2, 2.0, 1.0)
+        core = self._build(_impl.ShallowWater1DCore, ncoord, 0.001, so0)
+        mass = so0[2:-2:2, 0].sum()
+
+        core.march_alpha2(steps=20)
+        self.assertEqual(20, core.nstep)
+        self.assertAlmostEqual(mass, core.so0[2:-2:2, 0].sum(), places=10)
+        # The depth stays between the two initial states.
+        depth = core.so0[2:-2:2, 0]
+        self.assertTrue((depth > 1.0 - 1.e-6).all())
+        self.assertTrue((depth < 2.0 + 1.e-6).all())
+        # The dam-break flow goes to the shallow side.
+        self.assertTrue((core.so0[2:-2:2, 1] > -1.e-6).all())
+        self.assertGreater(core.max_cfl, 0)
+
+    def test_isothermal_euler_symmetry(self):
+        ncoord = 201
+        so0 = np.zeros((ncoord, 2), dtype='float64')
+        so0[:, 0] = 1.0
+        so0[ncoord // 2 - 10:ncoord // 2 + 11, 0] = 2.0
+        core = self._build(_impl.IsothermalEuler1DCore, ncoord, 0.002, so0,
+                           sound_speed=0.5)
+
+        core.march_alpha2(steps=20)
+        density = core.so0[:, 0]
+        momentum = core.so0[:, 1]
+        np.testing.assert_allclose(density, density[::-1], atol=1.e-12)
+        np.testing.assert_allclose(momentum, -momentum[::-1], atol=1.e-12)
+
+# vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
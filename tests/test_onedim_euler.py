@@ -1,10 +1,13 @@
 # Copyright (c) 2018, Yung-Yu Chen <yyc@solvcon.net>
 # BSD 3-Clause License, see COPYING
 
+import os
+import tempfile
 import unittest
 
 import numpy as np
 
+import modmesh
 from modmesh.onedim import euler1d
 
 
@@ -70,6 +73,366 @@ class Euler1DSolverTC(unittest.TestCase):
             svr2.march_alpha2(steps=1)
             self.assertEqual(self.svr.so0.tolist(), svr2.so0.tolist())
 
+    def test_march_adaptive(self):
+        st = euler1d.ShockTube()
+        st.build_constant(gamma=1.4, pressure1=1.0, density1=1.0,
+                          pressure5=0.1, density5=0.125)
+        st.build_numerical(xmin=-1, xmax=1, ncoord=201,
+                           time_increment=0.001)
+        svr = st.svr
+        svr.setup_march()
+        self.assertEqual(0.0, svr.time)
+        nstep = svr.march_alpha2_adaptive(time_stop=0.4, target_cfl=0.8,
+                                          dt_min=1.e-5, dt_max=0.01)
+        self.assertEqual(0.4, svr.time)
+        hist = svr.time_history
+        self.assertEqual((nstep, 3), hist.shape)
+        self.assertEqual(0.4, hist[-1, 0])
+        np.testing.assert_allclose(hist[:, 1].sum(), 0.4)
+        self.assertTrue((hist[:, 1] <= 0.01).all())
+        # Far fewer steps than the fixed initial time increment.
+        self.assertLess(nstep, 100)
+        # The time increment follows the target CFL after the start.
+        np.testing.assert_allclose(hist[10:-2, 2], 0.8, rtol=0.1)
+        svr.clear_time_history()
+        self.assertEqual((0, 3), svr.time_history.shape)
+        with self.assertRaisesRegex(ValueError, "target_cfl"):
+            svr.march_alpha2_adaptive(time_stop=1, target_cfl=0,
+                                      dt_min=1.e-5, dt_max=0.01)
+
+    def test_march_adaptive_oversized(self):
+        st = euler1d.ShockTube()
+        st.build_constant(gamma=1.4, pressure1=1.0, density1=1.0,
+                          pressure5=0.1, density5=0.125)
+        st.build_numerical(xmin=-1, xmax=1, ncoord=201,
+                           time_increment=0.05)
+        svr = st.svr
+        svr.setup_march()
+        svr.march_alpha2_adaptive(time_stop=0.1, target_cfl=0.8,
+                                  dt_min=1.e-5, dt_max=0.1)
+        hist = svr.time_history
+        # The first time increment is shrunk before marching, so that the
+        # CFL number of the initial condition is the target.  The fastest
+        # wave is the sound of the left state at rest.
+        dx = 0.01
+        np.testing.assert_allclose(hist[0, 1], 2 * 0.8 * dx / np.sqrt(1.4))
+        np.testing.assert_allclose(hist[1:-2, 2], 0.8, rtol=0.05)
+
+    def test_march_threaded(self):
+        def _march(nthread):
+            st = euler1d.ShockTube()
+            st.build_constant(gamma=1.4, pressure1=1.0, density1=1.0,
+                              pressure5=0.1, density5=0.125)
+            st.build_numerical(xmin=-1, xmax=1, ncoord=20001,
+                               time_increment=2.e-5)
+            svr = st.svr
+            svr.setup_march()
+            modmesh.thread_pool.nthread = nthread
+            svr.march_alpha2(steps=200)
+            return svr
+
+        pool = modmesh.thread_pool
+        nthread = pool.nthread
+        try:
+            svr1 = _march(1)
+            svr4 = _march(4)
+        finally:
+            pool.nthread = nthread
+        # Threads do not change the result.
+        self.assertEqual(svr1.so0.tolist(), svr4.so0.tolist())
+        self.assertEqual(svr1.so1.tolist(), svr4.so1.tolist())
+        self.assertEqual(svr1.cfl.tolist(), svr4.cfl.tolist())
+        self.assertEqual(svr1.max_cfl, svr4.max_cfl)
+
+    def test_clone(self):
+        st = euler1d.ShockTube()
+        st.build_constant(gamma=1.4, pressure1=1.0, density1=1.0,
+                          pressure5=0.1, density5=0.125)
+        st.build_numerical(xmin=-1, xmax=1, ncoord=201,
+                           time_increment=0.002)
+        svr = st.svr
+        svr.setup_march()
+        svr.march_alpha2(steps=20)
+        so0 = svr.so0.copy()
+
+        # The clone shares all arrays until written.
+        clone = svr.clone()
+        shared = ['coord', 'cfl', 'so0', 'so1', 'gamma']
+        self.assertEqual(shared, svr.shared_arrays)
+        self.assertEqual(shared, clone.shared_arrays)
+
+        # Marching the clone copies the solution but not the grid.
+        clone.march_alpha2(steps=10)
+        self.assertEqual(['coord', 'gamma'], clone.shared_arrays)
+        self.assertEqual(['coord', 'gamma'], svr.shared_arrays)
+        self.assertEqual(so0.tolist(), svr.so0.tolist())
+        svr.march_alpha2(steps=10)
+        self.assertEqual(svr.so0.tolist(), clone.so0.tolist())
+        self.assertEqual(svr.so1.tolist(), clone.so1.tolist())
+
+        # Taking an array from the clone for writing copies it.
+        clone.gamma.fill(1.2)
+        self.assertEqual(['coord'], clone.shared_arrays)
+        self.assertEqual([1.4], np.unique(svr.gamma).tolist())
+
+    def test_primitives(self):
+        st = euler1d.ShockTube()
+        st.build_constant(gamma=1.4, pressure1=1.0, density1=1.0,
+                          pressure5=0.1, density5=0.125)
+        st.build_numerical(xmin=-1, xmax=1, ncoord=201,
+                           time_increment=0.001)
+        svr = st.svr
+        svr.setup_march()
+        svr.march_alpha2(steps=50)
+
+        prims = svr.primitives()
+        self.assertEqual(
+            ['density', 'velocity', 'pressure', 'temperature',
+             'internal_energy', 'entropy'],
+            euler1d._impl.Euler1DPrimitives.fields)
+        for name in euler1d._impl.Euler1DPrimitives.fields:
+            np.testing.assert_allclose(getattr(prims, name),
+                                       getattr(svr, name), rtol=1.e-14)
+        # The buffers are reused.
+        density = prims.density
+        svr.march_alpha2(steps=1)
+        self.assertIs(prims, svr.primitives())
+        self.assertTrue(np.shares_memory(density, prims.density))
+        np.testing.assert_allclose(density, svr.density, rtol=1.e-14)
+
+        # Only the requested fields are computed.
+        part = euler1d._impl.Euler1DPrimitives(ncoord=svr.ncoord,
+                                               fields=['pressure'])
+        self.assertIs(part, svr.primitives(part))
+        self.assertIsNone(part.density)
+        np.testing.assert_allclose(part.pressure, svr.pressure,
+                                   rtol=1.e-14)
+
+        with self.assertRaisesRegex(ValueError, "unknown field"):
+            euler1d._impl.Euler1DPrimitives(ncoord=3, fields=['mach'])
+        with self.assertRaisesRegex(ValueError, "ncoord is 201"):
+            svr.primitives(euler1d._impl.Euler1DPrimitives(ncoord=3))
+
+    def test_update_metric(self):
+        def _build(scale):
+            st = euler1d.ShockTube()
+            st.build_constant(gamma=1.4, pressure1=1.0, density1=1.0,
+                              pressure5=0.1, density5=0.125)
+            # The diaphragm sits between the same two grid points.
+            st.build_numerical(xmin=-scale, xmax=scale, ncoord=201,
+                               time_increment=0.001,
+                               xdiaphragm=-0.005 * scale)
+            st.svr.setup_march()
+            return st.svr
+
+        svr = _build(scale=1)
+        # Stretch the grid after setup_march().
+        svr.coord[...] = np.linspace(-2, 2, num=201)
+        svr.update_metric()
+        svr.march_alpha2(steps=20)
+        svr2 = _build(scale=2)
+        svr2.march_alpha2(steps=20)
+        self.assertEqual(svr2.so0.tolist(), svr.so0.tolist())
+        self.assertEqual(svr2.so1.tolist(), svr.so1.tolist())
+
+        # Writing the coordinates marks the metric to be recomputed at the
+        # next march without update_metric().
+        svr = _build(scale=1)
+        svr.coord[...] = np.linspace(-2, 2, num=201)
+        svr.march_alpha2(steps=20)
+        self.assertEqual(svr2.so0.tolist(), svr.so0.tolist())
+        self.assertEqual(svr2.so1.tolist(), svr.so1.tolist())
+
+        # A view of the coordinates kept across a march is picked up too.
+        svr = _build(scale=1)
+        coord = svr.coord
+        svr.march_alpha2(steps=1)
+        svr3 = _build(scale=1)
+        svr3.march_alpha2(steps=1)
+        coord[...] = np.linspace(-2, 2, num=201)
+        svr3.coord[...] = np.linspace(-2, 2, num=201)
+        svr.march_alpha2(steps=19)
+        svr3.march_alpha2(steps=19)
+        self.assertEqual(svr3.so0.tolist(), svr.so0.tolist())
+        self.assertEqual(svr3.so1.tolist(), svr.so1.tolist())
+
+    def test_float32(self):
+        def _march(dtype):
+            st = euler1d.ShockTube()
+            st.build_constant(gamma=1.4, pressure1=1.0, density1=1.0,
+                              pressure5=0.1, density5=0.125)
+            st.build_numerical(xmin=-1, xmax=1, ncoord=201,
+                               time_increment=0.001, dtype=dtype)
+            svr = st.svr
+            svr.setup_march()
+            svr.march_alpha2(steps=50)
+            return svr
+
+        svr64 = _march('float64')
+        svr32 = _march(np.float32)
+        self.assertIs(euler1d._impl.Euler1DCore,
+                      euler1d._impl.Euler1DCoreFp64)
+        self.assertIsInstance(svr32._core, euler1d._impl.Euler1DCoreFp32)
+        for name in ('so0', 'so1', 'cfl', 'gamma'):
+            self.assertEqual(np.float32, getattr(svr32, name).dtype)
+        self.assertEqual(np.float64, svr32.coord.dtype)
+        self.assertEqual(np.float64, svr32.density.dtype)
+        np.testing.assert_allclose(svr32.density, svr64.density,
+                                   rtol=1.e-5)
+        np.testing.assert_allclose(svr32.pressure, svr64.pressure,
+                                   rtol=1.e-5)
+        self.assertAlmostEqual(svr32.max_cfl, svr64.max_cfl, places=5)
+
+        with tempfile.TemporaryDirectory() as tmpdir:
+            path = os.path.join(tmpdir, "euler1d32.ckpt")
+            svr32.save_checkpoint(path)
+            core = euler1d._impl.Euler1DCoreFp32(ncoord=3, time_increment=1)
+            core.load_checkpoint(path)
+            np.testing.assert_equal(core.so0, svr32.so0)
+
+        with self.assertRaisesRegex(ValueError, "not supported"):
+            euler1d.Euler1DSolver(-1, 1, 21, dtype='int32')
+
+    def test_checkpoint(self):
+        st = euler1d.ShockTube()
+        st.build_constant(gamma=1.4, pressure1=1.0, density1=1.0,
+                          pressure5=0.1, density5=0.125)
+        st.build_numerical(xmin=-1, xmax=1, ncoord=201,
+                           time_increment=0.002)
+        svr = st.svr
+        svr.setup_march()
+        svr.march_alpha2(steps=20)
+        self.assertEqual(20, svr.nstep)
+        with tempfile.TemporaryDirectory() as tmpdir:
+            path = os.path.join(tmpdir, "euler1d.ckpt")
+            svr.save_checkpoint(path)
+            path32 = os.path.join(tmpdir, "euler1d32.ckpt")
+            svr.save_checkpoint(path32, float32=True)
+            self.assertLess(os.path.getsize(path32), os.path.getsize(path))
+            so0 = svr.so0.copy()
+            svr.march_alpha2(steps=10)
+
+            # Restart into a core of a different size.
+            core = euler1d._impl.Euler1DCore(ncoord=3, time_increment=1)
+            core.load_checkpoint(path)
+            self.assertEqual(201, core.ncoord)
+            self.assertEqual(20, core.nstep)
+            self.assertAlmostEqual(0.04, core.time)
+            self.assertEqual(0.002, core.time_increment)
+            np.testing.assert_equal(core.so0, so0)
+            core.march_alpha2(steps=10)
+            self.assertEqual(30, core.nstep)
+            np.testing.assert_equal(core.so0, svr.so0)
+            np.testing.assert_equal(core.so1, svr.so1)
+
+            core.load_checkpoint(path32)
+            np.testing.assert_allclose(core.so0, so0, rtol=1.e-7)
+
+            with open(path, "r+b") as fobj:
+                fobj.seek(-16, os.SEEK_END)
+                fobj.write(b"\x7f")
+            with self.assertRaisesRegex(RuntimeError, "checksum mismatch"):
+                core.load_checkpoint(path)
+
+    def test_snapshot(self):
+        st = euler1d.ShockTube()
+        st.build_constant(gamma=1.4, pressure1=1.0, density1=1.0,
+                          pressure5=0.1, density5=0.125)
+        st.build_numerical(xmin=-1, xmax=1, ncoord=201,
+                           time_increment=0.002)
+        svr = st.svr
+        svr.setup_march()
+        with tempfile.TemporaryDirectory() as tmpdir:
+            path = os.path.join(tmpdir, "euler1d.snap")
+            writer = modmesh.SnapshotWriter(path)
+            with self.assertRaisesRegex(ValueError, "unknown field"):
+                svr.set_snapshot(writer, 5, ["density", "nothing"])
+            svr.set_snapshot(writer, 5, ["density", "pressure"])
+            # A clone does not push to the writer of the origin.
+            clone = svr.clone()
+            self.assertIsNone(clone.snapshot_writer)
+            clone.march_alpha2(steps=10)
+            self.assertEqual(0, writer.npushed)
+            density = []
+            for it in range(4):
+                svr.march_alpha2(steps=5)
+                density.append(svr.density.copy())
+            svr.clear_snapshot()
+            svr.march_alpha2(steps=5)
+            writer.close()
+            self.assertEqual(4, writer.nwritten)
+
+            reader = modmesh.SnapshotReader(path)
+            self.assertEqual(4, reader.nframe)
+            for it in range(4):
+                self.assertEqual("onedim::Euler1DCore", reader.kind(it))
+                self.assertEqual(5 * (it + 1), reader.integer(it, "nstep"))
+                self.assertFalse(reader.has(it, "so0"))
+                np.testing.assert_equal(reader.array(it, "density"),
+                                        density[it])
+            with self.assertRaises(IndexError):
+                reader.kind(4)
+
+
+class Euler1DEnsembleTC(unittest.TestCase):
+
+    @staticmethod
+    def _build_shocktube(pressure5, time_increment):
+        st = euler1d.ShockTube()
+        st.build_constant(gamma=1.4, pressure1=1.0, density1=1.0,
+                          pressure5=pressure5, density5=0.125)
+        st.build_numerical(xmin=-1, xmax=1, ncoord=41,
+                           time_increment=time_increment)
+        return st.svr._core
+
+    def setUp(self):
+        self.cores = [
+            self._build_shocktube(pressure5=0.1, time_increment=0.01),
+            self._build_shocktube(pressure5=0.2, time_increment=0.005),
+            self._build_shocktube(pressure5=0.4, time_increment=0.008),
+        ]
+        self.ens = euler1d._impl.Euler1DEnsemble(
+            core=self.cores[0], nmember=len(self.cores))
+        for it, core in enumerate(self.cores):
+            self.ens.load_member(imember=it, core=core)
+
+    def test_array_getter(self):
+        ens = self.ens
+        self.assertEqual(3, ens.nmember)
+        self.assertEqual((ens.ncoord,), ens.coord.shape)
+        self.assertEqual((3,), ens.time_increment.shape)
+        self.assertEqual((ens.ncoord, 3), ens.cfl.shape)
+        self.assertEqual((ens.ncoord, 3), ens.gamma.shape)
+        self.assertEqual((ens.ncoord, 3, ens.nvar), ens.so0.shape)
+        self.assertEqual((ens.ncoord, 3, ens.nvar), ens.so1.shape)
+        self.assertEqual([0.01, 0.005, 0.008], ens.time_increment.tolist())
+
+    def test_invalid(self):
+        with self.assertRaisesRegex(ValueError, "ncoord cannot be even"):
+            euler1d._impl.Euler1DEnsemble(
+                ncoord=40, nmember=2, time_increment=0.01)
+        with self.assertRaisesRegex(ValueError, "nmember cannot be zero"):
+            euler1d._impl.Euler1DEnsemble(
+                ncoord=41, nmember=0, time_increment=0.01)
+        with self.assertRaises(IndexError):
+            self.ens.extract_member(3)
+
+    def test_march_same_as_core(self):
+        self.ens.setup_march()
+        for core in self.cores:
+            core.setup_march()
+        self.ens.march_alpha2(steps=20)
+        for it, core in enumerate(self.cores):
+            core.march_alpha2(steps=20)
+            self.assertEqual(core.so0.tolist(),
+                             self.ens.so0[:, it, :].tolist())
+            self.assertEqual(core.so1.tolist(),
+                             self.ens.so1[:, it, :].tolist())
+            self.assertEqual(core.cfl.tolist(),
+                             self.ens.cfl[:, it].tolist())
+            member = self.ens.extract_member(it)
+            self.assertEqual(core.density.tolist(), member.density.tolist())
+
 
 class ShockTubeTC(unittest.TestCase):
 
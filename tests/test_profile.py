@@ -142,4 +142,36 @@ class TimeRegistryTC(unittest.TestCase):
             modmesh.time_registry.entry('ConcreteBuffer.clone').time,
             0)
 
+class HotCounterRegistryTC(unittest.TestCase):
+
+    def test_singleton(self):
+
+        self.assertIs(modmesh.hot_counter_registry,
+                      modmesh.HotCounterRegistry.me)
+
+    def test_tick_period(self):
+
+        period = modmesh.HotCounterRegistry.tick_period
+        self.assertGreater(period, 0)
+        # No tick source is slower than a microsecond.
+        self.assertLess(period, 1.e-6)
+
+    def test_clear(self):
+
+        reg = modmesh.hot_counter_registry
+        reg.clear()
+        self.assertEqual(len(reg), len(reg.names))
+        for rec in reg.records:
+            self.assertIn(rec.name, reg.names)
+            self.assertEqual(0, rec.ncall)
+            self.assertEqual(0, rec.nitem)
+            self.assertEqual(0, rec.time)
+        self.assertTrue(reg.report().startswith(" " * 28 + "Counter Name"))
+
+    def test_missing(self):
+
+        with self.assertRaisesRegex(IndexError, "no counter named"):
+            modmesh.hot_counter_registry.record("no such counter")
+
+
 # vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
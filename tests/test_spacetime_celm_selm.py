@@ -257,6 +257,25 @@ class SelmTC(unittest.TestCase):
         ):
             se10d.move_pos()
 
+    def test_move_solution(self):
+
+        # The solution accessors follow the element when it moves.
+        self.sol10.set_so0(0, np.arange(11, dtype='float64'))
+        se = self.se0.dup
+        self.assertEqual(0, se.get_so0(0))
+        se.move_right()
+        self.assertEqual(1, se.get_so0(0))
+        se.move_right().move_right()
+        self.assertEqual(3, se.get_so0(0))
+        se.set_so0(0, 30)
+        se.set_cfl(0.3)
+        self.assertEqual(30, self.sol10.selm(3).get_so0(0))
+        self.assertEqual(0.3, self.sol10.selm(3).get_cfl())
+        # The SEs of a CE share the solution with the ones from the solver.
+        ce = self.sol10.celm(2)
+        self.assertEqual(2, ce.selm_xn.get_so0(0))
+        self.assertEqual(30, ce.selm_xp.get_so0(0))
+
 
 class NonUniformTC(unittest.TestCase):
 
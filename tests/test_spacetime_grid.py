@@ -70,6 +70,46 @@ class GridTC(unittest.TestCase):
         self.grid10.xcoord.ndarray.fill(10)
         self.assertEqual([10]*nx, self.grid10.xcoord.ndarray.tolist())
 
+    def test_selm_metric(self):
+
+        x = self.grid10.xcoord.ndarray.copy()
+        metric = self.grid10.selm_metric.ndarray
+        self.assertEqual((3, len(x)), metric.shape)
+        self.assertEqual((x[1:-1] - x[:-2]).tolist(), metric[0, 1:-1].tolist())
+        self.assertEqual((x[2:] - x[1:-1]).tolist(), metric[1, 1:-1].tolist())
+        self.assertEqual(((x[:-2] + x[2:]) / 2).tolist(),
+                         metric[2, 1:-1].tolist())
+        self.assertEqual([0, 0, 0], metric[:, 0].tolist())
+        self.assertEqual([0, 0, 0], metric[:, -1].tolist())
+
+        # The metric follows the coordinates after update_metric().
+        self.grid10.xcoord.ndarray[...] = x * 2
+        self.grid10.update_metric()
+        metric = self.grid10.selm_metric.ndarray
+        self.assertEqual((x[2:] - x[1:-1]).tolist(),
+                         (metric[1, 1:-1] / 2).tolist())
+
+        # Writing xcoord marks the metric to be recomputed at the next march
+        # of a solver on the grid.
+        svr = libst.LinearScalarSolver(grid=self.grid10, time_increment=0.1)
+        self.grid10.xcoord.ndarray[...] = x * 4
+        svr.setup_march()
+        self.assertEqual((x[2:] - x[1:-1]).tolist(),
+                         (metric[1, 1:-1] / 4).tolist())
+
+        # A view of xcoord kept across a march is picked up by the geometric
+        # accessors without another march.
+        xview = self.grid10.xcoord.ndarray
+        svr.march_alpha2(steps=1)
+        se = svr.selm(3)
+        xctr, dxpos = svr.xctr(), se.dxpos
+        xview[...] = x * 8
+        self.assertEqual((xctr * 2).tolist(), svr.xctr().tolist())
+        self.assertEqual(dxpos * 2, se.dxpos)
+        self.assertEqual((x[2:] - x[1:-1]).tolist(),
+                         (self.grid10.selm_metric.ndarray[1, 1:-1]
+                          / 8).tolist())
+
     def test_number(self):
 
         self.assertEqual(10, self.grid10.ncelm)
@@ -50,5 +50,27 @@ class InviscidBurgersSolverTC(unittest.TestCase):
             res = self.svr.get_so0(0).ndarray
             self.assertLessEqual(res.max(), 1)
             self.assertGreaterEqual(res.min(), -1)
+    def test_ensemble(self):
+
+        dts = [self.svr.time_increment, 0.5 * self.svr.time_increment]
+        ens = libst.InviscidBurgersEnsemble(members=[
+            libst.InviscidBurgersSolver(grid=self.svr.grid, time_increment=dt)
+            for dt in dts])
+        for im in range(ens.nmember):
+            ens.member(im).set_so0(0, np.sin(self.xcrd))
+            ens.member(im).set_so1(0, np.cos(self.xcrd))
+        ens.setup_march()
+        for it in range(self.nstep):
+            ens.march_alpha2(steps=1)
+            self.svr.march_alpha2(steps=1)
+        self.assertEqual(self.svr.so0.ndarray.tolist(),
+                         ens.member(0).so0.ndarray.tolist())
+        # The member with the smaller time increment is behind.
+        self.assertEqual(self.nstep, ens.member(1).nstep)
+        self.assertAlmostEqual(0.5 * self.svr.time, ens.member(1).time)
+        res = ens.member(1).get_so0(0).ndarray
+        self.assertLessEqual(res.max(), 1)
+        self.assertGreaterEqual(res.min(), -1)
+
 
 # vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4:
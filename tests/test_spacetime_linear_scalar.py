@@ -1,10 +1,13 @@
 # Copyright (c) 2018, Yung-Yu Chen <yyc@solvcon.net>
 # BSD 3-Clause License, see COPYING
 
+import os
+import tempfile
 import unittest
 
 import numpy as np
 
+import modmesh
 from modmesh import spacetime as libst
 
 import math
@@ -135,6 +138,250 @@ class LinearScalarSolverTC(unittest.TestCase):
             self.assertEqual(self.svr.get_so0(0).ndarray.tolist(),
                              svr2.get_so0(0).ndarray.tolist())
 
+    def test_march_threaded(self):
+
+        self.assertTrue(libst.LinearScalarSolver.static_kernel)
+        pool = modmesh.thread_pool
+        nthread = pool.nthread
+        try:
+            pool.nthread = 1
+            nstep, _, svr1 = self._build_solver(10000)
+            svr1.march_alpha2(steps=nstep)
+            pool.nthread = 4
+            svr4 = self._build_solver(10000)[-1]
+            svr4.march_alpha2(steps=nstep)
+        finally:
+            pool.nthread = nthread
+        # Threads do not change the result.
+        self.assertEqual(svr1.so0.ndarray.tolist(), svr4.so0.ndarray.tolist())
+        self.assertEqual(svr1.so1.ndarray.tolist(), svr4.so1.ndarray.tolist())
+        self.assertEqual(svr1.cfl.ndarray.tolist(), svr4.cfl.ndarray.tolist())
+
+    def test_march_blocked(self):
+
+        nstep, _, svr1 = self._build_solver(10000)
+        svr1.march_alpha2(steps=nstep)
+        svr2 = self._build_solver(10000)[-1]
+        svr2.march_alpha2_blocked(steps=nstep, block_steps=3, tile_celm=64)
+        # Temporal blocking does not change the result.
+        self.assertEqual(svr1.so0.ndarray[1:-1].tolist(),
+                         svr2.so0.ndarray[1:-1].tolist())
+        self.assertEqual(svr1.so1.ndarray[1:-1].tolist(),
+                         svr2.so1.ndarray[1:-1].tolist())
+        self.assertEqual(svr1.cfl.ndarray[1:-1].tolist(),
+                         svr2.cfl.ndarray[1:-1].tolist())
+
+        with self.assertRaisesRegex(ValueError, "tile_celm 4 < 2 \\* "):
+            svr2.march_alpha2_blocked(steps=1, block_steps=3, tile_celm=4)
+
+    def test_march_adaptive(self):
+
+        _, _, svr = self._build_solver(100)
+        dx = 2 * np.pi / 100
+        svr.time_increment = dx / 10
+        nstep = svr.march_alpha2_adaptive(time_stop=np.pi, target_cfl=0.9,
+                                          dt_min=dx / 100, dt_max=dx)
+        self.assertEqual(np.pi, svr.time)
+        hist = svr.time_history.ndarray
+        self.assertEqual((nstep, 3), hist.shape)
+        self.assertAlmostEqual(0.1, hist[0, 2])
+        # The wave speed is constant, so one step is enough to hit the
+        # target.
+        np.testing.assert_allclose(hist[1:-2, 2], 0.9)
+        np.testing.assert_allclose(hist[1:-2, 1], 0.9 * dx)
+        self.assertAlmostEqual(svr.max_cfl(odd_plane=False), hist[-1, 2])
+
+        # An oversized initial time increment is shrunk before the first
+        # step.
+        _, _, svr = self._build_solver(100)
+        svr.time_increment = 10 * dx
+        svr.march_alpha2_adaptive(time_stop=np.pi, target_cfl=0.9,
+                                  dt_min=dx / 100, dt_max=10 * dx)
+        hist = svr.time_history.ndarray
+        self.assertAlmostEqual(0.9 * dx, hist[0, 1])
+        np.testing.assert_allclose(hist[:-2, 2], 0.9)
+
+    def test_march_lts(self):
+
+        # One level marches like march_alpha2().
+        _, _, svr1 = self._build_solver(100)
+        _, _, svr2 = self._build_solver(100)
+        svr1.march_alpha2(steps=10)
+        svr2.march_alpha2_lts(steps=10, cfl_limit=1.0)
+        self.assertEqual(0, svr2.lts_level.ndarray.max())
+        self.assertEqual(svr1.time, svr2.time)
+        self.assertEqual(svr1.so0.ndarray[1:-1].tolist(),
+                         svr2.so0.ndarray[1:-1].tolist())
+
+        # Stretched grid: the right half is 4 times finer.
+        xcrd = np.concatenate([np.linspace(0, np.pi, 50, endpoint=False),
+                               np.linspace(np.pi, 2 * np.pi, 201)])
+        dx = np.pi / 50
+        nstep = int(np.ceil(2 * np.pi / (0.9 * dx)))
+
+        def build(dt):
+            svr = libst.LinearScalarSolver(grid=libst.Grid(xcrd),
+                                           time_increment=dt)
+            svr.set_so0(0, np.sin(svr.xctr()))
+            svr.set_so1(0, np.cos(svr.xctr()))
+            svr.setup_march()
+            return svr
+
+        def error(svr):
+            so0 = svr.get_so0(0).ndarray
+            return np.abs(so0 - np.sin(svr.xctr() - svr.time)).max()
+
+        svr_lts = build(2 * np.pi / nstep)
+        svr_lts.march_alpha2_lts(steps=nstep, cfl_limit=1.0)
+        level = svr_lts.lts_level.ndarray
+        self.assertEqual(2 * 250 + 1, len(level))
+        self.assertEqual(0, level[:90].max())
+        self.assertEqual(2, level[110:].min())
+        self.assertLessEqual(np.abs(np.diff(level.astype(int))).max(), 1)
+        self.assertAlmostEqual(2 * np.pi, svr_lts.time)
+        # As accurate as the global time increment of the finest level.
+        svr_fine = build(2 * np.pi / (4 * nstep))
+        svr_fine.march_alpha2(steps=4 * nstep)
+        self.assertLess(error(svr_lts), 1.1 * error(svr_fine))
+        self.assertLess(error(svr_lts), 0.05)
+
+        with self.assertRaisesRegex(ValueError, "needs more than max_level"):
+            svr_lts.update_lts_level(cfl_limit=1.0, max_level=1)
+
+    def test_march_lts_conservation(self):
+
+        # A pulse marches through the interfaces of the levels at x = pi.
+        xcrd = np.concatenate([np.linspace(0, np.pi, 50, endpoint=False),
+                               np.linspace(np.pi, 2 * np.pi, 200)])
+        svr = libst.LinearScalarSolver(grid=libst.Grid(xcrd),
+                                       time_increment=0.9 * np.pi / 50)
+        xctr = svr.xctr()
+        inside = (xctr > 1) & (xctr < 2.5)
+        phase = (xctr - 1) / 1.5 * np.pi
+        svr.set_so0(0, 1 + np.where(inside, np.sin(phase), 0))
+        svr.set_so1(0, np.where(inside, np.cos(phase) * np.pi / 1.5, 0))
+        svr.setup_march()
+
+        def mass():
+            return sum(e.dx * e.get_so0(0)
+                       for e in svr.selms(odd_plane=False))
+
+        mass0 = mass()
+        for it in range(60):
+            svr.march_alpha2_lts(steps=1, cfl_limit=1.0)
+            self.assertAlmostEqual(mass0, mass(), delta=1.e-13)
+        self.assertEqual(2, svr.lts_level.ndarray.max())
+
+    def test_checkpoint(self):
+
+        _, _, svr = self._build_solver(100)
+        svr.march_alpha2(steps=10)
+        self.assertEqual(10, svr.nstep)
+        with tempfile.TemporaryDirectory() as tmpdir:
+            path = os.path.join(tmpdir, "linear_scalar.ckpt")
+            svr.save_checkpoint(path)
+            so0 = svr.so0.ndarray.copy()
+            svr.march_alpha2(steps=5)
+
+            svr2 = libst.LinearScalarSolver(grid=svr.grid, time_increment=1)
+            svr2.load_checkpoint(path)
+            self.assertEqual(10, svr2.nstep)
+            self.assertEqual(svr.time_increment, svr2.time_increment)
+            np.testing.assert_equal(svr2.so0.ndarray[1:-1], so0[1:-1])
+            svr2.march_alpha2(steps=5)
+            self.assertEqual(svr.time, svr2.time)
+            np.testing.assert_equal(svr2.so0.ndarray[1:-1],
+                                    svr.so0.ndarray[1:-1])
+            np.testing.assert_equal(svr2.so1.ndarray[1:-1],
+                                    svr.so1.ndarray[1:-1])
+
+            grid3 = libst.Grid(0, 1, 10)
+            svr3 = libst.LinearScalarSolver(grid=grid3, time_increment=1)
+            with self.assertRaisesRegex(ValueError, "grid in .* does not"):
+                svr3.load_checkpoint(path)
+
+    def test_snapshot(self):
+
+        _, _, svr = self._build_solver(100)
+        with tempfile.TemporaryDirectory() as tmpdir:
+            path = os.path.join(tmpdir, "linear_scalar.snap")
+            writer = modmesh.SnapshotWriter(path, capacity=1)
+            svr.set_snapshot(writer, 3, ["so0"])
+            so0 = []
+            for it in range(3):
+                svr.march_alpha2(steps=3)
+                so0.append(svr.so0.ndarray.copy())
+            svr.take_snapshot()
+            writer.close()
+            self.assertFalse(writer.is_open)
+
+            reader = modmesh.SnapshotReader(path)
+            self.assertEqual(4, reader.nframe)
+            for it in range(3):
+                self.assertEqual(3 * (it + 1), reader.integer(it, "nstep"))
+                np.testing.assert_equal(reader.array(it, "so0"), so0[it])
+            self.assertEqual(svr.time, reader.real(3, "time"))
+
+    def test_snapshot_clone(self):
+
+        _, _, svr = self._build_solver(100)
+        with tempfile.TemporaryDirectory() as tmpdir:
+            path = os.path.join(tmpdir, "linear_scalar.snap")
+            writer = modmesh.SnapshotWriter(path, capacity=1)
+            svr.set_snapshot(writer, 1, ["so0"])
+            svr.march_alpha2(steps=1)
+
+            # The clone does not write to the stream of the original.
+            clone = svr.clone()
+            self.assertIsNone(clone.snapshot_writer)
+            clone.march_alpha2(steps=2)
+            with self.assertRaisesRegex(RuntimeError, "no snapshot writer"):
+                clone.take_snapshot()
+            self.assertIs(writer, svr.snapshot_writer)
+            writer.close()
+
+            reader = modmesh.SnapshotReader(path)
+            self.assertEqual(1, reader.nframe)
+            self.assertEqual(1, reader.integer(0, "nstep"))
+
+            svr.clear_snapshot()
+            self.assertIsNone(svr.snapshot_writer)
+
+    def test_ensemble(self):
+
+        nstep, xcrd, svr = self._build_solver(100)
+        dts = [svr.time_increment, 0.5 * svr.time_increment]
+        ens = libst.LinearScalarEnsemble(grid=svr.grid, time_increments=dts)
+        self.assertEqual(2, ens.nmember)
+        self.assertIs(svr.grid, ens.grid)
+        solos = [libst.LinearScalarSolver(grid=svr.grid, time_increment=dt)
+                 for dt in dts]
+        for im, solo in enumerate(solos):
+            for s in (ens.member(im), solo):
+                s.set_so0(0, np.sin(xcrd + im))
+                s.set_so1(0, np.cos(xcrd + im))
+        ens.setup_march()
+        ens.march_alpha2(steps=nstep)
+
+        # Each member marches with its own time increment, like a solver
+        # marching alone.
+        for im, solo in enumerate(solos):
+            solo.setup_march()
+            solo.march_alpha2(steps=nstep)
+            member = ens.member(im)
+            self.assertEqual(nstep, member.nstep)
+            self.assertEqual(solo.time, member.time)
+            self.assertEqual(solo.so0.ndarray.tolist(),
+                             member.so0.ndarray.tolist())
+            self.assertEqual(solo.so1.ndarray.tolist(),
+                             member.so1.ndarray.tolist())
+
+        with self.assertRaisesRegex(IndexError, "out of range"):
+            ens.member(2)
+        other = self._build_solver(10)[-1]
+        with self.assertRaisesRegex(ValueError, "not on the grid"):
+            libst.LinearScalarEnsemble(members=[svr, other])
+
 
 class LinearScalarGridTestTC(unittest.TestCase):
     """
@@ -253,6 +253,22 @@ class PythonCustomSolverTC(unittest.TestCase):
         self.nstep, self.xcrd, self.svr = self._build_solver(self.resolution)
         self.cycle = 10
 
+    def test_static_kernel(self):
+        self.assertFalse(libst.Solver.static_kernel)
+        self.assertTrue(libst.LinearScalarSolver.static_kernel)
+        self.assertTrue(libst.InviscidBurgersSolver.static_kernel)
+
+        # The compiled kernel gives the same solution as the Python one.
+        svr = libst.LinearScalarSolver(
+            grid=self.svr.grid, time_increment=self.svr.time_increment)
+        svr.set_so0(0, np.sin(self.xcrd))
+        svr.set_so1(0, np.cos(self.xcrd))
+        svr.setup_march()
+        svr.march_alpha2(steps=self.nstep)
+        self.svr.march_alpha2(steps=self.nstep)
+        np.testing.assert_allclose(svr.get_so0(0), self.svr.get_so0(0))
+        np.testing.assert_allclose(svr.get_so1(0), self.svr.get_so1(0))
+
     def test_xctr(self):
         # On even plane.
         self.assertEqual(len(self.svr.xctr()), self.svr.grid.ncelm + 1)
@@ -413,4 +413,22 @@ class MetalTC(unittest.TestCase):
     def test_metal_status(self):
         self.assertEqual(True, modmesh.metal_running())
 
+
+class ThreadPoolTC(unittest.TestCase):
+
+    def test_singleton(self):
+        self.assertIs(modmesh.thread_pool, modmesh.ThreadPool.me)
+
+    def test_nthread(self):
+        pool = modmesh.thread_pool
+        orig = pool.nthread
+        self.assertGreaterEqual(orig, 1)
+        try:
+            pool.nthread = 2
+            self.assertEqual(2, pool.nthread)
+        finally:
+            pool.nthread = orig
+        self.assertEqual(orig, pool.nthread)
+
+
 # vim: set ff=unix fenc=utf8 et sw=4 ts=4 sts=4: